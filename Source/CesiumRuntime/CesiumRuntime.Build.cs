@@ -121,6 +121,7 @@ public class CesiumRuntime : ModuleRules
         );
 
         PrivateDependencyModuleNames.Add("Chaos");
+        PrivateDependencyModuleNames.Add("Json");
 
         if (Target.bBuildEditor == true)
         {
@@ -16,6 +16,7 @@
 #include "CesiumBoundingVolumeComponent.h"
 #include "CesiumCamera.h"
 #include "CesiumCameraManager.h"
+#include "CesiumCameraSubsystem.h"
 #include "CesiumCommon.h"
 #include "CesiumCustomVersion.h"
 #include "CesiumGeospatial/GlobeTransforms.h"
@@ -26,12 +27,21 @@
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumIonClient/Connection.h"
 #include "CesiumLifetime.h"
+#include "CesiumOnDemandPhysicsMeshes.h"
+#include "CesiumPrimitivePool.h"
+#include "CesiumTilesetPrimitiveComponent.h"
 #include "CesiumRasterOverlay.h"
 #include "CesiumRuntime.h"
 #include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
 #include "CesiumTextureUtility.h"
+#include "CesiumTileBudgetSubsystem.h"
 #include "CesiumTileExcluder.h"
+#include "CesiumTileLoadingBudget.h"
+#include "CesiumTilesToHide.h"
 #include "CesiumViewExtension.h"
+#include "CesiumViewStatePredictor.h"
+#include "CesiumVisibleGltfs.h"
 #include "Components/SceneCaptureComponent2D.h"
 #include "CreateGltfOptions.h"
 #include "Engine/Engine.h"
@@ -43,6 +53,7 @@
 #include "Engine/World.h"
 #include "EngineUtils.h"
 #include "ExtensionImageAssetUnreal.h"
+#include "GameFramework/Pawn.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/GameplayStatics.h"
 #include "LevelSequenceActor.h"
@@ -51,7 +62,9 @@
 #include "PixelFormat.h"
 #include "StereoRendering.h"
 #include "VecMath.h"
+#include <algorithm>
 #include <glm/gtc/matrix_inverse.hpp>
+#include <limits>
 #include <memory>
 #include <spdlog/spdlog.h>
 
@@ -92,7 +105,18 @@ ACesium3DTileset::ACesium3DTileset()
       _beforeMovieLoadingDescendantLimit{LoadingDescendantLimit},
       _beforeMovieUseLodTransitions{true},
 
-      _tilesetsBeingDestroyed(0) {
+      _pTilesToHideNextFrame(MakeShared<CesiumTilesToHide>()),
+      _renderGeneration(1),
+      _transformEpoch(1),
+      _pVisibleGltfs(MakeShared<CesiumVisibleGltfs>()),
+      _amortizeTileDestruction(false),
+
+      _tilesetsBeingDestroyed(0),
+
+      _pViewStatePredictor(MakeShared<CesiumViewStatePredictor>()),
+      _predictedTileLoadQueueLength(0),
+      _pOnDemandPhysicsMeshes(MakeShared<CesiumOnDemandPhysicsMeshes>()),
+      _pTileLoadingBudget(MakeShared<CesiumTileLoadingBudget>()) {
 
   PrimaryActorTick.bCanEverTick = true;
   PrimaryActorTick.TickGroup = ETickingGroup::TG_PostUpdateWork;
@@ -356,6 +380,13 @@ void ACesium3DTileset::PostInitProperties() {
   }
 }
 
+float ACesium3DTileset::GetVertexInflationFactor() const {
+  if (this->_gltfVertexCount == 0) {
+    return 1.0f;
+  }
+  return float(double(this->_vertexCount) / double(this->_gltfVertexCount));
+}
+
 void ACesium3DTileset::SetUseLodTransitions(bool InUseLodTransitions) {
   if (InUseLodTransitions != this->UseLodTransitions) {
     this->UseLodTransitions = InUseLodTransitions;
@@ -449,6 +480,31 @@ void ACesium3DTileset::SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes) {
   }
 }
 
+void ACesium3DTileset::SetCookPhysicsMeshesOnDemand(
+    bool bCookPhysicsMeshesOnDemand) {
+  if (this->CookPhysicsMeshesOnDemand != bCookPhysicsMeshesOnDemand) {
+    this->CookPhysicsMeshesOnDemand = bCookPhysicsMeshesOnDemand;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetSimplifyPhysicsMeshes(bool bSimplifyPhysicsMeshes) {
+  if (this->SimplifyPhysicsMeshes != bSimplifyPhysicsMeshes) {
+    this->SimplifyPhysicsMeshes = bSimplifyPhysicsMeshes;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetPhysicsMeshMaximumError(
+    float NewPhysicsMeshMaximumError) {
+  if (this->PhysicsMeshMaximumError != NewPhysicsMeshMaximumError) {
+    this->PhysicsMeshMaximumError = NewPhysicsMeshMaximumError;
+    if (this->SimplifyPhysicsMeshes) {
+      this->DestroyTileset();
+    }
+  }
+}
+
 void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
   if (this->CreateNavCollision != bCreateNavCollision) {
     this->CreateNavCollision = bCreateNavCollision;
@@ -456,6 +512,14 @@ void ACesium3DTileset::SetCreateNavCollision(bool bCreateNavCollision) {
   }
 }
 
+void ACesium3DTileset::SetCanEverAffectNavigation(
+    bool bCanEverAffectNavigation) {
+  if (this->CanEverAffectNavigation != bCanEverAffectNavigation) {
+    this->CanEverAffectNavigation = bCanEverAffectNavigation;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents) {
   if (this->AlwaysIncludeTangents != bAlwaysIncludeTangents) {
     this->AlwaysIncludeTangents = bAlwaysIncludeTangents;
@@ -463,6 +527,14 @@ void ACesium3DTileset::SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents) {
   }
 }
 
+void ACesium3DTileset::SetTangentGeneration(
+    ETangentGeneration NewTangentGeneration) {
+  if (this->TangentGeneration != NewTangentGeneration) {
+    this->TangentGeneration = NewTangentGeneration;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
   if (this->GenerateSmoothNormals != bGenerateSmoothNormals) {
     this->GenerateSmoothNormals = bGenerateSmoothNormals;
@@ -470,6 +542,31 @@ void ACesium3DTileset::SetGenerateSmoothNormals(bool bGenerateSmoothNormals) {
   }
 }
 
+void ACesium3DTileset::SetVertexFormat(ETileVertexFormat NewVertexFormat) {
+  if (this->VertexFormat != NewVertexFormat) {
+    this->VertexFormat = NewVertexFormat;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetGenerateIndexedFlatNormals(
+    bool bGenerateIndexedFlatNormals) {
+  if (this->GenerateIndexedFlatNormals != bGenerateIndexedFlatNormals) {
+    this->GenerateIndexedFlatNormals = bGenerateIndexedFlatNormals;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetFlatNormalCreaseAngle(
+    float NewFlatNormalCreaseAngle) {
+  if (this->FlatNormalCreaseAngle != NewFlatNormalCreaseAngle) {
+    this->FlatNormalCreaseAngle = NewFlatNormalCreaseAngle;
+    if (this->GenerateIndexedFlatNormals) {
+      this->DestroyTileset();
+    }
+  }
+}
+
 void ACesium3DTileset::SetEnableWaterMask(bool bEnableMask) {
   if (this->EnableWaterMask != bEnableMask) {
     this->EnableWaterMask = bEnableMask;
@@ -485,6 +582,27 @@ void ACesium3DTileset::SetIgnoreKhrMaterialsUnlit(
   }
 }
 
+void ACesium3DTileset::SetMergePrimitives(bool bMergePrimitives) {
+  if (this->MergePrimitives != bMergePrimitives) {
+    this->MergePrimitives = bMergePrimitives;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetUseTilesetSceneProxy(bool bUseTilesetSceneProxy) {
+  if (this->UseTilesetSceneProxy != bUseTilesetSceneProxy) {
+    this->UseTilesetSceneProxy = bUseTilesetSceneProxy;
+    this->DestroyTileset();
+  }
+}
+
+void ACesium3DTileset::SetQuantizePositions(bool bQuantizePositions) {
+  if (this->QuantizePositions != bQuantizePositions) {
+    this->QuantizePositions = bQuantizePositions;
+    this->DestroyTileset();
+  }
+}
+
 void ACesium3DTileset::SetMaterial(UMaterialInterface* InMaterial) {
   if (this->Material != InMaterial) {
     this->Material = InMaterial;
@@ -668,15 +786,15 @@ ACesium3DTileset::GetCesiumTilesetToUnrealRelativeWorldTransform() const {
 }
 
 void ACesium3DTileset::UpdateTransformFromCesium() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTransformFromCesium)
 
   const glm::dmat4& CesiumToUnreal =
       this->GetCesiumTilesetToUnrealRelativeWorldTransform();
-  TArray<UCesiumGltfComponent*> gltfComponents;
-  this->GetComponents<UCesiumGltfComponent>(gltfComponents);
 
-  for (UCesiumGltfComponent* pGltf : gltfComponents) {
-    pGltf->UpdateTransformFromCesium(CesiumToUnreal);
-  }
+  // Hidden tiles, which are usually the vast majority, are updated by
+  // showTilesToRender if and when they are shown again.
+  ++this->_transformEpoch;
+  this->_pVisibleGltfs->updateTransforms(CesiumToUnreal, this->_transformEpoch);
 
   if (this->BoundingVolumePoolComponent) {
     this->BoundingVolumePoolComponent->UpdateTransformFromCesium(
@@ -748,6 +866,7 @@ void ACesium3DTileset::OnConstruction(const FTransform& Transform) {
         pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
       }
     }
+    this->_pVisibleGltfs->clear();
   }
 }
 
@@ -772,6 +891,44 @@ void ACesium3DTileset::NotifyHit(
   // std::cout << "Hit face index 2: " << detailedHit.FaceIndex << std::endl;
 }
 
+namespace {
+/**
+ * Gets the time in milliseconds that may be spent creating the components of
+ * a tile right now, or zero if there is no limit.
+ */
+double getTileCreationTimeLimit(const CesiumTileLoadingBudget& budget) {
+  double limit = GetDefault<UCesiumRuntimeSettings>()->TileCreationTimeSlice;
+  if (limit <= 0.0) {
+    return 0.0;
+  }
+
+  if (CesiumTileLoadingBudget::isEnabled()) {
+    limit = glm::min(
+        limit,
+        budget.getRemainingMilliseconds(
+            CesiumTileLoadingBudget::Direction::Load));
+  }
+  return limit;
+}
+
+/**
+ * Gets the number of bytes of a tile's model, as counted by the total data
+ * bytes of the tileset.
+ */
+int64 computeDataBytes(const CesiumGltf::Model& model) {
+  int64 bytes = 0;
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bytes += int64(buffer.cesium.data.size());
+  }
+  for (const CesiumGltf::Image& image : model.images) {
+    if (image.pAsset) {
+      bytes += int64(image.pAsset->pixelData.size());
+    }
+  }
+  return bytes;
+}
+} // namespace
+
 class UnrealResourcePreparer
     : public Cesium3DTilesSelection::IPrepareRendererResources {
 public:
@@ -793,10 +950,25 @@ public:
     }
 
     options.alwaysIncludeTangents = this->_pActor->GetAlwaysIncludeTangents();
+    options.generateIndexedTangents =
+        this->_pActor->GetTangentGeneration() == ETangentGeneration::Indexed;
+    options.generateIndexedFlatNormals =
+        this->_pActor->GetGenerateIndexedFlatNormals();
+    options.flatNormalCreaseAngle = this->_pActor->GetFlatNormalCreaseAngle();
+    options.compactVertexFormat =
+        this->_pActor->GetVertexFormat() == ETileVertexFormat::Compact;
     options.createPhysicsMeshes = this->_pActor->GetCreatePhysicsMeshes();
+    options.cookPhysicsMeshesOnDemand =
+        this->_pActor->GetCookPhysicsMeshesOnDemand();
+    options.simplifyPhysicsMeshes = this->_pActor->GetSimplifyPhysicsMeshes();
+    options.physicsMeshMaximumError =
+        this->_pActor->GetPhysicsMeshMaximumError();
 
     options.ignoreKhrMaterialsUnlit =
         this->_pActor->GetIgnoreKhrMaterialsUnlit();
+    options.mergePrimitives = this->_pActor->GetMergePrimitives();
+    options.quantizePositions = this->_pActor->GetQuantizePositions() &&
+                                this->_pActor->GetUseTilesetSceneProxy();
 
     if (this->_pActor->_featuresMetadataDescription) {
       options.pFeaturesMetadataDescription =
@@ -828,6 +1000,9 @@ public:
   virtual void* prepareInMainThread(
       Cesium3DTilesSelection::Tile& tile,
       void* pLoadThreadResult) override {
+    CesiumTileLoadingBudget::ScopedTimer timer(
+        *this->_pActor->_pTileLoadingBudget,
+        CesiumTileLoadingBudget::Direction::Load);
     Cesium3DTilesSelection::TileContent& content = tile.getContent();
     if (content.isRenderContent()) {
       TUniquePtr<UCesiumGltfComponent::HalfConstructed> pHalf(
@@ -835,7 +1010,7 @@ public:
               pLoadThreadResult));
       Cesium3DTilesSelection::TileRenderContent& renderContent =
           *content.getRenderContent();
-      return UCesiumGltfComponent::CreateOnGameThread(
+      UCesiumGltfComponent* pGltf = UCesiumGltfComponent::CreateOnGameThread(
           renderContent.getModel(),
           this->_pActor,
           std::move(pHalf),
@@ -845,7 +1020,18 @@ public:
           this->_pActor->GetWaterMaterial(),
           this->_pActor->GetCustomDepthParameters(),
           tile,
-          this->_pActor->GetCreateNavCollision());
+          this->_pActor->GetCreateNavCollision() &&
+              this->_pActor->GetCanEverAffectNavigation(),
+          getTileCreationTimeLimit(*this->_pActor->_pTileLoadingBudget));
+      pGltf->TransformEpoch = this->_pActor->_transformEpoch;
+      pGltf->DataBytes = computeDataBytes(renderContent.getModel());
+      this->_pActor->_gltfVertexCount += pGltf->GltfVertexCount;
+      this->_pActor->_vertexCount += pGltf->VertexCount;
+      this->_pActor->_compactVertexBytesSaved += pGltf->CompactVertexBytesSaved;
+      if (!pGltf->IsCreationComplete()) {
+        this->_pActor->_gltfsBeingCreated.emplace_back(pGltf);
+      }
+      return pGltf;
     }
     // UE_LOG(LogCesium, VeryVerbose, TEXT("No content for tile"));
     return nullptr;
@@ -855,6 +1041,9 @@ public:
       Cesium3DTilesSelection::Tile& tile,
       void* pLoadThreadResult,
       void* pMainThreadResult) noexcept override {
+    CesiumTileLoadingBudget::ScopedTimer timer(
+        *this->_pActor->_pTileLoadingBudget,
+        CesiumTileLoadingBudget::Direction::Unload);
     if (pLoadThreadResult) {
       UCesiumGltfComponent::HalfConstructed* pHalf =
           reinterpret_cast<UCesiumGltfComponent::HalfConstructed*>(
@@ -863,7 +1052,24 @@ public:
     } else if (pMainThreadResult) {
       UCesiumGltfComponent* pGltf =
           reinterpret_cast<UCesiumGltfComponent*>(pMainThreadResult);
-      CesiumLifetime::destroyComponentRecursively(pGltf);
+      // The tile itself may be destroyed once its content is gone.
+      this->_pActor->_pTilesToHideNextFrame->remove(&tile);
+      this->_pActor->_pVisibleGltfs->remove(pGltf);
+      this->_pActor->_gltfVertexCount -= pGltf->GltfVertexCount;
+      this->_pActor->_vertexCount -= pGltf->VertexCount;
+      this->_pActor->_compactVertexBytesSaved -= pGltf->CompactVertexBytesSaved;
+
+      // Keep the reusable parts of the tile for tiles loaded later.
+      UCesiumPrimitivePool* pPool = this->_pActor->GetPrimitivePool();
+      if (pPool) {
+        pPool->ReleasePrimitiveComponents(pGltf);
+      }
+
+      if (this->_pActor->_amortizeTileDestruction) {
+        CesiumLifetime::destroyComponentRecursivelyAmortized(pGltf);
+      } else {
+        CesiumLifetime::destroyComponentRecursively(pGltf);
+      }
     }
   }
 
@@ -1039,9 +1245,11 @@ void ACesium3DTileset::UpdateLoadStatus() {
     return;
   }
 
-  // If we have tiles to hide next frame, we haven't completely finished loading
-  // yet. We need to tick once more. We're really close to done.
-  if (!this->_tilesToHideNextFrame.empty()) {
+  // If we have tiles to hide next frame, or tiles whose components are still
+  // being created, we haven't completely finished loading yet. We need to tick
+  // once more. We're really close to done.
+  if (!this->_pTilesToHideNextFrame->isEmpty() ||
+      !this->_gltfsBeingCreated.empty()) {
     this->LoadProgress = glm::min(this->LoadProgress, 99.9999f);
     return;
   }
@@ -1174,6 +1382,35 @@ void ACesium3DTileset::LoadTileset() {
     this->BoundingVolumePoolComponent->initPool(this->OcclusionPoolSize);
   }
 
+  if (!this->PrimitivePool) {
+    this->PrimitivePool = NewObject<UCesiumPrimitivePool>(this);
+    this->PrimitivePool->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+  }
+  this->PrimitivePool->SetMaximumSize(this->PrimitivePoolSize);
+
+  if (this->UseTilesetSceneProxy && !this->TilesetPrimitiveComponent) {
+    this->TilesetPrimitiveComponent =
+        NewObject<UCesiumTilesetPrimitiveComponent>(this);
+    this->TilesetPrimitiveComponent->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    this->TilesetPrimitiveComponent->RegisterComponent();
+  } else if (!this->UseTilesetSceneProxy && this->TilesetPrimitiveComponent) {
+    // Tiles of the previous tileset that are still being destroyed only refer
+    // to this component weakly.
+    this->TilesetPrimitiveComponent->DestroyComponent();
+    this->TilesetPrimitiveComponent = nullptr;
+  }
+
+  if (this->TilesetPrimitiveComponent) {
+    this->TilesetPrimitiveComponent->SetRenderCustomDepth(
+        this->CustomDepthParameters.RenderCustomDepth);
+    this->TilesetPrimitiveComponent->SetCustomDepthStencilWriteMask(
+        this->CustomDepthParameters.CustomDepthStencilWriteMask);
+    this->TilesetPrimitiveComponent->SetCustomDepthStencilValue(
+        this->CustomDepthParameters.CustomDepthStencilValue);
+  }
+
   CesiumGeospatial::Ellipsoid pNativeEllipsoid =
       this->ResolveGeoreference()->GetEllipsoid()->GetNativeEllipsoid();
 
@@ -1242,6 +1479,8 @@ void ACesium3DTileset::LoadTileset() {
       };
 
   // Generous per-frame time limits for loading / unloading on main thread.
+  // These are replaced every frame when the adaptive tile loading budget is
+  // enabled in the runtime settings.
   options.mainThreadLoadingTimeLimit = 5.0;
   options.tileCacheUnloadTimeLimit = 5.0;
 
@@ -1362,11 +1601,14 @@ void ACesium3DTileset::LoadTileset() {
   }
 }
 
-void ACesium3DTileset::DestroyTileset() {
+void ACesium3DTileset::DestroyTileset(bool allowAmortizedTileDestruction) {
   if (this->_cesiumViewExtension) {
     this->_cesiumViewExtension = nullptr;
   }
 
+  // The physics meshes go away with the tiles.
+  this->_pOnDemandPhysicsMeshes->reset();
+
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
     UE_LOG(
@@ -1415,7 +1657,28 @@ void ACesium3DTileset::DestroyTileset() {
   ++this->_tilesetsBeingDestroyed;
   this->_pTileset->getAsyncDestructionCompleteEvent().thenInMainThread(
       [this]() { --this->_tilesetsBeingDestroyed; });
+
+  // When only the tileset is recreated, for example because a property
+  // changed, its tiles are destroyed over several frames to avoid a long
+  // hitch. When the actor or its world goes away, they go right away, too.
+  UWorld* pWorld = this->GetWorld();
+  this->_amortizeTileDestruction =
+      allowAmortizedTileDestruction && !this->HasAnyFlags(RF_BeginDestroyed) &&
+      !this->IsActorBeingDestroyed() && IsValid(pWorld) &&
+      !pWorld->bIsTearingDown;
   this->_pTileset.Reset();
+  this->_amortizeTileDestruction = false;
+
+  // These refer to tiles of the destroyed tileset.
+  this->_pTilesToHideNextFrame->clear();
+  this->_gltfsBeingCreated.clear();
+  this->_pVisibleGltfs->clear();
+
+  UCesiumTileBudgetSubsystem* pTileBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (pTileBudget) {
+    pTileBudget->RemoveTileset(this);
+  }
 
   switch (this->TilesetSource) {
   case ETilesetSource::FromUrl:
@@ -1435,378 +1698,34 @@ void ACesium3DTileset::DestroyTileset() {
   }
 }
 
-std::vector<FCesiumCamera> ACesium3DTileset::GetCameras() const {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
-  std::vector<FCesiumCamera> cameras = this->GetPlayerCameras();
-
-  std::vector<FCesiumCamera> sceneCaptures = this->GetSceneCaptures();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(sceneCaptures.begin()),
-      std::make_move_iterator(sceneCaptures.end()));
-
-#if WITH_EDITOR
-  std::vector<FCesiumCamera> editorCameras = this->GetEditorCameras();
-  cameras.insert(
-      cameras.end(),
-      std::make_move_iterator(editorCameras.begin()),
-      std::make_move_iterator(editorCameras.end()));
-#endif
-
-  ACesiumCameraManager* pCameraManager = this->ResolvedCameraManager;
-  if (pCameraManager) {
-    const TMap<int32, FCesiumCamera>& extraCameras =
-        pCameraManager->GetCameras();
-    cameras.reserve(cameras.size() + extraCameras.Num());
-    for (auto cameraIt : extraCameras) {
-      cameras.push_back(cameraIt.Value);
-    }
-  }
-
-  return cameras;
-}
-
-std::vector<FCesiumCamera> ACesium3DTileset::GetPlayerCameras() const {
-  UWorld* pWorld = this->GetWorld();
-  if (!pWorld) {
-    return {};
-  }
-
-  double worldToMeters = 100.0;
-  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
-  if (pWorldSettings) {
-    worldToMeters = pWorldSettings->WorldToMeters;
-  }
-
-  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
-  if (GEngine) {
-    pStereoRendering = GEngine->StereoRenderingDevice;
-  }
-
-  bool useStereoRendering = false;
-  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
-    useStereoRendering = true;
-  }
-
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(pWorld->GetNumPlayerControllers());
-
-  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
-       playerControllerIt;
-       playerControllerIt++) {
-
-    const TWeakObjectPtr<APlayerController> pPlayerController =
-        *playerControllerIt;
-    if (pPlayerController == nullptr) {
-      continue;
-    }
-
-    const APlayerCameraManager* pPlayerCameraManager =
-        pPlayerController->PlayerCameraManager;
-
-    if (!pPlayerCameraManager) {
-      continue;
-    }
-
-    double fov = pPlayerCameraManager->GetFOVAngle();
-
-    FVector location;
-    FRotator rotation;
-    pPlayerController->GetPlayerViewPoint(location, rotation);
-
-    int32 sizeX, sizeY;
-    pPlayerController->GetViewportSize(sizeX, sizeY);
-    if (sizeX < 1 || sizeY < 1) {
-      continue;
-    }
-
-    float dpiScalingFactor = 1.0f;
-    if (this->_scaleUsingDPI) {
-      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
-      if (LocPlayer && LocPlayer->ViewportClient) {
-        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
-      }
-    }
-
-    if (useStereoRendering) {
-      const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
-      const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
-
-      uint32 stereoLeftSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoLeftSizeY = static_cast<uint32>(sizeY);
-      uint32 stereoRightSizeX = static_cast<uint32>(sizeX);
-      uint32 stereoRightSizeY = static_cast<uint32>(sizeY);
-      if (useStereoRendering) {
-        int32 _x;
-        int32 _y;
-
-        pStereoRendering
-            ->AdjustViewRect(leftEye, _x, _y, stereoLeftSizeX, stereoLeftSizeY);
-
-        pStereoRendering->AdjustViewRect(
-            rightEye,
-            _x,
-            _y,
-            stereoRightSizeX,
-            stereoRightSizeY);
-      }
-
-      FVector2D stereoLeftSize(stereoLeftSizeX, stereoLeftSizeY);
-      FVector2D stereoRightSize(stereoRightSizeX, stereoRightSizeY);
-
-      if (stereoLeftSize.X >= 1.0 && stereoLeftSize.Y >= 1.0) {
-        FVector leftEyeLocation = location;
-        FRotator leftEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            leftEye,
-            leftEyeRotation,
-            worldToMeters,
-            leftEyeLocation);
-
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(leftEye);
-
-        // TODO: consider assymetric frustums using 4 fovs
-        double one_over_tan_half_hfov = projection.M[0][0];
-
-        double hfov =
-            glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
-
-        cameras.emplace_back(
-            stereoLeftSize,
-            leftEyeLocation,
-            leftEyeRotation,
-            hfov);
-      }
-
-      if (stereoRightSize.X >= 1.0 && stereoRightSize.Y >= 1.0) {
-        FVector rightEyeLocation = location;
-        FRotator rightEyeRotation = rotation;
-        pStereoRendering->CalculateStereoViewOffset(
-            rightEye,
-            rightEyeRotation,
-            worldToMeters,
-            rightEyeLocation);
-
-        FMatrix projection =
-            pStereoRendering->GetStereoProjectionMatrix(rightEye);
-
-        double one_over_tan_half_hfov = projection.M[0][0];
-
-        double hfov =
-            glm::degrees(2.0f * glm::atan(1.0f / one_over_tan_half_hfov));
-
-        cameras.emplace_back(
-            stereoRightSize,
-            rightEyeLocation,
-            rightEyeRotation,
-            hfov);
-      }
-    } else {
-      cameras.emplace_back(
-          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
-          location,
-          rotation,
-          fov);
-    }
-  }
-
-  return cameras;
-}
-
-std::vector<FCesiumCamera> ACesium3DTileset::GetSceneCaptures() const {
-  // TODO: really USceneCaptureComponent2D can be attached to any actor, is it
-  // worth searching every actor? Might it be better to provide an interface
-  // where users can volunteer cameras to be used with the tile selection as
-  // needed?
-  TArray<AActor*> sceneCaptures;
-  static TSubclassOf<ASceneCapture2D> SceneCapture2D =
-      ASceneCapture2D::StaticClass();
-  UGameplayStatics::GetAllActorsOfClass(this, SceneCapture2D, sceneCaptures);
-
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(sceneCaptures.Num());
-
-  for (AActor* pActor : sceneCaptures) {
-    ASceneCapture2D* pSceneCapture = static_cast<ASceneCapture2D*>(pActor);
-    if (!pSceneCapture) {
-      continue;
-    }
-
-    USceneCaptureComponent2D* pSceneCaptureComponent =
-        pSceneCapture->GetCaptureComponent2D();
-    if (!pSceneCaptureComponent) {
-      continue;
-    }
-
-    if (pSceneCaptureComponent->ProjectionType !=
-        ECameraProjectionMode::Type::Perspective) {
-      continue;
-    }
-
-    UTextureRenderTarget2D* pRenderTarget =
-        pSceneCaptureComponent->TextureTarget;
-    if (!pRenderTarget) {
-      continue;
-    }
-
-    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
-    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
-      continue;
-    }
-
-    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
-    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
-    double captureFov = pSceneCaptureComponent->FOVAngle;
-
-    cameras.emplace_back(
-        renderTargetSize,
-        captureLocation,
-        captureRotation,
-        captureFov);
-  }
-
-  return cameras;
-}
-
-/*static*/ Cesium3DTilesSelection::ViewState
-ACesium3DTileset::CreateViewStateFromViewParameters(
-    const FCesiumCamera& camera,
-    const glm::dmat4& unrealWorldToTileset,
-    UCesiumEllipsoid* ellipsoid) {
-
-  double horizontalFieldOfView =
-      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
-
-  double actualAspectRatio;
-  glm::dvec2 size(camera.ViewportSize.X, camera.ViewportSize.Y);
-
-  if (camera.OverrideAspectRatio != 0.0f) {
-    // Use aspect ratio and recompute effective viewport size after black bars
-    // are added.
-    actualAspectRatio = camera.OverrideAspectRatio;
-    double computedX = actualAspectRatio * camera.ViewportSize.Y;
-    double computedY = camera.ViewportSize.Y / actualAspectRatio;
-
-    double barWidth = camera.ViewportSize.X - computedX;
-    double barHeight = camera.ViewportSize.Y - computedY;
-
-    if (barWidth > 0.0 && barWidth > barHeight) {
-      // Black bars on the sides
-      size.x = computedX;
-    } else if (barHeight > 0.0 && barHeight > barWidth) {
-      // Black bars on the top and bottom
-      size.y = computedY;
-    }
-  } else {
-    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
-  }
-
-  double verticalFieldOfView =
-      atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
-
-  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
-  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
-
-  glm::dvec3 tilesetCameraLocation = glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(camera.Location.X, camera.Location.Y, camera.Location.Z, 1.0));
-  glm::dvec3 tilesetCameraFront = glm::normalize(glm::dvec3(
-      unrealWorldToTileset *
-      glm::dvec4(direction.X, direction.Y, direction.Z, 0.0)));
-  glm::dvec3 tilesetCameraUp = glm::normalize(
-      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0)));
-
-  return Cesium3DTilesSelection::ViewState::create(
-      tilesetCameraLocation,
-      tilesetCameraFront,
-      tilesetCameraUp,
-      size,
-      horizontalFieldOfView,
-      verticalFieldOfView,
-      ellipsoid->GetNativeEllipsoid());
-}
-
-#if WITH_EDITOR
-std::vector<FCesiumCamera> ACesium3DTileset::GetEditorCameras() const {
-  if (!GEditor) {
-    return {};
-  }
-
-  UWorld* pWorld = this->GetWorld();
-  if (!IsValid(pWorld)) {
-    return {};
-  }
-
-  // Do not include editor cameras when running in a game world (which includes
-  // Play-in-Editor)
-  if (pWorld->IsGameWorld()) {
-    return {};
-  }
-
-  const TArray<FEditorViewportClient*>& viewportClients =
-      GEditor->GetAllViewportClients();
-
-  std::vector<FCesiumCamera> cameras;
-  cameras.reserve(viewportClients.Num());
-
-  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
-    if (!pEditorViewportClient) {
-      continue;
-    }
-
-    if (!pEditorViewportClient->IsVisible() ||
-        !pEditorViewportClient->IsRealtime() ||
-        !pEditorViewportClient->IsPerspective()) {
-      continue;
-    }
-
-    FRotator rotation;
-    if (pEditorViewportClient->bUsingOrbitCamera) {
-      rotation = (pEditorViewportClient->GetLookAtLocation() -
-                  pEditorViewportClient->GetViewLocation())
-                     .Rotation();
-    } else {
-      rotation = pEditorViewportClient->GetViewRotation();
-    }
-
-    const FVector& location = pEditorViewportClient->GetViewLocation();
-    double fov = pEditorViewportClient->ViewFOV;
-    FIntPoint offset;
-    FIntPoint size;
-    pEditorViewportClient->GetViewportDimensions(offset, size);
-
-    if (size.X < 1 || size.Y < 1) {
-      continue;
-    }
-
-    if (this->_scaleUsingDPI) {
-      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
-      size.X = static_cast<float>(size.X) / dpiScalingFactor;
-      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
-    }
-
-    if (pEditorViewportClient->IsAspectRatioConstrained()) {
-      cameras.emplace_back(
-          size,
-          location,
-          rotation,
-          fov,
-          pEditorViewportClient->AspectRatio);
-    } else {
-      cameras.emplace_back(size, location, rotation, fov);
-    }
-  }
-
-  return cameras;
-}
-#endif
-
 bool ACesium3DTileset::ShouldTickIfViewportsOnly() const {
   return this->UpdateInEditor;
 }
 
 namespace {
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Tiles Rendered"),
+    STAT_CesiumTilesRendered,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Tiles Touched"),
+    STAT_CesiumTilesTouched,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Predicted Views"),
+    STAT_CesiumPredictedViews,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Predicted Tiles Waiting to Load"),
+    STAT_CesiumPredictedTilesWaitingToLoad,
+    STATGROUP_Cesium);
+
+// The time limit for finishing the loading of tiles for the predicted views,
+// when the adaptive tile loading budget is disabled. At least one tile is
+// finished per frame regardless, and the time limit of the current views
+// isn't used up a second time.
+constexpr double minimumPredictedViewLoadingTime = 0.001;
+
 template <typename Func>
 void forEachRenderableTile(const auto& tiles, Func&& f) {
   for (Cesium3DTilesSelection::Tile* pTile : tiles) {
@@ -1832,23 +1751,75 @@ void forEachRenderableTile(const auto& tiles, Func&& f) {
       continue;
     }
 
+    if (!Gltf->IsCreationComplete()) {
+      // Not all of the tile's components have been created yet, so it can't
+      // be shown. It was never visible, so there is nothing to hide either.
+      continue;
+    }
+
     f(pTile, Gltf);
   }
 }
 
-void removeVisibleTilesFromList(
-    std::vector<Cesium3DTilesSelection::Tile*>& list,
-    const std::vector<Cesium3DTilesSelection::Tile*>& visibleTiles) {
-  if (list.empty()) {
+/**
+ * @brief Continues creating the components of tiles whose creation did not
+ * fit into the time slice of a single frame.
+ *
+ * Tiles are continued in the order they were loaded, and entries for
+ * completed or destroyed components are removed from the list.
+ *
+ * @param gltfs The components still being created
+ * @param budget The tileset's loading budget
+ */
+void continueTileCreation(
+    std::vector<TWeakObjectPtr<UCesiumGltfComponent>>& gltfs,
+    CesiumTileLoadingBudget& budget) {
+  if (gltfs.empty()) {
     return;
   }
 
-  for (Cesium3DTilesSelection::Tile* pTile : visibleTiles) {
-    auto it = std::find(list.begin(), list.end(), pTile);
-    if (it != list.end()) {
-      list.erase(it);
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ContinueTileCreation)
+  CesiumTileLoadingBudget::ScopedTimer timer(
+      budget,
+      CesiumTileLoadingBudget::Direction::Load);
+
+  const double limit = getTileCreationTimeLimit(budget);
+  const double start = FPlatformTime::Seconds();
+
+  size_t completed = 0;
+  for (; completed < gltfs.size(); ++completed) {
+    const double elapsed = (FPlatformTime::Seconds() - start) * 1000.0;
+    if (limit > 0.0 && completed > 0 && elapsed >= limit) {
+      break;
+    }
+
+    UCesiumGltfComponent* pGltf = gltfs[completed].Get();
+    if (!IsValid(pGltf)) {
+      continue;
+    }
+
+    const double remaining =
+        limit > 0.0 ? glm::max(limit - elapsed, 0.001) : 0.0;
+    if (!pGltf->ContinueCreateOnGameThread(remaining)) {
+      break;
     }
   }
+
+  gltfs.erase(gltfs.begin(), gltfs.begin() + completed);
+}
+
+/**
+ * @brief Determines whether a tile is loaded but cannot be shown yet, because
+ * its components are still being created.
+ */
+bool isTileBeingCreated(const Cesium3DTilesSelection::Tile& tile) {
+  const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+      tile.getContent().getRenderContent();
+  const UCesiumGltfComponent* pGltf =
+      pRenderContent ? static_cast<const UCesiumGltfComponent*>(
+                           pRenderContent->getRenderResources())
+                     : nullptr;
+  return pGltf && !pGltf->IsCreationComplete();
 }
 
 /**
@@ -1856,18 +1827,43 @@ void removeVisibleTilesFromList(
  *
  * The visual representations (i.e. the `getRendererResources` of the
  * tiles) are assumed to be `UCesiumGltfComponent` instances that
- * are made invisible by this call.
+ * are made invisible by this call. Tiles that were shown in the
+ * given render generation are left untouched. The collision of tiles that
+ * still have it, because they were never reported as fading out, is removed,
+ * too.
  *
  * @param tiles The tiles to hide
+ * @param generation The current render generation
+ * @param visibleGltfs The visible components, from which hidden ones are
+ * removed
+ * @return The number of tiles that were hidden
  */
-void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+uint32 hideTiles(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles,
+    uint64 generation,
+    CesiumVisibleGltfs& visibleGltfs) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::HideTiles)
+  uint32 touched = 0;
   forEachRenderableTile(
       tiles,
-      [](Cesium3DTilesSelection::Tile* /*pTile*/, UCesiumGltfComponent* pGltf) {
+      [generation, &visibleGltfs, &touched](
+          Cesium3DTilesSelection::Tile* /*pTile*/,
+          UCesiumGltfComponent* pGltf) {
+        if (pGltf->LastShownGeneration == generation) {
+          // Rendered again this frame.
+          return;
+        }
+
         if (pGltf->IsVisible()) {
+          ++touched;
           TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityFalse)
           pGltf->SetVisibility(false, true);
+          visibleGltfs.remove(pGltf);
+          if (pGltf->LastShownGeneration != 0) {
+            TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
+            pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+            pGltf->LastShownGeneration = 0;
+          }
         } else {
           // TODO: why is this happening?
           UE_LOG(
@@ -1876,21 +1872,35 @@ void hideTiles(const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
               TEXT("Tile to no longer render does not have a visible Gltf"));
         }
       });
+  return touched;
 }
 
 /**
  * @brief Removes collision for tiles that have been removed from the render
  * list. This includes tiles that are fading out.
+ *
+ * Tiles whose collision was already removed in an earlier frame are skipped.
+ *
+ * @return The number of tiles whose collision was removed
  */
-void removeCollisionForTiles(
-    const std::unordered_set<Cesium3DTilesSelection::Tile*>& tiles) {
+uint32 removeCollisionForTiles(const auto& tiles) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::RemoveCollisionForTiles)
+  uint32 touched = 0;
   forEachRenderableTile(
       tiles,
-      [](Cesium3DTilesSelection::Tile* /*pTile*/, UCesiumGltfComponent* pGltf) {
+      [&touched](
+          Cesium3DTilesSelection::Tile* /*pTile*/,
+          UCesiumGltfComponent* pGltf) {
+        if (pGltf->LastShownGeneration == 0) {
+          return;
+        }
+
         TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionDisabled)
         pGltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        pGltf->LastShownGeneration = 0;
+        ++touched;
       });
+  return touched;
 }
 
 /**
@@ -1934,11 +1944,28 @@ void ACesium3DTileset::updateTilesetOptionsFromProperties() {
       this->_pTileset->getOptions();
   options.maximumScreenSpaceError =
       static_cast<double>(this->MaximumScreenSpaceError);
-  options.maximumCachedBytes = this->MaximumCachedBytes;
   options.preloadAncestors = this->PreloadAncestors;
   options.preloadSiblings = this->PreloadSiblings;
   options.forbidHoles = this->ForbidHoles;
-  options.maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
+
+  if (this->PrimitivePool) {
+    this->PrimitivePool->SetMaximumSize(this->PrimitivePoolSize);
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  UCesiumTileBudgetSubsystem* pTileBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (pTileBudget && pTileBudget->IsEnabled()) {
+    UCesiumTileBudgetSubsystem::TilesetAllocation allocation =
+        pTileBudget->GetAllocation(this);
+    options.maximumCachedBytes = allocation.maximumCachedBytes;
+    options.maximumSimultaneousTileLoads =
+        allocation.maximumSimultaneousTileLoads;
+  } else {
+    options.maximumCachedBytes = this->MaximumCachedBytes;
+    options.maximumSimultaneousTileLoads = this->MaximumSimultaneousTileLoads;
+  }
+
   options.loadingDescendantLimit = this->LoadingDescendantLimit;
   options.enableFrustumCulling = this->EnableFrustumCulling;
   options.enableOcclusionCulling =
@@ -1955,6 +1982,51 @@ void ACesium3DTileset::updateTilesetOptionsFromProperties() {
   options.enableLodTransitionPeriod = this->UseLodTransitions;
   options.lodTransitionLength = this->LodTransitionLength;
   // options.kickDescendantsWhileFadingIn = false;
+
+  if (CesiumTileLoadingBudget::isEnabled()) {
+    CesiumTileLoadingBudget& budget = *this->_pTileLoadingBudget;
+    budget.beginFrame(
+        GFrameCounter,
+        CesiumTileLoadingBudget::getGameThreadFrameTime());
+    options.mainThreadLoadingTimeLimit = budget.getRemainingMilliseconds(
+        CesiumTileLoadingBudget::Direction::Load);
+    options.tileCacheUnloadTimeLimit = budget.getRemainingMilliseconds(
+        CesiumTileLoadingBudget::Direction::Unload);
+  } else {
+    options.mainThreadLoadingTimeLimit = 5.0;
+    options.tileCacheUnloadTimeLimit = 5.0;
+  }
+}
+
+void ACesium3DTileset::reportTileBudgetUsage(
+    const Cesium3DTilesSelection::ViewUpdateResult& result) {
+  UWorld* pWorld = this->GetWorld();
+  UCesiumTileBudgetSubsystem* pTileBudget =
+      pWorld ? pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>() : nullptr;
+  if (!pTileBudget || !pTileBudget->IsEnabled()) {
+    return;
+  }
+
+  UCesiumTileBudgetSubsystem::TilesetUsage usage;
+  usage.priority = this->TileBudgetPriority;
+  usage.totalBytes = this->_pTileset->getTotalDataBytes();
+  usage.tilesWaitingToLoad = result.workerThreadTileLoadQueueLength +
+                             result.mainThreadTileLoadQueueLength;
+
+  for (const Cesium3DTilesSelection::Tile* pTile :
+       result.tilesToRenderThisFrame) {
+    const Cesium3DTilesSelection::TileRenderContent* pRenderContent =
+        pTile->getContent().getRenderContent();
+    const UCesiumGltfComponent* pGltf =
+        pRenderContent ? static_cast<const UCesiumGltfComponent*>(
+                             pRenderContent->getRenderResources())
+                       : nullptr;
+    if (pGltf) {
+      usage.renderedBytes += pGltf->DataBytes;
+    }
+  }
+
+  pTileBudget->ReportUsage(this, usage);
 }
 
 void ACesium3DTileset::updateLastViewUpdateResultState(
@@ -2028,7 +2100,7 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
           LogCesium,
           Display,
           TEXT(
-              "%s: %d ms, Visited %d, Culled Visited %d, Rendered %d, Culled %d, Occluded %d, Waiting For Occlusion Results %d, Max Depth Visited: %d, Loading-Worker %d, Loading-Main %d, Loaded tiles %g%%"),
+              "%s: %d ms, Visited %d, Culled Visited %d, Rendered %d, Culled %d, Occluded %d, Waiting For Occlusion Results %d, Max Depth Visited: %d, Loading-Worker %d, Loading-Main %d, Loaded tiles %g%%, Vertex inflation %.2fx, Compact vertex savings %.1f MB"),
           *this->GetName(),
           (std::chrono::high_resolution_clock::now() - this->_startTime)
                   .count() /
@@ -2042,7 +2114,9 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
           result.maxDepthVisited,
           result.workerThreadTileLoadQueueLength,
           result.mainThreadTileLoadQueueLength,
-          this->LoadProgress);
+          this->LoadProgress,
+          this->GetVertexInflationFactor(),
+          double(this->_compactVertexBytesSaved) / (1024.0 * 1024.0));
     }
 
     if (this->LogSharedAssetStats && this->_pTileset) {
@@ -2060,15 +2134,39 @@ void ACesium3DTileset::updateLastViewUpdateResultState(
   }
 }
 
-void ACesium3DTileset::showTilesToRender(
+uint32 ACesium3DTileset::showTilesToRender(
     const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesToRender)
+  uint32 touched = 0;
   forEachRenderableTile(
       tiles,
       [&RootComponent = this->RootComponent,
-       &BodyInstance = this->BodyInstance](
+       &BodyInstance = this->BodyInstance,
+       &CesiumToUnreal = this->GetCesiumTilesetToUnrealRelativeWorldTransform(),
+       generation = this->_renderGeneration,
+       transformEpoch = this->_transformEpoch,
+       &visibleGltfs = *this->_pVisibleGltfs,
+       &touched](
           Cesium3DTilesSelection::Tile* pTile,
           UCesiumGltfComponent* pGltf) {
+        if (pGltf->LastShownGeneration + 1 == generation &&
+            pGltf->TransformEpoch == transformEpoch) {
+          // Already shown, with collision, in the previous frame and nothing
+          // has invalidated it since.
+          pGltf->LastShownGeneration = generation;
+          return;
+        }
+
+        pGltf->LastShownGeneration = generation;
+        ++touched;
+
+        if (pGltf->TransformEpoch != transformEpoch) {
+          // The transform changed while this tile was hidden.
+          TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateDeferredTransform)
+          pGltf->UpdateTransformFromCesium(CesiumToUnreal);
+          pGltf->TransformEpoch = transformEpoch;
+        }
+
         applyActorCollisionSettings(BodyInstance, pGltf);
 
         if (pGltf->GetAttachParent() == nullptr) {
@@ -2094,25 +2192,79 @@ void ACesium3DTileset::showTilesToRender(
           TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetVisibilityTrue)
           pGltf->SetVisibility(true, true);
         }
+        visibleGltfs.add(pGltf);
 
         {
           TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetCollisionEnabled)
           pGltf->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
         }
       });
+  return touched;
+}
+
+void ACesium3DTileset::updateOnDemandPhysicsMeshes(
+    const std::vector<Cesium3DTilesSelection::Tile*>& tiles) {
+  TArray<FVector> locations;
+  for (const AActor* pActor : this->CollisionInterestActors) {
+    if (IsValid(pActor)) {
+      locations.Add(pActor->GetActorLocation());
+    }
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  if (this->PlayerPawnsAreCollisionInterestActors && pWorld) {
+    for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+         playerControllerIt;
+         ++playerControllerIt) {
+      const APlayerController* pPlayerController = playerControllerIt->Get();
+      const APawn* pPawn =
+          pPlayerController ? pPlayerController->GetPawn() : nullptr;
+      if (pPawn) {
+        locations.Add(pPawn->GetActorLocation());
+      }
+    }
+  }
+
+  TArray<UCesiumGltfPrimitiveComponent*> primitives;
+  auto addPrimitives = [&primitives](
+                           Cesium3DTilesSelection::Tile* /*pTile*/,
+                           UCesiumGltfComponent* pGltf) {
+    for (USceneComponent* pChild : pGltf->GetAttachChildren()) {
+      UCesiumGltfPrimitiveComponent* pPrimitive =
+          Cast<UCesiumGltfPrimitiveComponent>(pChild);
+      if (pPrimitive && pPrimitive->getCollisionMeshSource()) {
+        primitives.Add(pPrimitive);
+      }
+    }
+  };
+  forEachRenderableTile(tiles, addPrimitives);
+  // These tiles remain visible until the next frame, so they keep their
+  // physics meshes until then, too.
+  forEachRenderableTile(
+      this->_pTilesToHideNextFrame->getTiles(),
+      addPrimitives);
+
+  this->_pOnDemandPhysicsMeshes->update(
+      locations,
+      this->PhysicsMeshCookingRadius,
+      primitives);
 }
 
-static void updateTileFades(const auto& tiles, bool fadingIn) {
+static uint32 updateTileFades(const auto& tiles, bool fadingIn) {
+  uint32 touched = 0;
   forEachRenderableTile(
       tiles,
-      [fadingIn](
+      [fadingIn, &touched](
           Cesium3DTilesSelection::Tile* pTile,
           UCesiumGltfComponent* pGltf) {
         float percentage = pTile->getContent()
                                .getRenderContent()
                                ->getLodTransitionFadePercentage();
-        pGltf->UpdateFade(percentage, fadingIn);
+        if (pGltf->UpdateFade(percentage, fadingIn)) {
+          ++touched;
+        }
       });
+  return touched;
 }
 
 // Called every frame
@@ -2163,8 +2315,10 @@ void ACesium3DTileset::Tick(float DeltaTime) {
 
   updateTilesetOptionsFromProperties();
 
-  std::vector<FCesiumCamera> cameras = this->GetCameras();
-  if (cameras.empty()) {
+  UWorld* pWorld = this->GetWorld();
+  UCesiumCameraSubsystem* pCameraSubsystem =
+      pWorld ? pWorld->GetSubsystem<UCesiumCameraSubsystem>() : nullptr;
+  if (!pCameraSubsystem) {
     return;
   }
 
@@ -2185,55 +2339,175 @@ void ACesium3DTileset::Tick(float DeltaTime) {
 
   UCesiumEllipsoid* ellipsoid = this->ResolveGeoreference()->GetEllipsoid();
 
-  std::vector<Cesium3DTilesSelection::ViewState> frustums;
-  for (const FCesiumCamera& camera : cameras) {
-    frustums.push_back(CreateViewStateFromViewParameters(
-        camera,
-        unrealWorldToCesiumTileset,
-        ellipsoid));
+  const std::vector<Cesium3DTilesSelection::ViewState>& viewStates =
+      pCameraSubsystem->GetViewStates(
+          unrealWorldToCesiumTileset,
+          ellipsoid,
+          this->_scaleUsingDPI,
+          this->ResolvedCameraManager);
+  if (viewStates.empty()) {
+    return;
   }
 
   const Cesium3DTilesSelection::ViewUpdateResult* pResult;
   if (this->_captureMovieMode) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateViewOffline)
-    pResult = &this->_pTileset->updateViewOffline(frustums);
+    pResult = &this->_pTileset->updateViewOffline(viewStates);
   } else {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::updateView)
-    pResult = &this->_pTileset->updateView(frustums, DeltaTime);
+    pResult = &this->_pTileset->updateView(viewStates, DeltaTime);
   }
   updateLastViewUpdateResultState(*pResult);
+  reportTileBudgetUsage(*pResult);
+
+  continueTileCreation(this->_gltfsBeingCreated, *this->_pTileLoadingBudget);
+
+  ++this->_renderGeneration;
+
+  uint32 tilesTouched = removeCollisionForTiles(pResult->tilesFadingOut);
+
+  const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender =
+      pResult->tilesToRenderThisFrame;
 
-  removeCollisionForTiles(pResult->tilesFadingOut);
+  // Show first so that tiles which are both scheduled to be hidden and
+  // rendered again this frame are recognized by their render generation and
+  // left visible.
+  tilesTouched += showTilesToRender(tilesToRender);
 
-  removeVisibleTilesFromList(
-      _tilesToHideNextFrame,
-      pResult->tilesToRenderThisFrame);
-  hideTiles(_tilesToHideNextFrame);
+  // While some of the tiles to render can't be shown yet, keep the tiles they
+  // replace visible to avoid leaving holes in the tileset.
+  CesiumTilesToHide& tilesToHide = *this->_pTilesToHideNextFrame;
+  tilesToHide.update(tilesToRender, isTileBeingCreated);
+  tilesTouched += hideTiles(
+      tilesToHide.takeTilesToHide(),
+      this->_renderGeneration,
+      *this->_pVisibleGltfs);
 
-  _tilesToHideNextFrame.clear();
+  std::vector<Cesium3DTilesSelection::Tile*> tilesFadingOut;
+  tilesFadingOut.reserve(pResult->tilesFadingOut.size());
   for (Cesium3DTilesSelection::Tile* pTile : pResult->tilesFadingOut) {
+    if (!tilesToHide.isKeptVisible(*pTile)) {
+      tilesFadingOut.push_back(pTile);
+    }
+
     Cesium3DTilesSelection::TileRenderContent* pRenderContent =
         pTile->getContent().getRenderContent();
     if (!this->UseLodTransitions ||
         (pRenderContent &&
          pRenderContent->getLodTransitionFadePercentage() >= 1.0f)) {
-      _tilesToHideNextFrame.push_back(pTile);
+      tilesToHide.add(pTile);
     }
   }
 
-  showTilesToRender(pResult->tilesToRenderThisFrame);
+  if (this->CreatePhysicsMeshes && this->CookPhysicsMeshesOnDemand) {
+    this->updateOnDemandPhysicsMeshes(tilesToRender);
+  }
 
   if (this->UseLodTransitions) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileFades)
-    updateTileFades(pResult->tilesToRenderThisFrame, true);
-    updateTileFades(pResult->tilesFadingOut, false);
+    tilesTouched += updateTileFades(tilesToRender, true);
+    tilesTouched += updateTileFades(tilesFadingOut, false);
   }
 
+  INC_DWORD_STAT_BY(STAT_CesiumTilesRendered, tilesToRender.size());
+  INC_DWORD_STAT_BY(STAT_CesiumTilesTouched, tilesTouched);
+
   this->UpdateLoadStatus();
+
+  // This replaces the view update result, so it must come last.
+  if (this->EnablePredictiveLoading && !this->UseLodTransitions &&
+      !this->_captureMovieMode) {
+    this->loadPredictedViews(viewStates, ellipsoid, DeltaTime, tilesToRender);
+  } else {
+    this->_pViewStatePredictor->reset();
+    this->_predictedTileLoadQueueLength = 0;
+  }
+}
+
+void ACesium3DTileset::loadPredictedViews(
+    const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+    UCesiumEllipsoid* pEllipsoid,
+    float DeltaTime,
+    const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPredictedViews)
+
+  this->_pViewStatePredictor->update(viewStates, DeltaTime);
+
+  INC_DWORD_STAT_BY(
+      STAT_CesiumPredictedTilesWaitingToLoad,
+      this->_predictedTileLoadQueueLength);
+
+  // Each tile that the predicted views are waiting for takes up a share of the
+  // budget, and the predictions furthest ahead are dropped first as the budget
+  // runs out.
+  const int64 remainingLoads = int64(this->MaximumPredictiveTileLoads) -
+                               this->_predictedTileLoadQueueLength;
+  if (remainingLoads <= 0 || this->PredictiveLoadingSteps <= 0) {
+    return;
+  }
+
+  const int32 steps = int32(FMath::DivideAndRoundUp(
+      int64(this->PredictiveLoadingSteps) * remainingLoads,
+      int64(this->MaximumPredictiveTileLoads)));
+  const double lookaheadTime = double(this->PredictiveLoadingLookaheadTime) *
+                               double(steps) /
+                               double(this->PredictiveLoadingSteps);
+
+  std::vector<Cesium3DTilesSelection::ViewState> predictedViewStates;
+  this->_pViewStatePredictor->predict(
+      viewStates,
+      lookaheadTime,
+      steps,
+      pEllipsoid->GetNativeEllipsoid(),
+      predictedViewStates);
+  INC_DWORD_STAT_BY(STAT_CesiumPredictedViews, predictedViewStates.size());
+  if (predictedViewStates.empty()) {
+    return;
+  }
+
+  // The next view update compares its selection against this one, rather than
+  // against the tiles rendered now, so it misses some of the tiles that stop
+  // being rendered. Hide all of them next frame, unless they are rendered
+  // again.
+  for (Cesium3DTilesSelection::Tile* pTile : tilesToRender) {
+    this->_pTilesToHideNextFrame->add(pTile);
+  }
+
+  // The tiles selected for the predicted views are never rendered, so they
+  // don't affect the level of detail of the current views. Because the
+  // current views were updated first, their tiles are already being loaded,
+  // and only the remaining load slots are left for the predicted views. This
+  // update mustn't unload tiles, which would include those rendered now, and
+  // it finishes loading at least one tile, but otherwise only takes the time
+  // left in the tile loading budget.
+  Cesium3DTilesSelection::TilesetOptions& options =
+      this->_pTileset->getOptions();
+  const int64_t maximumCachedBytes = options.maximumCachedBytes;
+  const double mainThreadLoadingTimeLimit = options.mainThreadLoadingTimeLimit;
+  options.maximumCachedBytes = std::numeric_limits<int64_t>::max();
+  options.mainThreadLoadingTimeLimit =
+      CesiumTileLoadingBudget::isEnabled()
+          ? this->_pTileLoadingBudget->getRemainingMilliseconds(
+                CesiumTileLoadingBudget::Direction::Load)
+          : minimumPredictedViewLoadingTime;
+
+  const Cesium3DTilesSelection::ViewUpdateResult& result =
+      this->_pTileset->updateView(predictedViewStates, 0.0f);
+  this->_predictedTileLoadQueueLength =
+      result.workerThreadTileLoadQueueLength +
+      result.mainThreadTileLoadQueueLength;
+
+  options.maximumCachedBytes = maximumCachedBytes;
+  options.mainThreadLoadingTimeLimit = mainThreadLoadingTimeLimit;
 }
 
 void ACesium3DTileset::EndPlay(const EEndPlayReason::Type EndPlayReason) {
-  this->DestroyTileset();
+  // Destroy pooled objects, and don't pool the tiles that are about to be
+  // freed.
+  if (this->PrimitivePool) {
+    this->PrimitivePool->SetMaximumSize(0);
+  }
+  this->DestroyTileset(false);
   AActor::EndPlay(EndPlayReason);
 }
 
@@ -2299,15 +2573,37 @@ void ACesium3DTileset::PostEditChangeProperty(
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IonAccessToken) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreatePhysicsMeshes) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      CookPhysicsMeshesOnDemand) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, SimplifyPhysicsMeshes) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PhysicsMeshMaximumError) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CreateNavCollision) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, CanEverAffectNavigation) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, AlwaysIncludeTangents) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TangentGeneration) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, GenerateSmoothNormals) ||
+      PropName == GET_MEMBER_NAME_CHECKED(
+                      ACesium3DTileset,
+                      GenerateIndexedFlatNormals) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, FlatNormalCreaseAngle) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, VertexFormat) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, EnableWaterMask) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, IgnoreKhrMaterialsUnlit) ||
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, MergePrimitives) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, UseTilesetSceneProxy) ||
+      PropName ==
+          GET_MEMBER_NAME_CHECKED(ACesium3DTileset, QuantizePositions) ||
       PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, Material) ||
       PropName ==
           GET_MEMBER_NAME_CHECKED(ACesium3DTileset, TranslucentMaterial) ||
@@ -2369,6 +2665,11 @@ void ACesium3DTileset::PostEditChangeChainProperty(
   if (PropName ==
       GET_MEMBER_NAME_CHECKED(ACesium3DTileset, PointCloudShading)) {
     FCesiumGltfPointsSceneProxyUpdater::UpdateSettingsInProxies(this);
+  } else if (
+      PropName == GET_MEMBER_NAME_CHECKED(ACesium3DTileset, BodyInstance)) {
+    // Skip a generation so that the new collision settings are applied to
+    // every rendered tile on the next frame.
+    ++this->_renderGeneration;
   }
 }
 
@@ -2409,6 +2710,11 @@ bool ACesium3DTileset::IsReadyForFinishDestroy() {
 }
 
 void ACesium3DTileset::Destroyed() {
+  // Destroy pooled objects, and don't pool the tiles that are about to be
+  // freed.
+  if (this->PrimitivePool) {
+    this->PrimitivePool->SetMaximumSize(0);
+  }
   this->DestroyTileset();
 
   AActor::Destroyed();
@@ -90,12 +90,16 @@ void ACesiumCameraManager::Tick(float DeltaTime) { Super::Tick(DeltaTime); }
 int32 ACesiumCameraManager::AddCamera(UPARAM(ref) const FCesiumCamera& camera) {
   int32 cameraId = this->_currentCameraId++;
   this->_cameras.Emplace(cameraId, camera);
+  ++this->_revision;
   return cameraId;
 }
 
 bool ACesiumCameraManager::RemoveCamera(int32 cameraId) {
   int32 numRemovedPairs = this->_cameras.Remove(cameraId);
   bool success = numRemovedPairs > 0;
+  if (success) {
+    ++this->_revision;
+  }
   return success;
 }
 
@@ -105,6 +109,7 @@ bool ACesiumCameraManager::UpdateCamera(
   FCesiumCamera* pCurrentCamera = this->_cameras.Find(cameraId);
   if (pCurrentCamera) {
     *pCurrentCamera = camera;
+    ++this->_revision;
     return true;
   }
 
@@ -0,0 +1,130 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPath.h"
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumRuntime.h"
+#include "Misc/FileHelper.h"
+#include <cmath>
+#include <glm/geometric.hpp>
+
+namespace {
+const TCHAR* csvHeader =
+    TEXT("frame,time,positionX,positionY,positionZ,directionX,directionY,"
+         "directionZ,upX,upY,upZ,fieldOfView,viewportWidth,viewportHeight");
+
+constexpr int32 csvColumns = 14;
+} // namespace
+
+/*static*/ std::optional<CesiumCameraPath>
+CesiumCameraPath::loadFromCsv(const FString& filename) {
+  TArray<FString> lines;
+  if (!FFileHelper::LoadFileToStringArray(lines, *filename)) {
+    UE_LOG(LogCesium, Error, TEXT("Could not read camera path %s"), *filename);
+    return std::nullopt;
+  }
+
+  CesiumCameraPath path;
+  int64 lastFrameNumber = -1;
+
+  // The first line is the header.
+  for (int32 i = 1; i < lines.Num(); ++i) {
+    const FString& line = lines[i];
+    if (line.TrimStartAndEnd().IsEmpty()) {
+      continue;
+    }
+
+    TArray<FString> values;
+    line.ParseIntoArray(values, TEXT(","), false);
+    if (values.Num() != csvColumns) {
+      UE_LOG(
+          LogCesium,
+          Error,
+          TEXT("Line %d of camera path %s has %d values instead of %d"),
+          i + 1,
+          *filename,
+          values.Num(),
+          csvColumns);
+      return std::nullopt;
+    }
+
+    double numbers[csvColumns];
+    for (int32 column = 0; column < csvColumns; ++column) {
+      numbers[column] = FCString::Atod(*values[column].TrimStartAndEnd());
+    }
+
+    int64 frameNumber = int64(numbers[0]);
+    if (frameNumber != lastFrameNumber || path.frames.empty()) {
+      CesiumCameraPath::Frame& frame = path.frames.emplace_back();
+      frame.time = numbers[1];
+      lastFrameNumber = frameNumber;
+    }
+
+    CesiumCameraPath::Camera& camera =
+        path.frames.back().cameras.emplace_back();
+    camera.position = glm::dvec3(numbers[2], numbers[3], numbers[4]);
+    camera.direction = glm::dvec3(numbers[5], numbers[6], numbers[7]);
+    camera.up = glm::dvec3(numbers[8], numbers[9], numbers[10]);
+    camera.fieldOfViewDegrees = numbers[11];
+    camera.viewportSize = glm::dvec2(numbers[12], numbers[13]);
+  }
+
+  return path;
+}
+
+bool CesiumCameraPath::saveToCsv(const FString& filename) const {
+  FString csv(csvHeader);
+  csv += TEXT("\n");
+
+  for (size_t i = 0; i < this->frames.size(); ++i) {
+    appendCsvLines(csv, uint64(i), this->frames[i]);
+  }
+
+  return FFileHelper::SaveStringToFile(csv, *filename);
+}
+
+/*static*/ const TCHAR* CesiumCameraPath::getCsvHeader() { return csvHeader; }
+
+/*static*/ void CesiumCameraPath::appendCsvLines(
+    FString& csv,
+    uint64 frameNumber,
+    const Frame& frame) {
+  for (const Camera& camera : frame.cameras) {
+    csv += FString::Printf(
+        TEXT("%llu,%.6f,%.6f,%.6f,%.6f,%.9f,%.9f,%.9f,%.9f,%.9f,%.9f,%.6f,"
+             "%.2f,%.2f\n"),
+        frameNumber,
+        frame.time,
+        camera.position.x,
+        camera.position.y,
+        camera.position.z,
+        camera.direction.x,
+        camera.direction.y,
+        camera.direction.z,
+        camera.up.x,
+        camera.up.y,
+        camera.up.z,
+        camera.fieldOfViewDegrees,
+        camera.viewportSize.x,
+        camera.viewportSize.y);
+  }
+}
+
+/*static*/ Cesium3DTilesSelection::ViewState CesiumCameraPath::createViewState(
+    const Camera& camera,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  double horizontalFieldOfView =
+      FMath::DegreesToRadians(camera.fieldOfViewDegrees);
+  double aspectRatio = camera.viewportSize.x / camera.viewportSize.y;
+  double verticalFieldOfView =
+      std::atan(std::tan(horizontalFieldOfView * 0.5) / aspectRatio) * 2.0;
+
+  return Cesium3DTilesSelection::ViewState::create(
+      camera.position,
+      glm::normalize(camera.direction),
+      glm::normalize(camera.up),
+      camera.viewportSize,
+      horizontalFieldOfView,
+      verticalFieldOfView,
+      ellipsoid);
+}
@@ -0,0 +1,82 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <optional>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class ViewState;
+}
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+/**
+ * A sequence of frames, each seen by one or more cameras, used to replay a
+ * camera flight for tile loading and selection tests.
+ *
+ * Cameras are expressed in Earth-Centered, Earth-Fixed coordinates, so that a
+ * path can be replayed independently of the georeference and origin of the
+ * world it was captured in.
+ *
+ * In CSV form, the first line is a header and each following line describes
+ * one camera in one frame:
+ *
+ * `frame,time,positionX,positionY,positionZ,directionX,directionY,directionZ,
+ * upX,upY,upZ,fieldOfView,viewportWidth,viewportHeight`
+ *
+ * Consecutive lines with the same frame number belong to the same frame. The
+ * time is in seconds since the start of the path, the position in meters,
+ * and the field of view is horizontal, in degrees.
+ */
+struct CesiumCameraPath {
+  struct Camera {
+    glm::dvec3 position{0.0};
+    glm::dvec3 direction{1.0, 0.0, 0.0};
+    glm::dvec3 up{0.0, 0.0, 1.0};
+    double fieldOfViewDegrees = 90.0;
+    glm::dvec2 viewportSize{1.0};
+  };
+
+  struct Frame {
+    double time = 0.0;
+    std::vector<Camera> cameras;
+  };
+
+  std::vector<Frame> frames;
+
+  /**
+   * Loads a path from a CSV file. Logs an error and returns an empty optional
+   * if the file can't be read or is malformed.
+   */
+  static std::optional<CesiumCameraPath> loadFromCsv(const FString& filename);
+
+  /**
+   * Saves the path to a CSV file, returning false if it can't be written.
+   */
+  bool saveToCsv(const FString& filename) const;
+
+  /**
+   * The header line of the CSV form, without a line terminator.
+   */
+  static const TCHAR* getCsvHeader();
+
+  /**
+   * Appends the CSV lines of one frame to the given string. This is used to
+   * write a path incrementally, one frame at a time, after the header.
+   */
+  static void
+  appendCsvLines(FString& csv, uint64 frameNumber, const Frame& frame);
+
+  /**
+   * Creates the view state used for tile selection from a camera.
+   */
+  static Cesium3DTilesSelection::ViewState createViewState(
+      const Camera& camera,
+      const CesiumGeospatial::Ellipsoid& ellipsoid);
+};
@@ -0,0 +1,187 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPathRecorderComponent.h"
+#include "CesiumCameraManager.h"
+#include "CesiumCameraPath.h"
+#include "CesiumCameraSubsystem.h"
+#include "CesiumGeoreference.h"
+#include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace {
+void writeUtf8(FArchive& archive, const FString& text) {
+  FTCHARToUTF8 utf8(*text);
+  archive.Serialize(const_cast<ANSICHAR*>(utf8.Get()), utf8.Length());
+}
+
+CesiumCameraPath::Camera
+toCameraPathCamera(const FCesiumCamera& camera, ACesiumGeoreference& georef) {
+  // As in tile selection, an overridden aspect ratio adds black bars to the
+  // viewport, which reduce the size that's actually rendered.
+  FVector2D size = camera.ViewportSize;
+  if (camera.OverrideAspectRatio != 0.0) {
+    double computedX = camera.OverrideAspectRatio * camera.ViewportSize.Y;
+    double computedY = camera.ViewportSize.Y / camera.OverrideAspectRatio;
+    double barWidth = camera.ViewportSize.X - computedX;
+    double barHeight = camera.ViewportSize.Y - computedY;
+    if (barWidth > 0.0 && barWidth > barHeight) {
+      size.X = computedX;
+    } else if (barHeight > 0.0 && barHeight > barWidth) {
+      size.Y = computedY;
+    }
+  }
+
+  FVector position =
+      georef.TransformUnrealPositionToEarthCenteredEarthFixed(camera.Location);
+  FVector direction = georef.TransformUnrealDirectionToEarthCenteredEarthFixed(
+      camera.Rotation.RotateVector(FVector::ForwardVector));
+  FVector up = georef.TransformUnrealDirectionToEarthCenteredEarthFixed(
+      camera.Rotation.RotateVector(FVector::UpVector));
+
+  CesiumCameraPath::Camera result;
+  result.position = glm::dvec3(position.X, position.Y, position.Z);
+  result.direction = glm::dvec3(direction.X, direction.Y, direction.Z);
+  result.up = glm::dvec3(up.X, up.Y, up.Z);
+  result.fieldOfViewDegrees = camera.FieldOfViewDegrees;
+  result.viewportSize = glm::dvec2(size.X, size.Y);
+  return result;
+}
+} // namespace
+
+UCesiumCameraPathRecorderComponent::UCesiumCameraPathRecorderComponent() {
+  this->PrimaryComponentTick.bCanEverTick = true;
+  // Record the cameras after they have moved for this frame.
+  this->PrimaryComponentTick.TickGroup = ETickingGroup::TG_PostUpdateWork;
+}
+
+bool UCesiumCameraPathRecorderComponent::StartRecording() {
+  this->StopRecording();
+
+  FString filename = this->GetAbsoluteFilename();
+  this->_pWriter.Reset(IFileManager::Get().CreateFileWriter(*filename));
+  if (!this->_pWriter) {
+    UE_LOG(
+        LogCesium,
+        Error,
+        TEXT("Could not open %s to record the camera path"),
+        *filename);
+    return false;
+  }
+
+  writeUtf8(
+      *this->_pWriter,
+      FString(CesiumCameraPath::getCsvHeader()) + TEXT("\n"));
+
+  UWorld* pWorld = this->GetWorld();
+  this->_frameNumber = 0;
+  this->_startTime = pWorld ? pWorld->GetTimeSeconds() : 0.0;
+
+  UE_LOG(LogCesium, Display, TEXT("Recording camera path to %s"), *filename);
+  return true;
+}
+
+void UCesiumCameraPathRecorderComponent::StopRecording() {
+  if (!this->_pWriter) {
+    return;
+  }
+
+  this->_pWriter->Close();
+  this->_pWriter.Reset();
+
+  UE_LOG(
+      LogCesium,
+      Display,
+      TEXT("Recorded %llu frames of camera path"),
+      this->_frameNumber);
+}
+
+bool UCesiumCameraPathRecorderComponent::IsRecording() const {
+  return this->_pWriter.IsValid();
+}
+
+FString UCesiumCameraPathRecorderComponent::GetAbsoluteFilename() const {
+  if (FPaths::IsRelative(this->Filename)) {
+    return FPaths::ConvertRelativePathToFull(FPaths::Combine(
+        FPaths::ProjectSavedDir(),
+        TEXT("CameraPaths"),
+        this->Filename));
+  }
+  return this->Filename;
+}
+
+void UCesiumCameraPathRecorderComponent::TickComponent(
+    float DeltaTime,
+    ELevelTick TickType,
+    FActorComponentTickFunction* ThisTickFunction) {
+  Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+  if (this->_pWriter) {
+    this->recordFrame();
+  }
+}
+
+void UCesiumCameraPathRecorderComponent::BeginPlay() {
+  Super::BeginPlay();
+
+  if (this->RecordOnBeginPlay) {
+    this->StartRecording();
+  }
+}
+
+void UCesiumCameraPathRecorderComponent::EndPlay(
+    const EEndPlayReason::Type EndPlayReason) {
+  this->StopRecording();
+  Super::EndPlay(EndPlayReason);
+}
+
+void UCesiumCameraPathRecorderComponent::recordFrame() {
+  UWorld* pWorld = this->GetWorld();
+  UCesiumCameraSubsystem* pCameraSubsystem =
+      pWorld ? pWorld->GetSubsystem<UCesiumCameraSubsystem>() : nullptr;
+  ACesiumGeoreference* pGeoreference =
+      IsValid(this->Georeference)
+          ? this->Georeference
+          : ACesiumGeoreference::GetDefaultGeoreferenceForActor(
+                this->GetOwner());
+  if (!pCameraSubsystem || !IsValid(pGeoreference)) {
+    return;
+  }
+
+  CesiumCameraPath::Frame frame;
+  frame.time = pWorld->GetTimeSeconds() - this->_startTime;
+
+  bool scaleUsingDPI =
+      GetDefault<UCesiumRuntimeSettings>()->ScaleLevelOfDetailByDPI;
+  const std::vector<FCesiumCamera> cameras =
+      this->RecordOnlyPlayerCameras
+          ? pCameraSubsystem->GetPlayerCameras(scaleUsingDPI)
+          : pCameraSubsystem->GetCameras(scaleUsingDPI);
+  for (const FCesiumCamera& camera : cameras) {
+    frame.cameras.push_back(toCameraPathCamera(camera, *pGeoreference));
+  }
+
+  // The cameras of the camera manager are placed explicitly for tile
+  // selection, so they're always recorded.
+  ACesiumCameraManager* pCameraManager =
+      IsValid(this->CameraManager)
+          ? this->CameraManager
+          : ACesiumCameraManager::GetDefaultCameraManager(this);
+  if (pCameraManager) {
+    for (const auto& cameraIt : pCameraManager->GetCameras()) {
+      frame.cameras.push_back(
+          toCameraPathCamera(cameraIt.Value, *pGeoreference));
+    }
+  }
+
+  if (frame.cameras.empty()) {
+    return;
+  }
+
+  FString lines;
+  CesiumCameraPath::appendCsvLines(lines, this->_frameNumber, frame);
+  writeUtf8(*this->_pWriter, lines);
+  ++this->_frameNumber;
+}
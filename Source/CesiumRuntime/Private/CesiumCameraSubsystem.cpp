@@ -0,0 +1,587 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "CesiumCameraManager.h"
+#include "CesiumEllipsoid.h"
+#include "CesiumRuntime.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "StereoRendering.h"
+#include <glm/trigonometric.hpp>
+
+#if WITH_EDITOR
+#include "Editor.h"
+#include "EditorViewportClient.h"
+#endif
+
+void UCesiumCameraSubsystem::Initialize(FSubsystemCollectionBase& Collection) {
+  Super::Initialize(Collection);
+
+  UWorld* pWorld = this->GetWorld();
+  if (pWorld) {
+    this->_actorSpawnedHandle = pWorld->AddOnActorSpawnedHandler(
+        FOnActorSpawned::FDelegate::CreateUObject(
+            this,
+            &UCesiumCameraSubsystem::onActorSpawned));
+  }
+
+  this->_levelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(
+      this,
+      &UCesiumCameraSubsystem::onLevelAdded);
+  this->_levelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(
+      this,
+      &UCesiumCameraSubsystem::onLevelRemoved);
+}
+
+void UCesiumCameraSubsystem::Deinitialize() {
+  UWorld* pWorld = this->GetWorld();
+  if (pWorld) {
+    pWorld->RemoveOnActorSpawnedHandler(this->_actorSpawnedHandle);
+  }
+
+  FWorldDelegates::LevelAddedToWorld.Remove(this->_levelAddedHandle);
+  FWorldDelegates::LevelRemovedFromWorld.Remove(this->_levelRemovedHandle);
+
+  this->_sceneCaptures.Empty();
+  this->_cameras.clear();
+  this->_viewStates.clear();
+
+  Super::Deinitialize();
+}
+
+bool UCesiumCameraSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::Editor ||
+         WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview ||
+         WorldType == EWorldType::EditorPreview;
+}
+
+void UCesiumCameraSubsystem::RegisterSceneCapture(
+    USceneCaptureComponent2D* SceneCapture) {
+  if (!IsValid(SceneCapture)) {
+    return;
+  }
+
+  this->_sceneCaptures.AddUnique(SceneCapture);
+  this->invalidate();
+
+  AActor* pOwner = SceneCapture->GetOwner();
+  if (pOwner) {
+    pOwner->OnDestroyed.AddUniqueDynamic(
+        this,
+        &UCesiumCameraSubsystem::OnSceneCaptureActorDestroyed);
+  }
+}
+
+void UCesiumCameraSubsystem::UnregisterSceneCapture(
+    USceneCaptureComponent2D* SceneCapture) {
+  this->_sceneCaptures.Remove(SceneCapture);
+  this->invalidate();
+}
+
+const std::vector<FCesiumCamera>&
+UCesiumCameraSubsystem::GetCameras(bool scaleUsingDPI) {
+  if (this->_sceneCapturesNeedInitialScan) {
+    // Scene captures that already exist when the world is created are not
+    // reported by any event, so find them once. From then on they are tracked
+    // as they are spawned, streamed in, and destroyed.
+    this->_sceneCapturesNeedInitialScan = false;
+    UWorld* pWorld = this->GetWorld();
+    if (pWorld) {
+      for (ULevel* pLevel : pWorld->GetLevels()) {
+        this->registerSceneCapturesInLevel(pLevel);
+      }
+    }
+  }
+
+  this->invalidateIfNewFrame();
+
+  for (const CachedCameras& cached : this->_cameras) {
+    if (cached.version == this->_version &&
+        cached.scaleUsingDPI == scaleUsingDPI) {
+      return cached.cameras;
+    }
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CollectCameras)
+
+  std::vector<FCesiumCamera>& cameras =
+      this->_cameras
+          .emplace_back(CachedCameras{this->_version, scaleUsingDPI, {}})
+          .cameras;
+  this->collectPlayerCameras(scaleUsingDPI, cameras);
+  this->collectSceneCaptures(cameras);
+#if WITH_EDITOR
+  this->collectEditorCameras(scaleUsingDPI, cameras);
+#endif
+
+  return cameras;
+}
+
+std::vector<FCesiumCamera>
+UCesiumCameraSubsystem::GetPlayerCameras(bool scaleUsingDPI) const {
+  std::vector<FCesiumCamera> cameras;
+  this->collectPlayerCameras(scaleUsingDPI, cameras);
+  return cameras;
+}
+
+const std::vector<Cesium3DTilesSelection::ViewState>&
+UCesiumCameraSubsystem::GetViewStates(
+    const glm::dmat4& unrealWorldToTileset,
+    UCesiumEllipsoid* pEllipsoid,
+    bool scaleUsingDPI,
+    const ACesiumCameraManager* pCameraManager) {
+  this->invalidateIfNewFrame();
+
+  const uint64 cameraManagerRevision =
+      pCameraManager ? pCameraManager->GetRevision() : 0;
+  for (const CachedViewStates& cached : this->_viewStates) {
+    if (cached.version == this->_version &&
+        cached.unrealWorldToTileset == unrealWorldToTileset &&
+        cached.pEllipsoid == pEllipsoid &&
+        cached.scaleUsingDPI == scaleUsingDPI &&
+        cached.pCameraManager == pCameraManager &&
+        cached.cameraManagerRevision == cameraManagerRevision) {
+      return cached.viewStates;
+    }
+  }
+
+  const std::vector<FCesiumCamera>& cameras = this->GetCameras(scaleUsingDPI);
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateViewStates)
+
+  CachedViewStates& cached = this->_viewStates.emplace_back(CachedViewStates{
+      this->_version,
+      unrealWorldToTileset,
+      pEllipsoid,
+      scaleUsingDPI,
+      pCameraManager,
+      cameraManagerRevision,
+      {}});
+
+  size_t extraCameras =
+      pCameraManager ? size_t(pCameraManager->GetCameras().Num()) : 0;
+  cached.viewStates.reserve(cameras.size() + extraCameras);
+  for (const FCesiumCamera& camera : cameras) {
+    cached.viewStates.push_back(CreateViewStateFromViewParameters(
+        camera,
+        unrealWorldToTileset,
+        pEllipsoid));
+  }
+
+  if (pCameraManager) {
+    for (const auto& cameraIt : pCameraManager->GetCameras()) {
+      cached.viewStates.push_back(CreateViewStateFromViewParameters(
+          cameraIt.Value,
+          unrealWorldToTileset,
+          pEllipsoid));
+    }
+  }
+
+  return cached.viewStates;
+}
+
+void UCesiumCameraSubsystem::invalidateIfNewFrame() {
+  if (this->_frame == GFrameCounter) {
+    return;
+  }
+
+  this->_frame = GFrameCounter;
+  this->_cameras.clear();
+  this->_viewStates.clear();
+}
+
+void UCesiumCameraSubsystem::invalidate() { ++this->_version; }
+
+void UCesiumCameraSubsystem::collectPlayerCameras(
+    bool scaleUsingDPI,
+    std::vector<FCesiumCamera>& cameras) const {
+  UWorld* pWorld = this->GetWorld();
+  if (!pWorld) {
+    return;
+  }
+
+  double worldToMeters = 100.0;
+  AWorldSettings* pWorldSettings = pWorld->GetWorldSettings();
+  if (pWorldSettings) {
+    worldToMeters = pWorldSettings->WorldToMeters;
+  }
+
+  TSharedPtr<IStereoRendering, ESPMode::ThreadSafe> pStereoRendering = nullptr;
+  if (GEngine) {
+    pStereoRendering = GEngine->StereoRenderingDevice;
+  }
+
+  bool useStereoRendering = false;
+  if (pStereoRendering && pStereoRendering->IsStereoEnabled()) {
+    useStereoRendering = true;
+  }
+
+  cameras.reserve(cameras.size() + pWorld->GetNumPlayerControllers());
+
+  for (auto playerControllerIt = pWorld->GetPlayerControllerIterator();
+       playerControllerIt;
+       playerControllerIt++) {
+
+    const TWeakObjectPtr<APlayerController> pPlayerController =
+        *playerControllerIt;
+    if (pPlayerController == nullptr) {
+      continue;
+    }
+
+    const APlayerCameraManager* pPlayerCameraManager =
+        pPlayerController->PlayerCameraManager;
+
+    if (!pPlayerCameraManager) {
+      continue;
+    }
+
+    double fov = pPlayerCameraManager->GetFOVAngle();
+
+    FVector location;
+    FRotator rotation;
+    pPlayerController->GetPlayerViewPoint(location, rotation);
+
+    int32 sizeX, sizeY;
+    pPlayerController->GetViewportSize(sizeX, sizeY);
+    if (sizeX < 1 || sizeY < 1) {
+      continue;
+    }
+
+    float dpiScalingFactor = 1.0f;
+    if (scaleUsingDPI) {
+      ULocalPlayer* LocPlayer = Cast<ULocalPlayer>(pPlayerController->Player);
+      if (LocPlayer && LocPlayer->ViewportClient) {
+        dpiScalingFactor = LocPlayer->ViewportClient->GetDPIScale();
+      }
+    }
+
+    if (useStereoRendering) {
+      const auto leftEye = EStereoscopicEye::eSSE_LEFT_EYE;
+      const auto rightEye = EStereoscopicEye::eSSE_RIGHT_EYE;
+
+      uint32 stereoLeftSizeX = static_cast<uint32>(sizeX);
+      uint32 stereoLeftSizeY = static_cast<uint32>(sizeY);
+      uint32 stereoRightSizeX = static_cast<uint32>(sizeX);
+      uint32 stereoRightSizeY = static_cast<uint32>(sizeY);
+      if (useStereoRendering) {
+        int32 _x;
+        int32 _y;
+
+        pStereoRendering
+            ->AdjustViewRect(leftEye, _x, _y, stereoLeftSizeX, stereoLeftSizeY);
+
+        pStereoRendering->AdjustViewRect(
+            rightEye,
+            _x,
+            _y,
+            stereoRightSizeX,
+            stereoRightSizeY);
+      }
+
+      FVector2D stereoLeftSize(stereoLeftSizeX, stereoLeftSizeY);
+      FVector2D stereoRightSize(stereoRightSizeX, stereoRightSizeY);
+
+      if (stereoLeftSize.X >= 1.0 && stereoLeftSize.Y >= 1.0) {
+        FVector leftEyeLocation = location;
+        FRotator leftEyeRotation = rotation;
+        pStereoRendering->CalculateStereoViewOffset(
+            leftEye,
+            leftEyeRotation,
+            worldToMeters,
+            leftEyeLocation);
+
+        FMatrix projection =
+            pStereoRendering->GetStereoProjectionMatrix(leftEye);
+
+        // TODO: consider assymetric frustums using 4 fovs
+        double one_over_tan_half_hfov = projection.M[0][0];
+
+        double hfov =
+            glm::degrees(2.0 * glm::atan(1.0 / one_over_tan_half_hfov));
+
+        cameras.emplace_back(
+            stereoLeftSize,
+            leftEyeLocation,
+            leftEyeRotation,
+            hfov);
+      }
+
+      if (stereoRightSize.X >= 1.0 && stereoRightSize.Y >= 1.0) {
+        FVector rightEyeLocation = location;
+        FRotator rightEyeRotation = rotation;
+        pStereoRendering->CalculateStereoViewOffset(
+            rightEye,
+            rightEyeRotation,
+            worldToMeters,
+            rightEyeLocation);
+
+        FMatrix projection =
+            pStereoRendering->GetStereoProjectionMatrix(rightEye);
+
+        double one_over_tan_half_hfov = projection.M[0][0];
+
+        double hfov =
+            glm::degrees(2.0f * glm::atan(1.0f / one_over_tan_half_hfov));
+
+        cameras.emplace_back(
+            stereoRightSize,
+            rightEyeLocation,
+            rightEyeRotation,
+            hfov);
+      }
+    } else {
+      cameras.emplace_back(
+          FVector2D(sizeX / dpiScalingFactor, sizeY / dpiScalingFactor),
+          location,
+          rotation,
+          fov);
+    }
+  }
+}
+
+void UCesiumCameraSubsystem::collectSceneCaptures(
+    std::vector<FCesiumCamera>& cameras) {
+  this->_sceneCaptures.RemoveAll(
+      [](const TWeakObjectPtr<USceneCaptureComponent2D>& pSceneCapture) {
+        return !pSceneCapture.IsValid();
+      });
+
+  cameras.reserve(cameras.size() + this->_sceneCaptures.Num());
+
+  for (const TWeakObjectPtr<USceneCaptureComponent2D>& pWeakSceneCapture :
+       this->_sceneCaptures) {
+    USceneCaptureComponent2D* pSceneCaptureComponent = pWeakSceneCapture.Get();
+    if (!pSceneCaptureComponent || !pSceneCaptureComponent->IsRegistered()) {
+      continue;
+    }
+
+    if (pSceneCaptureComponent->ProjectionType !=
+        ECameraProjectionMode::Type::Perspective) {
+      continue;
+    }
+
+    UTextureRenderTarget2D* pRenderTarget =
+        pSceneCaptureComponent->TextureTarget;
+    if (!pRenderTarget) {
+      continue;
+    }
+
+    FVector2D renderTargetSize(pRenderTarget->SizeX, pRenderTarget->SizeY);
+    if (renderTargetSize.X < 1.0 || renderTargetSize.Y < 1.0) {
+      continue;
+    }
+
+    FVector captureLocation = pSceneCaptureComponent->GetComponentLocation();
+    FRotator captureRotation = pSceneCaptureComponent->GetComponentRotation();
+    double captureFov = pSceneCaptureComponent->FOVAngle;
+
+    cameras.emplace_back(
+        renderTargetSize,
+        captureLocation,
+        captureRotation,
+        captureFov);
+  }
+}
+
+void UCesiumCameraSubsystem::registerSceneCapturesInLevel(ULevel* pLevel) {
+  if (!pLevel) {
+    return;
+  }
+
+  for (AActor* pActor : pLevel->Actors) {
+    ASceneCapture2D* pSceneCapture = Cast<ASceneCapture2D>(pActor);
+    if (IsValid(pSceneCapture)) {
+      this->RegisterSceneCapture(pSceneCapture->GetCaptureComponent2D());
+    }
+  }
+}
+
+void UCesiumCameraSubsystem::onActorSpawned(AActor* pActor) {
+  ASceneCapture2D* pSceneCapture = Cast<ASceneCapture2D>(pActor);
+  if (pSceneCapture) {
+    this->RegisterSceneCapture(pSceneCapture->GetCaptureComponent2D());
+  }
+}
+
+void UCesiumCameraSubsystem::onLevelAdded(ULevel* pLevel, UWorld* pWorld) {
+  // Levels that were already present before the first scan are covered by
+  // that scan.
+  if (pWorld != this->GetWorld() || this->_sceneCapturesNeedInitialScan) {
+    return;
+  }
+
+  this->registerSceneCapturesInLevel(pLevel);
+}
+
+void UCesiumCameraSubsystem::onLevelRemoved(ULevel* pLevel, UWorld* pWorld) {
+  if (pWorld != this->GetWorld()) {
+    return;
+  }
+
+  this->invalidate();
+
+  if (!pLevel) {
+    // A null level means all levels are being removed.
+    this->_sceneCaptures.Empty();
+    this->_sceneCapturesNeedInitialScan = true;
+    return;
+  }
+
+  this->_sceneCaptures.RemoveAll(
+      [pLevel](const TWeakObjectPtr<USceneCaptureComponent2D>& pSceneCapture) {
+        return !pSceneCapture.IsValid() ||
+               pSceneCapture->GetComponentLevel() == pLevel;
+      });
+}
+
+void UCesiumCameraSubsystem::OnSceneCaptureActorDestroyed(
+    AActor* DestroyedActor) {
+  this->_sceneCaptures.RemoveAll(
+      [DestroyedActor](
+          const TWeakObjectPtr<USceneCaptureComponent2D>& pSceneCapture) {
+        return !pSceneCapture.IsValid() ||
+               pSceneCapture->GetOwner() == DestroyedActor;
+      });
+  this->invalidate();
+}
+
+/*static*/ Cesium3DTilesSelection::ViewState
+UCesiumCameraSubsystem::CreateViewStateFromViewParameters(
+    const FCesiumCamera& camera,
+    const glm::dmat4& unrealWorldToTileset,
+    UCesiumEllipsoid* ellipsoid) {
+
+  double horizontalFieldOfView =
+      FMath::DegreesToRadians(camera.FieldOfViewDegrees);
+
+  double actualAspectRatio;
+  glm::dvec2 size(camera.ViewportSize.X, camera.ViewportSize.Y);
+
+  if (camera.OverrideAspectRatio != 0.0f) {
+    // Use aspect ratio and recompute effective viewport size after black bars
+    // are added.
+    actualAspectRatio = camera.OverrideAspectRatio;
+    double computedX = actualAspectRatio * camera.ViewportSize.Y;
+    double computedY = camera.ViewportSize.Y / actualAspectRatio;
+
+    double barWidth = camera.ViewportSize.X - computedX;
+    double barHeight = camera.ViewportSize.Y - computedY;
+
+    if (barWidth > 0.0 && barWidth > barHeight) {
+      // Black bars on the sides
+      size.x = computedX;
+    } else if (barHeight > 0.0 && barHeight > barWidth) {
+      // Black bars on the top and bottom
+      size.y = computedY;
+    }
+  } else {
+    actualAspectRatio = camera.ViewportSize.X / camera.ViewportSize.Y;
+  }
+
+  double verticalFieldOfView =
+      atan(tan(horizontalFieldOfView * 0.5) / actualAspectRatio) * 2.0;
+
+  FVector direction = camera.Rotation.RotateVector(FVector(1.0f, 0.0f, 0.0f));
+  FVector up = camera.Rotation.RotateVector(FVector(0.0f, 0.0f, 1.0f));
+
+  glm::dvec3 tilesetCameraLocation = glm::dvec3(
+      unrealWorldToTileset *
+      glm::dvec4(camera.Location.X, camera.Location.Y, camera.Location.Z, 1.0));
+  glm::dvec3 tilesetCameraFront = glm::normalize(glm::dvec3(
+      unrealWorldToTileset *
+      glm::dvec4(direction.X, direction.Y, direction.Z, 0.0)));
+  glm::dvec3 tilesetCameraUp = glm::normalize(
+      glm::dvec3(unrealWorldToTileset * glm::dvec4(up.X, up.Y, up.Z, 0.0)));
+
+  return Cesium3DTilesSelection::ViewState::create(
+      tilesetCameraLocation,
+      tilesetCameraFront,
+      tilesetCameraUp,
+      size,
+      horizontalFieldOfView,
+      verticalFieldOfView,
+      ellipsoid->GetNativeEllipsoid());
+}
+
+#if WITH_EDITOR
+void UCesiumCameraSubsystem::collectEditorCameras(
+    bool scaleUsingDPI,
+    std::vector<FCesiumCamera>& cameras) const {
+  if (!GEditor) {
+    return;
+  }
+
+  UWorld* pWorld = this->GetWorld();
+  if (!IsValid(pWorld)) {
+    return;
+  }
+
+  // Do not include editor cameras when running in a game world (which includes
+  // Play-in-Editor)
+  if (pWorld->IsGameWorld()) {
+    return;
+  }
+
+  const TArray<FEditorViewportClient*>& viewportClients =
+      GEditor->GetAllViewportClients();
+
+  cameras.reserve(cameras.size() + viewportClients.Num());
+
+  for (FEditorViewportClient* pEditorViewportClient : viewportClients) {
+    if (!pEditorViewportClient) {
+      continue;
+    }
+
+    if (!pEditorViewportClient->IsVisible() ||
+        !pEditorViewportClient->IsRealtime() ||
+        !pEditorViewportClient->IsPerspective()) {
+      continue;
+    }
+
+    FRotator rotation;
+    if (pEditorViewportClient->bUsingOrbitCamera) {
+      rotation = (pEditorViewportClient->GetLookAtLocation() -
+                  pEditorViewportClient->GetViewLocation())
+                     .Rotation();
+    } else {
+      rotation = pEditorViewportClient->GetViewRotation();
+    }
+
+    const FVector& location = pEditorViewportClient->GetViewLocation();
+    double fov = pEditorViewportClient->ViewFOV;
+    FIntPoint offset;
+    FIntPoint size;
+    pEditorViewportClient->GetViewportDimensions(offset, size);
+
+    if (size.X < 1 || size.Y < 1) {
+      continue;
+    }
+
+    if (scaleUsingDPI) {
+      float dpiScalingFactor = pEditorViewportClient->GetDPIScale();
+      size.X = static_cast<float>(size.X) / dpiScalingFactor;
+      size.Y = static_cast<float>(size.Y) / dpiScalingFactor;
+    }
+
+    if (pEditorViewportClient->IsAspectRatioConstrained()) {
+      cameras.emplace_back(
+          size,
+          location,
+          rotation,
+          fov,
+          pEditorViewportClient->AspectRatio);
+    } else {
+      cameras.emplace_back(size, location, rotation, fov);
+    }
+  }
+}
+#endif
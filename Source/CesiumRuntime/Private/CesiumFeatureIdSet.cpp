@@ -154,13 +154,17 @@ int64 UCesiumFeatureIdSetBlueprintLibrary::GetFeatureIDFromHit(
     return -1;
   }
 
-  const CesiumPrimitiveData& primData = pGltfComponent->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(
+          Hit.FaceIndex,
+          primitiveFaceIndex);
   if (!primData.pMeshPrimitive) {
     return -1;
   }
   auto VertexIndices = std::visit(
       CesiumGltf::IndicesForFaceFromAccessor{
-          Hit.FaceIndex,
+          primitiveFaceIndex,
           primData.PositionAccessor.size(),
           primData.pMeshPrimitive->mode},
       primData.IndexAccessor);
@@ -74,13 +74,25 @@ int64 UCesiumFeatureIdTextureBlueprintLibrary::GetGltfTextureCoordinateSetIndex(
 
 int64 UCesiumFeatureIdTextureBlueprintLibrary::GetUnrealUVChannel(
     const UPrimitiveComponent* PrimitiveComponent,
-    UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture) {
+    UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
+    int64 FaceIndex) {
   const auto* pCesiumPrimitive = Cast<ICesiumPrimitive>(PrimitiveComponent);
   if (!pCesiumPrimitive ||
       FeatureIDTexture._status != ECesiumFeatureIdTextureStatus::Valid) {
     return -1;
   }
-  const CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
+
+  // Only the sections of a non-instanced component's mesh can draw different
+  // primitives.
+  const auto* pGltfComponent =
+      Cast<UCesiumGltfPrimitiveComponent>(PrimitiveComponent);
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent
+          ? pGltfComponent->getPrimitiveDataForFace(
+                FaceIndex,
+                primitiveFaceIndex)
+          : pCesiumPrimitive->getPrimitiveData();
   auto textureCoordinateIndexIt = primData.GltfToUnrealTexCoordMap.find(
       UCesiumFeatureIdTextureBlueprintLibrary::GetGltfTextureCoordinateSetIndex(
           FeatureIDTexture));
@@ -1,10 +1,17 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumFlyToComponent.h"
+#include "Cesium3DTileset.h"
+#include "CesiumCamera.h"
+#include "CesiumCameraManager.h"
+#include "CesiumCameraSubsystem.h"
 #include "CesiumGeoreference.h"
 #include "CesiumGlobeAnchorComponent.h"
+#include "CesiumRuntimeSettings.h"
 #include "CesiumWgs84Ellipsoid.h"
 #include "Curves/CurveFloat.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
 #include "GameFramework/Controller.h"
 #include "GameFramework/Pawn.h"
 #include "UObject/ConstructorHelpers.h"
@@ -109,6 +116,13 @@ void UCesiumFlyToComponent::FlyToLocationEarthCenteredEarthFixed(
   this->_previousPositionEcef = ecefSource;
   this->_flightInProgress = true;
   this->_destinationEcef = EarthCenteredEarthFixedDestination;
+
+  this->_destinationWaitTime = 0.0f;
+  this->_finalDescentAllowed = !this->PreloadDestination ||
+                               this->DestinationLoadProgressThreshold <= 0.0f;
+  if (this->PreloadDestination) {
+    this->AddPreloadCameras();
+  }
 }
 
 void UCesiumFlyToComponent::FlyToLocationLongitudeLatitudeHeight(
@@ -164,6 +178,7 @@ void UCesiumFlyToComponent::FlyToLocationUnreal(
 
 void UCesiumFlyToComponent::InterruptFlight() {
   this->_flightInProgress = false;
+  this->RemovePreloadCameras();
 
   UCesiumGlobeAnchorComponent* GlobeAnchor = this->GetGlobeAnchor();
   if (IsValid(GlobeAnchor)) {
@@ -205,6 +220,18 @@ void UCesiumFlyToComponent::TickComponent(
 
   this->_currentFlyTime += DeltaTime;
 
+  // Hold the flight before its final descent until the destination is loaded.
+  const float descentTime = this->FinalDescentStart * this->Duration;
+  if (!this->_finalDescentAllowed && this->_currentFlyTime >= descentTime) {
+    this->_destinationWaitTime += DeltaTime;
+    if (this->IsDestinationLoaded() ||
+        this->_destinationWaitTime >= this->MaximumDestinationLoadWaitTime) {
+      this->_finalDescentAllowed = true;
+    } else {
+      this->_currentFlyTime = descentTime;
+    }
+  }
+
   // In order to accelerate at start and slow down at end, we use a progress
   // profile curve
   float flyPercentage;
@@ -229,6 +256,7 @@ void UCesiumFlyToComponent::TickComponent(
     this->SetCurrentRotationEastSouthUp(this->_destinationRotation);
     this->_flightInProgress = false;
     this->_currentFlyTime = 0.0f;
+    this->RemovePreloadCameras();
 
     // Trigger callback accessible from BP
     UE_LOG(LogCesium, Verbose, TEXT("Broadcasting OnFlightComplete"));
@@ -237,17 +265,9 @@ void UCesiumFlyToComponent::TickComponent(
     return;
   }
 
-  // Get altitude offset from profile curve if one is specified
-  double altitudeOffset = 0.0;
-  if (this->_maxHeight != 0.0 && this->HeightPercentageCurve) {
-    double curveOffset =
-        this->_maxHeight *
-        this->HeightPercentageCurve->GetFloatValue(flyPercentage);
-    altitudeOffset = curveOffset;
-  }
-
-  glm::dvec3 currentPositionEcef =
-      _currentCurve->getPosition(flyPercentage, altitudeOffset);
+  glm::dvec3 currentPositionEcef = _currentCurve->getPosition(
+      flyPercentage,
+      this->GetAltitudeOffset(flyPercentage));
 
   FVector currentPositionVector(
       currentPositionEcef.x,
@@ -267,6 +287,13 @@ void UCesiumFlyToComponent::TickComponent(
 
   this->_previousPositionEcef =
       GlobeAnchor->GetEarthCenteredEarthFixedPosition();
+
+  this->UpdatePreloadCameras(flyPercentage);
+}
+
+void UCesiumFlyToComponent::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+  this->RemovePreloadCameras();
+  Super::EndPlay(EndPlayReason);
 }
 
 FQuat UCesiumFlyToComponent::GetCurrentRotationEastSouthUp() {
@@ -325,3 +352,132 @@ void UCesiumFlyToComponent::SetCurrentRotationEastSouthUp(
     this->GetGlobeAnchor()->SetEastSouthUpRotation(EastSouthUpRotation);
   }
 }
+
+double UCesiumFlyToComponent::GetAltitudeOffset(float FlyPercentage) const {
+  // Get altitude offset from profile curve if one is specified
+  if (this->_maxHeight != 0.0 && this->HeightPercentageCurve) {
+    return this->_maxHeight *
+           this->HeightPercentageCurve->GetFloatValue(FlyPercentage);
+  }
+  return 0.0;
+}
+
+void UCesiumFlyToComponent::AddPreloadCameras() {
+  this->RemovePreloadCameras();
+
+  ACesiumGeoreference* Georeference =
+      this->GetGlobeAnchor()->ResolveGeoreference();
+  ACesiumCameraManager* CameraManager =
+      ACesiumCameraManager::GetDefaultCameraManager(this);
+  if (!IsValid(Georeference) || !IsValid(CameraManager)) {
+    return;
+  }
+
+  // Give the preload cameras the same view as the first player camera, so
+  // that the same tiles are selected as on arrival.
+  this->_preloadViewportSize = FVector2D(1920.0, 1080.0);
+  this->_preloadFieldOfView = 90.0;
+  UWorld* World = this->GetWorld();
+  UCesiumCameraSubsystem* CameraSubsystem =
+      World ? World->GetSubsystem<UCesiumCameraSubsystem>() : nullptr;
+  if (CameraSubsystem) {
+    const std::vector<FCesiumCamera>& Cameras = CameraSubsystem->GetCameras(
+        GetDefault<UCesiumRuntimeSettings>()->ScaleLevelOfDetailByDPI);
+    if (!Cameras.empty()) {
+      this->_preloadViewportSize = Cameras.front().ViewportSize;
+      this->_preloadFieldOfView = Cameras.front().FieldOfViewDegrees;
+    }
+  }
+
+  const int32 Points = FMath::Max(this->PreloadPointsAlongFlight, 0);
+  for (int32 i = 1; i <= Points + 1; ++i) {
+    PreloadCamera& Camera = this->_preloadCameras.emplace_back();
+    Camera.flyPercentage = float(i) / float(Points + 1);
+    if (i == Points + 1) {
+      Camera.positionEcef = this->_destinationEcef;
+      Camera.rotationEastSouthUp = this->_destinationRotation;
+    } else {
+      glm::dvec3 Position = this->_currentCurve->getPosition(
+          Camera.flyPercentage,
+          this->GetAltitudeOffset(Camera.flyPercentage));
+      Camera.positionEcef = FVector(Position.x, Position.y, Position.z);
+      Camera.rotationEastSouthUp = FQuat::Slerp(
+          this->_sourceRotation,
+          this->_destinationRotation,
+          Camera.flyPercentage);
+    }
+    Camera.id = CameraManager->AddCamera(
+        this->CreatePreloadCamera(Camera, *Georeference));
+  }
+
+  this->_pPreloadCameraManager = CameraManager;
+}
+
+void UCesiumFlyToComponent::UpdatePreloadCameras(float FlyPercentage) {
+  ACesiumCameraManager* CameraManager = this->_pPreloadCameraManager.Get();
+  ACesiumGeoreference* Georeference =
+      this->GetGlobeAnchor()->ResolveGeoreference();
+  if (!IsValid(CameraManager) || !IsValid(Georeference)) {
+    return;
+  }
+
+  // Remove the cameras the Actor has passed, and move the others along with
+  // the Unreal coordinate system, which may have changed since the last tick.
+  auto It = this->_preloadCameras.begin();
+  while (It != this->_preloadCameras.end()) {
+    if (It->flyPercentage <= FlyPercentage) {
+      CameraManager->RemoveCamera(It->id);
+      It = this->_preloadCameras.erase(It);
+    } else {
+      CameraManager->UpdateCamera(
+          It->id,
+          this->CreatePreloadCamera(*It, *Georeference));
+      ++It;
+    }
+  }
+}
+
+void UCesiumFlyToComponent::RemovePreloadCameras() {
+  ACesiumCameraManager* CameraManager = this->_pPreloadCameraManager.Get();
+  if (IsValid(CameraManager)) {
+    for (const PreloadCamera& Camera : this->_preloadCameras) {
+      CameraManager->RemoveCamera(Camera.id);
+    }
+  }
+  this->_preloadCameras.clear();
+  this->_pPreloadCameraManager.Reset();
+}
+
+FCesiumCamera UCesiumFlyToComponent::CreatePreloadCamera(
+    const PreloadCamera& Camera,
+    ACesiumGeoreference& Georeference) const {
+  FVector Location =
+      Georeference.TransformEarthCenteredEarthFixedPositionToUnreal(
+          Camera.positionEcef);
+  FRotator Rotation = Georeference.TransformEastSouthUpRotatorToUnreal(
+      Camera.rotationEastSouthUp.Rotator(),
+      Location);
+  return FCesiumCamera(
+      this->_preloadViewportSize,
+      Location,
+      Rotation,
+      this->_preloadFieldOfView);
+}
+
+bool UCesiumFlyToComponent::IsDestinationLoaded() const {
+  UWorld* World = this->GetWorld();
+  if (!World) {
+    return true;
+  }
+
+  for (TActorIterator<ACesium3DTileset> It(World); It; ++It) {
+    const ACesium3DTileset* Tileset = *It;
+    if (!IsValid(Tileset) || Tileset->IsHidden()) {
+      continue;
+    }
+    if (Tileset->GetLoadProgress() < this->DestinationLoadProgressThreshold) {
+      return false;
+    }
+  }
+  return true;
+}
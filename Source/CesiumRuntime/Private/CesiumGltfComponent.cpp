@@ -1,7 +1,9 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumGltfComponent.h"
+#include "AI/Navigation/NavCollisionBase.h"
 #include "Async/Async.h"
+#include "Async/ParallelFor.h"
 #include "CesiumCommon.h"
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumEncodedMetadataUtility.h"
@@ -9,11 +11,16 @@
 #include "CesiumGltfPointsComponent.h"
 #include "CesiumGltfPrimitiveComponent.h"
 #include "CesiumGltfTextures.h"
+#include "CesiumLifetime.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumPhysicsMeshUtility.h"
+#include "CesiumPrimitivePool.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumRuntime.h"
+#include "CesiumScratchBuffers.h"
 #include "CesiumTextureUtility.h"
 #include "CesiumTransforms.h"
+#include "CesiumVertexBufferUtility.h"
 #include "Chaos/AABBTree.h"
 #include "Chaos/CollisionConvexMesh.h"
 #include "Chaos/TriangleMeshImplicitObject.h"
@@ -55,12 +62,14 @@
 #include <CesiumRasterOverlays/RasterOverlayTile.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/joinToString.h>
+#include <algorithm>
 #include <cstddef>
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/gtc/matrix_inverse.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <glm/mat3x3.hpp>
 #include <iostream>
+#include <map>
 #include <type_traits>
 
 #if WITH_EDITOR
@@ -101,12 +110,69 @@ template <class T> struct IsAccessorView<T> : std::false_type {};
 template <class T>
 struct IsAccessorView<CesiumGltf::AccessorView<T>> : std::true_type {};
 
+/**
+ * The indices of a primitive without an index accessor, where each vertex is
+ * used once in order. Provides the accessor interface used by loadPrimitive
+ * without allocating an index buffer.
+ */
+struct SequentialIndices {
+  int64_t count;
+
+  int64_t size() const { return this->count; }
+  uint32_t operator[](int64_t i) const { return static_cast<uint32_t>(i); }
+};
+
+/**
+ * Cooks the collision mesh of a primitive from its render data, or from a
+ * simplified copy of its triangles if physics meshes are simplified. If
+ * cooking on demand, the triangles are kept instead, so that the collision
+ * mesh can be cooked once something comes near the primitive.
+ */
+static void createCollisionMesh(
+    LoadPrimitiveResult& primitiveResult,
+    const CreateModelOptions& modelOptions,
+    bool hasInstances) {
+  const FStaticMeshLODResources& lod =
+      primitiveResult.RenderData->LODResources[0];
+  if (lod.VertexBuffers.PositionVertexBuffer.GetNumVertices() == 0 ||
+      lod.IndexBuffer.GetNumIndices() == 0) {
+    return;
+  }
+
+  const bool cookOnDemand =
+      modelOptions.cookPhysicsMeshesOnDemand && !hasInstances;
+  if (!cookOnDemand && !modelOptions.simplifyPhysicsMeshes) {
+    primitiveResult.pCollisionMesh =
+        CesiumPhysicsMeshUtility::buildCollisionMesh(lod);
+    return;
+  }
+
+  CesiumPhysicsMeshUtility::CollisionMeshSource source =
+      CesiumPhysicsMeshUtility::copyCollisionMeshSource(lod);
+  if (modelOptions.simplifyPhysicsMeshes) {
+    source = CesiumPhysicsMeshUtility::simplifyCollisionMesh(
+        source,
+        CesiumPhysicsMeshUtility::unrealToMeshDistance(
+            modelOptions.physicsMeshMaximumError,
+            primitiveResult.transform));
+  }
+
+  if (cookOnDemand) {
+    primitiveResult.pCollisionMeshSource =
+        MakeShared<CesiumPhysicsMeshUtility::CollisionMeshSource>(
+            MoveTemp(source));
+  } else {
+    primitiveResult.pCollisionMesh =
+        CesiumPhysicsMeshUtility::buildCollisionMesh(source);
+  }
+}
+
 template <class T>
 static uint32_t updateTextureCoordinates(
     const CesiumGltf::Model& model,
     const CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
     const TArray<uint32>& indices,
     const std::optional<T>& texture,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -128,7 +194,7 @@ uint32_t updateTextureCoordinates(
     const CesiumGltf::Model& model,
     const CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
     const TArray<uint32>& indices,
     const std::string& attributeName,
     std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap) {
@@ -153,41 +219,39 @@ uint32_t updateTextureCoordinates(
     return 0;
   }
 
-  if (duplicateVertices) {
-    for (int i = 0; i < indices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
-      uint32 vertexIndex = indices[i];
-      if (vertexIndex >= 0 && vertexIndex < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[vertexIndex];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-      }
-    }
-  } else {
-    for (int i = 0; i < vertices.Num(); ++i) {
-      FStaticMeshBuildVertex& vertex = vertices[i];
-      if (i >= 0 && i < uvAccessor.size()) {
-        vertex.UVs[textureCoordinateIndex] = uvAccessor[i];
-      } else {
-        vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
-      }
-    }
-  }
+  CesiumVertexBufferUtility::copyUVs(
+      uvAccessor,
+      duplicateVertices ? &indices : nullptr,
+      vertices.getUVs(textureCoordinateIndex));
 
   return textureCoordinateIndex;
 }
 
+namespace {
+/**
+ * The vertices that mikktspace generates tangents for. They are duplicated,
+ * so every three consecutive vertices make up a triangle.
+ */
+struct MikkTSpaceVertices {
+  const FPositionVertexBuffer& positions;
+  const TArray<TMeshVector3>& normals;
+  // The first texture coordinate set, or nullptr if there is none.
+  const TArray<TMeshVector2>* pUVs;
+  TArray<TMeshVector4>& tangents;
+};
+} // namespace
+
+static MikkTSpaceVertices& getMikkVertices(const SMikkTSpaceContext* Context) {
+  return *reinterpret_cast<MikkTSpaceVertices*>(Context->m_pUserData);
+}
+
 static int mikkGetNumFaces(const SMikkTSpaceContext* Context) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return vertices.Num() / 3;
+  return getMikkVertices(Context).normals.Num() / 3;
 }
 
 static int
 mikkGetNumVertsOfFace(const SMikkTSpaceContext* Context, const int FaceIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  return FaceIdx < (vertices.Num() / 3) ? 3 : 0;
+  return FaceIdx < mikkGetNumFaces(Context) ? 3 : 0;
 }
 
 static void mikkGetPosition(
@@ -195,9 +259,8 @@ static void mikkGetPosition(
     float Position[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& position = vertices[FaceIdx * 3 + VertIdx].Position;
+  const TMeshVector3& position =
+      getMikkVertices(Context).positions.VertexPosition(FaceIdx * 3 + VertIdx);
   Position[0] = position.X;
   Position[1] = -position.Y;
   Position[2] = position.Z;
@@ -208,9 +271,8 @@ static void mikkGetNormal(
     float Normal[3],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector3& normal = vertices[FaceIdx * 3 + VertIdx].TangentZ;
+  const TMeshVector3& normal =
+      getMikkVertices(Context).normals[FaceIdx * 3 + VertIdx];
   Normal[0] = normal.X;
   Normal[1] = -normal.Y;
   Normal[2] = normal.Z;
@@ -221,9 +283,9 @@ static void mikkGetTexCoord(
     float UV[2],
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  const TMeshVector2& uv = vertices[FaceIdx * 3 + VertIdx].UVs[0];
+  const TArray<TMeshVector2>* pUVs = getMikkVertices(Context).pUVs;
+  const TMeshVector2 uv =
+      pUVs ? (*pUVs)[FaceIdx * 3 + VertIdx] : TMeshVector2(0.0f, 0.0f);
   UV[0] = uv.X;
   UV[1] = uv.Y;
 }
@@ -234,25 +296,26 @@ static void mikkSetTSpaceBasic(
     const float BitangentSign,
     const int FaceIdx,
     const int VertIdx) {
-  TArray<FStaticMeshBuildVertex>& vertices =
-      *reinterpret_cast<TArray<FStaticMeshBuildVertex>*>(Context->m_pUserData);
-  FStaticMeshBuildVertex& vertex = vertices[FaceIdx * 3 + VertIdx];
-
-  FVector3f TangentZ = vertex.TangentZ;
-  TangentZ.Y = -TangentZ.Y;
-
-  FVector3f TangentX = TMeshVector3(Tangent[0], Tangent[1], Tangent[2]);
-  FVector3f TangentY =
-      BitangentSign * TMeshVector3::CrossProduct(TangentZ, TangentX);
+  // The bitangent is the cross product of the normal and tangent, times the
+  // sign, before their Y axis is inverted. Inverting the Y axis negates the
+  // cross product, so the sign is negated, too.
+  getMikkVertices(Context).tangents[FaceIdx * 3 + VertIdx] =
+      TMeshVector4(Tangent[0], -Tangent[1], Tangent[2], -BitangentSign);
+}
 
-  TangentX.Y = -TangentX.Y;
-  TangentY.Y = -TangentY.Y;
+static void computeTangentSpace(
+    const FPositionVertexBuffer& positions,
+    CesiumVertexBufferUtility::VertexAttributes& vertices) {
+  vertices.tangents.SetNumZeroed(vertices.vertexCount);
 
-  vertex.TangentX = TangentX;
-  vertex.TangentY = TangentY;
-}
+  const bool hasUVs =
+      vertices.uvs.Num() > 0 && vertices.uvs[0].Num() == vertices.vertexCount;
+  MikkTSpaceVertices mikkVertices{
+      positions,
+      vertices.normals,
+      hasUVs ? &vertices.uvs[0] : nullptr,
+      vertices.tangents};
 
-static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
   SMikkTSpaceInterface MikkTInterface{};
   MikkTInterface.m_getNormal = mikkGetNormal;
   MikkTInterface.m_getNumFaces = mikkGetNumFaces;
@@ -264,73 +327,82 @@ static void computeTangentSpace(TArray<FStaticMeshBuildVertex>& vertices) {
 
   SMikkTSpaceContext MikkTContext{};
   MikkTContext.m_pInterface = &MikkTInterface;
-  MikkTContext.m_pUserData = (void*)(&vertices);
+  MikkTContext.m_pUserData = (void*)(&mikkVertices);
   // MikkTContext.m_bIgnoreDegenerates = false;
   genTangSpaceDefault(&MikkTContext);
 }
 
 static void setUnlitNormals(
-    TArray<FStaticMeshBuildVertex>& vertices,
+    const FPositionVertexBuffer& positions,
+    TArray<TMeshVector3>& normals,
     const CesiumGeospatial::Ellipsoid& ellipsoid,
     const glm::dmat4& vertexToEllipsoidFixed) {
   glm::dmat4 ellipsoidFixedToVertex =
       glm::affineInverse(vertexToEllipsoidFixed);
 
-  for (int i = 0; i < vertices.Num(); i++) {
-    FStaticMeshBuildVertex& v = vertices[i];
-    v.TangentX = v.TangentY = TMeshVector3(0.0f);
-
-    glm::dvec3 positionFixed = glm::dvec3(
-        vertexToEllipsoidFixed *
-        glm::dvec4(VecMath::createVector3D(FVector(v.Position)), 1.0));
-    glm::dvec3 normal = ellipsoid.geodeticSurfaceNormal(positionFixed);
-    v.TangentZ = FVector3f(VecMath::createVector(
-        glm::normalize(ellipsoidFixedToVertex * glm::dvec4(normal, 0.0))));
-  }
+  const int32 vertexCount = int32(positions.GetNumVertices());
+  normals.SetNumUninitialized(vertexCount);
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertexCount,
+      1,
+      [&](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; i++) {
+          glm::dvec3 positionFixed = glm::dvec3(
+              vertexToEllipsoidFixed *
+              glm::dvec4(
+                  VecMath::createVector3D(
+                      FVector(positions.VertexPosition(i))),
+                  1.0));
+          glm::dvec3 normal = ellipsoid.geodeticSurfaceNormal(positionFixed);
+          normals[i] = FVector3f(VecMath::createVector(glm::normalize(
+              ellipsoidFixedToVertex * glm::dvec4(normal, 0.0))));
+        }
+      });
 }
 
-static void computeFlatNormals(TArray<FStaticMeshBuildVertex>& vertices) {
-  // Compute flat normals
-  for (int i = 0; i < vertices.Num(); i += 3) {
-    FStaticMeshBuildVertex& v0 = vertices[i];
-    FStaticMeshBuildVertex& v1 = vertices[i + 1];
-    FStaticMeshBuildVertex& v2 = vertices[i + 2];
-
-    // The Y axis has previously been inverted, so undo that before
-    // computing the normal direction. Then invert the Y coordinate of the
-    // normal, too.
-
-    TMeshVector3 v01 = v1.Position - v0.Position;
-    v01.Y = -v01.Y;
-    TMeshVector3 v02 = v2.Position - v0.Position;
-    v02.Y = -v02.Y;
-    TMeshVector3 normal = TMeshVector3::CrossProduct(v01, v02);
-
-    normal.Y = -normal.Y;
-
-    v0.TangentX = v1.TangentX = v2.TangentX = TMeshVector3(0.0f);
-    v0.TangentY = v1.TangentY = v2.TangentY = TMeshVector3(0.0f);
-    v0.TangentZ = v1.TangentZ = v2.TangentZ = normal.GetSafeNormal();
-  }
+static void computeFlatNormals(
+    const FPositionVertexBuffer& positions,
+    TArray<TMeshVector3>& normals) {
+  const int32 vertexCount = int32(positions.GetNumVertices());
+  normals.SetNumUninitialized(vertexCount);
+
+  // Compute flat normals. Ranges start at a multiple of three, so that they
+  // contain whole triangles.
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertexCount,
+      3,
+      [&](int32 begin, int32 end) {
+        for (int32 i = begin; i + 2 < end; i += 3) {
+          const TMeshVector3& p0 = positions.VertexPosition(i);
+          const TMeshVector3& p1 = positions.VertexPosition(i + 1);
+          const TMeshVector3& p2 = positions.VertexPosition(i + 2);
+
+          // The Y axis has previously been inverted, so undo that before
+          // computing the normal direction. Then invert the Y coordinate of
+          // the normal, too.
+
+          TMeshVector3 v01 = p1 - p0;
+          v01.Y = -v01.Y;
+          TMeshVector3 v02 = p2 - p0;
+          v02.Y = -v02.Y;
+          TMeshVector3 normal = TMeshVector3::CrossProduct(v01, v02);
+
+          normal.Y = -normal.Y;
+
+          normals[i] = normals[i + 1] = normals[i + 2] =
+              normal.GetSafeNormal();
+        }
+      });
 }
 
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices);
-
 static const CesiumGltf::Material defaultMaterial;
 static const CesiumGltf::MaterialPBRMetallicRoughness
     defaultPbrMetallicRoughness;
 
 struct ColorVisitor {
   bool duplicateVertices;
-  TArray<FStaticMeshBuildVertex>& StaticMeshBuildVertices;
+  FColorVertexBuffer& colorBuffer;
+  int32 vertexCount;
   const TArray<uint32>& indices;
 
   bool operator()(CesiumGltf::AccessorView<nullptr_t>&& invalidView) {
@@ -338,34 +410,44 @@ struct ColorVisitor {
   }
 
   template <typename TColorView> bool operator()(TColorView&& colorView) {
-    if (colorView.status() != CesiumGltf::AccessorViewStatus::Valid) {
+    if (colorView.status() != CesiumGltf::AccessorViewStatus::Valid ||
+        this->vertexCount == 0) {
       return false;
     }
 
-    bool success = true;
+    // Check the whole accessor up front, so that the loops below can write
+    // straight into the vertex buffer.
+    int64 requiredSize = this->vertexCount;
     if (duplicateVertices) {
-      for (int i = 0; success && i < this->indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
-        uint32 vertexIndex = this->indices[i];
-        if (vertexIndex >= colorView.size()) {
-          success = false;
-        } else {
-          success =
-              ColorVisitor::convertColor(colorView[vertexIndex], vertex.Color);
-        }
+      uint32 maxIndex = 0;
+      for (uint32 index : this->indices) {
+        maxIndex = FMath::Max(maxIndex, index);
+      }
+      requiredSize = int64(maxIndex) + 1;
+    }
+
+    FColor color;
+    if (colorView.size() < requiredSize ||
+        !ColorVisitor::convertColor(colorView[0], color)) {
+      return false;
+    }
+
+    this->colorBuffer.Init(this->vertexCount, false);
+    if (duplicateVertices) {
+      for (int32 i = 0; i < this->vertexCount; ++i) {
+        ColorVisitor::convertColor(
+            colorView[this->indices[i]],
+            this->colorBuffer.VertexColor(i));
       }
     } else {
-      for (int i = 0; success && i < this->StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = this->StaticMeshBuildVertices[i];
-        if (i >= colorView.size()) {
-          success = false;
-        } else {
-          success = ColorVisitor::convertColor(colorView[i], vertex.Color);
-        }
+      for (int32 i = 0; i < this->vertexCount; ++i) {
+        ColorVisitor::convertColor(
+            colorView[i],
+            this->colorBuffer.VertexColor(i));
       }
     }
 
-    return success;
+    return true;
   }
 
   template <typename TElement>
@@ -635,7 +717,7 @@ static void updateTextureCoordinatesForFeaturesMetadata(
     const CesiumGltf::Model& model,
     const CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
     const TArray<uint32>& indices,
     const FCesiumPrimitiveFeatures& primitiveFeatures,
     const CesiumEncodedFeaturesMetadata::EncodedPrimitiveFeatures&
@@ -724,29 +806,28 @@ static void updateTextureCoordinatesForFeaturesMetadata(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& uvs = vertices.getUVs(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIDAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
+        for (int64_t i = 0; i < vertices.vertexCount; ++i) {
           if (i < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIDAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       }
@@ -775,18 +856,15 @@ static void updateTextureCoordinatesForFeaturesMetadata(
       featuresMetadataTexcoordParameters.Emplace(
           SafeName,
           textureCoordinateIndex);
+      TArray<TMeshVector2>& uvs = vertices.getUVs(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
+          uvs[i] = TMeshVector2(static_cast<float>(vertexIndex), 0.0f);
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
-          vertex.UVs[textureCoordinateIndex] =
-              TMeshVector2(static_cast<float>(i), 0.0f);
+        for (int64_t i = 0; i < vertices.vertexCount; ++i) {
+          uvs[i] = TMeshVector2(static_cast<float>(i), 0.0f);
         }
       }
     }
@@ -798,7 +876,7 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
     const CesiumGltf::Model& model,
     const CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
     const TArray<uint32>& indices,
     const CesiumEncodedMetadataUtility::EncodedMetadata& encodedMetadata,
     const CesiumEncodedMetadataUtility::EncodedMetadataPrimitive&
@@ -881,29 +959,28 @@ static void updateTextureCoordinatesForMetadata_DEPRECATED(
 
       // We encode unsigned integer feature ids as floats in the u-channel of
       // a texture coordinate slot.
+      TArray<TMeshVector2>& uvs = vertices.getUVs(textureCoordinateIndex);
       if (duplicateVertices) {
         for (int64_t i = 0; i < indices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
           uint32 vertexIndex = indices[i];
           if (vertexIndex >= 0 && vertexIndex < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, vertexIndex));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       } else {
-        for (int64_t i = 0; i < vertices.Num(); ++i) {
-          FStaticMeshBuildVertex& vertex = vertices[i];
+        for (int64_t i = 0; i < vertices.vertexCount; ++i) {
           if (i < vertexCount) {
             float featureId = static_cast<float>(
                 UCesiumFeatureIdAttributeBlueprintLibrary::
                     GetFeatureIDForVertex(featureIdAttribute, i));
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(featureId, 0.0f);
+            uvs[i] = TMeshVector2(featureId, 0.0f);
           } else {
-            vertex.UVs[textureCoordinateIndex] = TMeshVector2(0.0f, 0.0f);
+            uvs[i] = TMeshVector2(0.0f, 0.0f);
           }
         }
       }
@@ -918,7 +995,7 @@ static void loadPrimitiveFeaturesMetadata(
     CesiumGltf::Model& model,
     CesiumGltf::MeshPrimitive& primitive,
     bool duplicateVertices,
-    TArray<FStaticMeshBuildVertex>& vertices,
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
     const TArray<uint32>& indices) {
 
   CesiumGltf::ExtensionExtMeshFeatures* pFeatures =
@@ -1151,6 +1228,7 @@ static void loadPrimitive(
 
   if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::TRIANGLES &&
       primitive.mode != CesiumGltf::MeshPrimitive::Mode::TRIANGLE_STRIP &&
+      primitive.mode != CesiumGltf::MeshPrimitive::Mode::TRIANGLE_FAN &&
       primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS) {
     // TODO: add support for other primitive types.
     UE_LOG(
@@ -1315,15 +1393,10 @@ static void loadPrimitive(
     glm::dvec3 minPosition{std::numeric_limits<double>::max()};
     glm::dvec3 maxPosition{std::numeric_limits<double>::lowest()};
     if (min.size() != 3 || max.size() != 3) {
-      for (int64_t i = 0; i < positionView.size(); ++i) {
-        minPosition.x = glm::min<double>(minPosition.x, positionView[i].X);
-        minPosition.y = glm::min<double>(minPosition.y, positionView[i].Y);
-        minPosition.z = glm::min<double>(minPosition.z, positionView[i].Z);
-
-        maxPosition.x = glm::max<double>(maxPosition.x, positionView[i].X);
-        maxPosition.y = glm::max<double>(maxPosition.y, positionView[i].Y);
-        maxPosition.z = glm::max<double>(maxPosition.z, positionView[i].Z);
-      }
+      const FBox box =
+          CesiumVertexBufferUtility::computeBoundingBox(positionView);
+      minPosition = VecMath::createVector3D(box.Min);
+      maxPosition = VecMath::createVector3D(box.Max);
     } else {
       minPosition = glm::dvec3(min[0], min[1], min[2]);
       maxPosition = glm::dvec3(max[0], max[1], max[2]);
@@ -1345,81 +1418,71 @@ static void loadPrimitive(
     RenderData->Bounds.SphereRadius = 0.0f;
   }
 
-  TArray<uint32> indices;
-  if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES ||
-      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(static_cast<TArray<uint32>::SizeType>(indicesView.size()));
-
-    for (int32 i = 0; i < indicesView.size(); ++i) {
-      indices[i] = indicesView[i];
-    }
-  } else {
-    // assume TRIANGLE_STRIP because all others are rejected earlier.
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
-    indices.SetNum(
-        static_cast<TArray<uint32>::SizeType>(3 * (indicesView.size() - 2)));
-    for (int32 i = 0; i < indicesView.size() - 2; ++i) {
-      if (i % 2) {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 2];
-        indices[3 * i + 2] = indicesView[i + 1];
-      } else {
-        indices[3 * i] = indicesView[i];
-        indices[3 * i + 1] = indicesView[i + 1];
-        indices[3 * i + 2] = indicesView[i + 2];
-      }
-    }
-  }
+  const CreateModelOptions& modelOptions =
+      *options.pMeshOptions->pNodeOptions->pModelOptions;
+  const bool isPoints =
+      primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS;
 
   // If we don't have normals, the gltf spec prescribes that the client
   // implementation must generate flat normals, which requires duplicating
-  // vertices shared by multiple triangles. If we don't have tangents, but
-  // need them, we need to use a tangent space generation algorithm which
-  // requires duplicated vertices.
+  // vertices shared by multiple triangles unless only the vertices between
+  // triangles facing different ways are split. If we don't have tangents, but
+  // need them, MikkTSpace requires duplicated vertices, too. The indexed
+  // tangent generator doesn't, so it keeps the vertices shared unless flat
+  // normals need them duplicated anyway.
   bool normalsAreRequired = !primitiveResult.isUnlit;
   bool needToGenerateFlatNormals = normalsAreRequired && !hasNormals;
   bool needToGenerateTangents = needsTangents && !hasTangents;
-  bool duplicateVertices = needToGenerateFlatNormals || needToGenerateTangents;
-  duplicateVertices = duplicateVertices &&
-                      primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS;
+  const bool useMikkTSpace =
+      needToGenerateTangents &&
+      (!modelOptions.generateIndexedTangents || isPoints);
+  const bool generateIndexedFlatNormals =
+      needToGenerateFlatNormals && modelOptions.generateIndexedFlatNormals &&
+      !isPoints && !useMikkTSpace;
+  const bool generateIndexedTangents =
+      needToGenerateTangents && !useMikkTSpace &&
+      (!needToGenerateFlatNormals || generateIndexedFlatNormals);
+  bool duplicateVertices =
+      (needToGenerateFlatNormals && !generateIndexedFlatNormals) ||
+      (needToGenerateTangents && !generateIndexedTangents);
+  duplicateVertices = duplicateVertices && !isPoints;
+
+  // The indices are only copied into an array when duplicating vertices or
+  // generating indexed normals or tangents needs them. Otherwise, they are
+  // copied straight into the index buffer in its final width.
+  const bool needIndexArray = duplicateVertices ||
+                              generateIndexedFlatNormals ||
+                              generateIndexedTangents;
+  CesiumScratchBuffers::TScratchArray<uint32> indexBuffer;
+  TArray<uint32>& indices = indexBuffer.get();
+  if (needIndexArray) {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyIndices)
+    const int64 indexCount =
+        CesiumVertexBufferUtility::getTriangleListIndexCount(
+            primitive.mode,
+            int64(indicesView.size()));
+    indices.SetNumUninitialized(static_cast<int32>(indexCount));
+    CesiumVertexBufferUtility::copyTriangleListIndices(
+        indicesView,
+        primitive.mode,
+        0,
+        indexCount,
+        indices.GetData());
+  }
 
-  TArray<FStaticMeshBuildVertex> StaticMeshBuildVertices;
-  StaticMeshBuildVertices.SetNum(
-      duplicateVertices ? indices.Num()
-                        : static_cast<int>(positionView.size()));
+  CesiumVertexBufferUtility::VertexAttributes vertices;
+  vertices.vertexCount = duplicateVertices
+                             ? indices.Num()
+                             : static_cast<int32>(positionView.size());
 
   {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyDuplicatedPositions)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector3& pos = positionView[vertexIndex];
-        vertex.Position.X = pos.X * CesiumPrimitiveData::positionScaleFactor;
-        vertex.Position.Y = -pos.Y * CesiumPrimitiveData::positionScaleFactor;
-        vertex.Position.Z = pos.Z * CesiumPrimitiveData::positionScaleFactor;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
-    } else {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector3& pos = positionView[i];
-        vertex.Position.X = pos.X * CesiumPrimitiveData::positionScaleFactor;
-        vertex.Position.Y = -pos.Y * CesiumPrimitiveData::positionScaleFactor;
-        vertex.Position.Z = pos.Z * CesiumPrimitiveData::positionScaleFactor;
-        vertex.UVs[0] = TMeshVector2(0.0f, 0.0f);
-        vertex.UVs[2] = TMeshVector2(0.0f, 0.0f);
-        RenderData->Bounds.SphereRadius = FMath::Max(
-            (FVector(vertex.Position) - RenderData->Bounds.Origin).Size(),
-            RenderData->Bounds.SphereRadius);
-      }
-    }
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyPositions)
+    RenderData->Bounds.SphereRadius = CesiumVertexBufferUtility::copyPositions(
+        positionView,
+        duplicateVertices ? &indices : nullptr,
+        CesiumPrimitiveData::positionScaleFactor,
+        FVector3f(RenderData->Bounds.Origin),
+        LODResources.VertexBuffers.PositionVertexBuffer);
   }
 
   bool hasVertexColors = false;
@@ -1431,13 +1494,28 @@ static void loadPrimitive(
     hasVertexColors = createAccessorView(
         model,
         colorAccessorID,
-        ColorVisitor{duplicateVertices, StaticMeshBuildVertices, indices});
+        ColorVisitor{
+            duplicateVertices,
+            LODResources.VertexBuffers.ColorVertexBuffer,
+            vertices.vertexCount,
+            indices});
+  }
+
+  // Vertex colors that are all opaque white don't change how the primitive
+  // looks, so the compact vertex format leaves them out.
+  bool droppedVertexColors = false;
+  if (hasVertexColors && modelOptions.compactVertexFormat &&
+      CesiumVertexBufferUtility::isOpaqueWhite(
+          LODResources.VertexBuffers.ColorVertexBuffer)) {
+    LODResources.VertexBuffers.ColorVertexBuffer.CleanUp();
+    hasVertexColors = false;
+    droppedVertexColors = true;
   }
 
   LODResources.bHasColorVertexData = hasVertexColors;
 
   // We need to copy the texture coordinates associated with each texture (if
-  // any) into the the appropriate UVs slot in FStaticMeshBuildVertex.
+  // any) into the the appropriate Unreal texture coordinate set.
 
   std::unordered_map<int32_t, uint32_t>& gltfToUnrealTexCoordMap =
       primitiveResult.GltfToUnrealTexCoordMap;
@@ -1450,7 +1528,7 @@ static void loadPrimitive(
       model,
       primitive,
       duplicateVertices,
-      StaticMeshBuildVertices,
+      vertices,
       indices);
 
   {
@@ -1478,7 +1556,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             pbrMetallicRoughness.baseColorTexture,
             gltfToUnrealTexCoordMap);
@@ -1487,7 +1565,7 @@ static void loadPrimitive(
         model,
         primitive,
         duplicateVertices,
-        StaticMeshBuildVertices,
+        vertices,
         indices,
         pbrMetallicRoughness.metallicRoughnessTexture,
         gltfToUnrealTexCoordMap);
@@ -1497,7 +1575,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.normalTexture,
             gltfToUnrealTexCoordMap);
@@ -1507,7 +1585,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.occlusionTexture,
             gltfToUnrealTexCoordMap);
@@ -1517,7 +1595,7 @@ static void loadPrimitive(
             model,
             primitive,
             duplicateVertices,
-            StaticMeshBuildVertices,
+            vertices,
             indices,
             material.emissiveTexture,
             gltfToUnrealTexCoordMap);
@@ -1533,7 +1611,7 @@ static void loadPrimitive(
                 model,
                 primitive,
                 duplicateVertices,
-                StaticMeshBuildVertices,
+                vertices,
                 indices,
                 attributeName,
                 gltfToUnrealTexCoordMap);
@@ -1554,163 +1632,157 @@ static void loadPrimitive(
   // TangentY: Bi-tangent
   // TangentZ: Normal
 
+  const FPositionVertexBuffer& positionBuffer =
+      LODResources.VertexBuffers.PositionVertexBuffer;
+
   if (hasNormals) {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormalsForDuplicatedVertices)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
-        const TMeshVector3& normal = normalAccessor[vertexIndex];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
-      }
-    } else {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormals)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        vertex.TangentX = TMeshVector3(0.0f, 0.0f, 0.0f);
-        vertex.TangentY = TMeshVector3(0.0f, 0.0f, 0.0f);
-        const TMeshVector3& normal = normalAccessor[i];
-        vertex.TangentZ.X = normal.X;
-        vertex.TangentZ.Y = -normal.Y;
-        vertex.TangentZ.Z = normal.Z;
-      }
-    }
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyNormals)
+    CesiumVertexBufferUtility::copyNormals(
+        normalAccessor,
+        duplicateVertices ? &indices : nullptr,
+        vertices.vertexCount,
+        vertices.normals);
   } else {
     if (primitiveResult.isUnlit) {
       setUnlitNormals(
-          StaticMeshBuildVertices,
+          positionBuffer,
+          vertices.normals,
           ellipsoid,
           transform * yInvertMatrix * scaleMatrix);
-    } else {
+    } else if (!generateIndexedFlatNormals) {
       TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeFlatNormals)
-      computeFlatNormals(StaticMeshBuildVertices);
+      computeFlatNormals(positionBuffer, vertices.normals);
     }
   }
 
   if (hasTangents) {
-    if (duplicateVertices) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangentsForDuplicatedVertices)
-      for (int i = 0; i < indices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        uint32 vertexIndex = indices[i];
-        const TMeshVector4& tangent = tangentAccessor[vertexIndex];
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
-            tangent.W;
-      }
-    } else {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
-      for (int i = 0; i < StaticMeshBuildVertices.Num(); ++i) {
-        FStaticMeshBuildVertex& vertex = StaticMeshBuildVertices[i];
-        const TMeshVector4& tangent = tangentAccessor[i];
-        vertex.TangentX = tangent;
-        vertex.TangentX.X = tangent.X;
-        vertex.TangentX.Y = -tangent.Y;
-        vertex.TangentX.Z = tangent.Z;
-        vertex.TangentY =
-            TMeshVector3::CrossProduct(vertex.TangentZ, vertex.TangentX) *
-            tangent.W;
-      }
-    }
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyTangents)
+    CesiumVertexBufferUtility::copyTangents(
+        tangentAccessor,
+        duplicateVertices ? &indices : nullptr,
+        vertices.vertexCount,
+        vertices.tangents);
+  }
+
+  if (generateIndexedFlatNormals) {
+    // This is done after the tangents are copied, so that split vertices
+    // get copies of them.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeIndexedFlatNormals)
+    CesiumScratchBuffers::TScratchArray<uint32> copiedVertices;
+    CesiumVertexBufferUtility::computeIndexedFlatNormals(
+        positionBuffer,
+        indices,
+        FMath::DegreesToRadians(modelOptions.flatNormalCreaseAngle),
+        vertices,
+        copiedVertices.get());
+    CesiumVertexBufferUtility::appendVertexCopies(
+        copiedVertices.get(),
+        LODResources.VertexBuffers.PositionVertexBuffer,
+        hasVertexColors ? &LODResources.VertexBuffers.ColorVertexBuffer
+                        : nullptr);
   }
 
-  if (needsTangents && !hasTangents) {
+  if (generateIndexedTangents) {
+    // Note that this assumes normals and UVs are already populated.
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeIndexedTangents)
+    CesiumScratchBuffers::TScratchArray<uint32> copiedVertices;
+    CesiumVertexBufferUtility::computeIndexedTangents(
+        positionBuffer,
+        indices,
+        vertices,
+        copiedVertices.get());
+    CesiumVertexBufferUtility::appendVertexCopies(
+        copiedVertices.get(),
+        LODResources.VertexBuffers.PositionVertexBuffer,
+        hasVertexColors ? &LODResources.VertexBuffers.ColorVertexBuffer
+                        : nullptr);
+  } else if (needsTangents && !hasTangents) {
     // Use mikktspace to calculate the tangents.
     // Note that this assumes normals and UVs are already populated.
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ComputeTangents)
-    computeTangentSpace(StaticMeshBuildVertices);
+    computeTangentSpace(positionBuffer, vertices);
   }
 
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::InitBuffers)
 
-    // Set to full precision (32-bit) UVs. This is especially important for
-    // metadata because integer feature IDs can and will lose meaningful
-    // precision when using 16-bit floats.
+    // Use full precision (32-bit) UVs for feature IDs and metadata, because
+    // integer feature IDs can and will lose meaningful precision when using
+    // 16-bit floats, and for texture coordinates too large for 16-bit floats.
+    // Raster overlays need them, too, because the material scales their
+    // texture coordinates to the raster tile, magnifying any rounding into
+    // visible seams. Otherwise, the compact vertex format uses half-precision
+    // UVs.
+    const bool useFullPrecisionUVs =
+        !modelOptions.compactVertexFormat ||
+        primitiveResult.FeaturesMetadataTexCoordParameters.Num() > 0 ||
+        !primitiveResult.overlayTextureCoordinateIDToUVIndex.empty() ||
+        !CesiumVertexBufferUtility::canUseHalfPrecisionUVs(vertices);
     LODResources.VertexBuffers.StaticMeshVertexBuffer.SetUseFullPrecisionUVs(
-        true);
-
-    LODResources.VertexBuffers.PositionVertexBuffer.Init(
-        StaticMeshBuildVertices,
-        false);
-
-    FColorVertexBuffer& ColorVertexBuffer =
-        LODResources.VertexBuffers.ColorVertexBuffer;
-    if (hasVertexColors) {
-      ColorVertexBuffer.Init(StaticMeshBuildVertices, false);
-    }
+        useFullPrecisionUVs);
 
     uint32 numberOfTextureCoordinates =
         gltfToUnrealTexCoordMap.size() == 0
             ? 1
             : uint32(gltfToUnrealTexCoordMap.size());
 
-    FStaticMeshVertexBuffer& vertexBuffer =
-        LODResources.VertexBuffers.StaticMeshVertexBuffer;
-    vertexBuffer.Init(
-        StaticMeshBuildVertices.Num(),
-        numberOfTextureCoordinates,
-        false);
+    if (!useFullPrecisionUVs) {
+      primitiveResult.compactVertexBytesSaved +=
+          uint64(vertices.vertexCount) * numberOfTextureCoordinates *
+          (sizeof(FVector2f) - sizeof(FVector2DHalf));
+    }
+    if (droppedVertexColors) {
+      primitiveResult.compactVertexBytesSaved +=
+          uint64(vertices.vertexCount) * sizeof(FColor);
+    }
 
-    // Manually copy the vertices into the buffer. We do this because UE 5.3
-    // and 5.4 have a bug where the overload of `FStaticMeshVertexBuffer::Init`
-    // taking an array of `FStaticMeshBuildVertex` will create a mesh with all 8
-    // sets of texture coordinates, even when we usually only need one or two.
-    // See https://github.com/CesiumGS/cesium-unreal/issues/1513
-    for (uint32 vertexIndex = 0;
-         vertexIndex < uint32(StaticMeshBuildVertices.Num());
-         ++vertexIndex) {
-      const FStaticMeshBuildVertex& source =
-          StaticMeshBuildVertices[vertexIndex];
+    // The positions and colors are already in their vertex buffers, so only
+    // the tangent frames and texture coordinates are left. Only the texture
+    // coordinate sets that are actually used are created.
+    CesiumVertexBufferUtility::initStaticMeshVertexBuffer(
+        vertices,
+        numberOfTextureCoordinates,
+        LODResources.VertexBuffers.StaticMeshVertexBuffer);
+  }
 
-      vertexBuffer.SetVertexTangents(
-          vertexIndex,
-          source.TangentX,
-          source.TangentY,
-          source.TangentZ);
-      for (uint32 uvIndex = 0; uvIndex < numberOfTextureCoordinates;
-           uvIndex++) {
-        vertexBuffer
-            .SetVertexUV(vertexIndex, uvIndex, source.UVs[uvIndex], false);
-      }
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
+    FRawStaticIndexBuffer& unrealIndexBuffer = LODResources.IndexBuffer;
+    if (duplicateVertices) {
+      // Every triangle has vertices of its own.
+      CesiumVertexBufferUtility::setTriangleListIndices(
+          SequentialIndices{vertices.vertexCount},
+          CesiumGltf::MeshPrimitive::Mode::TRIANGLES,
+          vertices.vertexCount,
+          unrealIndexBuffer);
+    } else if (needIndexArray) {
+      // Generating indexed normals or tangents may have changed the indices.
+      unrealIndexBuffer.SetIndices(
+          indices,
+          vertices.vertexCount >= std::numeric_limits<uint16>::max()
+              ? EIndexBufferStride::Type::Force32Bit
+              : EIndexBufferStride::Type::Force16Bit);
+    } else {
+      CesiumVertexBufferUtility::setTriangleListIndices(
+          indicesView,
+          primitive.mode,
+          vertices.vertexCount,
+          unrealIndexBuffer);
     }
   }
 
   FStaticMeshSectionArray& Sections = LODResources.Sections;
   FStaticMeshSection& section = Sections.AddDefaulted_GetRef();
   // This will be ignored if the primitive contains points.
-  section.NumTriangles = indices.Num() / 3;
+  section.NumTriangles = LODResources.IndexBuffer.GetNumIndices() / 3;
   section.FirstIndex = 0;
   section.MinVertexIndex = 0;
-  section.MaxVertexIndex = StaticMeshBuildVertices.Num() - 1;
+  section.MaxVertexIndex = vertices.vertexCount - 1;
   section.bEnableCollision =
       primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS;
   section.bCastShadow = true;
   section.MaterialIndex = 0;
 
-  if (duplicateVertices) {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReverseWindingOrder)
-    for (int32 i = 0; i < indices.Num(); i++) {
-      indices[i] = i;
-    }
-  }
-
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetIndices)
-    LODResources.IndexBuffer.SetIndices(
-        indices,
-        StaticMeshBuildVertices.Num() >= std::numeric_limits<uint16>::max()
-            ? EIndexBufferStride::Type::Force32Bit
-            : EIndexBufferStride::Type::Force16Bit);
-  }
-
   LODResources.bHasDepthOnlyIndices = false;
   LODResources.bHasReversedIndices = false;
   LODResources.bHasReversedDepthOnlyIndices = false;
@@ -1722,19 +1794,20 @@ static void loadPrimitive(
 
   primitiveResult.transform = transform * yInvertMatrix * scaleMatrix;
 
+  // Primitives that may be merged get their collision mesh after merging, so
+  // that it is only cooked once.
+  const bool mayBeMerged =
+      modelOptions.mergePrimitives &&
+      options.pMeshOptions->pHalfConstructedNodeResult->InstanceTransforms
+          .empty();
+
   if (primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS &&
-      options.pMeshOptions->pNodeOptions->pModelOptions->createPhysicsMeshes) {
-    if (StaticMeshBuildVertices.Num() != 0 && indices.Num() != 0) {
-      TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
-      primitiveResult.pCollisionMesh =
-          StaticMeshBuildVertices.Num() < TNumericLimits<uint16>::Max()
-              ? BuildChaosTriangleMeshes<uint16>(
-                    StaticMeshBuildVertices,
-                    indices)
-              : BuildChaosTriangleMeshes<int32>(
-                    StaticMeshBuildVertices,
-                    indices);
-    }
+      modelOptions.createPhysicsMeshes && !mayBeMerged) {
+    createCollisionMesh(
+        primitiveResult,
+        modelOptions,
+        !options.pMeshOptions->pHalfConstructedNodeResult->InstanceTransforms
+             .empty());
   }
 }
 
@@ -1833,18 +1906,13 @@ static void loadPrimitive(
       *pPositionAccessor);
 
   if (primitive.indices < 0 || primitive.indices >= model.accessors.size()) {
-    std::vector<uint32_t> syntheticIndexBuffer(positionView.size());
-    syntheticIndexBuffer.resize(positionView.size());
-    for (uint32_t i = 0; i < positionView.size(); ++i) {
-      syntheticIndexBuffer[i] = i;
-    }
     loadPrimitive(
         result,
         transform,
         options,
         *pPositionAccessor,
         positionView,
-        syntheticIndexBuffer,
+        SequentialIndices{positionView.size()},
         ellipsoid);
   } else {
     loadIndexedPrimitive(
@@ -1858,28 +1926,111 @@ static void loadPrimitive(
   result.PositionAccessor = std::move(positionView);
 }
 
-static void loadMesh(
-    std::optional<LoadMeshResult>& result,
-    const glm::dmat4x4& transform,
-    CreateMeshOptions& options,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+namespace {
+/**
+ * A glTF mesh instantiated by a node. The primitives of a model are only
+ * loaded once all of its nodes have been visited, so that they can be loaded
+ * in parallel.
+ */
+struct PendingMesh {
+  size_t nodeResultIndex;
+  const CesiumGltf::Node* pNode;
+  int32_t meshIndex;
+  glm::dmat4x4 transform;
+};
 
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadMesh)
+/**
+ * An instance of a glTF primitive, given by the index of the pending mesh it
+ * belongs to and its index within that mesh.
+ */
+struct PrimitiveInstance {
+  size_t pendingMeshIndex;
+  size_t primitiveIndex;
+};
+} // namespace
 
-  CesiumGltf::Model& model = *options.pNodeOptions->pModelOptions->pModel;
-  CesiumGltf::Mesh& mesh = model.meshes[options.meshIndex];
+/**
+ * Loads the primitives of all pending meshes of a model into their node
+ * results. Each glTF primitive is loaded by a separate task. The instances of
+ * a primitive that is used by several nodes are loaded one after another by
+ * the same task, though, because loading a primitive may modify it.
+ */
+static void loadMeshes(
+    LoadModelResult& result,
+    const CreateModelOptions& options,
+    const std::vector<PendingMesh>& pendingMeshes,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadMeshes)
+
+  const CesiumGltf::Model& model = *options.pModel;
+
+  // The primitive options point to these, so they must not be moved before
+  // all primitives are loaded.
+  std::vector<CreateNodeOptions> nodeOptions;
+  std::vector<CreateMeshOptions> meshOptions;
+  nodeOptions.reserve(pendingMeshes.size());
+  meshOptions.reserve(pendingMeshes.size());
+
+  std::vector<std::vector<PrimitiveInstance>> tasks;
+  std::map<std::pair<int32_t, size_t>, size_t> taskIndices;
+
+  for (size_t i = 0; i < pendingMeshes.size(); ++i) {
+    const PendingMesh& pendingMesh = pendingMeshes[i];
+    LoadNodeResult& nodeResult =
+        result.nodeResults[pendingMesh.nodeResultIndex];
+    const CreateNodeOptions& nodeOption = nodeOptions.emplace_back(
+        CreateNodeOptions{&options, &result, pendingMesh.pNode});
+    meshOptions.push_back({&nodeOption, &nodeResult, pendingMesh.meshIndex});
+
+    const CesiumGltf::Mesh& mesh = model.meshes[pendingMesh.meshIndex];
+    nodeResult.meshResult = LoadMeshResult();
+    nodeResult.meshResult->primitiveResults.resize(mesh.primitives.size());
+
+    for (size_t j = 0; j < mesh.primitives.size(); ++j) {
+      auto [taskIt, added] =
+          taskIndices.try_emplace({pendingMesh.meshIndex, j}, tasks.size());
+      if (added) {
+        tasks.emplace_back();
+      }
+      tasks[taskIt->second].push_back({i, j});
+    }
+  }
 
-  result = LoadMeshResult();
-  result->primitiveResults.reserve(mesh.primitives.size());
-  for (size_t i = 0; i < mesh.primitives.size(); i++) {
-    CreatePrimitiveOptions primitiveOptions = {&options, &*result, i};
-    auto& primitiveResult = result->primitiveResults.emplace_back();
-    loadPrimitive(primitiveResult, transform, primitiveOptions, ellipsoid);
+  // Primitives vary widely in size, so the tasks are unbalanced.
+  ParallelFor(
+      int32(tasks.size()),
+      [&](int32 taskIndex) {
+        for (const PrimitiveInstance& instance : tasks[taskIndex]) {
+          const PendingMesh& pendingMesh =
+              pendingMeshes[instance.pendingMeshIndex];
+          LoadMeshResult& meshResult =
+              *result.nodeResults[pendingMesh.nodeResultIndex].meshResult;
+          CreatePrimitiveOptions primitiveOptions = {
+              &meshOptions[instance.pendingMeshIndex],
+              &meshResult,
+              int32_t(instance.primitiveIndex)};
+          loadPrimitive(
+              meshResult.primitiveResults[instance.primitiveIndex],
+              pendingMesh.transform,
+              primitiveOptions,
+              ellipsoid);
+        }
+      },
+      EParallelForFlags::BackgroundPriority | EParallelForFlags::Unbalanced);
 
+  for (const PendingMesh& pendingMesh : pendingMeshes) {
     // if it doesn't have render data, then it can't be loaded
-    if (!primitiveResult.RenderData) {
-      result->primitiveResults.pop_back();
-    }
+    std::vector<LoadPrimitiveResult>& primitiveResults =
+        result.nodeResults[pendingMesh.nodeResultIndex]
+            .meshResult->primitiveResults;
+    primitiveResults.erase(
+        std::remove_if(
+            primitiveResults.begin(),
+            primitiveResults.end(),
+            [](const LoadPrimitiveResult& primitiveResult) {
+              return !primitiveResult.RenderData;
+            }),
+        primitiveResults.end());
   }
 }
 
@@ -2032,9 +2183,9 @@ static void loadInstancingData(
 
 static void loadNode(
     std::vector<LoadNodeResult>& loadNodeResults,
+    std::vector<PendingMesh>& pendingMeshes,
     const glm::dmat4x4& transform,
-    CreateNodeOptions& options,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+    CreateNodeOptions& options) {
 
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadNode)
 
@@ -2059,6 +2210,7 @@ static void loadNode(
   CesiumGltf::Model& model = *options.pModelOptions->pModel;
   const CesiumGltf::Node& node = *options.pNode;
 
+  const size_t resultIndex = loadNodeResults.size();
   LoadNodeResult& result = loadNodeResults.emplace_back();
 
   glm::dmat4x4 nodeTransform = transform;
@@ -2113,8 +2265,7 @@ static void loadNode(
             node.getExtension<CesiumGltf::ExtensionExtMeshGpuInstancing>()) {
       loadInstancingData(model, result, pGpuInstancingExtension);
     }
-    CreateMeshOptions meshOptions = {&options, &result, meshId};
-    loadMesh(result.meshResult, nodeTransform, meshOptions, ellipsoid);
+    pendingMeshes.push_back({resultIndex, &node, meshId, nodeTransform});
   }
 
   for (int childNodeId : node.children) {
@@ -2123,7 +2274,7 @@ static void loadNode(
           options.pModelOptions,
           options.pHalfConstructedModelResult,
           &model.nodes[childNodeId]};
-      loadNode(loadNodeResults, nodeTransform, childNodeOptions, ellipsoid);
+      loadNode(loadNodeResults, pendingMeshes, nodeTransform, childNodeOptions);
     }
   }
 }
@@ -2268,103 +2419,473 @@ loadModelMetadata(LoadModelResult& result, const CreateModelOptions& options) {
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
 }
 
-static CesiumAsync::Future<UCesiumGltfComponent::CreateOffGameThreadResult>
-loadModelAnyThreadPart(
-    const CesiumAsync::AsyncSystem& asyncSystem,
-    const glm::dmat4x4& transform,
-    CreateModelOptions&& options,
-    const CesiumGeospatial::Ellipsoid& ellipsoid) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadModelAnyThreadPart)
+namespace {
+/**
+ * Copies the indices of an index buffer. Unlike
+ * FRawStaticIndexBuffer::GetCopy, this keeps the memory already allocated by
+ * the array if it is large enough.
+ */
+void copyIndices(
+    const FRawStaticIndexBuffer& indexBuffer,
+    TArray<uint32>& out) {
+  const FIndexArrayView view = indexBuffer.GetArrayView();
+  out.SetNumUninitialized(view.Num());
+  for (int32 i = 0; i < view.Num(); ++i) {
+    out[i] = view[i];
+  }
+}
 
-  return CesiumGltfTextures::createInWorkerThread(asyncSystem, *options.pModel)
-      .thenInWorkerThread(
-          [transform, ellipsoid, options = std::move(options)]() mutable
-          -> UCesiumGltfComponent::CreateOffGameThreadResult {
-            auto pHalf = MakeUnique<HalfConstructedReal>();
+bool isMergeable(
+    const CesiumGltf::Model& model,
+    const LoadNodeResult& nodeResult,
+    const LoadPrimitiveResult& primitiveResult) {
+  if (!nodeResult.InstanceTransforms.empty() || !primitiveResult.RenderData) {
+    return false;
+  }
 
-            loadModelMetadata(pHalf->loadModelResult, options);
+  const CesiumGltf::MeshPrimitive& primitive =
+      model.meshes[primitiveResult.meshIndex]
+          .primitives[primitiveResult.primitiveIndex];
+  return primitive.mode != CesiumGltf::MeshPrimitive::Mode::POINTS;
+}
 
-            glm::dmat4x4 rootTransform = transform;
+/**
+ * Determines whether two primitives can be drawn by sections of the same mesh.
+ * The sections of a mesh share its transform and component settings, and the
+ * raster overlays of a component are applied with a single set of texture
+ * coordinates.
+ */
+bool canMerge(const LoadPrimitiveResult& a, const LoadPrimitiveResult& b) {
+  return a.transform == b.transform && a.isUnlit == b.isUnlit &&
+         a.overlayTextureCoordinateIDToUVIndex ==
+             b.overlayTextureCoordinateIDToUVIndex;
+}
 
-            CesiumGltf::Model& model = *options.pModel;
+/**
+ * Determines whether the material of a primitive has parameters that depend
+ * on the primitive itself rather than only on its glTF material.
+ */
+bool hasPrimitiveSpecificMaterial(const LoadPrimitiveResult& primitiveResult) {
+  PRAGMA_DISABLE_DEPRECATION_WARNINGS
+  return primitiveResult.waterMaskTexture || !primitiveResult.onlyLand ||
+         !primitiveResult.EncodedFeatures.featureIdSets.IsEmpty() ||
+         !primitiveResult.EncodedMetadata.propertyTextureIndices.IsEmpty() ||
+         primitiveResult.EncodedMetadata_DEPRECATED.has_value();
+  PRAGMA_ENABLE_DEPRECATION_WARNINGS
+}
 
-            {
-              rootTransform = CesiumGltfContent::GltfUtilities::applyRtcCenter(
-                  model,
-                  rootTransform);
-              applyGltfUpAxisTransform(model, rootTransform);
-            }
+bool canShareMaterial(
+    const LoadPrimitiveResult& a,
+    const LoadPrimitiveResult& b) {
+  return a.materialIndex == b.materialIndex &&
+         a.textureCoordinateParameters == b.textureCoordinateParameters &&
+         a.FeaturesMetadataTexCoordParameters.OrderIndependentCompareEqual(
+             b.FeaturesMetadataTexCoordParameters) &&
+         !hasPrimitiveSpecificMaterial(a) && !hasPrimitiveSpecificMaterial(b);
+}
 
-            if (model.scene >= 0 && model.scene < model.scenes.size()) {
-              // Show the default scene
-              const CesiumGltf::Scene& defaultScene = model.scenes[model.scene];
-              for (int nodeId : defaultScene.nodes) {
-                CreateNodeOptions nodeOptions = {
-                    &options,
-                    &pHalf->loadModelResult,
-                    &model.nodes[nodeId]};
-                loadNode(
-                    pHalf->loadModelResult.nodeResults,
-                    rootTransform,
-                    nodeOptions,
-                    ellipsoid);
-              }
-            } else if (model.scenes.size() > 0) {
-              // There's no default, so show the first scene
-              const CesiumGltf::Scene& defaultScene = model.scenes[0];
-              for (int nodeId : defaultScene.nodes) {
-                CreateNodeOptions nodeOptions = {
-                    &options,
-                    &pHalf->loadModelResult,
-                    &model.nodes[nodeId]};
-                loadNode(
-                    pHalf->loadModelResult.nodeResults,
-                    rootTransform,
-                    nodeOptions,
-                    ellipsoid);
-              }
-            } else if (model.nodes.size() > 0) {
-              // No scenes at all, use the first node as the root node.
-              CreateNodeOptions nodeOptions = {
-                  &options,
-                  &pHalf->loadModelResult,
-                  &model.nodes[0]};
-              loadNode(
-                  pHalf->loadModelResult.nodeResults,
-                  rootTransform,
-                  nodeOptions,
-                  ellipsoid);
-            } else if (model.meshes.size() > 0) {
-              // No nodes either, show all the meshes.
-              for (size_t i = 0; i < model.meshes.size(); i++) {
-                CreateNodeOptions dummyNodeOptions = {
-                    &options,
-                    &pHalf->loadModelResult,
-                    nullptr};
-                LoadNodeResult& dummyNodeResult =
-                    pHalf->loadModelResult.nodeResults.emplace_back();
-                CreateMeshOptions meshOptions = {
-                    &dummyNodeOptions,
-                    &dummyNodeResult,
-                    i};
-                loadMesh(
-                    dummyNodeResult.meshResult,
-                    rootTransform,
-                    meshOptions,
-                    ellipsoid);
-              }
-            }
+/**
+ * Merges the render data of the given primitives into one mesh with a section
+ * per primitive. Texture coordinate sets are padded to the largest number used
+ * by any of the primitives, and vertex colors default to white for the
+ * primitives that have none.
+ */
+TUniquePtr<FStaticMeshRenderData> mergeRenderData(
+    const std::vector<LoadPrimitiveResult*>& primitives,
+    const std::vector<int32>& materialSlots) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MergeRenderData)
 
-            UCesiumGltfComponent::CreateOffGameThreadResult result;
-            result.HalfConstructed = std::move(pHalf);
-            result.TileLoadResult = std::move(options.tileLoadResult);
+  uint32 vertexCount = 0;
+  uint32 numberOfTextureCoordinates = 1;
+  bool hasVertexColors = false;
+  bool useFullPrecisionUVs = false;
+  for (const LoadPrimitiveResult* pPrimitive : primitives) {
+    const FStaticMeshLODResources& lod =
+        pPrimitive->RenderData->LODResources[0];
+    vertexCount += lod.VertexBuffers.PositionVertexBuffer.GetNumVertices();
+    numberOfTextureCoordinates = FMath::Max(
+        numberOfTextureCoordinates,
+        lod.VertexBuffers.StaticMeshVertexBuffer.GetNumTexCoords());
+    hasVertexColors |= lod.bHasColorVertexData;
+    useFullPrecisionUVs |=
+        lod.VertexBuffers.StaticMeshVertexBuffer.GetUseFullPrecisionUVs();
+  }
 
-            return result;
-          });
-}
+  TUniquePtr<FStaticMeshRenderData> RenderData =
+      MakeUnique<FStaticMeshRenderData>();
+  RenderData->AllocateLODResources(1);
+  FStaticMeshLODResources& LODResources = RenderData->LODResources[0];
 
-bool applyTexture(
-    CesiumGltf::Model& model,
+  CesiumScratchBuffers::TScratchArray<FVector3f> positionBuffer;
+  TArray<FVector3f>& positions = positionBuffer.get();
+  positions.Reserve(vertexCount);
+  CesiumScratchBuffers::TScratchArray<FColor> colorBuffer;
+  TArray<FColor>& colors = colorBuffer.get();
+  if (hasVertexColors) {
+    colors.Init(FColor::White, vertexCount);
+  }
+  CesiumScratchBuffers::TScratchArray<uint32> indexBuffer;
+  TArray<uint32>& indices = indexBuffer.get();
+  CesiumScratchBuffers::TScratchArray<uint32> sourceIndexBuffer;
+  TArray<uint32>& sourceIndices = sourceIndexBuffer.get();
+
+  FStaticMeshVertexBuffer& vertexBuffer =
+      LODResources.VertexBuffers.StaticMeshVertexBuffer;
+  vertexBuffer.SetUseFullPrecisionUVs(useFullPrecisionUVs);
+  vertexBuffer.Init(vertexCount, numberOfTextureCoordinates, false);
+
+  for (size_t i = 0; i < primitives.size(); ++i) {
+    const FStaticMeshLODResources& source =
+        primitives[i]->RenderData->LODResources[0];
+    const FStaticMeshVertexBuffer& sourceVertices =
+        source.VertexBuffers.StaticMeshVertexBuffer;
+    const uint32 sourceVertexCount =
+        source.VertexBuffers.PositionVertexBuffer.GetNumVertices();
+    const uint32 sourceTextureCoordinates = sourceVertices.GetNumTexCoords();
+    const uint32 firstVertex = uint32(positions.Num());
+
+    for (uint32 vertex = 0; vertex < sourceVertexCount; ++vertex) {
+      const uint32 target = firstVertex + vertex;
+      positions.Add(
+          source.VertexBuffers.PositionVertexBuffer.VertexPosition(vertex));
+      vertexBuffer.SetVertexTangents(
+          target,
+          FVector3f(sourceVertices.VertexTangentX(vertex)),
+          sourceVertices.VertexTangentY(vertex),
+          FVector3f(sourceVertices.VertexTangentZ(vertex)));
+      for (uint32 uvIndex = 0; uvIndex < numberOfTextureCoordinates;
+           ++uvIndex) {
+        vertexBuffer.SetVertexUV(
+            target,
+            uvIndex,
+            uvIndex < sourceTextureCoordinates
+                ? sourceVertices.GetVertexUV(vertex, uvIndex)
+                : FVector2f::ZeroVector,
+            false);
+      }
+      if (source.bHasColorVertexData) {
+        colors[target] =
+            source.VertexBuffers.ColorVertexBuffer.VertexColor(vertex);
+      }
+    }
+
+    copyIndices(source.IndexBuffer, sourceIndices);
+
+    FStaticMeshSection& section = LODResources.Sections.AddDefaulted_GetRef();
+    section.NumTriangles = sourceIndices.Num() / 3;
+    section.FirstIndex = indices.Num();
+    section.MinVertexIndex = firstVertex;
+    section.MaxVertexIndex = firstVertex + sourceVertexCount - 1;
+    section.bEnableCollision = true;
+    section.bCastShadow = true;
+    section.MaterialIndex = materialSlots[i];
+
+    for (uint32 index : sourceIndices) {
+      indices.Add(firstVertex + index);
+    }
+
+    if (i == 0) {
+      RenderData->Bounds = primitives[i]->RenderData->Bounds;
+    } else {
+      RenderData->Bounds =
+          RenderData->Bounds + primitives[i]->RenderData->Bounds;
+    }
+  }
+
+  LODResources.VertexBuffers.PositionVertexBuffer.Init(positions, false);
+  LODResources.bHasColorVertexData = hasVertexColors;
+  if (hasVertexColors) {
+    LODResources.VertexBuffers.ColorVertexBuffer.InitFromColorArray(colors);
+  }
+
+  LODResources.IndexBuffer.SetIndices(
+      indices,
+      vertexCount >= std::numeric_limits<uint16>::max()
+          ? EIndexBufferStride::Type::Force32Bit
+          : EIndexBufferStride::Type::Force16Bit);
+
+  LODResources.bHasDepthOnlyIndices = false;
+  LODResources.bHasReversedIndices = false;
+  LODResources.bHasReversedDepthOnlyIndices = false;
+
+  return RenderData;
+}
+
+/**
+ * Merges a group of compatible primitives into the first one, which afterward
+ * renders all of them with a section each.
+ */
+void mergePrimitiveGroup(std::vector<LoadPrimitiveResult*>& group) {
+  // Primitives share a material slot with the first earlier primitive they
+  // can share a material with.
+  std::vector<int32> materialSlots(group.size());
+  int32 slotCount = 0;
+  for (size_t i = 0; i < group.size(); ++i) {
+    materialSlots[i] = slotCount;
+    for (size_t j = 0; j < i; ++j) {
+      if (canShareMaterial(*group[j], *group[i])) {
+        materialSlots[i] = materialSlots[j];
+        break;
+      }
+    }
+    if (materialSlots[i] == slotCount) {
+      ++slotCount;
+    }
+  }
+
+  TUniquePtr<FStaticMeshRenderData> RenderData =
+      mergeRenderData(group, materialSlots);
+
+  LoadPrimitiveResult& merged = *group[0];
+  merged.RenderData = std::move(RenderData);
+  merged.mergedPrimitives.reserve(group.size() - 1);
+  for (size_t i = 1; i < group.size(); ++i) {
+    LoadPrimitiveResult& primitiveResult =
+        merged.mergedPrimitives.emplace_back(std::move(*group[i]));
+    primitiveResult.RenderData.Reset();
+  }
+}
+} // namespace
+
+/**
+ * Counts the vertices of the glTF primitives that were loaded and of the
+ * meshes created for them, and the vertex memory saved by the compact vertex
+ * format. This must be done before primitives are merged.
+ */
+static void
+countVertices(LoadModelResult& result, const CesiumGltf::Model& model) {
+  for (const LoadNodeResult& nodeResult : result.nodeResults) {
+    if (!nodeResult.meshResult) {
+      continue;
+    }
+
+    for (const LoadPrimitiveResult& primitiveResult :
+         nodeResult.meshResult->primitiveResults) {
+      const CesiumGltf::MeshPrimitive& primitive =
+          model.meshes[primitiveResult.meshIndex]
+              .primitives[primitiveResult.primitiveIndex];
+      const CesiumGltf::Accessor& positionAccessor =
+          model.accessors[primitive.attributes.at("POSITION")];
+      result.gltfVertexCount += uint64(positionAccessor.count);
+      result.vertexCount += primitiveResult.RenderData->LODResources[0]
+                                .VertexBuffers.PositionVertexBuffer
+                                .GetNumVertices();
+      result.compactVertexBytesSaved += primitiveResult.compactVertexBytesSaved;
+    }
+  }
+}
+
+/**
+ * Merges the compatible primitives of a model, so that each group of them is
+ * rendered by a single mesh with a section per primitive. Primitives that
+ * aren't merged keep their own mesh. This also creates the collision meshes
+ * that loadPrimitive skipped for primitives that could be merged.
+ */
+static void
+mergePrimitives(LoadModelResult& result, const CreateModelOptions& options) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::MergePrimitives)
+
+  const CesiumGltf::Model& model = *options.pModel;
+
+  // Take the mergeable primitives out of their nodes, remembering which node
+  // each came from.
+  std::vector<LoadPrimitiveResult> candidates;
+  std::vector<size_t> candidateNodes;
+  for (size_t nodeIndex = 0; nodeIndex < result.nodeResults.size();
+       ++nodeIndex) {
+    LoadNodeResult& nodeResult = result.nodeResults[nodeIndex];
+    if (!nodeResult.meshResult) {
+      continue;
+    }
+
+    std::vector<LoadPrimitiveResult>& primitiveResults =
+        nodeResult.meshResult->primitiveResults;
+    auto firstMergeable = std::stable_partition(
+        primitiveResults.begin(),
+        primitiveResults.end(),
+        [&model, &nodeResult](const LoadPrimitiveResult& primitiveResult) {
+          return !isMergeable(model, nodeResult, primitiveResult);
+        });
+    for (auto it = firstMergeable; it != primitiveResults.end(); ++it) {
+      candidates.emplace_back(std::move(*it));
+      candidateNodes.push_back(nodeIndex);
+    }
+    primitiveResults.erase(firstMergeable, primitiveResults.end());
+  }
+
+  std::vector<std::vector<LoadPrimitiveResult*>> groups;
+  std::vector<size_t> groupNodes;
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    auto groupIt = std::find_if(
+        groups.begin(),
+        groups.end(),
+        [&candidate = candidates[i]](
+            const std::vector<LoadPrimitiveResult*>& group) {
+          return canMerge(*group[0], candidate);
+        });
+    if (groupIt != groups.end()) {
+      groupIt->push_back(&candidates[i]);
+    } else {
+      groups.push_back({&candidates[i]});
+      groupNodes.push_back(candidateNodes[i]);
+    }
+  }
+
+  for (size_t i = 0; i < groups.size(); ++i) {
+    std::vector<LoadPrimitiveResult*>& group = groups[i];
+    if (group.size() > 1) {
+      mergePrimitiveGroup(group);
+    }
+
+    LoadPrimitiveResult& primitiveResult = *group[0];
+    if (options.createPhysicsMeshes) {
+      // Only primitives without instances are merged.
+      createCollisionMesh(primitiveResult, options, false);
+    }
+
+    result.nodeResults[groupNodes[i]].meshResult->primitiveResults.emplace_back(
+        std::move(primitiveResult));
+  }
+}
+
+/**
+ * Quantizes the positions of the primitives that are drawn by the tileset's
+ * scene proxy. Points and instanced primitives are drawn by scene proxies of
+ * their own, which need full-precision positions. This must be done after
+ * primitives are merged.
+ */
+static void
+quantizePositions(LoadModelResult& result, const CesiumGltf::Model& model) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::QuantizePositions)
+
+  for (LoadNodeResult& nodeResult : result.nodeResults) {
+    if (!nodeResult.meshResult || !nodeResult.InstanceTransforms.empty()) {
+      continue;
+    }
+
+    for (LoadPrimitiveResult& primitiveResult :
+         nodeResult.meshResult->primitiveResults) {
+      const CesiumGltf::MeshPrimitive& primitive =
+          model.meshes[primitiveResult.meshIndex]
+              .primitives[primitiveResult.primitiveIndex];
+      if (primitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS ||
+          !primitiveResult.RenderData) {
+        continue;
+      }
+
+      primitiveResult.pQuantizedPositions =
+          MakeUnique<FCesiumQuantizedPositions>(
+              primitiveResult.RenderData->LODResources[0]
+                  .VertexBuffers.PositionVertexBuffer);
+    }
+  }
+}
+
+static CesiumAsync::Future<UCesiumGltfComponent::CreateOffGameThreadResult>
+loadModelAnyThreadPart(
+    const CesiumAsync::AsyncSystem& asyncSystem,
+    const glm::dmat4x4& transform,
+    CreateModelOptions&& options,
+    const CesiumGeospatial::Ellipsoid& ellipsoid) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::loadModelAnyThreadPart)
+
+  return CesiumGltfTextures::createInWorkerThread(asyncSystem, *options.pModel)
+      .thenInWorkerThread(
+          [transform, ellipsoid, options = std::move(options)]() mutable
+          -> UCesiumGltfComponent::CreateOffGameThreadResult {
+            auto pHalf = MakeUnique<HalfConstructedReal>();
+
+            loadModelMetadata(pHalf->loadModelResult, options);
+
+            glm::dmat4x4 rootTransform = transform;
+
+            CesiumGltf::Model& model = *options.pModel;
+
+            {
+              rootTransform = CesiumGltfContent::GltfUtilities::applyRtcCenter(
+                  model,
+                  rootTransform);
+              applyGltfUpAxisTransform(model, rootTransform);
+            }
+
+            std::vector<LoadNodeResult>& nodeResults =
+                pHalf->loadModelResult.nodeResults;
+            std::vector<PendingMesh> pendingMeshes;
+
+            if (model.scene >= 0 && model.scene < model.scenes.size()) {
+              // Show the default scene
+              const CesiumGltf::Scene& defaultScene = model.scenes[model.scene];
+              for (int nodeId : defaultScene.nodes) {
+                CreateNodeOptions nodeOptions = {
+                    &options,
+                    &pHalf->loadModelResult,
+                    &model.nodes[nodeId]};
+                loadNode(
+                    nodeResults,
+                    pendingMeshes,
+                    rootTransform,
+                    nodeOptions);
+              }
+            } else if (model.scenes.size() > 0) {
+              // There's no default, so show the first scene
+              const CesiumGltf::Scene& defaultScene = model.scenes[0];
+              for (int nodeId : defaultScene.nodes) {
+                CreateNodeOptions nodeOptions = {
+                    &options,
+                    &pHalf->loadModelResult,
+                    &model.nodes[nodeId]};
+                loadNode(
+                    nodeResults,
+                    pendingMeshes,
+                    rootTransform,
+                    nodeOptions);
+              }
+            } else if (model.nodes.size() > 0) {
+              // No scenes at all, use the first node as the root node.
+              CreateNodeOptions nodeOptions = {
+                  &options,
+                  &pHalf->loadModelResult,
+                  &model.nodes[0]};
+              loadNode(nodeResults, pendingMeshes, rootTransform, nodeOptions);
+            } else if (model.meshes.size() > 0) {
+              // No nodes either, show all the meshes.
+              for (size_t i = 0; i < model.meshes.size(); i++) {
+                pendingMeshes.push_back(
+                    {nodeResults.size(), nullptr, int32_t(i), rootTransform});
+                nodeResults.emplace_back();
+              }
+            }
+
+            loadMeshes(
+                pHalf->loadModelResult,
+                options,
+                pendingMeshes,
+                ellipsoid);
+
+            countVertices(pHalf->loadModelResult, model);
+
+            if (options.mergePrimitives) {
+              mergePrimitives(pHalf->loadModelResult, options);
+            }
+
+            if (options.quantizePositions) {
+              quantizePositions(pHalf->loadModelResult, model);
+            }
+
+            // Primitives may have been loaded by other worker threads, whose
+            // pools are trimmed when they finish a tile of their own.
+            CesiumScratchBuffers::endTile();
+
+            UCesiumGltfComponent::CreateOffGameThreadResult result;
+            result.HalfConstructed = std::move(pHalf);
+            result.TileLoadResult = std::move(options.tileLoadResult);
+
+            return result;
+          });
+}
+
+bool applyTexture(
+    CesiumGltf::Model& model,
     UMaterialInstanceDynamic* pMaterial,
     const FMaterialParameterInfo& info,
     CesiumTextureUtility::LoadedTextureResult* pLoadedTexture) {
@@ -2865,95 +3386,32 @@ static void SetMetadataParameterValues_DEPRECATED(
 PRAGMA_ENABLE_DEPRECATION_WARNINGS
 #pragma endregion
 
-static void loadPrimitiveGameThreadPart(
+static void setPrimitiveData(
+    CesiumPrimitiveData& primData,
     CesiumGltf::Model& model,
-    UCesiumGltfComponent* pGltf,
     LoadPrimitiveResult& loadResult,
-    const glm::dmat4x4& cesiumToUnrealTransform,
-    const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision,
     ACesium3DTileset* pTilesetActor,
-    const std::vector<FTransform>& instanceTransforms) {
-  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
-
-#if DEBUG_GLTF_ASSET_NAMES
-  FName componentName = createSafeName(loadResult.name, "");
-#else
-  FName componentName = "";
-#endif
-
-  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
-      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
-
-  CesiumGltf::MeshPrimitive& meshPrimitive =
-      model.meshes[loadResult.meshIndex].primitives[loadResult.primitiveIndex];
-
-  UStaticMeshComponent* pMesh = nullptr;
-  ICesiumPrimitive* pCesiumPrimitive = nullptr;
-  if (meshPrimitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
-    UCesiumGltfPointsComponent* pPointMesh =
-        NewObject<UCesiumGltfPointsComponent>(pGltf, componentName);
-    pPointMesh->UsesAdditiveRefinement =
-        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
-    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
-    pPointMesh->Dimensions = loadResult.dimensions;
-    pMesh = pPointMesh;
-    pCesiumPrimitive = pPointMesh;
-  } else if (!instanceTransforms.empty()) {
-    auto* pInstancedComponent =
-        NewObject<UCesiumGltfInstancedComponent>(pGltf, componentName);
-    pMesh = pInstancedComponent;
-    for (const FTransform& transform : instanceTransforms) {
-      pInstancedComponent->AddInstance(transform, false);
-    }
-    pCesiumPrimitive = pInstancedComponent;
-  } else {
-    auto* pComponent =
-        NewObject<UCesiumGltfPrimitiveComponent>(pGltf, componentName);
-    pMesh = pComponent;
-    pCesiumPrimitive = pComponent;
-  }
-  CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
-
-  UStaticMesh* pStaticMesh;
-  {
-    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMesh)
-    primData.pTilesetActor = pTilesetActor;
-    primData.overlayTextureCoordinateIDToUVIndex =
-        loadResult.overlayTextureCoordinateIDToUVIndex;
-    primData.GltfToUnrealTexCoordMap =
-        std::move(loadResult.GltfToUnrealTexCoordMap);
-    primData.TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
-    primData.PositionAccessor = std::move(loadResult.PositionAccessor);
-    primData.IndexAccessor = std::move(loadResult.IndexAccessor);
-    primData.HighPrecisionNodeTransform = loadResult.transform;
-    pCesiumPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
-    pMesh->bUseDefaultCollision = false;
-    pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
-    pMesh->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    primData.pModel = &model;
-    primData.pMeshPrimitive = &meshPrimitive;
-    primData.boundingVolume = boundingVolume;
-    pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
-    pMesh->SetCustomDepthStencilWriteMask(
-        pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
-    pMesh->SetCustomDepthStencilValue(
-        pGltf->CustomDepthParameters.CustomDepthStencilValue);
-    if (loadResult.isUnlit) {
-      pMesh->bCastDynamicShadow = false;
-    }
-
-    pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
-    pMesh->SetStaticMesh(pStaticMesh);
-
-    pStaticMesh->SetFlags(
-        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
-    pStaticMesh->NeverStream = true;
-
-    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
-  }
+    const Cesium3DTilesSelection::BoundingVolume& boundingVolume) {
+  primData.pTilesetActor = pTilesetActor;
+  primData.overlayTextureCoordinateIDToUVIndex =
+      loadResult.overlayTextureCoordinateIDToUVIndex;
+  primData.GltfToUnrealTexCoordMap =
+      std::move(loadResult.GltfToUnrealTexCoordMap);
+  primData.TexCoordAccessorMap = std::move(loadResult.TexCoordAccessorMap);
+  primData.PositionAccessor = std::move(loadResult.PositionAccessor);
+  primData.IndexAccessor = std::move(loadResult.IndexAccessor);
+  primData.HighPrecisionNodeTransform = loadResult.transform;
+  primData.pModel = &model;
+  primData.pMeshPrimitive =
+      &model.meshes[loadResult.meshIndex].primitives[loadResult.primitiveIndex];
+  primData.boundingVolume = boundingVolume;
+}
 
+static UMaterialInstanceDynamic* createPrimitiveMaterial(
+    CesiumGltf::Model& model,
+    UCesiumGltfComponent* pGltf,
+    LoadPrimitiveResult& loadResult,
+    UCesiumPrimitivePool* pPool) {
   const CesiumGltf::Material& material =
       loadResult.materialIndex != -1 ? model.materials[loadResult.materialIndex]
                                      : defaultMaterial;
@@ -2993,10 +3451,11 @@ static void loadPrimitiveGameThreadPart(
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMaterial)
 
-    pMaterial = UMaterialInstanceDynamic::Create(
-        pBaseMaterial,
-        nullptr,
-        ImportedSlotName);
+    pMaterial = pPool ? pPool->AcquireMaterial(pBaseMaterial, ImportedSlotName)
+                      : UMaterialInstanceDynamic::Create(
+                            pBaseMaterial,
+                            nullptr,
+                            ImportedSlotName);
 
     pMaterial->SetFlags(
         RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
@@ -3109,6 +3568,15 @@ static void loadPrimitiveGameThreadPart(
     }
   }
 
+  pMaterial->TwoSided = true;
+
+  return pMaterial;
+}
+
+static void setPrimitiveFeaturesMetadata(
+    CesiumPrimitiveData& primData,
+    const UCesiumGltfComponent& gltf,
+    LoadPrimitiveResult& loadResult) {
   primData.Features = std::move(loadResult.Features);
   primData.Metadata = std::move(loadResult.Metadata);
 
@@ -3123,7 +3591,7 @@ static void loadPrimitiveGameThreadPart(
   primData.Metadata_DEPRECATED = FCesiumMetadataPrimitive{
       primData.Features,
       primData.Metadata,
-      pGltf->Metadata};
+      gltf.Metadata};
 
   if (loadResult.EncodedMetadata_DEPRECATED) {
     primData.EncodedMetadata_DEPRECATED =
@@ -3131,11 +3599,159 @@ static void loadPrimitiveGameThreadPart(
   }
 
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
+}
 
-  pMaterial->TwoSided = true;
+/**
+ * Sets up the data and materials of the primitives that were merged into the
+ * mesh of a primitive component, which are drawn by the sections after the
+ * first.
+ */
+static void loadMergedPrimitivesGameThreadPart(
+    CesiumGltf::Model& model,
+    UCesiumGltfComponent* pGltf,
+    UCesiumGltfPrimitiveComponent* pComponent,
+    UStaticMesh* pStaticMesh,
+    LoadPrimitiveResult& loadResult,
+    ACesium3DTileset* pTilesetActor,
+    const Cesium3DTilesSelection::BoundingVolume& boundingVolume) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadMergedPrimitives)
+
+  UCesiumPrimitivePool* pPool = pTilesetActor->GetPrimitivePool();
+  const FStaticMeshSectionArray& sections =
+      pStaticMesh->GetRenderData()->LODResources[0].Sections;
+
+  for (size_t i = 0; i < loadResult.mergedPrimitives.size(); ++i) {
+    LoadPrimitiveResult& mergedResult = loadResult.mergedPrimitives[i];
+    const FStaticMeshSection& section = sections[int32(i) + 1];
+
+    // Material slots are numbered in the order of the first section that uses
+    // each of them, so a new slot is always the next one.
+    if (section.MaterialIndex == pStaticMesh->GetStaticMaterials().Num()) {
+      pStaticMesh->AddMaterial(
+          createPrimitiveMaterial(model, pGltf, mergedResult, pPool));
+    }
+
+    CesiumPrimitiveData& primData =
+        pComponent->addMergedPrimitive(section.FirstIndex / 3);
+    setPrimitiveData(
+        primData,
+        model,
+        mergedResult,
+        pTilesetActor,
+        boundingVolume);
+    setPrimitiveFeaturesMetadata(primData, *pGltf, mergedResult);
+  }
+}
+
+static void loadPrimitiveGameThreadPart(
+    CesiumGltf::Model& model,
+    UCesiumGltfComponent* pGltf,
+    LoadPrimitiveResult& loadResult,
+    const glm::dmat4x4& cesiumToUnrealTransform,
+    const Cesium3DTilesSelection::Tile& tile,
+    bool createNavCollision,
+    ACesium3DTileset* pTilesetActor,
+    const std::vector<FTransform>& instanceTransforms) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadPrimitive)
+
+#if DEBUG_GLTF_ASSET_NAMES
+  FName componentName = createSafeName(loadResult.name, "");
+#else
+  FName componentName = "";
+#endif
+
+  const Cesium3DTilesSelection::BoundingVolume& boundingVolume =
+      tile.getContentBoundingVolume().value_or(tile.getBoundingVolume());
+
+  CesiumGltf::MeshPrimitive& meshPrimitive =
+      model.meshes[loadResult.meshIndex].primitives[loadResult.primitiveIndex];
+
+  UCesiumPrimitivePool* pPool = pTilesetActor->GetPrimitivePool();
+
+  UStaticMeshComponent* pMesh = nullptr;
+  ICesiumPrimitive* pCesiumPrimitive = nullptr;
+  if (meshPrimitive.mode == CesiumGltf::MeshPrimitive::Mode::POINTS) {
+    UCesiumGltfPointsComponent* pPointMesh =
+        NewObject<UCesiumGltfPointsComponent>(pGltf, componentName);
+    pPointMesh->UsesAdditiveRefinement =
+        tile.getRefine() == Cesium3DTilesSelection::TileRefine::Add;
+    pPointMesh->GeometricError = static_cast<float>(tile.getGeometricError());
+    pPointMesh->Dimensions = loadResult.dimensions;
+    pMesh = pPointMesh;
+    pCesiumPrimitive = pPointMesh;
+  } else if (!instanceTransforms.empty()) {
+    auto* pInstancedComponent =
+        NewObject<UCesiumGltfInstancedComponent>(pGltf, componentName);
+    pMesh = pInstancedComponent;
+    for (const FTransform& transform : instanceTransforms) {
+      pInstancedComponent->AddInstance(transform, false);
+    }
+    pCesiumPrimitive = pInstancedComponent;
+  } else {
+    auto* pComponent =
+        pPool ? pPool->AcquirePrimitiveComponent(pGltf, componentName)
+              : NewObject<UCesiumGltfPrimitiveComponent>(pGltf, componentName);
+    pComponent->setTilesetPrimitiveComponent(
+        pTilesetActor->GetTilesetPrimitiveComponent());
+    pMesh = pComponent;
+    pCesiumPrimitive = pComponent;
+  }
+  CesiumPrimitiveData& primData = pCesiumPrimitive->getPrimitiveData();
+
+  UStaticMesh* pStaticMesh;
+  {
+    TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SetupMesh)
+    setPrimitiveData(
+        primData,
+        model,
+        loadResult,
+        pTilesetActor,
+        boundingVolume);
+    pCesiumPrimitive->UpdateTransformFromCesium(cesiumToUnrealTransform);
+    pMesh->bUseDefaultCollision = false;
+    pMesh->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic);
+    pMesh->SetFlags(
+        RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+    pMesh->SetRenderCustomDepth(pGltf->CustomDepthParameters.RenderCustomDepth);
+    pMesh->SetCustomDepthStencilWriteMask(
+        pGltf->CustomDepthParameters.CustomDepthStencilWriteMask);
+    pMesh->SetCustomDepthStencilValue(
+        pGltf->CustomDepthParameters.CustomDepthStencilValue);
+    if (loadResult.isUnlit) {
+      pMesh->bCastDynamicShadow = false;
+    }
+
+    // A component from the pool already has a static mesh to reuse.
+    pStaticMesh = pMesh->GetStaticMesh();
+    if (!pStaticMesh) {
+      pStaticMesh = NewObject<UStaticMesh>(pMesh, componentName);
+      pMesh->SetStaticMesh(pStaticMesh);
+
+      pStaticMesh->SetFlags(
+          RF_Transient | RF_DuplicateTransient | RF_TextExportTransient);
+      pStaticMesh->NeverStream = true;
+    }
+
+    pStaticMesh->SetRenderData(std::move(loadResult.RenderData));
+  }
+
+  UMaterialInstanceDynamic* pMaterial =
+      createPrimitiveMaterial(model, pGltf, loadResult, pPool);
+  setPrimitiveFeaturesMetadata(primData, *pGltf, loadResult);
 
   pStaticMesh->AddMaterial(pMaterial);
 
+  if (!loadResult.mergedPrimitives.empty()) {
+    loadMergedPrimitivesGameThreadPart(
+        model,
+        pGltf,
+        Cast<UCesiumGltfPrimitiveComponent>(pMesh),
+        pStaticMesh,
+        loadResult,
+        pTilesetActor,
+        boundingVolume);
+  }
+
   pStaticMesh->SetLightingGuid();
 
   {
@@ -3143,6 +3759,17 @@ static void loadPrimitiveGameThreadPart(
     pStaticMesh->InitResources();
   }
 
+  if (loadResult.pQuantizedPositions) {
+    // Only plain primitive components are drawn by the tileset's scene proxy,
+    // which is the only one that can draw quantized positions.
+    UCesiumGltfPrimitiveComponent* pPrimitiveComponent =
+        Cast<UCesiumGltfPrimitiveComponent>(pMesh);
+    if (pPrimitiveComponent) {
+      pPrimitiveComponent->setQuantizedPositions(
+          MoveTemp(loadResult.pQuantizedPositions));
+    }
+  }
+
   // Set up RenderData bounds and LOD data
   pStaticMesh->CalculateExtendedBounds();
   pStaticMesh->GetRenderData()->ScreenSize[0].Default = 1.0f;
@@ -3150,6 +3777,9 @@ static void loadPrimitiveGameThreadPart(
   {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::BodySetup)
 
+    // The collision mesh was already cooked in the worker thread, so all that
+    // is left to do here is to attach it. A static mesh from the pool keeps
+    // its emptied body setup, in which case this creates nothing.
     pStaticMesh->CreateBodySetup();
 
     UBodySetup* pBodySetup = pMesh->GetBodySetup();
@@ -3174,11 +3804,43 @@ static void loadPrimitiveGameThreadPart(
         UPhysicsSettings::Get()->bSupportUVFromHitResults;
   }
 
+  if (loadResult.pCollisionMeshSource) {
+    // Only primitives without instances have their collision meshes cooked on
+    // demand.
+    UCesiumGltfPrimitiveComponent* pPrimitiveComponent =
+        Cast<UCesiumGltfPrimitiveComponent>(pMesh);
+    if (pPrimitiveComponent) {
+      pPrimitiveComponent->setCollisionMeshSource(
+          MoveTemp(loadResult.pCollisionMeshSource));
+    }
+  }
+
   if (createNavCollision) {
     TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CreateNavCollision)
-    pStaticMesh->CreateNavCollision(true);
+
+    // Tiles use their complex collision as simple collision, so the
+    // navigation system exports the triangles of the collision mesh that was
+    // cooked in the worker thread. The navigation collision only provides the
+    // navigation area. UStaticMesh::CreateNavCollision would also gather
+    // convex elements from the body setup, which tiles don't have, through
+    // the derived data cache in the editor. A static mesh from the pool keeps
+    // its navigation collision, in which case this creates nothing.
+    if (!pStaticMesh->GetNavCollision()) {
+      pStaticMesh->SetNavCollision(
+          UNavCollisionBase::ConstructNew(*pStaticMesh));
+    }
+  } else if (pStaticMesh->GetNavCollision()) {
+    // Left over from the previous use of a static mesh from the pool.
+    UNavCollisionBase* pNavCollision = pStaticMesh->GetNavCollision();
+    pStaticMesh->SetNavCollision(nullptr);
+    CesiumLifetime::destroy(pNavCollision);
   }
 
+  // Tiles of a tileset that is kept out of navigation aren't even gathered
+  // when the navigation mesh is built.
+  pMesh->SetCanEverAffectNavigation(
+      pTilesetActor->GetCanEverAffectNavigation());
+
   pMesh->SetMobility(pGltf->Mobility);
 
   pMesh->SetupAttachment(pGltf);
@@ -3212,7 +3874,8 @@ UCesiumGltfComponent::CreateOffGameThread(
     UMaterialInterface* pBaseWaterMaterial,
     FCustomDepthParameters CustomDepthParameters,
     const Cesium3DTilesSelection::Tile& tile,
-    bool createNavCollision) {
+    bool createNavCollision,
+    double timeLimitMilliseconds) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::LoadModel)
 
   HalfConstructedReal* pReal =
@@ -3232,6 +3895,10 @@ UCesiumGltfComponent::CreateOffGameThread(
   Gltf->EncodedMetadata = std::move(pReal->loadModelResult.EncodedMetadata);
   Gltf->EncodedMetadata_DEPRECATED =
       std::move(pReal->loadModelResult.EncodedMetadata_DEPRECATED);
+  Gltf->GltfVertexCount = pReal->loadModelResult.gltfVertexCount;
+  Gltf->VertexCount = pReal->loadModelResult.vertexCount;
+  Gltf->CompactVertexBytesSaved =
+      pReal->loadModelResult.compactVertexBytesSaved;
 
   if (pBaseMaterial) {
     Gltf->BaseMaterial = pBaseMaterial;
@@ -3253,27 +3920,120 @@ UCesiumGltfComponent::CreateOffGameThread(
     encodeMetadataGameThreadPart(*Gltf->EncodedMetadata_DEPRECATED);
   }
 
-  for (LoadNodeResult& node : pReal->loadModelResult.nodeResults) {
-    if (node.meshResult) {
-      for (LoadPrimitiveResult& primitive : node.meshResult->primitiveResults) {
-        loadPrimitiveGameThreadPart(
-            model,
-            Gltf,
-            primitive,
-            cesiumToUnrealTransform,
-            tile,
-            createNavCollision,
-            pTilesetActor,
-            node.InstanceTransforms);
+  if (timeLimitMilliseconds <= 0.0) {
+    for (LoadNodeResult& node : pReal->loadModelResult.nodeResults) {
+      if (node.meshResult) {
+        for (LoadPrimitiveResult& primitive :
+             node.meshResult->primitiveResults) {
+          loadPrimitiveGameThreadPart(
+              model,
+              Gltf,
+              primitive,
+              cesiumToUnrealTransform,
+              tile,
+              createNavCollision,
+              pTilesetActor,
+              node.InstanceTransforms);
+        }
       }
     }
+
+    Gltf->SetVisibility(false, true);
+    Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    return Gltf;
   }
 
-  Gltf->SetVisibility(false, true);
-  Gltf->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+  // Create the primitives incrementally. Whatever doesn't fit in the time
+  // limit is created by later calls to ContinueCreateOnGameThread.
+  Gltf->_pPendingCreation = MakeUnique<PendingCreation>();
+  Gltf->_pPendingCreation->pHalfConstructed = std::move(pHalfConstructed);
+  Gltf->_pPendingCreation->pModel = &model;
+  Gltf->_pPendingCreation->pTilesetActor = pTilesetActor;
+  Gltf->_pPendingCreation->pTile = &tile;
+  Gltf->_pPendingCreation->createNavCollision = createNavCollision;
+
+  Gltf->createPendingPrimitives(timeLimitMilliseconds);
   return Gltf;
 }
 
+bool UCesiumGltfComponent::ContinueCreateOnGameThread(
+    double timeLimitMilliseconds) {
+  if (!this->_pPendingCreation) {
+    return true;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ContinueLoadModel)
+  return this->createPendingPrimitives(timeLimitMilliseconds);
+}
+
+bool UCesiumGltfComponent::createPendingPrimitives(
+    double timeLimitMilliseconds) {
+  PendingCreation& pending = *this->_pPendingCreation;
+  HalfConstructedReal* pReal =
+      static_cast<HalfConstructedReal*>(pending.pHalfConstructed.Get());
+  std::vector<LoadNodeResult>& nodes = pReal->loadModelResult.nodeResults;
+
+  // The tileset may have moved since creation started, so always use its
+  // current transform.
+  const glm::dmat4 cesiumToUnrealTransform =
+      pending.pTilesetActor->GetCesiumTilesetToUnrealRelativeWorldTransform();
+
+  const double start = FPlatformTime::Seconds();
+  size_t created = 0;
+
+  // Always create at least one primitive so that creation makes progress even
+  // with a tiny time limit.
+  while (pending.nodeIndex < nodes.size()) {
+    LoadNodeResult& node = nodes[pending.nodeIndex];
+    if (!node.meshResult ||
+        pending.primitiveIndex >= node.meshResult->primitiveResults.size()) {
+      ++pending.nodeIndex;
+      pending.primitiveIndex = 0;
+      continue;
+    }
+
+    if (timeLimitMilliseconds > 0.0 && created > 0 &&
+        (FPlatformTime::Seconds() - start) * 1000.0 >= timeLimitMilliseconds) {
+      break;
+    }
+
+    loadPrimitiveGameThreadPart(
+        *pending.pModel,
+        this,
+        node.meshResult->primitiveResults[pending.primitiveIndex],
+        cesiumToUnrealTransform,
+        *pending.pTile,
+        pending.createNavCollision,
+        pending.pTilesetActor,
+        node.InstanceTransforms);
+    ++pending.primitiveIndex;
+    ++created;
+  }
+
+  // New primitives are registered visible, so hide them again right away.
+  // The tile is shown as a whole once it is complete.
+  this->SetVisibility(false, true);
+  this->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+  if (pending.nodeIndex < nodes.size()) {
+    return false;
+  }
+
+  // All primitives exist now, so apply the raster tiles that were attached in
+  // the meantime.
+  TUniquePtr<PendingCreation> pFinished = std::move(this->_pPendingCreation);
+  for (const PendingRasterTile& rasterTile : pFinished->rasterTiles) {
+    this->applyRasterTile(
+        *rasterTile.pRasterTile,
+        rasterTile.pTexture,
+        rasterTile.translation,
+        rasterTile.scale,
+        rasterTile.textureCoordinateID);
+  }
+
+  return true;
+}
+
 UCesiumGltfComponent::UCesiumGltfComponent() : USceneComponent() {
   // Structure to hold one-time initialization
   struct FConstructorStatics {
@@ -3319,9 +4079,14 @@ void forEachPrimitiveComponent(UCesiumGltfComponent* pGltf, Func&& f) {
   for (USceneComponent* pSceneComponent : pGltf->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pSceneComponent);
-    if (pPrimitive) {
+    if (!pPrimitive) {
+      continue;
+    }
+
+    // A mesh with merged primitives has a material for each of them.
+    for (int32 i = 0; i < pPrimitive->GetNumMaterials(); ++i) {
       UMaterialInstanceDynamic* pMaterial =
-          Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(0));
+          Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterial(i));
 
       if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
         // Don't try to update the material while it's in the process of
@@ -3354,6 +4119,31 @@ void UCesiumGltfComponent::AttachRasterTile(
     const glm::dvec2& translation,
     const glm::dvec2& scale,
     int32 textureCoordinateID) {
+  if (this->_pPendingCreation) {
+    // Not all primitives exist yet, so apply the raster tile once they do.
+    this->_pPendingCreation->rasterTiles.push_back(PendingRasterTile{
+        &rasterTile,
+        pTexture,
+        translation,
+        scale,
+        textureCoordinateID});
+    return;
+  }
+
+  this->applyRasterTile(
+      rasterTile,
+      pTexture,
+      translation,
+      scale,
+      textureCoordinateID);
+}
+
+void UCesiumGltfComponent::applyRasterTile(
+    const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+    UTexture2D* pTexture,
+    const glm::dvec2& translation,
+    const glm::dvec2& scale,
+    int32_t textureCoordinateID) {
   FVector4 translationAndScale(translation.x, translation.y, scale.x, scale.y);
 
   forEachPrimitiveComponent(
@@ -3418,6 +4208,19 @@ void UCesiumGltfComponent::DetachRasterTile(
     const Cesium3DTilesSelection::Tile& tile,
     const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
     UTexture2D* pTexture) {
+  if (this->_pPendingCreation) {
+    std::vector<PendingRasterTile>& pending =
+        this->_pPendingCreation->rasterTiles;
+    pending.erase(
+        std::remove_if(
+            pending.begin(),
+            pending.end(),
+            [&rasterTile](const PendingRasterTile& candidate) {
+              return candidate.pRasterTile == &rasterTile;
+            }),
+        pending.end());
+  }
+
   forEachPrimitiveComponent(
       this,
       [this, &rasterTile, pTexture](
@@ -3465,6 +4268,7 @@ void UCesiumGltfComponent::BeginDestroy() {
   // Clear everything we can in order to reduce memory usage, because this
   // UObject might not actually get deleted by the garbage collector until
   // much later.
+  this->_pPendingCreation.Reset();
   this->Metadata = FCesiumModelMetadata();
   this->EncodedMetadata = CesiumEncodedFeaturesMetadata::EncodedModelMetadata();
 
@@ -3475,104 +4279,60 @@ void UCesiumGltfComponent::BeginDestroy() {
   Super::BeginDestroy();
 }
 
-void UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
+bool UCesiumGltfComponent::UpdateFade(float fadePercentage, bool fadingIn) {
   if (!this->IsVisible()) {
-    return;
+    return false;
+  }
+
+  fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
+  if (fadePercentage == this->_lastFadePercentage &&
+      fadingIn == this->_lastFadingIn) {
+    return false;
   }
 
   UCesiumMaterialUserData* pCesiumData =
       BaseMaterial->GetAssetUserData<UCesiumMaterialUserData>();
 
   if (!pCesiumData) {
-    return;
+    return false;
   }
 
   int fadeLayerIndex = pCesiumData->LayerNames.Find("DitherFade");
   if (fadeLayerIndex < 0) {
-    return;
+    return false;
   }
 
-  fadePercentage = glm::clamp(fadePercentage, 0.0f, 1.0f);
+  this->_lastFadePercentage = fadePercentage;
+  this->_lastFadingIn = fadingIn;
 
   for (USceneComponent* pChild : this->GetAttachChildren()) {
     UCesiumGltfPrimitiveComponent* pPrimitive =
         Cast<UCesiumGltfPrimitiveComponent>(pChild);
-    if (!pPrimitive || pPrimitive->GetMaterials().IsEmpty()) {
-      continue;
-    }
-
-    UMaterialInstanceDynamic* pMaterial =
-        Cast<UMaterialInstanceDynamic>(pPrimitive->GetMaterials()[0]);
-    if (!pMaterial) {
+    if (!pPrimitive) {
       continue;
     }
 
-    pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            "FadePercentage",
-            EMaterialParameterAssociation::LayerParameter,
-            fadeLayerIndex),
-        fadePercentage);
-    pMaterial->SetScalarParameterValueByInfo(
-        FMaterialParameterInfo(
-            "FadingType",
-            EMaterialParameterAssociation::LayerParameter,
-            fadeLayerIndex),
-        fadingIn ? 0.0f : 1.0f);
-  }
-}
-
-template <typename TIndex>
-#if ENGINE_VERSION_5_4_OR_HIGHER
-static Chaos::FTriangleMeshImplicitObjectPtr
-#else
-static TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-#endif
-BuildChaosTriangleMeshes(
-    const TArray<FStaticMeshBuildVertex>& vertexData,
-    const TArray<uint32>& indices) {
-  int32 vertexCount = vertexData.Num();
-  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
-  vertices.AddParticles(vertexCount);
-  for (int32 i = 0; i < vertexCount; ++i) {
-    vertices.X(i) = vertexData[i].Position;
-  }
-
-  int32 triangleCount = indices.Num() / 3;
-  TArray<Chaos::TVector<TIndex, 3>> triangles;
-  triangles.Reserve(triangleCount);
-  TArray<int32> faceRemap;
-  faceRemap.Reserve(triangleCount);
-
-  for (int32 i = 0; i < triangleCount; ++i) {
-    const int32 index0 = 3 * i;
-    int32 vIndex0 = indices[index0 + 1];
-    int32 vIndex1 = indices[index0];
-    int32 vIndex2 = indices[index0 + 2];
+    for (UMaterialInterface* pMaterialInterface : pPrimitive->GetMaterials()) {
+      UMaterialInstanceDynamic* pMaterial =
+          Cast<UMaterialInstanceDynamic>(pMaterialInterface);
+      if (!pMaterial) {
+        continue;
+      }
 
-    triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
-    faceRemap.Add(i);
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "FadePercentage",
+              EMaterialParameterAssociation::LayerParameter,
+              fadeLayerIndex),
+          fadePercentage);
+      pMaterial->SetScalarParameterValueByInfo(
+          FMaterialParameterInfo(
+              "FadingType",
+              EMaterialParameterAssociation::LayerParameter,
+              fadeLayerIndex),
+          fadingIn ? 0.0f : 1.0f);
+    }
   }
 
-  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
-  TArray<uint16> materials;
-  materials.SetNum(triangles.Num());
-
-#if ENGINE_VERSION_5_4_OR_HIGHER
-  return new Chaos::FTriangleMeshImplicitObject(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#else
-  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
-      MoveTemp(vertices),
-      MoveTemp(triangles),
-      MoveTemp(materials),
-      MoveTemp(pFaceRemap),
-      nullptr,
-      false);
-#endif
+  return true;
 }
@@ -14,7 +14,9 @@
 #include "Interfaces/IHttpRequest.h"
 #include <CesiumAsync/SharedFuture.h>
 #include <glm/mat4x4.hpp>
+#include <glm/vec2.hpp>
 #include <memory>
+#include <vector>
 #include "CesiumGltfComponent.generated.h"
 
 class UMaterialInterface;
@@ -88,7 +90,24 @@ public:
       UMaterialInterface* BaseWaterMaterial,
       FCustomDepthParameters CustomDepthParameters,
       const Cesium3DTilesSelection::Tile& tile,
-      bool createNavCollision);
+      bool createNavCollision,
+      double timeLimitMilliseconds = 0.0);
+
+  /**
+   * Continues creating the primitive components of a tile whose creation was
+   * interrupted by the time limit passed to CreateOnGameThread.
+   *
+   * @param timeLimitMilliseconds The maximum time to spend, or zero for no
+   * limit. At least one primitive is created per call.
+   * @return True if all primitives have now been created.
+   */
+  bool ContinueCreateOnGameThread(double timeLimitMilliseconds);
+
+  /**
+   * Whether all primitive components of this tile have been created. Tiles
+   * that are not complete are never shown.
+   */
+  bool IsCreationComplete() const { return !this->_pPendingCreation; }
 
   UCesiumGltfComponent();
 
@@ -132,9 +151,96 @@ public:
 
   virtual void BeginDestroy() override;
 
-  void UpdateFade(float fadePercentage, bool fadingIn);
+  /**
+   * Updates the dither fade parameters of this tile's materials. Does nothing
+   * if the fade state has not changed since the last call.
+   *
+   * @return True if any material parameters were modified.
+   */
+  bool UpdateFade(float fadePercentage, bool fadingIn);
+
+  /**
+   * The owning tileset's render generation at the time this tile was last
+   * shown. The tileset uses this to skip tiles whose visibility and collision
+   * state did not change since the previous frame.
+   */
+  uint64 LastShownGeneration = 0;
+
+  /**
+   * The owning tileset's transform epoch at the time this tile's transform was
+   * last updated. Transform changes are only applied to hidden tiles once they
+   * are shown again.
+   */
+  uint64 TransformEpoch = 0;
+
+  /**
+   * The number of vertices of this tile's glTF primitives.
+   */
+  uint64 GltfVertexCount = 0;
+
+  /**
+   * The number of vertices of the meshes created for this tile's glTF
+   * primitives. This is larger than GltfVertexCount when vertices were
+   * duplicated to generate normals or tangents.
+   */
+  uint64 VertexCount = 0;
+
+  /**
+   * The number of bytes of vertex memory saved by storing this tile's meshes
+   * in the compact vertex format.
+   */
+  uint64 CompactVertexBytesSaved = 0;
+
+  /**
+   * The number of bytes of this tile's glTF buffers and images, which is how
+   * much the tile adds to the total data bytes of its tileset.
+   */
+  int64 DataBytes = 0;
 
 private:
+  struct PendingRasterTile {
+    const CesiumRasterOverlays::RasterOverlayTile* pRasterTile;
+    UTexture2D* pTexture;
+    glm::dvec2 translation;
+    glm::dvec2 scale;
+    int32_t textureCoordinateID;
+  };
+
+  /**
+   * The state needed to resume creating this tile's primitive components in a
+   * later frame.
+   */
+  struct PendingCreation {
+    TUniquePtr<HalfConstructed> pHalfConstructed;
+    CesiumGltf::Model* pModel = nullptr;
+    ACesium3DTileset* pTilesetActor = nullptr;
+    const Cesium3DTilesSelection::Tile* pTile = nullptr;
+    bool createNavCollision = false;
+    size_t nodeIndex = 0;
+    size_t primitiveIndex = 0;
+
+    /**
+     * The raster tiles attached while creation was still in progress. They
+     * are applied to each primitive created afterwards. The textures are kept
+     * alive by the raster tiles until they are detached.
+     */
+    std::vector<PendingRasterTile> rasterTiles;
+  };
+
+  bool createPendingPrimitives(double timeLimitMilliseconds);
+
+  void applyRasterTile(
+      const CesiumRasterOverlays::RasterOverlayTile& RasterTile,
+      UTexture2D* Texture,
+      const glm::dvec2& Translation,
+      const glm::dvec2& Scale,
+      int32_t TextureCoordinateID);
+
+  TUniquePtr<PendingCreation> _pPendingCreation;
+
   UPROPERTY()
   UTexture2D* Transparent1x1 = nullptr;
+
+  float _lastFadePercentage = -1.0f;
+  bool _lastFadingIn = false;
 };
@@ -1,14 +1,22 @@
 // Copyright 2020-2024 CesiumGS, Inc. and Contributors
 
 #include "CesiumGltfPrimitiveComponent.h"
+#include "AI/NavigationSystemBase.h"
+#include "Algo/BinarySearch.h"
 #include "CalcBounds.h"
 #include "CesiumLifetime.h"
 #include "CesiumMaterialUserData.h"
+#include "CesiumQuantizedPositions.h"
+#include "CesiumRuntime.h"
+#include "CesiumTilesetPrimitiveComponent.h"
 #include "Engine/Texture.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "PhysicsEngine/BodySetup.h"
+#include "RenderingThread.h"
+#include "Runtime/Launch/Resources/Version.h"
 #include "VecMath.h"
 
+#include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGltf/MeshPrimitive.h>
 #include <CesiumGltf/Model.h>
 #include <variant>
@@ -38,10 +46,14 @@ void destroyCesiumPrimitive(UStaticMeshComponent* pComponent) {
   // much later.
   auto* cesiumPrimitive = Cast<ICesiumPrimitive>(pComponent);
   cesiumPrimitive->getPrimitiveData().destroy();
-  UMaterialInstanceDynamic* pMaterial =
-      Cast<UMaterialInstanceDynamic>(pComponent->GetMaterial(0));
-  if (pMaterial) {
-    CesiumLifetime::destroy(pMaterial);
+
+  // A mesh with merged primitives has a material for each of them.
+  for (int32 i = 0; i < pComponent->GetNumMaterials(); ++i) {
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pComponent->GetMaterial(i));
+    if (pMaterial) {
+      CesiumLifetime::destroy(pMaterial);
+    }
   }
 
   UStaticMesh* pMesh = pComponent->GetStaticMesh();
@@ -57,7 +69,19 @@ void destroyCesiumPrimitive(UStaticMeshComponent* pComponent) {
 }
 } // namespace
 void UCesiumGltfPrimitiveComponent::BeginDestroy() {
+  // The tileset component must stop drawing the mesh before it's destroyed.
+  if (this->_shownByTilesetPrimitiveComponent) {
+    if (UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent =
+            this->_pTilesetPrimitiveComponent.Get()) {
+      pTilesetPrimitiveComponent->HidePrimitive(this);
+    }
+    this->_shownByTilesetPrimitiveComponent = false;
+  }
+
+  this->releaseQuantizedPositions();
+  this->setCollisionMeshSource(nullptr);
   destroyCesiumPrimitive(this);
+  this->destroyMergedPrimitives();
   Super::BeginDestroy();
 }
 
@@ -167,3 +191,203 @@ const CesiumPrimitiveData&
 UCesiumGltfInstancedComponent::getPrimitiveData() const {
   return _cesiumData;
 }
+
+CesiumPrimitiveData&
+UCesiumGltfPrimitiveComponent::addMergedPrimitive(int64 firstFace) {
+  TUniquePtr<MergedPrimitive>& pMerged =
+      _mergedPrimitives.Add_GetRef(MakeUnique<MergedPrimitive>());
+  pMerged->firstFace = firstFace;
+  return pMerged->data;
+}
+
+const CesiumPrimitiveData&
+UCesiumGltfPrimitiveComponent::getPrimitiveDataForFace(
+    int64 faceIndex,
+    int64& primitiveFaceIndex) const {
+  primitiveFaceIndex = faceIndex;
+  if (faceIndex < 0 || _mergedPrimitives.IsEmpty() ||
+      faceIndex < _mergedPrimitives[0]->firstFace) {
+    return _cesiumData;
+  }
+
+  // Find the last merged primitive that starts at or before the face.
+  const int32 index = Algo::UpperBoundBy(
+      _mergedPrimitives,
+      faceIndex,
+      [](const TUniquePtr<MergedPrimitive>& pMerged) {
+        return pMerged->firstFace;
+      });
+  const MergedPrimitive& merged = *_mergedPrimitives[index - 1];
+  primitiveFaceIndex = faceIndex - merged.firstFace;
+  return merged.data;
+}
+
+void UCesiumGltfPrimitiveComponent::destroyMergedPrimitives() {
+  for (const TUniquePtr<MergedPrimitive>& pMerged : _mergedPrimitives) {
+    pMerged->data.destroy();
+  }
+  _mergedPrimitives.Empty();
+}
+
+void UCesiumGltfPrimitiveComponent::setTilesetPrimitiveComponent(
+    UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent) {
+  this->_pTilesetPrimitiveComponent = pTilesetPrimitiveComponent;
+}
+
+void UCesiumGltfPrimitiveComponent::setQuantizedPositions(
+    TUniquePtr<FCesiumQuantizedPositions>&& pQuantizedPositions) {
+  this->releaseQuantizedPositions();
+
+  FStaticMeshRenderData* pRenderData =
+      this->GetStaticMesh() ? this->GetStaticMesh()->GetRenderData() : nullptr;
+  if (!pQuantizedPositions || !pRenderData) {
+    return;
+  }
+
+  this->_pQuantizedPositions = pQuantizedPositions.Release();
+  ENQUEUE_RENDER_COMMAND(Cesium_InitQuantizedPositions)
+  ([pQuantizedPositions = this->_pQuantizedPositions,
+    pRenderData](FRHICommandListImmediate& RHICmdList) {
+    pQuantizedPositions->InitResources(
+        RHICmdList,
+        pRenderData->LODResources[0],
+        pRenderData->LODVertexFactories[0]);
+  });
+}
+
+void UCesiumGltfPrimitiveComponent::releaseQuantizedPositions() {
+  if (!this->_pQuantizedPositions) {
+    return;
+  }
+
+  // Any earlier command to hide the mesh is executed first.
+  ENQUEUE_RENDER_COMMAND(Cesium_ReleaseQuantizedPositions)
+  ([pQuantizedPositions =
+        this->_pQuantizedPositions](FRHICommandListImmediate& RHICmdList) {
+    pQuantizedPositions->ReleaseResources();
+    delete pQuantizedPositions;
+  });
+  this->_pQuantizedPositions = nullptr;
+}
+
+namespace {
+uint64 lastCollisionMeshRequest = 0;
+}
+
+void UCesiumGltfPrimitiveComponent::setCollisionMeshSource(
+    TSharedPtr<const CesiumPhysicsMeshUtility::CollisionMeshSource>&&
+        pCollisionMeshSource) {
+  this->releaseCollisionMesh();
+  this->_pCollisionMeshSource = MoveTemp(pCollisionMeshSource);
+}
+
+void UCesiumGltfPrimitiveComponent::requestCollisionMesh() {
+  if (!this->_pCollisionMeshSource || this->_collisionMeshRequest != 0) {
+    return;
+  }
+
+  const uint64 request = ++lastCollisionMeshRequest;
+  this->_collisionMeshRequest = request;
+
+  getAsyncSystem()
+      .runInWorkerThread([pSource = this->_pCollisionMeshSource]() {
+        return CesiumPhysicsMeshUtility::buildCollisionMesh(*pSource);
+      })
+      .thenInMainThread(
+          [pThis = TWeakObjectPtr<UCesiumGltfPrimitiveComponent>(this),
+           request](CesiumPhysicsMeshUtility::CollisionMeshPtr&&
+                        pCollisionMesh) {
+            UCesiumGltfPrimitiveComponent* pComponent = pThis.Get();
+            if (!pComponent || !pCollisionMesh ||
+                pComponent->_collisionMeshRequest != request) {
+              // Released, or requested again, while it was being cooked.
+              return;
+            }
+
+            UBodySetup* pBodySetup = pComponent->GetBodySetup();
+            if (!pBodySetup) {
+              return;
+            }
+
+            pComponent->_pCollisionMesh = MoveTemp(pCollisionMesh);
+#if ENGINE_VERSION_5_4_OR_HIGHER
+            pBodySetup->TriMeshGeometries.Add(pComponent->_pCollisionMesh);
+#else
+            pBodySetup->ChaosTriMeshes.Add(pComponent->_pCollisionMesh);
+#endif
+            pComponent->RecreatePhysicsState();
+
+            // The navigation system gathers the triangles of the collision
+            // mesh, which didn't exist when the component was registered.
+            if (pComponent->CanEverAffectNavigation()) {
+              FNavigationSystem::UpdateComponentData(*pComponent);
+            }
+          });
+}
+
+void UCesiumGltfPrimitiveComponent::releaseCollisionMesh() {
+  this->_collisionMeshRequest = 0;
+  if (!this->_pCollisionMesh) {
+    return;
+  }
+
+  UBodySetup* pBodySetup = this->GetBodySetup();
+  if (pBodySetup) {
+#if ENGINE_VERSION_5_4_OR_HIGHER
+    pBodySetup->TriMeshGeometries.Remove(this->_pCollisionMesh);
+#else
+    pBodySetup->ChaosTriMeshes.Remove(this->_pCollisionMesh);
+#endif
+    if (this->IsPhysicsStateCreated()) {
+      this->RecreatePhysicsState();
+    }
+  }
+  this->_pCollisionMesh = nullptr;
+}
+
+bool UCesiumGltfPrimitiveComponent::ShouldCreateRenderState() const {
+  return !this->_pTilesetPrimitiveComponent.IsValid() &&
+         Super::ShouldCreateRenderState();
+}
+
+void UCesiumGltfPrimitiveComponent::OnRegister() {
+  Super::OnRegister();
+  this->updateTilesetPrimitiveComponent();
+}
+
+void UCesiumGltfPrimitiveComponent::OnUnregister() {
+  Super::OnUnregister();
+  this->updateTilesetPrimitiveComponent();
+}
+
+void UCesiumGltfPrimitiveComponent::OnVisibilityChanged() {
+  Super::OnVisibilityChanged();
+  this->updateTilesetPrimitiveComponent();
+}
+
+void UCesiumGltfPrimitiveComponent::OnUpdateTransform(
+    EUpdateTransformFlags UpdateTransformFlags,
+    ETeleportType Teleport) {
+  Super::OnUpdateTransform(UpdateTransformFlags, Teleport);
+  if (this->_shownByTilesetPrimitiveComponent) {
+    this->updateTilesetPrimitiveComponent();
+  }
+}
+
+void UCesiumGltfPrimitiveComponent::updateTilesetPrimitiveComponent() {
+  UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent =
+      this->_pTilesetPrimitiveComponent.Get();
+  if (!pTilesetPrimitiveComponent) {
+    this->_shownByTilesetPrimitiveComponent = false;
+    return;
+  }
+
+  const bool show = this->IsRegistered() && this->IsVisible();
+  if (show) {
+    // This also updates the transform of a primitive that is already shown.
+    pTilesetPrimitiveComponent->ShowPrimitive(this);
+  } else if (this->_shownByTilesetPrimitiveComponent) {
+    pTilesetPrimitiveComponent->HidePrimitive(this);
+  }
+  this->_shownByTilesetPrimitiveComponent = show;
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "CesiumPhysicsMeshUtility.h"
 #include "CesiumPrimitive.h"
 #include "Components/InstancedStaticMeshComponent.h"
 #include "Components/StaticMeshComponent.h"
@@ -19,6 +20,9 @@ struct Model;
 struct MeshPrimitive;
 } // namespace CesiumGltf
 
+class FCesiumQuantizedPositions;
+class UCesiumTilesetPrimitiveComponent;
+
 UCLASS()
 class UCesiumGltfPrimitiveComponent : public UStaticMeshComponent,
                                       public ICesiumPrimitive {
@@ -39,8 +43,155 @@ public:
   CesiumPrimitiveData& getPrimitiveData() override;
   const CesiumPrimitiveData& getPrimitiveData() const override;
 
+  /**
+   * Adds the data of a glTF primitive that was merged into this component's
+   * mesh after the first one. The data of the first primitive is returned by
+   * getPrimitiveData.
+   *
+   * @param firstFace The index of the first face of the primitive within the
+   * mesh. Primitives must be added in the order of their faces.
+   * @return The data of the merged primitive, to be filled in by the caller.
+   */
+  CesiumPrimitiveData& addMergedPrimitive(int64 firstFace);
+
+  /**
+   * Gets the number of glTF primitives rendered by this component's mesh.
+   */
+  int32 getPrimitiveCount() const { return 1 + _mergedPrimitives.Num(); }
+
+  /**
+   * Gets the data of the glTF primitive that contains the given face of this
+   * component's mesh, along with the index of the face within that primitive.
+   * Unless primitives were merged into this component, this is the data
+   * returned by getPrimitiveData and the face index is unchanged.
+   *
+   * @param faceIndex The index of the face within the mesh, such as the
+   * FaceIndex of a hit result.
+   * @param primitiveFaceIndex Receives the index of the face within the glTF
+   * primitive.
+   */
+  const CesiumPrimitiveData& getPrimitiveDataForFace(
+      int64 faceIndex,
+      int64& primitiveFaceIndex) const;
+
+  /**
+   * Destroys the data of all primitives merged into this component, except
+   * for the first one.
+   */
+  void destroyMergedPrimitives();
+
+  /**
+   * Sets the tileset-wide component that renders this primitive instead of
+   * this component's own scene proxy. Must be called before the component is
+   * registered. If nullptr, the primitive renders itself as usual.
+   */
+  void setTilesetPrimitiveComponent(
+      UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent);
+
+  /**
+   * Sets the quantized positions that the tileset-wide component draws this
+   * primitive's mesh with, and initializes their resources on the render
+   * thread. Must be called after the resources of the mesh are initialized.
+   */
+  void setQuantizedPositions(
+      TUniquePtr<FCesiumQuantizedPositions>&& pQuantizedPositions);
+
+  /**
+   * Gets the quantized positions of this primitive's mesh, or nullptr if its
+   * positions aren't quantized.
+   */
+  const FCesiumQuantizedPositions* getQuantizedPositions() const {
+    return _pQuantizedPositions;
+  }
+
+  /**
+   * Releases the quantized positions of this primitive's mesh, if any. This
+   * must be done after the tileset-wide component stops drawing the mesh.
+   */
+  void releaseQuantizedPositions();
+
+  /**
+   * Sets the triangles that this primitive's collision mesh is cooked from
+   * once it is requested. Until then, the primitive has no collision mesh.
+   * Any collision mesh cooked from a previous source is released.
+   */
+  void setCollisionMeshSource(
+      TSharedPtr<const CesiumPhysicsMeshUtility::CollisionMeshSource>&&
+          pCollisionMeshSource);
+
+  /**
+   * Gets the triangles that this primitive's collision mesh is cooked from on
+   * demand, or nullptr if its collision mesh was cooked when it was loaded.
+   */
+  const TSharedPtr<const CesiumPhysicsMeshUtility::CollisionMeshSource>&
+  getCollisionMeshSource() const {
+    return _pCollisionMeshSource;
+  }
+
+  /**
+   * Whether the collision mesh has been requested since it was last released,
+   * whether or not it has been cooked yet.
+   */
+  bool isCollisionMeshRequested() const { return _collisionMeshRequest != 0; }
+
+  /**
+   * Cooks the collision mesh from the collision mesh source on a worker
+   * thread, and adds it to the body setup once it is cooked, unless it is
+   * released before then. Does nothing if there is no source or the collision
+   * mesh is already requested.
+   */
+  void requestCollisionMesh();
+
+  /**
+   * Removes the collision mesh that was cooked from the collision mesh
+   * source, or discards it once it is cooked if it is still being cooked. The
+   * source is kept, so the collision mesh can be requested again.
+   */
+  void releaseCollisionMesh();
+
+  bool ShouldCreateRenderState() const override;
+
+protected:
+  void OnRegister() override;
+  void OnUnregister() override;
+  void OnVisibilityChanged() override;
+  void OnUpdateTransform(
+      EUpdateTransformFlags UpdateTransformFlags,
+      ETeleportType Teleport = ETeleportType::None) override;
+
 private:
+  /**
+   * Shows or hides this primitive in the tileset-wide component, depending on
+   * whether it is registered and visible.
+   */
+  void updateTilesetPrimitiveComponent();
+
+  struct MergedPrimitive {
+    int64 firstFace;
+    CesiumPrimitiveData data;
+  };
+
   CesiumPrimitiveData _cesiumData;
+
+  // Held by pointer so that adding primitives doesn't move the data of
+  // earlier ones, which the deprecated metadata structs point into.
+  TArray<TUniquePtr<MergedPrimitive>> _mergedPrimitives;
+
+  TWeakObjectPtr<UCesiumTilesetPrimitiveComponent> _pTilesetPrimitiveComponent;
+  bool _shownByTilesetPrimitiveComponent = false;
+
+  // Owned by this component, but deleted on the render thread once its
+  // resources are released.
+  FCesiumQuantizedPositions* _pQuantizedPositions = nullptr;
+
+  TSharedPtr<const CesiumPhysicsMeshUtility::CollisionMeshSource>
+      _pCollisionMeshSource;
+  CesiumPhysicsMeshUtility::CollisionMeshPtr _pCollisionMesh;
+
+  // Identifies the latest request for the collision mesh, so that the result
+  // of an earlier request that was released is discarded. Zero when the
+  // collision mesh isn't requested.
+  uint64 _collisionMeshRequest = 0;
 };
 
 UCLASS()
@@ -167,6 +167,7 @@ bool isSupportedIndexComponentType(int32_t componentType) {
 bool isSupportedPrimitiveMode(int32_t primitiveMode) {
   return primitiveMode == CesiumGltf::MeshPrimitive::Mode::TRIANGLES ||
          primitiveMode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_STRIP ||
+         primitiveMode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_FAN ||
          primitiveMode == CesiumGltf::MeshPrimitive::Mode::POINTS;
 }
 
@@ -2,19 +2,68 @@
 
 #include "CesiumLifetime.h"
 #include "CesiumRuntime.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
 #if WITH_EDITOR
 #include "Editor.h"
 #include "Editor/EditorEngine.h"
 #include "Engine/Selection.h"
 #endif
+#include "Components/PrimitiveComponent.h"
+#include "Components/StaticMeshComponent.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/Texture2D.h"
+#include "HAL/PlatformTime.h"
 #include "PhysicsEngine/BodySetup.h"
 #include "Runtime/Launch/Resources/Version.h"
 #include "StaticMeshResources.h"
 #include "UObject/Object.h"
 #include <algorithm>
 
+namespace {
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Objects Pending Destruction"),
+    STAT_CesiumObjectsPendingDestruction,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Bytes Pending Destruction"),
+    STAT_CesiumBytesPendingDestruction,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Objects Destroyed"),
+    STAT_CesiumObjectsDestroyed,
+    STATGROUP_Cesium);
+
+// How many bytes each frame that an object waits to be destroyed adds to its
+// priority. An object is destroyed before a larger one that was handed over
+// later once it has waited for one frame per this many bytes of difference.
+constexpr int64 agingBytesPerFrame = 1024 * 1024;
+
+bool useDestructionBudget() {
+  return GetDefault<UCesiumRuntimeSettings>()->UseDestructionBudget;
+}
+
+int64 estimateBytes(UObject* pObject) {
+  return pObject->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+}
+
+int64 estimateComponentBytes(USceneComponent* pComponent) {
+  int64 bytes = 0;
+  TArray<USceneComponent*> children;
+  pComponent->GetChildrenComponents(true, children);
+  children.Add(pComponent);
+  for (USceneComponent* pChild : children) {
+    UStaticMeshComponent* pMeshComponent = Cast<UStaticMeshComponent>(pChild);
+    UStaticMesh* pMesh =
+        pMeshComponent ? pMeshComponent->GetStaticMesh() : nullptr;
+    if (pMesh) {
+      bytes += estimateBytes(pMesh);
+    }
+  }
+  return bytes;
+}
+} // namespace
+
 /*static*/
 AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
 
@@ -22,6 +71,11 @@ AmortizedDestructor CesiumLifetime::amortizedDestructor = AmortizedDestructor();
   amortizedDestructor.destroy(pObject);
 }
 
+/*static*/ void CesiumLifetime::destroyComponentRecursivelyAmortized(
+    USceneComponent* pComponent) {
+  amortizedDestructor.destroyComponentRecursively(pComponent);
+}
+
 /*static*/ void
 CesiumLifetime::destroyComponentRecursively(USceneComponent* pComponent) {
   TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::DestroyComponent)
@@ -72,9 +126,40 @@ bool AmortizedDestructor::IsTickableInEditor() const { return true; }
 TStatId AmortizedDestructor::GetStatId() const { return TStatId(); }
 
 void AmortizedDestructor::destroy(UObject* pObject) {
-  if (!runDestruction(pObject)) {
-    addToPending(pObject);
+  if (!pObject) {
+    return;
   }
+
+  if (!useDestructionBudget()) {
+    if (!runDestruction(pObject)) {
+      this->addToPending(pObject, estimateBytes(pObject), false);
+    }
+    return;
+  }
+
+  this->addToPending(pObject, estimateBytes(pObject), false);
+}
+
+void AmortizedDestructor::destroyComponentRecursively(
+    USceneComponent* pComponent) {
+  if (!pComponent) {
+    return;
+  }
+
+  // Make the component disappear right away, even though it may remain
+  // registered for a few more frames.
+  pComponent->SetVisibility(false, true);
+  TArray<USceneComponent*> children;
+  pComponent->GetChildrenComponents(true, children);
+  children.Add(pComponent);
+  for (USceneComponent* pChild : children) {
+    UPrimitiveComponent* pPrimitive = Cast<UPrimitiveComponent>(pChild);
+    if (pPrimitive) {
+      pPrimitive->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    }
+  }
+
+  this->addToPending(pComponent, estimateComponentBytes(pComponent), true);
 }
 
 bool AmortizedDestructor::runDestruction(UObject* pObject) const {
@@ -108,17 +193,83 @@ bool AmortizedDestructor::runDestruction(UObject* pObject) const {
   return false;
 }
 
-void AmortizedDestructor::addToPending(UObject* pObject) {
-  _pending.Add(pObject);
+void AmortizedDestructor::addToPending(
+    UObject* pObject,
+    int64 bytes,
+    bool isComponent) {
+  this->_pending.HeapPush(
+      PendingObject{
+          pObject,
+          bytes,
+          isComponent,
+          bytes - agingBytesPerFrame * this->_frame,
+          this->_sequence++},
+      HighestPriorityFirst());
+  this->_bytesPending += bytes;
 }
 
 void AmortizedDestructor::processPending() {
-  std::swap(_nextPending, _pending);
-  _pending.Empty();
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ProcessPendingDestruction)
+
+  ++this->_frame;
 
-  for (TWeakObjectPtr<UObject> pObject : _nextPending) {
-    destroy(pObject.Get(true));
+  // Objects that weren't ready last frame get another chance, and keep the
+  // priority they gained while waiting.
+  for (PendingObject& pending : this->_nextPending) {
+    this->_pending.HeapPush(MoveTemp(pending), HighestPriorityFirst());
   }
+  this->_nextPending.Empty();
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  const double timeBudget = pSettings->DestructionTimeBudget;
+  const int32 objectBudget = pSettings->DestructionObjectBudget;
+  const double start = FPlatformTime::Seconds();
+
+  int32 processed = 0;
+  while (!this->_pending.IsEmpty()) {
+    if (processed > 0) {
+      if (objectBudget > 0 && processed >= objectBudget) {
+        break;
+      }
+      if (timeBudget > 0.0 &&
+          (FPlatformTime::Seconds() - start) * 1000.0 >= timeBudget) {
+        break;
+      }
+    }
+
+    PendingObject pending;
+    this->_pending.HeapPop(pending, HighestPriorityFirst());
+    this->_bytesPending -= pending.bytes;
+    ++processed;
+
+    if (pending.isComponent) {
+      USceneComponent* pComponent =
+          Cast<USceneComponent>(pending.pObject.Get());
+      if (pComponent) {
+        CesiumLifetime::destroyComponentRecursively(pComponent);
+        INC_DWORD_STAT(STAT_CesiumObjectsDestroyed);
+      }
+      continue;
+    }
+
+    UObject* pObject = pending.pObject.Get(true);
+    if (runDestruction(pObject)) {
+      INC_DWORD_STAT(STAT_CesiumObjectsDestroyed);
+    } else {
+      this->_bytesPending += pending.bytes;
+      this->_nextPending.Add(MoveTemp(pending));
+    }
+  }
+
+  this->updateStats();
+}
+
+void AmortizedDestructor::updateStats() const {
+  SET_DWORD_STAT(
+      STAT_CesiumObjectsPendingDestruction,
+      this->_pending.Num() + this->_nextPending.Num());
+  SET_MEMORY_STAT(STAT_CesiumBytesPendingDestruction, this->_bytesPending);
 }
 
 void AmortizedDestructor::finalizeDestroy(UObject* pObject) const {
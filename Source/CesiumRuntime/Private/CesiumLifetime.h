@@ -9,6 +9,18 @@
 class UObject;
 class UTexture;
 
+/**
+ * Destroys objects whose destruction can't finish right away in later frames.
+ *
+ * When the destruction budget in the runtime settings is enabled, objects are
+ * instead queued and destroyed over multiple frames, within the per-frame time
+ * and object budgets. Components handed over with destroyComponentRecursively
+ * are always queued. Objects that are expected to release the most memory are
+ * destroyed first, but every frame an object waits counts as additional
+ * memory, so that small objects can't be held back forever by larger ones
+ * handed over later. Objects of equal priority are destroyed in the order they
+ * were handed over.
+ */
 class AmortizedDestructor : FTickableGameObject {
 public:
   void Tick(float DeltaTime) override;
@@ -17,22 +29,69 @@ public:
   bool IsTickableInEditor() const override;
   TStatId GetStatId() const;
   void destroy(UObject* pObject);
+  void destroyComponentRecursively(USceneComponent* pComponent);
 
 private:
+  struct PendingObject {
+    TWeakObjectPtr<UObject> pObject;
+    int64 bytes;
+    bool isComponent;
+
+    // The bytes, less the aging bonus for the frames before the object was
+    // handed over. The bonus for the frames since then is the same for all
+    // objects, so this orders them by their aged size.
+    int64 priority;
+
+    // The order in which objects were handed over, for ties.
+    uint64 sequence;
+  };
+
+  struct HighestPriorityFirst {
+    bool operator()(const PendingObject& lhs, const PendingObject& rhs) const {
+      return lhs.priority != rhs.priority ? lhs.priority > rhs.priority
+                                          : lhs.sequence < rhs.sequence;
+    }
+  };
+
   bool runDestruction(UObject* pObject) const;
-  void addToPending(UObject* pObject);
+  void addToPending(UObject* pObject, int64 bytes, bool isComponent);
   void processPending();
   void finalizeDestroy(UObject* pObject) const;
+  void updateStats() const;
 
-  TArray<TWeakObjectPtr<UObject>> _pending;
-  TArray<TWeakObjectPtr<UObject>> _nextPending;
+  // A max-heap of the objects waiting to be destroyed, ordered by priority.
+  TArray<PendingObject> _pending;
+
+  // Objects that have begun destruction but were not yet ready to finish it.
+  // They are retried in the next frame.
+  TArray<PendingObject> _nextPending;
+
+  int64 _bytesPending = 0;
+  int64 _frame = 0;
+  uint64 _sequence = 0;
 };
 
 class CesiumLifetime {
 public:
+  /**
+   * Destroys an object, within the amortized destruction budget if it is
+   * enabled.
+   */
   static void destroy(UObject* pObject);
+
+  /**
+   * Immediately unregisters and destroys a component and all of its children.
+   */
   static void destroyComponentRecursively(USceneComponent* pComponent);
 
+  /**
+   * Hides a component and disables its collision immediately, and then
+   * unregisters and destroys it along with all of its children within the
+   * amortized destruction budget. This is done even if the budget is disabled
+   * for other objects.
+   */
+  static void destroyComponentRecursivelyAmortized(USceneComponent* pComponent);
+
 private:
   static AmortizedDestructor amortizedDestructor;
 };
@@ -23,7 +23,9 @@ UCesiumMetadataPickingBlueprintLibrary::GetMetadataValuesForFace(
   if (!IsValid(pModel)) {
     return TMap<FString, FCesiumMetadataValue>();
   }
-  const CesiumPrimitiveData& primData = pGltfComponent->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(FaceIndex, primitiveFaceIndex);
   const FCesiumPrimitiveFeatures& features = primData.Features;
   const TArray<FCesiumFeatureIdSet>& featureIDSets =
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(features);
@@ -48,7 +50,7 @@ UCesiumMetadataPickingBlueprintLibrary::GetMetadataValuesForFace(
   int64 featureID =
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromFace(
           features,
-          FaceIndex,
+          primitiveFaceIndex,
           FeatureIDSetIndex);
   if (featureID < 0) {
     return TMap<FString, FCesiumMetadataValue>();
@@ -89,7 +91,11 @@ bool UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
     return false;
   }
 
-  const CesiumPrimitiveData& primData = pGltfComponent->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(
+          Hit.FaceIndex,
+          primitiveFaceIndex);
 
   if (primData.PositionAccessor.status() !=
       CesiumGltf::AccessorViewStatus::Valid) {
@@ -103,7 +109,7 @@ bool UCesiumMetadataPickingBlueprintLibrary::FindUVFromHit(
 
   auto VertexIndices = std::visit(
       CesiumGltf::IndicesForFaceFromAccessor{
-          Hit.FaceIndex,
+          primitiveFaceIndex,
           primData.PositionAccessor.size(),
           primData.pMeshPrimitive->mode},
       primData.IndexAccessor);
@@ -164,7 +170,11 @@ UCesiumMetadataPickingBlueprintLibrary::GetPropertyTableValuesFromHit(
     return TMap<FString, FCesiumMetadataValue>();
   }
 
-  const CesiumPrimitiveData& primData = pGltfComponent->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(
+          Hit.FaceIndex,
+          primitiveFaceIndex);
   const FCesiumPrimitiveFeatures& features = primData.Features;
   const TArray<FCesiumFeatureIdSet>& featureIDSets =
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDSets(features);
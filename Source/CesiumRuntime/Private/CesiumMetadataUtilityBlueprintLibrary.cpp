@@ -31,7 +31,9 @@ UCesiumMetadataUtilityBlueprintLibrary::GetMetadataValuesForFace(
     return TMap<FString, FCesiumMetadataValue>();
   }
 
-  const CesiumPrimitiveData& primData = pGltfComponent->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(FaceIndex, primitiveFaceIndex);
   const UCesiumGltfComponent* pModel =
       Cast<UCesiumGltfComponent>(pGltfComponent->GetOuter());
   if (!IsValid(pModel)) {
@@ -67,7 +69,7 @@ UCesiumMetadataUtilityBlueprintLibrary::GetMetadataValuesForFace(
   int64 featureID =
       UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromFace(
           features,
-          FaceIndex,
+          primitiveFaceIndex,
           0);
   if (featureID < 0) {
     return TMap<FString, FCesiumMetadataValue>();
@@ -0,0 +1,68 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumOnDemandPhysicsMeshes.h"
+#include "CesiumCommon.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include <CesiumUtility/Tracing.h>
+
+namespace {
+// Collision meshes are released only once the primitive is this much further
+// away than the radius they are requested within.
+constexpr double releaseRadiusFactor = 1.25;
+} // namespace
+
+void CesiumOnDemandPhysicsMeshes::update(
+    const TArray<FVector>& locations,
+    double radius,
+    const TArray<UCesiumGltfPrimitiveComponent*>& primitives) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateOnDemandPhysicsMeshes)
+
+  TSet<const UCesiumGltfPrimitiveComponent*> rendered;
+  rendered.Reserve(primitives.Num());
+  for (const UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+    rendered.Add(pPrimitive);
+  }
+
+  const double releaseRadius = radius * releaseRadiusFactor;
+  for (int32 i = this->_requested.Num() - 1; i >= 0; --i) {
+    UCesiumGltfPrimitiveComponent* pPrimitive = this->_requested[i].Get();
+    if (pPrimitive && pPrimitive->isCollisionMeshRequested()) {
+      if (rendered.Contains(pPrimitive) &&
+          isNearAny(pPrimitive->Bounds.GetBox(), locations, releaseRadius)) {
+        continue;
+      }
+      pPrimitive->releaseCollisionMesh();
+    }
+
+    // Primitives that were destroyed or released by someone else, such as the
+    // primitive pool, are simply forgotten.
+    this->_requested.RemoveAtSwap(i);
+  }
+
+  for (UCesiumGltfPrimitiveComponent* pPrimitive : primitives) {
+    if (pPrimitive->isCollisionMeshRequested() ||
+        !isNearAny(pPrimitive->Bounds.GetBox(), locations, radius)) {
+      continue;
+    }
+
+    pPrimitive->requestCollisionMesh();
+    if (pPrimitive->isCollisionMeshRequested()) {
+      this->_requested.Add(pPrimitive);
+    }
+  }
+}
+
+void CesiumOnDemandPhysicsMeshes::reset() { this->_requested.Empty(); }
+
+/*static*/ bool CesiumOnDemandPhysicsMeshes::isNearAny(
+    const FBox& bounds,
+    const TArray<FVector>& locations,
+    double radius) {
+  const double radiusSquared = radius * radius;
+  for (const FVector& location : locations) {
+    if (bounds.ComputeSquaredDistanceToPoint(location) <= radiusSquared) {
+      return true;
+    }
+  }
+  return false;
+}
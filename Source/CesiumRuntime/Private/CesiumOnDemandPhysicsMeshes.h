@@ -0,0 +1,60 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Box.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UCesiumGltfPrimitiveComponent;
+
+/**
+ * Decides which tiles get their collision meshes cooked when a tileset cooks
+ * them on demand. A primitive's collision mesh is requested once the primitive
+ * is rendered within a radius of one of the locations that collision is
+ * needed at, such as those of pawns and vehicles, and released once it is no
+ * longer rendered or has moved sufficiently far away from all of them.
+ */
+class CesiumOnDemandPhysicsMeshes {
+public:
+  /**
+   * Requests the collision meshes of the rendered primitives that are near
+   * one of the given locations, and releases those that are no longer needed.
+   *
+   * @param locations The locations that collision is needed at, in Unreal
+   * world coordinates.
+   * @param radius How close the bounds of a primitive must come to one of the
+   * locations for its collision mesh to be requested. Collision meshes are
+   * released a bit further out, so that primitives near the edge of the radius
+   * aren't cooked over and over.
+   * @param primitives The rendered primitives whose collision meshes are
+   * cooked on demand.
+   */
+  void update(
+      const TArray<FVector>& locations,
+      double radius,
+      const TArray<UCesiumGltfPrimitiveComponent*>& primitives);
+
+  /**
+   * Forgets all requested collision meshes, without releasing them. Used when
+   * the primitives are about to be destroyed anyway.
+   */
+  void reset();
+
+  /**
+   * Gets the number of primitives whose collision meshes are requested.
+   */
+  int32 getRequestedCount() const { return this->_requested.Num(); }
+
+  /**
+   * Determines whether a bounding box is within the given radius of any of
+   * the given locations.
+   */
+  static bool isNearAny(
+      const FBox& bounds,
+      const TArray<FVector>& locations,
+      double radius);
+
+private:
+  TArray<TWeakObjectPtr<UCesiumGltfPrimitiveComponent>> _requested;
+};
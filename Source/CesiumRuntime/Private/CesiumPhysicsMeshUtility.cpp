@@ -0,0 +1,211 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshUtility.h"
+#include "CesiumCommon.h"
+#include <CesiumUtility/Tracing.h>
+#include <glm/geometric.hpp>
+#include <meshoptimizer.h>
+
+namespace CesiumPhysicsMeshUtility {
+
+namespace {
+FVector3f getPosition(const FPositionVertexBuffer& positions, int32 index) {
+  return positions.VertexPosition(uint32(index));
+}
+
+FVector3f getPosition(const TArray<FVector3f>& positions, int32 index) {
+  return positions[index];
+}
+
+int32 getVertexCount(const FPositionVertexBuffer& positions) {
+  return int32(positions.GetNumVertices());
+}
+
+int32 getVertexCount(const TArray<FVector3f>& positions) {
+  return positions.Num();
+}
+
+template <typename TIndex, typename TPositions, typename TIndices>
+CollisionMeshPtr
+buildChaosTriangleMesh(const TPositions& positions, const TIndices& indices) {
+  const int32 vertexCount = getVertexCount(positions);
+  Chaos::TParticles<Chaos::FRealSingle, 3> vertices;
+  vertices.AddParticles(vertexCount);
+  for (int32 i = 0; i < vertexCount; ++i) {
+    vertices.X(i) = getPosition(positions, i);
+  }
+
+  int32 triangleCount = indices.Num() / 3;
+  TArray<Chaos::TVector<TIndex, 3>> triangles;
+  triangles.Reserve(triangleCount);
+  TArray<int32> faceRemap;
+  faceRemap.Reserve(triangleCount);
+
+  for (int32 i = 0; i < triangleCount; ++i) {
+    const int32 index0 = 3 * i;
+    int32 vIndex0 = indices[index0 + 1];
+    int32 vIndex1 = indices[index0];
+    int32 vIndex2 = indices[index0 + 2];
+
+    triangles.Add(Chaos::TVector<int32, 3>(vIndex0, vIndex1, vIndex2));
+    faceRemap.Add(i);
+  }
+
+  TUniquePtr<TArray<int32>> pFaceRemap = MakeUnique<TArray<int32>>(faceRemap);
+  TArray<uint16> materials;
+  materials.SetNum(triangles.Num());
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  return new Chaos::FTriangleMeshImplicitObject(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#else
+  return MakeShared<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>(
+      MoveTemp(vertices),
+      MoveTemp(triangles),
+      MoveTemp(materials),
+      MoveTemp(pFaceRemap),
+      nullptr,
+      false);
+#endif
+}
+
+template <typename TPositions, typename TIndices>
+CollisionMeshPtr
+buildCollisionMesh(const TPositions& positions, const TIndices& indices) {
+  const int32 vertexCount = getVertexCount(positions);
+  if (vertexCount == 0 || indices.Num() == 0) {
+    return nullptr;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ChaosCook)
+  return vertexCount < TNumericLimits<uint16>::Max()
+             ? buildChaosTriangleMesh<uint16>(positions, indices)
+             : buildChaosTriangleMesh<int32>(positions, indices);
+}
+} // namespace
+
+SIZE_T CollisionMeshSource::getSizeBytes() const {
+  return this->positions.GetAllocatedSize() + this->indices.GetAllocatedSize();
+}
+
+CollisionMeshSource
+copyCollisionMeshSource(const FStaticMeshLODResources& lodResources) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::CopyCollisionMeshSource)
+  CollisionMeshSource result;
+
+  const FPositionVertexBuffer& positions =
+      lodResources.VertexBuffers.PositionVertexBuffer;
+  result.positions.SetNumUninitialized(int32(positions.GetNumVertices()));
+  for (int32 i = 0; i < result.positions.Num(); ++i) {
+    result.positions[i] = positions.VertexPosition(uint32(i));
+  }
+
+  const FIndexArrayView indices = lodResources.IndexBuffer.GetArrayView();
+  result.indices.SetNumUninitialized(indices.Num());
+  for (int32 i = 0; i < indices.Num(); ++i) {
+    result.indices[i] = indices[i];
+  }
+
+  return result;
+}
+
+CollisionMeshSource
+simplifyCollisionMesh(const CollisionMeshSource& source, float maximumError) {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::SimplifyCollisionMesh)
+  CollisionMeshSource result;
+  const size_t vertexCount = size_t(source.positions.Num());
+  const size_t indexCount = size_t(source.indices.Num());
+  if (vertexCount == 0 || indexCount == 0) {
+    return result;
+  }
+
+  // Weld the vertices that have exactly the same position.
+  TArray<uint32> remap;
+  remap.SetNumUninitialized(int32(vertexCount));
+  const size_t weldedCount = meshopt_generateVertexRemap(
+      remap.GetData(),
+      source.indices.GetData(),
+      indexCount,
+      source.positions.GetData(),
+      vertexCount,
+      sizeof(FVector3f));
+
+  TArray<FVector3f> welded;
+  welded.SetNumUninitialized(int32(weldedCount));
+  meshopt_remapVertexBuffer(
+      welded.GetData(),
+      source.positions.GetData(),
+      vertexCount,
+      sizeof(FVector3f),
+      remap.GetData());
+
+  TArray<uint32> weldedIndices;
+  weldedIndices.SetNumUninitialized(int32(indexCount));
+  meshopt_remapIndexBuffer(
+      weldedIndices.GetData(),
+      source.indices.GetData(),
+      indexCount,
+      remap.GetData());
+
+  // The error is relative to the size of the mesh.
+  const float scale = meshopt_simplifyScale(
+      &welded.GetData()->X,
+      weldedCount,
+      sizeof(FVector3f));
+  const float relativeError = scale > 0.0f ? maximumError / scale : 0.0f;
+
+  result.indices.SetNumUninitialized(int32(indexCount));
+  const size_t simplifiedCount = meshopt_simplify(
+      result.indices.GetData(),
+      weldedIndices.GetData(),
+      indexCount,
+      &welded.GetData()->X,
+      weldedCount,
+      sizeof(FVector3f),
+      0,
+      relativeError,
+      meshopt_SimplifyLockBorder,
+      nullptr);
+  result.indices.SetNum(int32(simplifiedCount));
+
+  // Drop the vertices that no triangle uses anymore.
+  result.positions.SetNumUninitialized(int32(weldedCount));
+  const size_t usedCount = meshopt_optimizeVertexFetch(
+      result.positions.GetData(),
+      result.indices.GetData(),
+      simplifiedCount,
+      welded.GetData(),
+      weldedCount,
+      sizeof(FVector3f));
+  result.positions.SetNum(int32(usedCount));
+
+  return result;
+}
+
+float unrealToMeshDistance(double distance, const glm::dmat4& meshToGltf) {
+  const double scale = glm::max(
+      glm::max(
+          glm::length(glm::dvec3(meshToGltf[0])),
+          glm::length(glm::dvec3(meshToGltf[1]))),
+      glm::length(glm::dvec3(meshToGltf[2])));
+  const double metersPerUnrealUnit = 0.01;
+  return scale > 0.0 ? float(distance * metersPerUnrealUnit / scale) : 0.0f;
+}
+
+CollisionMeshPtr
+buildCollisionMesh(const FStaticMeshLODResources& lodResources) {
+  return buildCollisionMesh(
+      lodResources.VertexBuffers.PositionVertexBuffer,
+      lodResources.IndexBuffer.GetArrayView());
+}
+
+CollisionMeshPtr buildCollisionMesh(const CollisionMeshSource& source) {
+  return buildCollisionMesh(source.positions, source.indices);
+}
+
+} // namespace CesiumPhysicsMeshUtility
@@ -0,0 +1,99 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Chaos/TriangleMeshImplicitObject.h"
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "StaticMeshResources.h"
+#include <glm/mat4x4.hpp>
+
+/**
+ * Functions that cook the Chaos collision meshes of tiles.
+ *
+ * A collision mesh is either cooked from the render data of a primitive while
+ * the primitive is loaded, or later, from a copy of its triangles that is kept
+ * on the CPU until collision is needed.
+ */
+namespace CesiumPhysicsMeshUtility {
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+using CollisionMeshPtr = Chaos::FTriangleMeshImplicitObjectPtr;
+#else
+using CollisionMeshPtr =
+    TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>;
+#endif
+
+/**
+ * The triangles of a primitive's mesh, kept on the CPU so that its collision
+ * mesh can be cooked once it is needed. The render data doesn't keep its
+ * positions and indices on the CPU once they are uploaded.
+ */
+struct CollisionMeshSource {
+  /**
+   * The positions of the vertices, in the mesh's coordinates.
+   */
+  TArray<FVector3f> positions;
+
+  /**
+   * The indices of the triangles, in the winding order of the index buffer.
+   */
+  TArray<uint32> indices;
+
+  /**
+   * Gets the number of bytes used by the positions and indices.
+   */
+  SIZE_T getSizeBytes() const;
+};
+
+/**
+ * Copies the triangles of a mesh, so that its collision mesh can be cooked
+ * after its render data no longer has them.
+ */
+CollisionMeshSource
+copyCollisionMeshSource(const FStaticMeshLODResources& lodResources);
+
+/**
+ * Simplifies the triangles of a collision mesh.
+ *
+ * Vertices at the same position are welded first, which undoes the copies
+ * made for flat normals and tangents, and for other attributes that the
+ * collision mesh doesn't need. The welded mesh is then decimated by
+ * collapsing edges in the order of their quadric error, until the next
+ * collapse would move the surface further than the given error. The vertices
+ * on the border of the mesh are kept in place, so that the collision meshes
+ * of neighboring tiles still meet.
+ *
+ * @param source The triangles to simplify.
+ * @param maximumError The largest distance, in the coordinates of the mesh,
+ * that the simplified surface may deviate from the original one.
+ * @return The simplified triangles, which only contain the vertices they use.
+ */
+CollisionMeshSource
+simplifyCollisionMesh(const CollisionMeshSource& source, float maximumError);
+
+/**
+ * Converts a distance in Unreal units (centimeters) to the coordinates of a
+ * primitive's mesh.
+ *
+ * @param distance The distance in Unreal units.
+ * @param meshToGltf The transform from the coordinates of the mesh to those of
+ * the glTF (meters), including the scale of the node. Its largest scale is
+ * used, so that the converted distance is never longer than the original one.
+ */
+float unrealToMeshDistance(double distance, const glm::dmat4& meshToGltf);
+
+/**
+ * Cooks the collision mesh of the given render data. Returns nullptr if the
+ * render data has no triangles.
+ */
+CollisionMeshPtr
+buildCollisionMesh(const FStaticMeshLODResources& lodResources);
+
+/**
+ * Cooks the collision mesh of the given triangles. Returns nullptr if there
+ * are no triangles. This may be called from any thread.
+ */
+CollisionMeshPtr buildCollisionMesh(const CollisionMeshSource& source);
+
+} // namespace CesiumPhysicsMeshUtility
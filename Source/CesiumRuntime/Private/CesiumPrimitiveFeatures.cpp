@@ -28,14 +28,18 @@ FCesiumPrimitiveFeatures::FCesiumPrimitiveFeatures(
 
 const FCesiumPrimitiveFeatures&
 UCesiumPrimitiveFeaturesBlueprintLibrary::GetPrimitiveFeatures(
-    const UPrimitiveComponent* component) {
+    const UPrimitiveComponent* component,
+    int64 FaceIndex) {
   const UCesiumGltfPrimitiveComponent* pGltfComponent =
       Cast<UCesiumGltfPrimitiveComponent>(component);
   if (!IsValid(pGltfComponent)) {
     return EmptyPrimitiveFeatures;
   }
 
-  return pGltfComponent->getPrimitiveData().Features;
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(FaceIndex, primitiveFaceIndex);
+  return primData.Features;
 }
 
 const TArray<FCesiumFeatureIdSet>&
@@ -25,14 +25,18 @@ FCesiumPrimitiveMetadata::FCesiumPrimitiveMetadata(
 
 const FCesiumPrimitiveMetadata&
 UCesiumPrimitiveMetadataBlueprintLibrary::GetPrimitiveMetadata(
-    const UPrimitiveComponent* component) {
+    const UPrimitiveComponent* component,
+    int64 FaceIndex) {
   const UCesiumGltfPrimitiveComponent* pGltfComponent =
       Cast<UCesiumGltfPrimitiveComponent>(component);
   if (!IsValid(pGltfComponent)) {
     return EmptyPrimitiveMetadata;
   }
 
-  return pGltfComponent->getPrimitiveData().Metadata;
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pGltfComponent->getPrimitiveDataForFace(FaceIndex, primitiveFaceIndex);
+  return primData.Metadata;
 }
 
 const TArray<int64>&
@@ -0,0 +1,265 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitivePool.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumLifetime.h"
+#include "CesiumStats.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace {
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Pooled Components Reused"),
+    STAT_CesiumPooledComponentsReused,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Pooled Materials Reused"),
+    STAT_CesiumPooledMaterialsReused,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Pooled Components Missed"),
+    STAT_CesiumPooledComponentsMissed,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Pooled Materials Missed"),
+    STAT_CesiumPooledMaterialsMissed,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Pooled Components"),
+    STAT_CesiumPooledComponents,
+    STATGROUP_Cesium);
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Pooled Materials"),
+    STAT_CesiumPooledMaterials,
+    STATGROUP_Cesium);
+
+constexpr ERenameFlags renameFlags =
+    REN_DontCreateRedirectors | REN_ForceNoResetLoaders | REN_NonTransactional |
+    REN_DoNotDirty;
+
+void renameInto(UObject* pObject, UObject* pNewOuter, FName name) {
+  if (name.IsNone()) {
+    name = pObject->GetClass()->GetFName();
+  }
+  pObject->Rename(
+      *MakeUniqueObjectName(pNewOuter, pObject->GetClass(), name).ToString(),
+      pNewOuter,
+      renameFlags);
+}
+
+/**
+ * Resets the state of an unregistered component that the tile it belonged to,
+ * or users of that tile, may have changed, so that the next tile gets the
+ * component as if it were newly created.
+ */
+void resetComponent(UCesiumGltfPrimitiveComponent* pComponent) {
+  const UCesiumGltfPrimitiveComponent* pDefaults =
+      GetDefault<UCesiumGltfPrimitiveComponent>();
+
+  pComponent->SetVisibility(pDefaults->GetVisibleFlag());
+  pComponent->SetHiddenInGame(false);
+  pComponent->SetMobility(pDefaults->Mobility);
+  pComponent->CastShadow = pDefaults->CastShadow;
+  pComponent->bCastDynamicShadow = pDefaults->bCastDynamicShadow;
+  pComponent->SetCullDistance(pDefaults->LDMaxDrawDistance);
+  pComponent->EmptyOverrideMaterials();
+  pComponent->ComponentTags.Empty();
+
+  // The collision profile, enabled state, responses, and physics simulation
+  // are all part of the body instance.
+  pComponent->BodyInstance.CopyBodyInstancePropertiesFrom(
+      &pDefaults->BodyInstance);
+  pComponent->SetGenerateOverlapEvents(pDefaults->GetGenerateOverlapEvents());
+  pComponent->OnComponentHit.Clear();
+  pComponent->OnComponentBeginOverlap.Clear();
+  pComponent->OnComponentEndOverlap.Clear();
+
+  const FCustomPrimitiveData& customPrimitiveData =
+      pComponent->GetCustomPrimitiveData();
+  for (int32 i = 0; i < customPrimitiveData.Data.Num(); ++i) {
+    pComponent->SetCustomPrimitiveDataFloat(i, 0.0f);
+  }
+}
+} // namespace
+
+void UCesiumPrimitivePool::SetMaximumSize(int32 MaximumSize) {
+  this->_maximumSize = FMath::Max(MaximumSize, 0);
+  this->trim();
+}
+
+UCesiumGltfPrimitiveComponent* UCesiumPrimitivePool::AcquirePrimitiveComponent(
+    UCesiumGltfComponent* Gltf,
+    FName Name) {
+  if (this->_maximumSize > 0) {
+    for (int32 i = 0; i < this->Components.Num(); ++i) {
+      UCesiumGltfPrimitiveComponent* pComponent = this->Components[i];
+      if (!IsValid(pComponent)) {
+        this->Components.RemoveAt(i--);
+        DEC_DWORD_STAT(STAT_CesiumPooledComponents);
+        continue;
+      }
+
+      // The render thread may still be releasing the previous render data of
+      // the static mesh, and it can't be replaced until that's done.
+      UStaticMesh* pStaticMesh = pComponent->GetStaticMesh();
+      if (pStaticMesh &&
+          !pStaticMesh->ReleaseResourcesFence.IsFenceComplete()) {
+        continue;
+      }
+
+      this->Components.RemoveAt(i);
+      DEC_DWORD_STAT(STAT_CesiumPooledComponents);
+      INC_DWORD_STAT(STAT_CesiumPooledComponentsReused);
+      this->_componentHits.record(true);
+
+      renameInto(pComponent, Gltf, Name);
+      return pComponent;
+    }
+
+    INC_DWORD_STAT(STAT_CesiumPooledComponentsMissed);
+    this->_componentHits.record(false);
+  }
+
+  return NewObject<UCesiumGltfPrimitiveComponent>(Gltf, Name);
+}
+
+UMaterialInstanceDynamic* UCesiumPrimitivePool::AcquireMaterial(
+    UMaterialInterface* BaseMaterial,
+    FName Name) {
+  if (this->_maximumSize > 0) {
+    FCesiumPooledMaterials* pPooled = this->Materials.Find(BaseMaterial);
+    while (pPooled && !pPooled->Materials.IsEmpty()) {
+      UMaterialInstanceDynamic* pMaterial = pPooled->Materials.Pop();
+      --this->_materialCount;
+      DEC_DWORD_STAT(STAT_CesiumPooledMaterials);
+      if (!IsValid(pMaterial)) {
+        continue;
+      }
+
+      INC_DWORD_STAT(STAT_CesiumPooledMaterialsReused);
+      this->_materialHits.record(true);
+      return pMaterial;
+    }
+
+    INC_DWORD_STAT(STAT_CesiumPooledMaterialsMissed);
+    this->_materialHits.record(false);
+  }
+
+  return UMaterialInstanceDynamic::Create(BaseMaterial, nullptr, Name);
+}
+
+void UCesiumPrimitivePool::ReleasePrimitiveComponents(
+    UCesiumGltfComponent* Gltf) {
+  if (this->_maximumSize <= 0 || this->HasAnyFlags(RF_BeginDestroyed) ||
+      !IsValid(Gltf)) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ReleasePrimitiveComponents)
+
+  TArray<USceneComponent*> children = Gltf->GetAttachChildren();
+  for (USceneComponent* pChild : children) {
+    // Only plain primitive components are pooled. Points and instanced
+    // components are rare enough that they are simply destroyed.
+    if (!pChild || pChild->GetClass() !=
+                       UCesiumGltfPrimitiveComponent::StaticClass()) {
+      continue;
+    }
+
+    if (!this->releasePrimitiveComponent(
+            static_cast<UCesiumGltfPrimitiveComponent*>(pChild))) {
+      break;
+    }
+  }
+}
+
+bool UCesiumPrimitivePool::releasePrimitiveComponent(
+    UCesiumGltfPrimitiveComponent* pComponent) {
+  if (this->Components.Num() >= this->_maximumSize) {
+    return false;
+  }
+
+  if (pComponent->IsRegistered()) {
+    pComponent->UnregisterComponent();
+  }
+  pComponent->DetachFromComponent(
+      FDetachmentTransformRules::KeepRelativeTransform);
+  resetComponent(pComponent);
+
+  // Drop everything that refers to the tile's glTF, which is about to be
+  // freed.
+  CesiumPrimitiveData& primData = pComponent->getPrimitiveData();
+  primData.destroy();
+  primData.PositionAccessor = CesiumGltf::AccessorView<FVector3f>();
+  primData.IndexAccessor = CesiumGltf::IndexAccessorType();
+  primData.boundingVolume.reset();
+  pComponent->destroyMergedPrimitives();
+  pComponent->releaseQuantizedPositions();
+  pComponent->setCollisionMeshSource(nullptr);
+
+  UStaticMesh* pStaticMesh = pComponent->GetStaticMesh();
+  if (pStaticMesh) {
+    for (FStaticMaterial& material : pStaticMesh->GetStaticMaterials()) {
+      this->releaseMaterial(
+          Cast<UMaterialInstanceDynamic>(material.MaterialInterface));
+    }
+    pStaticMesh->GetStaticMaterials().Empty();
+
+    // The body setup and navigation collision are kept, so that the next
+    // primitive only has to fill them in. Invalidating the body setup drops
+    // the previous collision mesh and gives it a new GUID, which also makes
+    // the navigation collision gather its geometry again.
+    UBodySetup* pBodySetup = pStaticMesh->GetBodySetup();
+    if (pBodySetup) {
+      pBodySetup->InvalidatePhysicsData();
+    }
+
+    pStaticMesh->ReleaseResources();
+  }
+
+  renameInto(pComponent, this, NAME_None);
+  this->Components.Add(pComponent);
+  INC_DWORD_STAT(STAT_CesiumPooledComponents);
+  return true;
+}
+
+void UCesiumPrimitivePool::releaseMaterial(
+    UMaterialInstanceDynamic* pMaterial) {
+  if (!IsValid(pMaterial) || pMaterial->IsUnreachable()) {
+    return;
+  }
+
+  if (this->_materialCount >= this->_maximumSize) {
+    CesiumLifetime::destroy(pMaterial);
+    return;
+  }
+
+  pMaterial->ClearParameterValues();
+  this->Materials.FindOrAdd(pMaterial->Parent).Materials.Add(pMaterial);
+  ++this->_materialCount;
+  INC_DWORD_STAT(STAT_CesiumPooledMaterials);
+}
+
+void UCesiumPrimitivePool::trim() {
+  while (this->Components.Num() > this->_maximumSize) {
+    UCesiumGltfPrimitiveComponent* pComponent = this->Components.Pop();
+    DEC_DWORD_STAT(STAT_CesiumPooledComponents);
+    if (IsValid(pComponent)) {
+      CesiumLifetime::destroyComponentRecursively(pComponent);
+    }
+  }
+
+  for (auto& [pBaseMaterial, pooled] : this->Materials) {
+    while (this->_materialCount > this->_maximumSize &&
+           !pooled.Materials.IsEmpty()) {
+      UMaterialInstanceDynamic* pMaterial = pooled.Materials.Pop();
+      --this->_materialCount;
+      DEC_DWORD_STAT(STAT_CesiumPooledMaterials);
+      if (IsValid(pMaterial)) {
+        CesiumLifetime::destroy(pMaterial);
+      }
+    }
+  }
+}
@@ -0,0 +1,113 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "CesiumPrimitivePool.generated.h"
+
+class UCesiumGltfComponent;
+class UCesiumGltfPrimitiveComponent;
+class UMaterialInstanceDynamic;
+class UMaterialInterface;
+
+USTRUCT()
+struct FCesiumPooledMaterials {
+  GENERATED_BODY()
+
+  UPROPERTY()
+  TArray<UMaterialInstanceDynamic*> Materials;
+};
+
+/**
+ * Keeps the primitive components, static meshes, and dynamic material
+ * instances of unloaded tiles so that newly-loaded tiles of the same tileset
+ * can reuse them, instead of creating new objects and leaving the old ones to
+ * the garbage collector.
+ *
+ * A pooled component keeps its static mesh, which is refilled with the render
+ * data of the next primitive that uses it. Material instances are pooled
+ * separately by their base material, with their parameters cleared.
+ */
+UCLASS()
+class UCesiumPrimitivePool : public UObject {
+  GENERATED_BODY()
+
+public:
+  /**
+   * Sets the maximum number of components, and separately of material
+   * instances, that are kept in the pool. Objects in excess of a reduced
+   * maximum are destroyed. A maximum of zero disables pooling.
+   */
+  void SetMaximumSize(int32 MaximumSize);
+
+  /**
+   * Gets a primitive component for the given glTF component, either from the
+   * pool or newly created. A pooled component may already have a static mesh,
+   * which should be reused.
+   */
+  UCesiumGltfPrimitiveComponent*
+  AcquirePrimitiveComponent(UCesiumGltfComponent* Gltf, FName Name);
+
+  /**
+   * Gets a dynamic material instance of the given base material, either from
+   * the pool or newly created.
+   */
+  UMaterialInstanceDynamic*
+  AcquireMaterial(UMaterialInterface* BaseMaterial, FName Name);
+
+  /**
+   * Detaches the reusable primitive components of a glTF component that is
+   * about to be destroyed and moves them into the pool, along with their
+   * static meshes and materials. The remaining children are left in place to
+   * be destroyed with the glTF component.
+   */
+  void ReleasePrimitiveComponents(UCesiumGltfComponent* Gltf);
+
+  /**
+   * Gets the percentage of component requests to this pool that were served
+   * with a pooled component, or 0 if there were none.
+   */
+  float GetComponentHitRate() const { return this->_componentHits.getRate(); }
+
+  /**
+   * Gets the percentage of material requests to this pool that were served
+   * with a pooled material instance, or 0 if there were none.
+   */
+  float GetMaterialHitRate() const { return this->_materialHits.getRate(); }
+
+private:
+  /**
+   * Counts the requests that were served with a pooled object.
+   */
+  struct HitCounter {
+    uint64 hits = 0;
+    uint64 requests = 0;
+
+    void record(bool hit) {
+      this->hits += hit ? 1 : 0;
+      ++this->requests;
+    }
+
+    float getRate() const {
+      return this->requests > 0
+                 ? 100.0f * float(this->hits) / float(this->requests)
+                 : 0.0f;
+    }
+  };
+
+  bool releasePrimitiveComponent(UCesiumGltfPrimitiveComponent* pComponent);
+  void releaseMaterial(UMaterialInstanceDynamic* pMaterial);
+  void trim();
+
+  UPROPERTY()
+  TArray<UCesiumGltfPrimitiveComponent*> Components;
+
+  UPROPERTY()
+  TMap<UMaterialInterface*, FCesiumPooledMaterials> Materials;
+
+  int32 _maximumSize = 0;
+  int32 _materialCount = 0;
+  HitCounter _componentHits;
+  HitCounter _materialHits;
+};
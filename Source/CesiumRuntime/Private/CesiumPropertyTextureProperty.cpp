@@ -403,7 +403,8 @@ int64 UCesiumPropertyTexturePropertyBlueprintLibrary::
 
 int64 UCesiumPropertyTexturePropertyBlueprintLibrary::GetUnrealUVChannel(
     const UPrimitiveComponent* Component,
-    UPARAM(ref) const FCesiumPropertyTextureProperty& Property) {
+    UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+    int64 FaceIndex) {
   const UCesiumGltfPrimitiveComponent* pPrimitive =
       Cast<UCesiumGltfPrimitiveComponent>(Component);
   if (!pPrimitive) {
@@ -412,7 +413,9 @@ int64 UCesiumPropertyTexturePropertyBlueprintLibrary::GetUnrealUVChannel(
 
   int64_t texCoordSetIndex = UCesiumPropertyTexturePropertyBlueprintLibrary::
       GetGltfTextureCoordinateSetIndex(Property);
-  const CesiumPrimitiveData& primData = pPrimitive->getPrimitiveData();
+  int64 primitiveFaceIndex;
+  const CesiumPrimitiveData& primData =
+      pPrimitive->getPrimitiveDataForFace(FaceIndex, primitiveFaceIndex);
   auto textureCoordinateIndexIt =
       primData.GltfToUnrealTexCoordMap.find(texCoordSetIndex);
   if (textureCoordinateIndexIt == primData.GltfToUnrealTexCoordMap.end()) {
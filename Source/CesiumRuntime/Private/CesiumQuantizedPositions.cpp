@@ -0,0 +1,157 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumQuantizedPositions.h"
+#include "RenderingThread.h"
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+#define RHI_CREATE_BUFFER RHICmdList.CreateBuffer
+#define RHI_LOCK_BUFFER RHICmdList.LockBuffer
+#define RHI_UNLOCK_BUFFER RHICmdList.UnlockBuffer
+#else
+#define RHI_CREATE_BUFFER RHICreateBuffer
+#define RHI_LOCK_BUFFER RHILockBuffer
+#define RHI_UNLOCK_BUFFER RHIUnlockBuffer
+#endif
+
+namespace {
+constexpr float MaximumQuantizedValue = float(MAX_uint16);
+}
+
+FCesiumPositionQuantization
+FCesiumPositionQuantization::FromBounds(const FBox3f& Bounds) {
+  FCesiumPositionQuantization Result;
+  if (Bounds.IsValid) {
+    Result.Offset = Bounds.Min;
+    Result.Extent = Bounds.GetSize().GetMax();
+  }
+
+  // A mesh whose positions are all the same still needs an invertible
+  // dequantization matrix.
+  if (Result.Extent <= 0.0f) {
+    Result.Extent = 1.0f;
+  }
+
+  return Result;
+}
+
+FCesiumQuantizedPosition
+FCesiumPositionQuantization::Quantize(const FVector3f& Position) const {
+  const FVector3f Normalized = (Position - Offset) / Extent;
+  auto quantizeComponent = [](float Value) {
+    return uint16(FMath::RoundToInt32(
+        FMath::Clamp(Value, 0.0f, 1.0f) * MaximumQuantizedValue));
+  };
+  return FCesiumQuantizedPosition{
+      quantizeComponent(Normalized.X),
+      quantizeComponent(Normalized.Y),
+      quantizeComponent(Normalized.Z),
+      MAX_uint16};
+}
+
+FVector3f FCesiumPositionQuantization::Dequantize(
+    const FCesiumQuantizedPosition& Position) const {
+  return Offset + FVector3f(Position.X, Position.Y, Position.Z) *
+                      (Extent / MaximumQuantizedValue);
+}
+
+FMatrix FCesiumPositionQuantization::GetDequantizationMatrix() const {
+  return FScaleMatrix(FVector(Extent)) * FTranslationMatrix(FVector(Offset));
+}
+
+void FCesiumQuantizedPositionVertexBuffer::INIT_RHI_SIGNATURE {
+  const uint32 Size = Positions.Num() * sizeof(FCesiumQuantizedPosition);
+  if (Size == 0) {
+    return;
+  }
+
+  FRHIResourceCreateInfo CreateInfo(
+      TEXT("FCesiumQuantizedPositionVertexBuffer"));
+  VertexBufferRHI = RHI_CREATE_BUFFER(
+      Size,
+      BUF_Static | BUF_VertexBuffer,
+      sizeof(FCesiumQuantizedPosition),
+      ERHIAccess::VertexOrIndexBuffer,
+      CreateInfo);
+
+  void* Data = RHI_LOCK_BUFFER(VertexBufferRHI, 0, Size, RLM_WriteOnly);
+  FMemory::Memcpy(Data, Positions.GetData(), Size);
+  RHI_UNLOCK_BUFFER(VertexBufferRHI);
+
+  // The positions are only needed on the GPU from now on.
+  Positions.Empty();
+}
+
+FCesiumQuantizedPositions::FCesiumQuantizedPositions(
+    const FPositionVertexBuffer& Positions)
+    : VertexFactory(
+          GMaxRHIFeatureLevel,
+          "FCesiumQuantizedPositions::VertexFactory") {
+  const uint32 NumVertices = Positions.GetNumVertices();
+
+  FBox3f Bounds(ForceInit);
+  for (uint32 i = 0; i < NumVertices; ++i) {
+    Bounds += Positions.VertexPosition(i);
+  }
+  Quantization = FCesiumPositionQuantization::FromBounds(Bounds);
+
+  VertexBuffer.Positions.SetNumUninitialized(NumVertices);
+  for (uint32 i = 0; i < NumVertices; ++i) {
+    VertexBuffer.Positions[i] =
+        Quantization.Quantize(Positions.VertexPosition(i));
+  }
+}
+
+FCesiumQuantizedPositions::~FCesiumQuantizedPositions() {}
+
+void FCesiumQuantizedPositions::InitResources(
+    FRHICommandListImmediate& RHICmdList,
+    FStaticMeshLODResources& LODResources,
+    FStaticMeshVertexFactories& LODVertexFactories) {
+  check(IsInRenderingThread());
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  VertexBuffer.InitResource(RHICmdList);
+#else
+  VertexBuffer.InitResource();
+#endif
+
+  // Bind the same attributes as the LOD's own vertex factory, except for the
+  // positions.
+  FStaticMeshVertexBuffers& Buffers = LODResources.VertexBuffers;
+  FLocalVertexFactory::FDataType Data;
+  Buffers.StaticMeshVertexBuffer.BindTangentVertexBuffer(&VertexFactory, Data);
+  Buffers.StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(
+      &VertexFactory,
+      Data);
+  Buffers.StaticMeshVertexBuffer.BindLightMapVertexBuffer(
+      &VertexFactory,
+      Data,
+      0);
+  Buffers.ColorVertexBuffer.BindColorVertexBuffer(&VertexFactory, Data);
+  Data.PositionComponent = FVertexStreamComponent(
+      &VertexBuffer,
+      0,
+      sizeof(FCesiumQuantizedPosition),
+      VET_UShort4N);
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+  VertexFactory.SetData(RHICmdList, Data);
+  VertexFactory.InitResource(RHICmdList);
+#else
+  VertexFactory.SetData(Data);
+  VertexFactory.InitResource();
+#endif
+
+  // Releasing the vertex factories that refer to the full-precision positions
+  // frees the GPU memory of the positions. Releasing them again when the
+  // static mesh is released does nothing.
+  LODVertexFactories.VertexFactory.ReleaseResource();
+  LODVertexFactories.VertexFactoryOverrideColorVertexBuffer.ReleaseResource();
+  Buffers.PositionVertexBuffer.ReleaseResource();
+}
+
+void FCesiumQuantizedPositions::ReleaseResources() {
+  check(IsInRenderingThread());
+  VertexFactory.ReleaseResource();
+  VertexBuffer.ReleaseResource();
+}
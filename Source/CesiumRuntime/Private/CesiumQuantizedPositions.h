@@ -0,0 +1,138 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "LocalVertexFactory.h"
+#include "Math/Box.h"
+#include "RHIResources.h"
+#include "Rendering/PositionVertexBuffer.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "StaticMeshResources.h"
+
+#if ENGINE_VERSION_5_3_OR_HIGHER
+#define INIT_RHI_SIGNATURE InitRHI(FRHICommandListBase& RHICmdList)
+#else
+#define INIT_RHI_SIGNATURE InitRHI()
+#endif
+
+/**
+ * A position quantized to 16 bits per component. The vertex declaration reads
+ * it as normalized unsigned shorts, so each component is in the range [0, 1].
+ * W is always the largest value, so that it reads as 1.0 like the W of a
+ * full-precision position.
+ */
+struct FCesiumQuantizedPosition {
+  uint16 X;
+  uint16 Y;
+  uint16 Z;
+  uint16 W;
+};
+
+/**
+ * How the positions within a bounding box are mapped to quantized positions.
+ * All three axes share a single scale, so dequantizing a mesh with a
+ * translation and a uniform scale leaves its normals and tangents unchanged.
+ */
+struct FCesiumPositionQuantization {
+  /**
+   * The position that is quantized to zero.
+   */
+  FVector3f Offset = FVector3f::ZeroVector;
+
+  /**
+   * The distance from the offset, along each axis, that is quantized to the
+   * largest value.
+   */
+  float Extent = 0.0f;
+
+  /**
+   * Creates the quantization that covers the given bounding box.
+   */
+  static FCesiumPositionQuantization FromBounds(const FBox3f& Bounds);
+
+  FCesiumQuantizedPosition Quantize(const FVector3f& Position) const;
+  FVector3f Dequantize(const FCesiumQuantizedPosition& Position) const;
+
+  /**
+   * Gets the matrix that transforms normalized quantized positions, as they
+   * are read by the vertex shader, to the positions they were quantized from.
+   */
+  FMatrix GetDequantizationMatrix() const;
+};
+
+/**
+ * A vertex buffer of quantized positions. Like a FPositionVertexBuffer
+ * without CPU access, it discards its positions once they are uploaded.
+ */
+class FCesiumQuantizedPositionVertexBuffer : public FVertexBuffer {
+public:
+  TArray<FCesiumQuantizedPosition> Positions;
+
+  virtual void INIT_RHI_SIGNATURE override;
+};
+
+/**
+ * The positions of a tile mesh quantized to 16 bits per component, along
+ * with a vertex factory that reads them in place of the mesh's full-precision
+ * positions. All other vertex attributes are still read from the mesh's own
+ * vertex buffers.
+ *
+ * The vertex factory yields positions in the unit cube, so the mesh must be
+ * drawn with the dequantization matrix applied before its local-to-world
+ * transform. Only the tileset scene proxy does that; static mesh scene
+ * proxies always draw the full-precision positions. Collision and picking
+ * aren't affected, because they use the full-precision positions of the
+ * collision mesh and the glTF.
+ */
+class FCesiumQuantizedPositions {
+public:
+  /**
+   * Quantizes the given positions to the bounding box that encloses them.
+   */
+  explicit FCesiumQuantizedPositions(const FPositionVertexBuffer& Positions);
+  ~FCesiumQuantizedPositions();
+
+  FCesiumQuantizedPositions(const FCesiumQuantizedPositions&) = delete;
+  FCesiumQuantizedPositions&
+  operator=(const FCesiumQuantizedPositions&) = delete;
+
+  const FCesiumPositionQuantization& GetQuantization() const {
+    return Quantization;
+  }
+
+  /**
+   * Gets the quantized positions. They are empty once the resources are
+   * initialized.
+   */
+  const TArray<FCesiumQuantizedPosition>& GetPositions() const {
+    return VertexBuffer.Positions;
+  }
+
+  const FLocalVertexFactory& GetVertexFactory() const { return VertexFactory; }
+
+  /**
+   * Uploads the quantized positions and initializes the vertex factory with
+   * the other attributes of the given LOD. The LOD's full-precision position
+   * buffer and vertex factory are released, because the mesh is only drawn
+   * with this vertex factory from now on.
+   *
+   * Must be called on the render thread, after the LOD's resources are
+   * initialized.
+   */
+  void InitResources(
+      FRHICommandListImmediate& RHICmdList,
+      FStaticMeshLODResources& LODResources,
+      FStaticMeshVertexFactories& LODVertexFactories);
+
+  /**
+   * Releases the vertex buffer and vertex factory. Must be called on the
+   * render thread, once the vertex factory is no longer drawn.
+   */
+  void ReleaseResources();
+
+private:
+  FCesiumPositionQuantization Quantization;
+  FCesiumQuantizedPositionVertexBuffer VertexBuffer;
+  FLocalVertexFactory VertexFactory;
+};
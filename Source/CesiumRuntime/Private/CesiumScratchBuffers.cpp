@@ -0,0 +1,116 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScratchBuffers.h"
+#include "CesiumStats.h"
+#include <atomic>
+
+namespace {
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Scratch Arrays Borrowed"),
+    STAT_CesiumScratchArraysBorrowed,
+    STATGROUP_Cesium);
+DECLARE_DWORD_COUNTER_STAT(
+    TEXT("Scratch Arrays Reused"),
+    STAT_CesiumScratchArraysReused,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("Scratch Memory Retained"),
+    STAT_CesiumScratchMemoryRetained,
+    STATGROUP_Cesium);
+
+std::atomic<uint64> borrowedCount{0};
+std::atomic<uint64> reusedCount{0};
+std::atomic<int64> retainedByteCount{0};
+
+// Incremented whenever any thread finishes loading a tile.
+std::atomic<uint32> tileEpoch{0};
+
+/**
+ * The pools of a single thread, one for each type of array element.
+ */
+struct ThreadPools {
+  TArray<TUniquePtr<CesiumScratchBuffers::Private::PoolBase>> pools;
+  int64 retainedBytes = 0;
+
+  // The tile epoch in which this thread last released unused arrays.
+  uint32 tile = tileEpoch;
+
+  ~ThreadPools() {
+    retainedByteCount -= this->retainedBytes;
+    DEC_MEMORY_STAT_BY(STAT_CesiumScratchMemoryRetained, this->retainedBytes);
+  }
+};
+
+ThreadPools& getThreadPools() {
+  static thread_local ThreadPools threadPools;
+  return threadPools;
+}
+
+void releaseUnused(ThreadPools& threadPools, uint32 tile) {
+  // Keep the arrays that were used during the previous or the current epoch.
+  for (const TUniquePtr<CesiumScratchBuffers::Private::PoolBase>& pPool :
+       threadPools.pools) {
+    pPool->releaseUnused(tile - 1);
+  }
+  threadPools.tile = tile;
+}
+} // namespace
+
+namespace CesiumScratchBuffers {
+
+Counters getCounters() {
+  Counters result;
+  result.borrowed = borrowedCount;
+  result.reused = reusedCount;
+  result.retainedBytes = retainedByteCount;
+  return result;
+}
+
+void endTile() { releaseUnused(getThreadPools(), ++tileEpoch); }
+
+namespace Private {
+
+void addPool(TUniquePtr<PoolBase>&& pPool) {
+  getThreadPools().pools.Add(MoveTemp(pPool));
+}
+
+uint32 getCurrentTile() { return tileEpoch; }
+
+void releaseUnusedIfNewTile() {
+  ThreadPools& threadPools = getThreadPools();
+  const uint32 tile = tileEpoch;
+  if (threadPools.tile != tile) {
+    releaseUnused(threadPools, tile);
+  }
+}
+
+void countBorrowed(bool reused) {
+  ++borrowedCount;
+  INC_DWORD_STAT(STAT_CesiumScratchArraysBorrowed);
+  if (reused) {
+    ++reusedCount;
+    INC_DWORD_STAT(STAT_CesiumScratchArraysReused);
+  }
+}
+
+bool tryRetain(int64 bytes) {
+  ThreadPools& threadPools = getThreadPools();
+  if (threadPools.retainedBytes + bytes > MaximumRetainedBytesPerThread) {
+    return false;
+  }
+
+  threadPools.retainedBytes += bytes;
+  retainedByteCount += bytes;
+  INC_MEMORY_STAT_BY(STAT_CesiumScratchMemoryRetained, bytes);
+  return true;
+}
+
+void forget(int64 bytes) {
+  getThreadPools().retainedBytes -= bytes;
+  retainedByteCount -= bytes;
+  DEC_MEMORY_STAT_BY(STAT_CesiumScratchMemoryRetained, bytes);
+}
+
+} // namespace Private
+
+} // namespace CesiumScratchBuffers
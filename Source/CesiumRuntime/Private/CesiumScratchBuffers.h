@@ -0,0 +1,168 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+
+/**
+ * Per-thread pools of the temporary arrays used while loading tiles.
+ *
+ * Loading a glTF primitive needs several arrays, such as its indices and
+ * vertex attributes, that are only used until its vertex and index buffers
+ * are built. Borrowing them from the pool of the loading thread keeps their
+ * memory around for the next primitive instead of allocating and freeing it
+ * for every primitive. Each thread retains at most
+ * `MaximumRetainedBytesPerThread` bytes.
+ *
+ * Every loaded tile, no matter which thread loaded it, starts a new tile
+ * epoch. Arrays that weren't used during the previous or the current epoch
+ * are released by the next thread that ends a tile or borrows from its
+ * pool, so that threads that only help with parts of a tile, such as
+ * ParallelFor workers, trim their pools as well.
+ */
+namespace CesiumScratchBuffers {
+
+/**
+ * The maximum number of bytes of array memory that the pool of a single
+ * thread retains.
+ */
+constexpr int64 MaximumRetainedBytesPerThread = 32 * 1024 * 1024;
+
+/**
+ * Counts the use of the pools of all threads since startup.
+ */
+struct Counters {
+  /**
+   * The number of arrays that were borrowed.
+   */
+  uint64 borrowed = 0;
+
+  /**
+   * The number of borrowed arrays that already had memory allocated, because
+   * they were used before.
+   */
+  uint64 reused = 0;
+
+  /**
+   * The number of bytes of array memory currently retained by all pools.
+   */
+  int64 retainedBytes = 0;
+};
+
+/**
+ * Gets the counters of all pools.
+ */
+Counters getCounters();
+
+/**
+ * Starts a new tile epoch, and releases the arrays of the calling thread's
+ * pool that were not used since the start of the previous epoch. This is
+ * called after each tile is loaded.
+ */
+void endTile();
+
+namespace Private {
+
+class PoolBase {
+public:
+  virtual ~PoolBase() = default;
+  virtual void releaseUnused(uint32 oldestTileToKeep) = 0;
+};
+
+void addPool(TUniquePtr<PoolBase>&& pPool);
+uint32 getCurrentTile();
+void releaseUnusedIfNewTile();
+void countBorrowed(bool reused);
+bool tryRetain(int64 bytes);
+void forget(int64 bytes);
+
+template <typename T> class Pool : public PoolBase {
+public:
+  static Pool& get() {
+    static thread_local Pool* pPool = nullptr;
+    if (!pPool) {
+      pPool = new Pool();
+      addPool(TUniquePtr<PoolBase>(pPool));
+    }
+    return *pPool;
+  }
+
+  TArray<T> acquire() {
+    releaseUnusedIfNewTile();
+
+    TArray<T> result;
+    if (this->_arrays.Num() > 0) {
+      result = this->_arrays.Pop().array;
+      forget(result.GetAllocatedSize());
+    }
+    countBorrowed(result.Max() > 0);
+    return result;
+  }
+
+  void release(TArray<T>&& array) {
+    array.Reset();
+    const int64 bytes = array.GetAllocatedSize();
+    if (bytes > 0 && tryRetain(bytes)) {
+      this->_arrays.Add({MoveTemp(array), getCurrentTile()});
+    }
+  }
+
+  virtual void releaseUnused(uint32 oldestTileToKeep) override {
+    for (int32 i = this->_arrays.Num() - 1; i >= 0; --i) {
+      // The difference handles tile epochs that wrapped around.
+      if (int32(this->_arrays[i].tile - oldestTileToKeep) < 0) {
+        forget(this->_arrays[i].array.GetAllocatedSize());
+        this->_arrays.RemoveAt(i);
+      }
+    }
+  }
+
+private:
+  struct Entry {
+    TArray<T> array;
+    // The tile epoch during which the array was last returned.
+    uint32 tile;
+  };
+
+  TArray<Entry> _arrays;
+};
+
+} // namespace Private
+
+/**
+ * Borrows an empty array from the calling thread's pool. It should be
+ * returned with {@link release} once it is no longer needed.
+ */
+template <typename T> TArray<T> acquire() {
+  return Private::Pool<T>::get().acquire();
+}
+
+/**
+ * Returns an array to the calling thread's pool, which keeps its memory for
+ * the next {@link acquire} if the pool isn't full.
+ */
+template <typename T> void release(TArray<T>&& array) {
+  Private::Pool<T>::get().release(MoveTemp(array));
+}
+
+/**
+ * An array borrowed from the calling thread's pool for as long as this
+ * object exists.
+ */
+template <typename T> class TScratchArray {
+public:
+  TScratchArray() : _array(acquire<T>()) {}
+  ~TScratchArray() { release(MoveTemp(this->_array)); }
+
+  TScratchArray(const TScratchArray&) = delete;
+  TScratchArray& operator=(const TScratchArray&) = delete;
+
+  TArray<T>& get() { return this->_array; }
+  const TArray<T>& get() const { return this->_array; }
+
+private:
+  TArray<T> _array;
+};
+
+} // namespace CesiumScratchBuffers
@@ -0,0 +1,11 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Stats/Stats.h"
+
+/**
+ * The stats group for the Cesium runtime, shown with `stat Cesium`. Individual
+ * stats are declared in the translation units that update them.
+ */
+DECLARE_STATS_GROUP(TEXT("Cesium"), STATGROUP_Cesium, STATCAT_Advanced);
@@ -27,6 +27,7 @@
 #include <CesiumGltf/Ktx2TranscodeTargets.h>
 #include <CesiumGltfReader/GltfReader.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <mutex>
 
 namespace {
 
@@ -39,6 +40,10 @@ struct ExtensionUnrealTexture {
       pTexture = nullptr;
 };
 
+// Primitives of the same model may be loaded in parallel, and they may share
+// textures. This protects the extensions that track the Unreal textures.
+std::mutex textureExtensionMutex;
+
 } // namespace
 
 namespace CesiumTextureUtility {
@@ -158,18 +163,32 @@ TUniquePtr<LoadedTextureResult> loadTextureFromModelAnyThreadPart(
     textureIndex = -1;
   }
 
-  ExtensionUnrealTexture& extension =
-      texture.addExtension<ExtensionUnrealTexture>();
-  if (extension.pTexture && (extension.pTexture->getUnrealTexture() ||
-                             extension.pTexture->getTextureResource())) {
-    // There's an existing Unreal texture for this glTF texture. This will
-    // happen if this texture is used by multiple primitives on the same
-    // model. It will also be the case when this model was upsampled from a
-    // parent tile.
+  auto getExistingTexture =
+      [&texture, textureIndex]() -> TUniquePtr<LoadedTextureResult> {
+    const ExtensionUnrealTexture* pExtension =
+        texture.getExtension<ExtensionUnrealTexture>();
+    if (!pExtension || !pExtension->pTexture ||
+        (!pExtension->pTexture->getUnrealTexture() &&
+         !pExtension->pTexture->getTextureResource())) {
+      return nullptr;
+    }
+
     TUniquePtr<LoadedTextureResult> pResult = MakeUnique<LoadedTextureResult>();
-    pResult->pTexture = extension.pTexture;
+    pResult->pTexture = pExtension->pTexture;
     pResult->textureIndex = textureIndex;
     return pResult;
+  };
+
+  {
+    std::scoped_lock lock(textureExtensionMutex);
+    TUniquePtr<LoadedTextureResult> pExisting = getExistingTexture();
+    if (pExisting) {
+      // There's an existing Unreal texture for this glTF texture. This will
+      // happen if this texture is used by multiple primitives on the same
+      // model. It will also be the case when this model was upsampled from a
+      // parent tile.
+      return pExisting;
+    }
   }
 
   std::optional<int32_t> optionalSourceIndex =
@@ -182,11 +201,21 @@ TUniquePtr<LoadedTextureResult> loadTextureFromModelAnyThreadPart(
   const CesiumGltf::Sampler& sampler =
       model.getSafe(model.samplers, texture.sampler);
 
+  // The texture is prepared without holding the lock, so that the textures of
+  // other primitives and tiles can be prepared at the same time.
   TUniquePtr<LoadedTextureResult> result =
       loadTextureFromImageAndSamplerAnyThreadPart(*image.pAsset, sampler, sRGB);
 
   if (result) {
-    extension.pTexture = result->pTexture;
+    std::scoped_lock lock(textureExtensionMutex);
+    TUniquePtr<LoadedTextureResult> pExisting = getExistingTexture();
+    if (pExisting) {
+      // Another primitive prepared the same texture in the meantime, so use
+      // that one instead.
+      return pExisting;
+    }
+
+    texture.addExtension<ExtensionUnrealTexture>().pTexture = result->pTexture;
     result->textureIndex = textureIndex;
   }
 
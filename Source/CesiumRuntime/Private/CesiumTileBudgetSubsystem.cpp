@@ -0,0 +1,259 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileBudgetSubsystem.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
+#include "RenderCore.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+DECLARE_DWORD_ACCUMULATOR_STAT(
+    TEXT("Tilesets Sharing Budget"),
+    STAT_CesiumTilesetsSharingBudget,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("World Tile Cache Bytes"),
+    STAT_CesiumWorldTileCacheBytes,
+    STATGROUP_Cesium);
+DECLARE_MEMORY_STAT(
+    TEXT("World Rendered Tile Bytes"),
+    STAT_CesiumWorldRenderedTileBytes,
+    STATGROUP_Cesium);
+
+// A tileset that hasn't reported its usage for this many frames, for example
+// because its updates are suspended, no longer receives a share of the budget.
+constexpr uint64 maximumFramesWithoutReport = 2;
+
+/**
+ * Splits `total` into integer shares proportional to the given weights, using
+ * the largest remainder method so that the shares add up to `total`. If all
+ * weights are zero, everything is split evenly instead.
+ */
+template <typename T>
+std::vector<T> splitProportionally(T total, std::vector<double> weights) {
+  std::vector<T> shares(weights.size(), T(0));
+  if (weights.empty() || total <= T(0)) {
+    return shares;
+  }
+
+  double weightSum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  if (weightSum <= 0.0) {
+    std::fill(weights.begin(), weights.end(), 1.0);
+    weightSum = double(weights.size());
+  }
+
+  std::vector<std::pair<double, size_t>> remainders;
+  remainders.reserve(weights.size());
+
+  T assigned = T(0);
+  for (size_t i = 0; i < weights.size(); ++i) {
+    double exact = double(total) * weights[i] / weightSum;
+    double whole = std::floor(exact);
+    shares[i] = T(whole);
+    assigned += shares[i];
+    remainders.emplace_back(exact - whole, i);
+  }
+
+  std::sort(
+      remainders.begin(),
+      remainders.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+  for (size_t i = 0; assigned < total && i < remainders.size(); ++i) {
+    ++shares[remainders[i].second];
+    ++assigned;
+  }
+
+  return shares;
+}
+} // namespace
+
+void UCesiumTileBudgetSubsystem::Deinitialize() {
+  DEC_DWORD_STAT_BY(STAT_CesiumTilesetsSharingBudget, this->_tilesets.Num());
+  this->_tilesets.Empty();
+  Super::Deinitialize();
+}
+
+bool UCesiumTileBudgetSubsystem::IsEnabled() const {
+  return GetDefault<UCesiumRuntimeSettings>()->UseWorldTileBudget;
+}
+
+UCesiumTileBudgetSubsystem::TilesetAllocation
+UCesiumTileBudgetSubsystem::GetAllocation(const ACesium3DTileset* pTileset) {
+  this->updateIfNewFrame();
+
+  TilesetEntry* pEntry = this->findEntry(pTileset);
+  if (!pEntry) {
+    // A new tileset hasn't rendered anything yet, so it only competes with its
+    // priority until it reports its usage.
+    TilesetEntry& entry = this->_tilesets.Emplace_GetRef();
+    entry.pTileset = pTileset;
+    entry.usage.priority = pTileset->TileBudgetPriority;
+    entry.lastReportedFrame = GFrameCounter;
+    INC_DWORD_STAT(STAT_CesiumTilesetsSharingBudget);
+
+    this->updateAllocations();
+    pEntry = &this->_tilesets.Last();
+  }
+
+  return pEntry->allocation;
+}
+
+void UCesiumTileBudgetSubsystem::ReportUsage(
+    const ACesium3DTileset* pTileset,
+    const TilesetUsage& usage) {
+  TilesetEntry* pEntry = this->findEntry(pTileset);
+  if (!pEntry) {
+    return;
+  }
+
+  pEntry->usage = usage;
+  pEntry->lastReportedFrame = GFrameCounter;
+}
+
+void UCesiumTileBudgetSubsystem::RemoveTileset(
+    const ACesium3DTileset* pTileset) {
+  int32 removed = this->_tilesets.RemoveAll(
+      [pTileset](const TilesetEntry& entry) {
+        return entry.pTileset.Get() == pTileset;
+      });
+  DEC_DWORD_STAT_BY(STAT_CesiumTilesetsSharingBudget, removed);
+}
+
+/*static*/ std::vector<UCesiumTileBudgetSubsystem::TilesetAllocation>
+UCesiumTileBudgetSubsystem::ComputeAllocations(
+    const std::vector<TilesetUsage>& usages,
+    int64 maximumCachedBytes,
+    int64 minimumSpareBytesPerTileset,
+    int32 maximumSimultaneousTileLoads) {
+  std::vector<TilesetAllocation> allocations(usages.size());
+  if (usages.empty()) {
+    return allocations;
+  }
+
+  // The rendered tiles are kept no matter what, so only the remainder of the
+  // cache is actually up for distribution. It goes mostly to the tilesets
+  // that are rendering the most, because they are the most likely to need
+  // more tiles near the ones they render.
+  int64 renderedBytes = 0;
+  std::vector<double> cacheWeights;
+  cacheWeights.reserve(usages.size());
+  for (const TilesetUsage& usage : usages) {
+    int64 rendered = std::max(usage.renderedBytes, int64(0));
+    renderedBytes += rendered;
+    cacheWeights.push_back(std::max(usage.priority, 0.0) * double(rendered));
+  }
+
+  if (std::all_of(cacheWeights.begin(), cacheWeights.end(), [](double w) {
+        return w <= 0.0;
+      })) {
+    for (size_t i = 0; i < usages.size(); ++i) {
+      cacheWeights[i] = std::max(usages[i].priority, 0.0);
+    }
+  }
+
+  // Every tileset keeps a little spare cache, even if it rendered nothing
+  // recently, so that its tiles aren't all unloaded while it's briefly idle.
+  const int64 tilesets = int64(usages.size());
+  int64 availableBytes = std::max(maximumCachedBytes - renderedBytes, int64(0));
+  int64 minimumSpareBytes = std::clamp(
+      minimumSpareBytesPerTileset,
+      int64(0),
+      availableBytes / tilesets);
+  std::vector<int64> spareBytes = splitProportionally(
+      availableBytes - minimumSpareBytes * tilesets,
+      std::move(cacheWeights));
+
+  // Every tileset may load one tile at a time so that it can make progress,
+  // and the rest of the loads go to the tilesets that are waiting for the
+  // most tiles.
+  std::vector<double> loadWeights;
+  loadWeights.reserve(usages.size());
+  for (const TilesetUsage& usage : usages) {
+    loadWeights.push_back(
+        std::max(usage.priority, 0.0) * double(usage.tilesWaitingToLoad));
+  }
+
+  if (std::all_of(loadWeights.begin(), loadWeights.end(), [](double w) {
+        return w <= 0.0;
+      })) {
+    for (size_t i = 0; i < usages.size(); ++i) {
+      loadWeights[i] = std::max(usages[i].priority, 0.0);
+    }
+  }
+
+  std::vector<int32> extraLoads = splitProportionally(
+      std::max(maximumSimultaneousTileLoads - int32(usages.size()), 0),
+      std::move(loadWeights));
+
+  for (size_t i = 0; i < usages.size(); ++i) {
+    allocations[i].maximumCachedBytes =
+        std::max(usages[i].renderedBytes, int64(0)) + minimumSpareBytes +
+        spareBytes[i];
+    allocations[i].maximumSimultaneousTileLoads = 1 + extraLoads[i];
+  }
+
+  return allocations;
+}
+
+bool UCesiumTileBudgetSubsystem::DoesSupportWorldType(
+    const EWorldType::Type WorldType) const {
+  return WorldType == EWorldType::Game || WorldType == EWorldType::Editor ||
+         WorldType == EWorldType::PIE || WorldType == EWorldType::GamePreview ||
+         WorldType == EWorldType::EditorPreview;
+}
+
+UCesiumTileBudgetSubsystem::TilesetEntry*
+UCesiumTileBudgetSubsystem::findEntry(const ACesium3DTileset* pTileset) {
+  return this->_tilesets.FindByPredicate([pTileset](const TilesetEntry& entry) {
+    return entry.pTileset.Get() == pTileset;
+  });
+}
+
+void UCesiumTileBudgetSubsystem::updateIfNewFrame() {
+  if (this->_frame == GFrameCounter) {
+    return;
+  }
+
+  this->_frame = GFrameCounter;
+
+  int32 removed = this->_tilesets.RemoveAll([](const TilesetEntry& entry) {
+    return !entry.pTileset.IsValid() ||
+           entry.lastReportedFrame + maximumFramesWithoutReport < GFrameCounter;
+  });
+  DEC_DWORD_STAT_BY(STAT_CesiumTilesetsSharingBudget, removed);
+
+  this->updateAllocations();
+}
+
+void UCesiumTileBudgetSubsystem::updateAllocations() {
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::UpdateTileBudgetAllocations)
+
+  std::vector<TilesetUsage> usages;
+  usages.reserve(this->_tilesets.Num());
+
+  int64 totalBytes = 0;
+  int64 renderedBytes = 0;
+  for (const TilesetEntry& entry : this->_tilesets) {
+    usages.push_back(entry.usage);
+    totalBytes += entry.usage.totalBytes;
+    renderedBytes += entry.usage.renderedBytes;
+  }
+
+  SET_MEMORY_STAT(STAT_CesiumWorldTileCacheBytes, totalBytes);
+  SET_MEMORY_STAT(STAT_CesiumWorldRenderedTileBytes, renderedBytes);
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  std::vector<TilesetAllocation> allocations = ComputeAllocations(
+      usages,
+      pSettings->WorldMaximumCachedBytes,
+      pSettings->WorldMinimumCachedBytesPerTileset,
+      pSettings->WorldMaximumSimultaneousTileLoads);
+
+  for (int32 i = 0; i < this->_tilesets.Num(); ++i) {
+    this->_tilesets[i].allocation = allocations[i];
+  }
+}
@@ -0,0 +1,158 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileLoadingBudget.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumStats.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "RenderCore.h"
+#include <algorithm>
+
+namespace {
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Tile Loading Budget (ms)"),
+    STAT_CesiumTileLoadingBudget,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Tile Loading Time Used (ms)"),
+    STAT_CesiumTileLoadingTimeUsed,
+    STATGROUP_Cesium);
+DECLARE_FLOAT_COUNTER_STAT(
+    TEXT("Tile Unloading Time Used (ms)"),
+    STAT_CesiumTileUnloadingTimeUsed,
+    STATGROUP_Cesium);
+
+// The budget never drops below this, because a limit of zero means "no limit"
+// to cesium-native.
+constexpr double minimumRemainingMilliseconds = 0.001;
+
+// How quickly the smoothed frame time follows the measured frame time.
+constexpr double frameTimeSmoothing = 0.1;
+
+// How much the budget changes per frame for each millisecond of difference
+// between the target and smoothed frame times.
+constexpr double budgetGain = 0.1;
+} // namespace
+
+/*static*/ CesiumTileLoadingBudget::FrameBudget&
+CesiumTileLoadingBudget::FrameBudget::get() {
+  static FrameBudget budget;
+  return budget;
+}
+
+void CesiumTileLoadingBudget::FrameBudget::beginFrame(
+    uint64 frame,
+    double frameTimeMilliseconds) {
+  if (this->_frame == frame) {
+    return;
+  }
+
+  this->_frame = frame;
+  this->_tilesetsInLastFrame = std::max(this->_tilesetsInFrame, 1u);
+  this->_tilesetsInFrame = 0;
+
+  if (!CesiumTileLoadingBudget::isEnabled()) {
+    return;
+  }
+
+  if (this->_smoothedFrameTime <= 0.0) {
+    this->_smoothedFrameTime = frameTimeMilliseconds;
+  } else {
+    this->_smoothedFrameTime +=
+        (frameTimeMilliseconds - this->_smoothedFrameTime) *
+        frameTimeSmoothing;
+  }
+
+  const UCesiumRuntimeSettings* pSettings =
+      GetDefault<UCesiumRuntimeSettings>();
+  double minimum = pSettings->MinimumTileLoadingBudget;
+  double maximum =
+      std::max(minimum, double(pSettings->MaximumTileLoadingBudget));
+  double error =
+      pSettings->TargetGameThreadFrameTime - this->_smoothedFrameTime;
+  this->_budget =
+      std::clamp(this->_budget + error * budgetGain, minimum, maximum);
+
+  SET_FLOAT_STAT(STAT_CesiumTileLoadingBudget, this->_budget);
+}
+
+void CesiumTileLoadingBudget::FrameBudget::addTileset() {
+  ++this->_tilesetsInFrame;
+}
+
+double CesiumTileLoadingBudget::FrameBudget::getTilesetMilliseconds(
+    Direction direction) const {
+  double unloadShare = std::clamp(
+      double(GetDefault<UCesiumRuntimeSettings>()->TileUnloadingBudgetShare),
+      0.0,
+      1.0);
+  double share =
+      direction == Direction::Unload ? unloadShare : 1.0 - unloadShare;
+  return this->_budget * share / this->_tilesetsInLastFrame;
+}
+
+CesiumTileLoadingBudget::ScopedTimer::ScopedTimer(
+    CesiumTileLoadingBudget& budget,
+    Direction direction)
+    : _budget(budget),
+      _direction(direction),
+      _start(FPlatformTime::Seconds()) {}
+
+CesiumTileLoadingBudget::ScopedTimer::~ScopedTimer() {
+  this->_budget.consume(
+      this->_direction,
+      (FPlatformTime::Seconds() - this->_start) * 1000.0);
+}
+
+CesiumTileLoadingBudget::CesiumTileLoadingBudget(FrameBudget& frameBudget)
+    : _frameBudget(frameBudget) {}
+
+/*static*/ bool CesiumTileLoadingBudget::isEnabled() {
+  return GetDefault<UCesiumRuntimeSettings>()->UseAdaptiveTileLoadingBudget;
+}
+
+/*static*/ double CesiumTileLoadingBudget::getGameThreadFrameTime() {
+  // GGameThreadTime excludes time spent waiting on the render thread, so it
+  // reflects the work that the budget actually competes with. It isn't
+  // measured in every configuration, so fall back on the frame delta time.
+  double frameTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+  if (frameTime <= 0.0) {
+    frameTime = FApp::GetDeltaTime() * 1000.0;
+  }
+  return frameTime;
+}
+
+void CesiumTileLoadingBudget::beginFrame(
+    uint64 frame,
+    double frameTimeMilliseconds) {
+  this->_frameBudget.beginFrame(frame, frameTimeMilliseconds);
+  if (this->_frame == frame) {
+    return;
+  }
+
+  this->_frame = frame;
+  this->_usedToLoad = 0.0;
+  this->_usedToUnload = 0.0;
+  this->_frameBudget.addTileset();
+}
+
+double
+CesiumTileLoadingBudget::getRemainingMilliseconds(Direction direction) const {
+  double used = direction == Direction::Unload ? this->_usedToUnload
+                                               : this->_usedToLoad;
+  return std::max(
+      this->_frameBudget.getTilesetMilliseconds(direction) - used,
+      minimumRemainingMilliseconds);
+}
+
+void CesiumTileLoadingBudget::consume(
+    Direction direction,
+    double milliseconds) {
+  if (direction == Direction::Unload) {
+    this->_usedToUnload += milliseconds;
+    INC_FLOAT_STAT_BY(STAT_CesiumTileUnloadingTimeUsed, milliseconds);
+  } else {
+    this->_usedToLoad += milliseconds;
+    INC_FLOAT_STAT_BY(STAT_CesiumTileLoadingTimeUsed, milliseconds);
+  }
+}
@@ -0,0 +1,144 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "HAL/Platform.h"
+
+/**
+ * Controls how much game thread time a tileset may spend each frame
+ * finalizing newly-loaded tiles and unloading cached tiles.
+ *
+ * When `UseAdaptiveTileLoadingBudget` is enabled in the runtime settings, the
+ * total time that all tilesets together may spend is adjusted once per frame
+ * based on the smoothed game thread frame time, so that it grows while there
+ * is headroom below the target frame time and shrinks while frames are too
+ * slow. That total is split evenly among the tilesets, so a tileset with a
+ * lot of work can't take the time of the others. Each tileset's share is
+ * split again into separate budgets for loading and unloading, so that
+ * unloading a large cache can't starve loading, nor the other way around.
+ */
+class CesiumTileLoadingBudget {
+public:
+  /**
+   * The work that a budget is spent on.
+   */
+  enum class Direction {
+    /**
+     * Finalizing newly-loaded tiles and creating their components.
+     */
+    Load,
+
+    /**
+     * Unloading cached tiles.
+     */
+    Unload
+  };
+
+  /**
+   * The total time that all tilesets together may spend in a frame, and the
+   * number of tilesets that share it.
+   */
+  class FrameBudget {
+  public:
+    /**
+     * Gets the frame budget shared by all tilesets.
+     */
+    static FrameBudget& get();
+
+    /**
+     * Starts a new frame, unless the given frame was already started, and
+     * adjusts the total budget to the given game thread frame time.
+     */
+    void beginFrame(uint64 frame, double frameTimeMilliseconds);
+
+    /**
+     * Counts a tileset that shares the budget in the current frame.
+     */
+    void addTileset();
+
+    /**
+     * Gets the frame that was last started.
+     */
+    uint64 getFrame() const { return this->_frame; }
+
+    /**
+     * Gets the total time in milliseconds that all tilesets may spend in the
+     * current frame.
+     */
+    double getMilliseconds() const { return this->_budget; }
+
+    /**
+     * Gets the time in milliseconds that a single tileset may spend in the
+     * current frame in the given direction. The total is split evenly among
+     * the tilesets that shared it in the previous frame.
+     */
+    double getTilesetMilliseconds(Direction direction) const;
+
+  private:
+    uint64 _frame = 0;
+    double _budget = 5.0;
+    double _smoothedFrameTime = 0.0;
+    uint32 _tilesetsInLastFrame = 1;
+    uint32 _tilesetsInFrame = 0;
+  };
+
+  /**
+   * Measures the time between construction and destruction and subtracts it
+   * from the current frame's budget in the given direction.
+   */
+  class ScopedTimer {
+  public:
+    ScopedTimer(CesiumTileLoadingBudget& budget, Direction direction);
+    ~ScopedTimer();
+
+  private:
+    CesiumTileLoadingBudget& _budget;
+    Direction _direction;
+    double _start;
+  };
+
+  /**
+   * Creates the budget of a tileset, which takes its share of the given frame
+   * budget.
+   */
+  explicit CesiumTileLoadingBudget(
+      FrameBudget& frameBudget = FrameBudget::get());
+
+  /**
+   * Whether the adaptive budget is enabled. If not, tilesets use their default
+   * fixed time limits.
+   */
+  static bool isEnabled();
+
+  /**
+   * Gets the game thread time of the last frame, in milliseconds.
+   */
+  static double getGameThreadFrameTime();
+
+  /**
+   * Starts a new frame, which resets the time used in both directions. This
+   * also starts the frame of the shared frame budget, unless another tileset
+   * already did.
+   */
+  void beginFrame(uint64 frame, double frameTimeMilliseconds);
+
+  /**
+   * Gets the time in milliseconds that may still be spent in the current
+   * frame in the given direction. This is always greater than zero, because
+   * cesium-native interprets a zero limit as unlimited. It always processes
+   * at least one tile, though, so a tiny limit still guarantees progress.
+   */
+  double getRemainingMilliseconds(Direction direction) const;
+
+  /**
+   * Subtracts the given time from the current frame's budget in the given
+   * direction.
+   */
+  void consume(Direction direction, double milliseconds);
+
+private:
+  FrameBudget& _frameBudget;
+  uint64 _frame = 0;
+  double _usedToLoad = 0.0;
+  double _usedToUnload = 0.0;
+};
@@ -0,0 +1,66 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesToHide.h"
+#include <Cesium3DTilesSelection/Tile.h>
+
+void CesiumTilesToHide::clear() {
+  this->_tiles.clear();
+  this->_tilesBeingCreated.clear();
+  this->_ancestorsOfTilesBeingCreated.clear();
+}
+
+void CesiumTilesToHide::update(
+    const std::vector<Tile*>& tilesToRender,
+    const std::function<bool(const Tile&)>& isBeingCreated) {
+  this->_tilesBeingCreated.clear();
+  this->_ancestorsOfTilesBeingCreated.clear();
+
+  for (const Tile* pTile : tilesToRender) {
+    if (!pTile || !isBeingCreated(*pTile)) {
+      continue;
+    }
+
+    this->_tilesBeingCreated.insert(pTile);
+    for (const Tile* pParent = pTile->getParent(); pParent;
+         pParent = pParent->getParent()) {
+      if (!this->_ancestorsOfTilesBeingCreated.insert(pParent).second) {
+        // The remaining ancestors were added for an earlier tile.
+        break;
+      }
+    }
+  }
+}
+
+bool CesiumTilesToHide::isKeptVisible(const Tile& tile) const {
+  if (this->_tilesBeingCreated.empty()) {
+    return false;
+  }
+
+  if (this->_ancestorsOfTilesBeingCreated.count(&tile) > 0) {
+    return true;
+  }
+
+  for (const Tile* pParent = tile.getParent(); pParent;
+       pParent = pParent->getParent()) {
+    if (this->_tilesBeingCreated.count(pParent) > 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::vector<CesiumTilesToHide::Tile*> CesiumTilesToHide::takeTilesToHide() {
+  std::vector<Tile*> result;
+  result.reserve(this->_tiles.size());
+  for (auto it = this->_tiles.begin(); it != this->_tiles.end();) {
+    if (*it && this->isKeptVisible(**it)) {
+      ++it;
+      continue;
+    }
+
+    result.push_back(*it);
+    it = this->_tiles.erase(it);
+  }
+  return result;
+}
@@ -0,0 +1,82 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+class Tile;
+}
+
+/**
+ * The tiles that are no longer rendered, and are about to be hidden.
+ *
+ * A tile that is replaced by a tile whose components are still being created
+ * stays visible until its replacement can be shown, to avoid leaving a hole
+ * in the tileset. Only the tiles that are related to such an incomplete tile,
+ * i.e. its ancestors and its descendants, are kept. All others are hidden
+ * right away, no matter how many other tiles are still being created.
+ *
+ * Tiles must be removed with {@link remove} when their content is freed, so
+ * that this never refers to tiles that no longer exist.
+ */
+class CesiumTilesToHide {
+public:
+  using Tile = Cesium3DTilesSelection::Tile;
+
+  /**
+   * Adds a tile to hide. Adding a tile more than once has no effect.
+   */
+  void add(Tile* pTile) { this->_tiles.insert(pTile); }
+
+  /**
+   * Forgets a tile, for example because its content was freed.
+   */
+  void remove(Tile* pTile) { this->_tiles.erase(pTile); }
+
+  /**
+   * Forgets all tiles.
+   */
+  void clear();
+
+  /**
+   * Determines whether there are no tiles to hide.
+   */
+  bool isEmpty() const { return this->_tiles.empty(); }
+
+  /**
+   * Gets the tiles to hide, including those that are currently kept visible.
+   */
+  const std::unordered_set<Tile*>& getTiles() const { return this->_tiles; }
+
+  /**
+   * Finds the rendered tiles that are still being created. Until the next
+   * call, the tiles they replace are kept visible.
+   *
+   * @param tilesToRender The tiles that are rendered in this frame.
+   * @param isBeingCreated Determines whether a tile is loaded, but can't be
+   * shown yet because its components are still being created.
+   */
+  void update(
+      const std::vector<Tile*>& tilesToRender,
+      const std::function<bool(const Tile&)>& isBeingCreated);
+
+  /**
+   * Determines whether a tile must stay visible, because it is an ancestor or
+   * a descendant of a rendered tile that is still being created.
+   */
+  bool isKeptVisible(const Tile& tile) const;
+
+  /**
+   * Removes the tiles that aren't kept visible, and returns them so that they
+   * can be hidden.
+   */
+  std::vector<Tile*> takeTilesToHide();
+
+private:
+  std::unordered_set<Tile*> _tiles;
+  std::unordered_set<const Tile*> _tilesBeingCreated;
+  std::unordered_set<const Tile*> _ancestorsOfTilesBeingCreated;
+};
@@ -0,0 +1,175 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetPrimitiveComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumQuantizedPositions.h"
+#include "CesiumTilesetSceneProxy.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/Material.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "StaticMeshResources.h"
+
+namespace {
+bool hasRenderData(const UStaticMeshComponent* pPrimitive) {
+  const UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+  const FStaticMeshRenderData* pRenderData =
+      pStaticMesh ? pStaticMesh->GetRenderData() : nullptr;
+  return pRenderData && !pRenderData->LODResources.IsEmpty() &&
+         pRenderData->LODVertexFactories.Num() > 0;
+}
+
+FCesiumTilesetSceneProxyMesh
+createProxyMesh(const UStaticMeshComponent* pPrimitive) {
+  FCesiumTilesetSceneProxyMesh result;
+  result.RenderData = pPrimitive->GetStaticMesh()->GetRenderData();
+
+  const int32 materialCount = pPrimitive->GetNumMaterials();
+  result.Materials.Reserve(materialCount);
+  for (int32 i = 0; i < materialCount; ++i) {
+    UMaterialInterface* pMaterial = pPrimitive->GetMaterial(i);
+    if (!pMaterial) {
+      pMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+    }
+    result.Materials.Add(pMaterial->GetRenderProxy());
+  }
+
+  const FTransform& transform = pPrimitive->GetComponentTransform();
+  result.LocalToWorld = pPrimitive->GetRenderMatrix();
+  result.Bounds = pPrimitive->CalcBounds(transform);
+  result.LocalBounds = pPrimitive->CalcBounds(FTransform::Identity);
+
+  // Quantized positions are dequantized by the transform of the mesh.
+  const UCesiumGltfPrimitiveComponent* pGltfPrimitive =
+      Cast<UCesiumGltfPrimitiveComponent>(pPrimitive);
+  const FCesiumQuantizedPositions* pQuantizedPositions =
+      pGltfPrimitive ? pGltfPrimitive->getQuantizedPositions() : nullptr;
+  if (pQuantizedPositions) {
+    const FMatrix dequantization =
+        pQuantizedPositions->GetQuantization().GetDequantizationMatrix();
+    result.VertexFactory = &pQuantizedPositions->GetVertexFactory();
+    result.LocalToWorld = dequantization * result.LocalToWorld;
+    result.LocalBounds =
+        result.LocalBounds.TransformBy(dequantization.Inverse());
+  }
+  result.CastShadow = pPrimitive->CastShadow && pPrimitive->bCastDynamicShadow;
+  result.ReverseCulling = transform.GetDeterminant() < 0.0f;
+  return result;
+}
+} // namespace
+
+UCesiumTilesetPrimitiveComponent::UCesiumTilesetPrimitiveComponent() {
+  PrimaryComponentTick.bCanEverTick = false;
+  Mobility = EComponentMobility::Movable;
+
+  // Collision and navigation are still handled by the primitive components.
+  SetCollisionProfileName(UCollisionProfile::NoCollision_ProfileName);
+  SetGenerateOverlapEvents(false);
+  bCanEverAffectNavigation = false;
+}
+
+UCesiumTilesetPrimitiveComponent::~UCesiumTilesetPrimitiveComponent() {}
+
+void UCesiumTilesetPrimitiveComponent::ShowPrimitive(
+    const UStaticMeshComponent* Primitive) {
+  if (!Primitive || !hasRenderData(Primitive)) {
+    return;
+  }
+
+  TRACE_CPUPROFILER_EVENT_SCOPE(Cesium::ShowTilesetPrimitive)
+
+  this->_primitives.Add(Primitive);
+
+  // The bounds enclose all shown primitives, so that the proxy isn't drawn
+  // when none of them can be seen. They're updated at the end of the frame.
+  this->MarkRenderTransformDirty();
+
+  FCesiumTilesetSceneProxy* pProxy =
+      static_cast<FCesiumTilesetSceneProxy*>(this->SceneProxy);
+  if (!pProxy) {
+    return;
+  }
+
+  ENQUEUE_RENDER_COMMAND(Cesium_ShowTilesetPrimitive)
+  ([pProxy,
+    Primitive,
+    mesh = createProxyMesh(Primitive),
+    relevance = Primitive->GetMaterialRelevance(this->getFeatureLevel())](
+       FRHICommandListImmediate& RHICmdList) mutable {
+    pProxy->ShowMesh(RHICmdList, Primitive, MoveTemp(mesh), relevance);
+  });
+}
+
+void UCesiumTilesetPrimitiveComponent::HidePrimitive(
+    const UStaticMeshComponent* Primitive) {
+  if (this->_primitives.Remove(Primitive) == 0) {
+    return;
+  }
+
+  this->MarkRenderTransformDirty();
+
+  FCesiumTilesetSceneProxy* pProxy =
+      static_cast<FCesiumTilesetSceneProxy*>(this->SceneProxy);
+  if (!pProxy) {
+    return;
+  }
+
+  ENQUEUE_RENDER_COMMAND(Cesium_HideTilesetPrimitive)
+  ([pProxy, Primitive](FRHICommandListImmediate& RHICmdList) {
+    pProxy->HideMesh(Primitive);
+  });
+}
+
+FPrimitiveSceneProxy* UCesiumTilesetPrimitiveComponent::CreateSceneProxy() {
+  if (!IsValid(this)) {
+    return nullptr;
+  }
+
+  // The proxy is recreated whenever the render state is, so it needs to start
+  // out with all primitives that are currently shown.
+  const ERHIFeatureLevel::Type featureLevel = this->getFeatureLevel();
+  TMap<const void*, FCesiumTilesetSceneProxyMesh> meshes;
+  meshes.Reserve(this->_primitives.Num());
+  FMaterialRelevance relevance;
+  for (const UStaticMeshComponent* pPrimitive : this->_primitives) {
+    if (hasRenderData(pPrimitive)) {
+      meshes.Add(pPrimitive, createProxyMesh(pPrimitive));
+      relevance |= pPrimitive->GetMaterialRelevance(featureLevel);
+    }
+  }
+
+  return new FCesiumTilesetSceneProxy(this, MoveTemp(meshes), relevance);
+}
+
+FBoxSphereBounds UCesiumTilesetPrimitiveComponent::CalcBounds(
+    const FTransform& LocalToWorld) const {
+  // Each primitive has its own transform, so their world bounds are combined
+  // regardless of the transform of this component.
+  TOptional<FBoxSphereBounds> bounds;
+  for (const UStaticMeshComponent* pPrimitive : this->_primitives) {
+    bounds = bounds ? *bounds + pPrimitive->Bounds : pPrimitive->Bounds;
+  }
+  if (!bounds) {
+    return FBoxSphereBounds(
+        LocalToWorld.GetLocation(),
+        FVector::ZeroVector,
+        0.0);
+  }
+  return *bounds;
+}
+
+void UCesiumTilesetPrimitiveComponent::GetUsedMaterials(
+    TArray<UMaterialInterface*>& OutMaterials,
+    bool bGetDebugMaterials) const {
+  for (const UStaticMeshComponent* pPrimitive : this->_primitives) {
+    pPrimitive->GetUsedMaterials(OutMaterials, bGetDebugMaterials);
+  }
+}
+
+ERHIFeatureLevel::Type
+UCesiumTilesetPrimitiveComponent::getFeatureLevel() const {
+  const FSceneInterface* pScene = this->GetScene();
+  return pScene ? pScene->GetFeatureLevel() : GMaxRHIFeatureLevel;
+}
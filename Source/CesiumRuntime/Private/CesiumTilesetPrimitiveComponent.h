@@ -0,0 +1,56 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/PrimitiveComponent.h"
+#include "Containers/Set.h"
+#include "CoreMinimal.h"
+
+#include "CesiumTilesetPrimitiveComponent.generated.h"
+
+class UStaticMeshComponent;
+
+/**
+ * A single component that renders the glTF primitives of all shown tiles of a
+ * tileset. Primitives rendered this way don't create render state of their
+ * own, so showing or hiding them only updates the list of meshes drawn by
+ * this component's scene proxy.
+ */
+UCLASS()
+class UCesiumTilesetPrimitiveComponent : public UPrimitiveComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumTilesetPrimitiveComponent();
+  virtual ~UCesiumTilesetPrimitiveComponent();
+
+  /**
+   * Starts drawing the static mesh of the given primitive, or updates it if
+   * it is already drawn, for example because it moved.
+   */
+  void ShowPrimitive(const UStaticMeshComponent* Primitive);
+
+  /**
+   * Stops drawing the static mesh of the given primitive. This must be called
+   * before the mesh's render data or materials are released.
+   */
+  void HidePrimitive(const UStaticMeshComponent* Primitive);
+
+  /**
+   * Gets the number of primitives that are currently drawn.
+   */
+  int32 GetShownPrimitiveCount() const { return this->_primitives.Num(); }
+
+  // Override UPrimitiveComponent interface.
+  virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+  virtual FBoxSphereBounds
+  CalcBounds(const FTransform& LocalToWorld) const override;
+  virtual void GetUsedMaterials(
+      TArray<UMaterialInterface*>& OutMaterials,
+      bool bGetDebugMaterials = false) const override;
+
+private:
+  ERHIFeatureLevel::Type getFeatureLevel() const;
+
+  TSet<const UStaticMeshComponent*> _primitives;
+};
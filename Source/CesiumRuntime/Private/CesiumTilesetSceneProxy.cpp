@@ -0,0 +1,186 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetSceneProxy.h"
+#include "CesiumTilesetPrimitiveComponent.h"
+#include "ConvexVolume.h"
+#include "PrimitiveUniformShaderParameters.h"
+#include "SceneManagement.h"
+#include "StaticMeshResources.h"
+
+SIZE_T FCesiumTilesetSceneProxy::GetTypeHash() const {
+  static size_t UniquePointer;
+  return reinterpret_cast<size_t>(&UniquePointer);
+}
+
+FCesiumTilesetSceneProxy::FCesiumTilesetSceneProxy(
+    const UCesiumTilesetPrimitiveComponent* InComponent,
+    TMap<const void*, FCesiumTilesetSceneProxyMesh>&& InMeshes,
+    const FMaterialRelevance& InMaterialRelevance)
+    : FPrimitiveSceneProxy(InComponent),
+      Meshes(MoveTemp(InMeshes)),
+      MaterialRelevance(InMaterialRelevance) {
+  // The materials change as tiles are shown, so they can't all be known by
+  // the component when the proxy is created.
+  bVerifyUsedMaterials = false;
+}
+
+FCesiumTilesetSceneProxy::~FCesiumTilesetSceneProxy() {}
+
+#if ENGINE_VERSION_5_4_OR_HIGHER
+void FCesiumTilesetSceneProxy::CreateRenderThreadResources(
+    FRHICommandListBase& RHICmdList) {
+  for (auto& Pair : Meshes) {
+    CreateUniformBuffer(RHICmdList, Pair.Value);
+  }
+}
+#else
+void FCesiumTilesetSceneProxy::CreateRenderThreadResources() {
+  FRHICommandListBase& RHICmdList = FRHICommandListImmediate::Get();
+  for (auto& Pair : Meshes) {
+    CreateUniformBuffer(RHICmdList, Pair.Value);
+  }
+}
+#endif
+
+void FCesiumTilesetSceneProxy::ShowMesh(
+    FRHICommandListBase& RHICmdList,
+    const void* Key,
+    FCesiumTilesetSceneProxyMesh&& Mesh,
+    const FMaterialRelevance& InMaterialRelevance) {
+  check(IsInRenderingThread());
+  FCesiumTilesetSceneProxyMesh& Added = Meshes.Add(Key, MoveTemp(Mesh));
+  CreateUniformBuffer(RHICmdList, Added);
+  MaterialRelevance |= InMaterialRelevance;
+}
+
+void FCesiumTilesetSceneProxy::HideMesh(const void* Key) {
+  check(IsInRenderingThread());
+  Meshes.Remove(Key);
+}
+
+bool FCesiumTilesetSceneProxy::IsMeshInFrustum(
+    const FBoxSphereBounds& Bounds,
+    const FConvexVolume& Frustum,
+    const FVector& FrustumTranslation) {
+  return Frustum.IntersectBox(
+      Bounds.Origin + FrustumTranslation,
+      Bounds.BoxExtent);
+}
+
+void FCesiumTilesetSceneProxy::CreateUniformBuffer(
+    FRHICommandListBase& RHICmdList,
+    FCesiumTilesetSceneProxyMesh& Mesh) const {
+  // Each tile has its own transform, so it needs its own primitive uniform
+  // buffer rather than the one of this proxy. The transform of a shown mesh
+  // never changes, because moving it shows it again, so the buffer is only
+  // filled once.
+  Mesh.UniformBuffer = MakeShared<FDynamicPrimitiveUniformBuffer>();
+  Mesh.UniformBuffer->Set(
+#if ENGINE_VERSION_5_4_OR_HIGHER
+      RHICmdList,
+#endif
+      Mesh.LocalToWorld,
+      Mesh.LocalToWorld,
+      Mesh.Bounds,
+      Mesh.LocalBounds,
+      Mesh.LocalBounds,
+      ReceivesDecals(),
+      false,
+      false);
+}
+
+void FCesiumTilesetSceneProxy::GetDynamicMeshElements(
+    const TArray<const FSceneView*>& Views,
+    const FSceneViewFamily& ViewFamily,
+    uint32 VisibilityMap,
+    FMeshElementCollector& Collector) const {
+  QUICK_SCOPE_CYCLE_COUNTER(STAT_TilesetSceneProxy_GetDynamicMeshElements);
+
+  for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ViewIndex++) {
+    if (!(VisibilityMap & (1 << ViewIndex))) {
+      continue;
+    }
+
+    // The bounds of this proxy enclose all tiles, so each of them is culled
+    // individually. Shadow passes provide a frustum of their own, which
+    // includes the shadow casters outside of the main view.
+    const FSceneView* View = Views[ViewIndex];
+    const FConvexVolume* ShadowFrustum =
+        View->GetDynamicMeshElementsShadowCullFrustum();
+    const FConvexVolume& Frustum =
+        ShadowFrustum ? *ShadowFrustum : View->ViewFrustum;
+    const FVector FrustumTranslation =
+        ShadowFrustum ? View->GetPreShadowTranslation() : FVector::ZeroVector;
+
+    for (const auto& Pair : Meshes) {
+      const FCesiumTilesetSceneProxyMesh& TileMesh = Pair.Value;
+      if (!TileMesh.UniformBuffer ||
+          (ShadowFrustum && !TileMesh.CastShadow) ||
+          !IsMeshInFrustum(TileMesh.Bounds, Frustum, FrustumTranslation)) {
+        continue;
+      }
+
+      const FStaticMeshLODResources& LODResources =
+          TileMesh.RenderData->LODResources[0];
+      const FLocalVertexFactory& VertexFactory =
+          TileMesh.VertexFactory
+              ? *TileMesh.VertexFactory
+              : TileMesh.RenderData->LODVertexFactories[0].VertexFactory;
+
+      for (const FStaticMeshSection& Section : LODResources.Sections) {
+        if (Section.NumTriangles == 0 ||
+            !TileMesh.Materials.IsValidIndex(Section.MaterialIndex)) {
+          continue;
+        }
+
+        FMeshBatch& Mesh = Collector.AllocateMesh();
+        Mesh.VertexFactory = &VertexFactory;
+        Mesh.MaterialRenderProxy = TileMesh.Materials[Section.MaterialIndex];
+        Mesh.ReverseCulling = TileMesh.ReverseCulling;
+        Mesh.Type = PT_TriangleList;
+        Mesh.DepthPriorityGroup = SDPG_World;
+        Mesh.LODIndex = 0;
+        Mesh.CastShadow = TileMesh.CastShadow;
+        Mesh.bCanApplyViewModeOverrides = false;
+        Mesh.bUseAsOccluder = false;
+        Mesh.bWireframe = false;
+
+        FMeshBatchElement& BatchElement = Mesh.Elements[0];
+        BatchElement.IndexBuffer = &LODResources.IndexBuffer;
+        BatchElement.FirstIndex = Section.FirstIndex;
+        BatchElement.NumPrimitives = Section.NumTriangles;
+        BatchElement.MinVertexIndex = Section.MinVertexIndex;
+        BatchElement.MaxVertexIndex = Section.MaxVertexIndex;
+        BatchElement.PrimitiveUniformBufferResource =
+            &TileMesh.UniformBuffer->UniformBuffer;
+
+        Collector.AddMesh(ViewIndex, Mesh);
+      }
+    }
+  }
+}
+
+FPrimitiveViewRelevance
+FCesiumTilesetSceneProxy::GetViewRelevance(const FSceneView* View) const {
+  FPrimitiveViewRelevance Result;
+  Result.bDrawRelevance = IsShown(View);
+  // The set of meshes changes whenever tiles are shown or hidden, so they
+  // are always gathered dynamically.
+  Result.bDynamicRelevance = true;
+  Result.bStaticRelevance = false;
+
+  Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+  Result.bRenderInMainPass = ShouldRenderInMainPass();
+  Result.bRenderInDepthPass = ShouldRenderInDepthPass();
+  Result.bUsesLightingChannels =
+      GetLightingChannelMask() != GetDefaultLightingChannelMask();
+  Result.bShadowRelevance = IsShadowCast(View);
+
+  MaterialRelevance.SetPrimitiveViewRelevance(Result);
+
+  return Result;
+}
+
+uint32 FCesiumTilesetSceneProxy::GetMemoryFootprint(void) const {
+  return (sizeof(*this) + GetAllocatedSize() + Meshes.GetAllocatedSize());
+}
@@ -0,0 +1,118 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CesiumCommon.h"
+#include "Containers/Map.h"
+#include "MaterialShared.h"
+#include "PrimitiveSceneProxy.h"
+
+class FDynamicPrimitiveUniformBuffer;
+class FLocalVertexFactory;
+class FStaticMeshRenderData;
+struct FConvexVolume;
+class UCesiumTilesetPrimitiveComponent;
+
+/**
+ * The render thread's copy of a glTF primitive that is drawn by a
+ * FCesiumTilesetSceneProxy. It refers to the render data and materials of the
+ * primitive's static mesh, which must be hidden before they're released.
+ */
+struct FCesiumTilesetSceneProxyMesh {
+  const FStaticMeshRenderData* RenderData = nullptr;
+
+  // The vertex factory to draw the mesh with instead of the one of its render
+  // data, such as one that reads quantized positions.
+  const FLocalVertexFactory* VertexFactory = nullptr;
+
+  // The material of each section of the mesh, by material index.
+  TArray<const FMaterialRenderProxy*> Materials;
+
+  FMatrix LocalToWorld = FMatrix::Identity;
+  FBoxSphereBounds Bounds;
+  FBoxSphereBounds LocalBounds;
+  bool CastShadow = true;
+  bool ReverseCulling = false;
+
+  // The primitive uniform buffer with the transform of the mesh. It is
+  // created on the render thread once the mesh is added to the proxy, and
+  // reused every frame.
+  TSharedPtr<FDynamicPrimitiveUniformBuffer> UniformBuffer;
+};
+
+/**
+ * The scene proxy of a UCesiumTilesetPrimitiveComponent. It draws the static
+ * meshes of all shown tiles of a tileset, each with its own transform, so
+ * that showing and hiding a tile only updates the proxy's list of meshes.
+ */
+class FCesiumTilesetSceneProxy final : public FPrimitiveSceneProxy {
+public:
+  SIZE_T GetTypeHash() const override;
+
+  FCesiumTilesetSceneProxy(
+      const UCesiumTilesetPrimitiveComponent* InComponent,
+      TMap<const void*, FCesiumTilesetSceneProxyMesh>&& InMeshes,
+      const FMaterialRelevance& InMaterialRelevance);
+
+  virtual ~FCesiumTilesetSceneProxy();
+
+  /**
+   * Adds a mesh to the meshes drawn by this proxy, or replaces the one with
+   * the same key. Must be called on the render thread.
+   */
+  void ShowMesh(
+      FRHICommandListBase& RHICmdList,
+      const void* Key,
+      FCesiumTilesetSceneProxyMesh&& Mesh,
+      const FMaterialRelevance& InMaterialRelevance);
+
+  /**
+   * Removes a mesh from the meshes drawn by this proxy. Must be called on the
+   * render thread.
+   */
+  void HideMesh(const void* Key);
+
+  /**
+   * Determines whether a mesh with the given world bounds intersects a view
+   * frustum, and so needs to be drawn.
+   *
+   * @param Bounds The world bounds of the mesh.
+   * @param Frustum The frustum to test against.
+   * @param FrustumTranslation The translation from world space to the space
+   * of the frustum, such as the pre-shadow translation of a shadow frustum.
+   */
+  static bool IsMeshInFrustum(
+      const FBoxSphereBounds& Bounds,
+      const FConvexVolume& Frustum,
+      const FVector& FrustumTranslation = FVector::ZeroVector);
+
+protected:
+#if ENGINE_VERSION_5_4_OR_HIGHER
+  virtual void
+  CreateRenderThreadResources(FRHICommandListBase& RHICmdList) override;
+#else
+  virtual void CreateRenderThreadResources() override;
+#endif
+
+  virtual void GetDynamicMeshElements(
+      const TArray<const FSceneView*>& Views,
+      const FSceneViewFamily& ViewFamily,
+      uint32 VisibilityMap,
+      FMeshElementCollector& Collector) const override;
+
+  virtual FPrimitiveViewRelevance
+  GetViewRelevance(const FSceneView* View) const override;
+
+  virtual uint32 GetMemoryFootprint(void) const override;
+
+private:
+  void CreateUniformBuffer(
+      FRHICommandListBase& RHICmdList,
+      FCesiumTilesetSceneProxyMesh& Mesh) const;
+
+  TMap<const void*, FCesiumTilesetSceneProxyMesh> Meshes;
+
+  // The combined relevance of the materials of all meshes that were ever
+  // shown. It only grows, which at worst costs an unnecessary pass.
+  FMaterialRelevance MaterialRelevance;
+};
@@ -0,0 +1,707 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexBufferUtility.h"
+#include "Async/ParallelFor.h"
+#include "CesiumScratchBuffers.h"
+#include "Math/VectorRegister.h"
+#include "Misc/ScopeLock.h"
+
+using namespace CesiumGltf;
+
+namespace {
+
+// Splitting fewer vertices than this into ranges costs more in task overhead
+// than it saves.
+constexpr int32 minimumVerticesPerRange = 32 * 1024;
+
+// The loops below are instantiated separately for duplicated and indexed
+// vertices, so that neither has to decide how to find the glTF vertex of
+// every Unreal vertex.
+template <bool Duplicate>
+FORCEINLINE int64 sourceIndex(const TArray<uint32>* pIndices, int32 i) {
+  if constexpr (Duplicate) {
+    return (*pIndices)[i];
+  } else {
+    return i;
+  }
+}
+
+FORCEINLINE int32
+vertexCountOf(const TArray<uint32>* pIndices, int64 sourceCount) {
+  return pIndices ? pIndices->Num() : static_cast<int32>(sourceCount);
+}
+
+template <bool Duplicate>
+float copyPositionsImpl(
+    const AccessorView<FVector3f>& positions,
+    const TArray<uint32>* pIndices,
+    float scale,
+    const FVector3f& center,
+    FPositionVertexBuffer& positionBuffer) {
+  const int32 vertexCount = vertexCountOf(pIndices, positions.size());
+  positionBuffer.Init(vertexCount, false);
+  if (vertexCount == 0) {
+    return 0.0f;
+  }
+
+  const VectorRegister4Float scaleAndFlip =
+      MakeVectorRegisterFloat(scale, -scale, scale, 0.0f);
+  const VectorRegister4Float centerRegister = VectorLoadFloat3_W0(&center.X);
+  FVector3f* pTarget = &positionBuffer.VertexPosition(0);
+
+  FCriticalSection maximumLock;
+  float maximumDistanceSquared = 0.0f;
+
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertexCount,
+      1,
+      [&](int32 begin, int32 end) {
+        VectorRegister4Float rangeMaximum = VectorZeroFloat();
+        for (int32 i = begin; i < end; ++i) {
+          const FVector3f& source =
+              positions[sourceIndex<Duplicate>(pIndices, i)];
+          const VectorRegister4Float position =
+              VectorMultiply(VectorLoadFloat3_W0(&source.X), scaleAndFlip);
+          VectorStoreFloat3(position, &pTarget[i].X);
+
+          // Compare squared distances, so that only the largest one needs a
+          // square root.
+          const VectorRegister4Float offset =
+              VectorSubtract(position, centerRegister);
+          rangeMaximum = VectorMax(rangeMaximum, VectorDot3(offset, offset));
+        }
+
+        float result[4];
+        VectorStore(rangeMaximum, result);
+        FScopeLock scopeLock(&maximumLock);
+        maximumDistanceSquared = FMath::Max(maximumDistanceSquared, result[0]);
+      });
+
+  return FMath::Sqrt(maximumDistanceSquared);
+}
+
+template <bool Duplicate>
+void copyNormalsImpl(
+    const AccessorView<FVector3f>& normals,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector3f>& result) {
+  result.SetNumUninitialized(vertexCount);
+
+  const VectorRegister4Float flip =
+      MakeVectorRegisterFloat(1.0f, -1.0f, 1.0f, 0.0f);
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertexCount,
+      1,
+      [&](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; ++i) {
+          const FVector3f& source =
+              normals[sourceIndex<Duplicate>(pIndices, i)];
+          VectorStoreFloat3(
+              VectorMultiply(VectorLoadFloat3_W0(&source.X), flip),
+              &result[i].X);
+        }
+      });
+}
+
+template <bool Duplicate>
+void copyTangentsImpl(
+    const AccessorView<FVector4f>& tangents,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector4f>& result) {
+  result.SetNumUninitialized(vertexCount);
+
+  const VectorRegister4Float flip =
+      MakeVectorRegisterFloat(1.0f, -1.0f, 1.0f, 1.0f);
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertexCount,
+      1,
+      [&](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; ++i) {
+          const FVector4f& source =
+              tangents[sourceIndex<Duplicate>(pIndices, i)];
+          VectorStore(
+              VectorMultiply(VectorLoad(&source.X), flip),
+              &result[i].X);
+        }
+      });
+}
+
+template <bool Duplicate>
+void copyUVsImpl(
+    const AccessorView<FVector2f>& uvs,
+    const TArray<uint32>* pIndices,
+    TArray<FVector2f>& result) {
+  const int64 uvCount = uvs.size();
+  if constexpr (Duplicate) {
+    for (int32 i = 0; i < result.Num(); ++i) {
+      const uint32 vertexIndex = (*pIndices)[i];
+      result[i] =
+          vertexIndex < uvCount ? uvs[vertexIndex] : FVector2f::ZeroVector;
+    }
+  } else {
+    // The rest of the array is already filled with zeros.
+    const int32 count =
+        static_cast<int32>(FMath::Min<int64>(result.Num(), uvCount));
+    for (int32 i = 0; i < count; ++i) {
+      result[i] = uvs[i];
+    }
+  }
+}
+
+template <bool HasNormals, bool HasTangents>
+void setTangentFrames(
+    const CesiumVertexBufferUtility::VertexAttributes& vertices,
+    FStaticMeshVertexBuffer& vertexBuffer) {
+  static_assert(HasNormals || !HasTangents);
+
+  const FVector3f zero(0.0f);
+  CesiumVertexBufferUtility::forEachVertexRange(
+      vertices.vertexCount,
+      1,
+      [&](int32 begin, int32 end) {
+        for (int32 i = begin; i < end; ++i) {
+          if constexpr (HasTangents) {
+            const FVector4f& tangent = vertices.tangents[i];
+            const FVector3f& normal = vertices.normals[i];
+            const FVector3f tangentX(tangent);
+            vertexBuffer.SetVertexTangents(
+                i,
+                tangentX,
+                FVector3f::CrossProduct(normal, tangentX) * tangent.W,
+                normal);
+          } else if constexpr (HasNormals) {
+            vertexBuffer.SetVertexTangents(i, zero, zero, vertices.normals[i]);
+          } else {
+            vertexBuffer.SetVertexTangents(i, zero, zero, zero);
+          }
+        }
+      });
+}
+
+// Writes a texture coordinate set directly into the interleaved texture
+// coordinates of the vertex buffer, whose element type depends on its UV
+// precision.
+template <typename TUV>
+void setUVs(
+    const CesiumVertexBufferUtility::VertexAttributes& vertices,
+    uint32 textureCoordinateCount,
+    FStaticMeshVertexBuffer& vertexBuffer) {
+  TUV* pData = static_cast<TUV*>(vertexBuffer.GetTexCoordData());
+  const int32 vertexCount = vertices.vertexCount;
+
+  for (uint32 uvIndex = 0; uvIndex < textureCoordinateCount; ++uvIndex) {
+    const bool hasUVs = int32(uvIndex) < vertices.uvs.Num() &&
+                        vertices.uvs[uvIndex].Num() == vertexCount;
+    if (hasUVs) {
+      const TArray<FVector2f>& uvs = vertices.uvs[uvIndex];
+      for (int32 i = 0; i < vertexCount; ++i) {
+        pData[i * textureCoordinateCount + uvIndex] = TUV(uvs[i]);
+      }
+    } else {
+      const TUV zero = TUV(FVector2f::ZeroVector);
+      for (int32 i = 0; i < vertexCount; ++i) {
+        pData[i * textureCoordinateCount + uvIndex] = zero;
+      }
+    }
+  }
+}
+
+template <typename T>
+void appendCopies(
+    TArray<T>& values,
+    int32 vertexCount,
+    const TArray<uint32>& copiedVertices) {
+  // Attributes that don't have one value per vertex weren't written, or are
+  // written by the caller.
+  if (values.Num() != vertexCount) {
+    return;
+  }
+  values.SetNumUninitialized(vertexCount + copiedVertices.Num());
+  for (int32 i = 0; i < copiedVertices.Num(); ++i) {
+    values[vertexCount + i] = values[copiedVertices[i]];
+  }
+}
+
+// Appends copies of the given vertices to every attribute array that has one
+// value per vertex.
+void appendAttributeCopies(
+    CesiumVertexBufferUtility::VertexAttributes& vertices,
+    const TArray<uint32>& copiedVertices) {
+  const int32 vertexCount = vertices.vertexCount;
+  appendCopies(vertices.normals, vertexCount, copiedVertices);
+  appendCopies(vertices.tangents, vertexCount, copiedVertices);
+  for (TArray<FVector2f>& uvSet : vertices.uvs) {
+    appendCopies(uvSet, vertexCount, copiedVertices);
+  }
+  vertices.vertexCount += copiedVertices.Num();
+}
+
+} // namespace
+
+namespace CesiumVertexBufferUtility {
+
+void forEachVertexRange(
+    int32 vertexCount,
+    int32 granularity,
+    TFunctionRef<void(int32 begin, int32 end)> function) {
+  const int32 rangeCount = FMath::Max(1, vertexCount / minimumVerticesPerRange);
+  if (rangeCount == 1) {
+    function(0, vertexCount);
+    return;
+  }
+
+  const auto rangeStart = [vertexCount, rangeCount, granularity](int32 index) {
+    if (index >= rangeCount) {
+      return vertexCount;
+    }
+    const int64 start = int64(vertexCount) * index / rangeCount;
+    return int32(start - start % granularity);
+  };
+
+  // Tiles are loaded in the background, so the ranges shouldn't delay more
+  // urgent work.
+  ParallelFor(
+      rangeCount,
+      [&function, &rangeStart](int32 index) {
+        function(rangeStart(index), rangeStart(index + 1));
+      },
+      EParallelForFlags::BackgroundPriority);
+}
+
+VertexAttributes::VertexAttributes()
+    : normals(CesiumScratchBuffers::acquire<FVector3f>()),
+      tangents(CesiumScratchBuffers::acquire<FVector4f>()) {}
+
+VertexAttributes::~VertexAttributes() {
+  CesiumScratchBuffers::release(MoveTemp(this->normals));
+  CesiumScratchBuffers::release(MoveTemp(this->tangents));
+  for (TArray<FVector2f>& uvSet : this->uvs) {
+    CesiumScratchBuffers::release(MoveTemp(uvSet));
+  }
+}
+
+TArray<FVector2f>& VertexAttributes::getUVs(uint32 textureCoordinateIndex) {
+  for (int32 i = this->uvs.Num(); i <= int32(textureCoordinateIndex); ++i) {
+    this->uvs.Add(CesiumScratchBuffers::acquire<FVector2f>());
+  }
+
+  TArray<FVector2f>& result = this->uvs[textureCoordinateIndex];
+  if (result.Num() != this->vertexCount) {
+    result.SetNumZeroed(this->vertexCount);
+  }
+  return result;
+}
+
+FBox computeBoundingBox(const AccessorView<FVector3f>& positions) {
+  if (positions.size() <= 0) {
+    return FBox(ForceInit);
+  }
+
+  VectorRegister4Float minimum = VectorLoadFloat3_W0(&positions[0].X);
+  VectorRegister4Float maximum = minimum;
+  for (int64 i = 1; i < positions.size(); ++i) {
+    const VectorRegister4Float position = VectorLoadFloat3_W0(&positions[i].X);
+    minimum = VectorMin(minimum, position);
+    maximum = VectorMax(maximum, position);
+  }
+
+  FVector4f minimumPosition;
+  FVector4f maximumPosition;
+  VectorStore(minimum, &minimumPosition.X);
+  VectorStore(maximum, &maximumPosition.X);
+  return FBox(
+      FVector(minimumPosition.X, minimumPosition.Y, minimumPosition.Z),
+      FVector(maximumPosition.X, maximumPosition.Y, maximumPosition.Z));
+}
+
+int64 getTriangleListIndexCount(int32 mode, int64 indexCount) {
+  if (mode == MeshPrimitive::Mode::TRIANGLE_STRIP ||
+      mode == MeshPrimitive::Mode::TRIANGLE_FAN) {
+    return indexCount < 3 ? 0 : 3 * (indexCount - 2);
+  }
+  return indexCount;
+}
+
+float copyPositions(
+    const AccessorView<FVector3f>& positions,
+    const TArray<uint32>* pIndices,
+    float scale,
+    const FVector3f& center,
+    FPositionVertexBuffer& positionBuffer) {
+  if (pIndices) {
+    return copyPositionsImpl<true>(
+        positions,
+        pIndices,
+        scale,
+        center,
+        positionBuffer);
+  } else {
+    return copyPositionsImpl<false>(
+        positions,
+        pIndices,
+        scale,
+        center,
+        positionBuffer);
+  }
+}
+
+void copyNormals(
+    const AccessorView<FVector3f>& normals,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector3f>& result) {
+  if (pIndices) {
+    copyNormalsImpl<true>(normals, pIndices, vertexCount, result);
+  } else {
+    copyNormalsImpl<false>(normals, pIndices, vertexCount, result);
+  }
+}
+
+void copyTangents(
+    const AccessorView<FVector4f>& tangents,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector4f>& result) {
+  if (pIndices) {
+    copyTangentsImpl<true>(tangents, pIndices, vertexCount, result);
+  } else {
+    copyTangentsImpl<false>(tangents, pIndices, vertexCount, result);
+  }
+}
+
+void copyUVs(
+    const AccessorView<FVector2f>& uvs,
+    const TArray<uint32>* pIndices,
+    TArray<FVector2f>& result) {
+  if (pIndices) {
+    copyUVsImpl<true>(uvs, pIndices, result);
+  } else {
+    copyUVsImpl<false>(uvs, pIndices, result);
+  }
+}
+
+void computeIndexedTangents(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    VertexAttributes& vertices,
+    TArray<uint32>& copiedVertices) {
+  const int32 vertexCount = vertices.vertexCount;
+  const TArray<FVector3f>& normals = vertices.normals;
+  const TArray<FVector2f>* pUVs =
+      vertices.uvs.Num() > 0 && vertices.uvs[0].Num() == vertexCount
+          ? &vertices.uvs[0]
+          : nullptr;
+  const int32 triangleCount = indices.Num() / 3;
+
+  // The sums of the tangents of the triangles around each vertex, separately
+  // for triangles with positive (even elements) and mirrored (odd elements)
+  // texture coordinates.
+  CesiumScratchBuffers::TScratchArray<FVector3f> tangentSums;
+  tangentSums.get().SetNumZeroed(2 * vertexCount);
+
+  // For each vertex, bit 0 is set if a positive triangle uses it and bit 1 if
+  // a mirrored triangle uses it.
+  CesiumScratchBuffers::TScratchArray<uint8> orientations;
+  orientations.get().SetNumZeroed(vertexCount);
+
+  // Whether each triangle has mirrored texture coordinates.
+  CesiumScratchBuffers::TScratchArray<bool> mirrored;
+  mirrored.get().SetNumZeroed(triangleCount);
+
+  if (pUVs) {
+    for (int32 triangle = 0; triangle < triangleCount; ++triangle) {
+      const uint32* pCorners = &indices[3 * triangle];
+      const FVector3f p0 = positions.VertexPosition(pCorners[0]);
+      const FVector3f edge1 = positions.VertexPosition(pCorners[1]) - p0;
+      const FVector3f edge2 = positions.VertexPosition(pCorners[2]) - p0;
+      const FVector2f uv0 = (*pUVs)[pCorners[0]];
+      const FVector2f uvEdge1 = (*pUVs)[pCorners[1]] - uv0;
+      const FVector2f uvEdge2 = (*pUVs)[pCorners[2]] - uv0;
+
+      const float uvArea = uvEdge1.X * uvEdge2.Y - uvEdge2.X * uvEdge1.Y;
+      FVector3f faceNormal = FVector3f::CrossProduct(edge1, edge2);
+      const float area = faceNormal.Size();
+      if (uvArea == 0.0f || area == 0.0f) {
+        continue;
+      }
+
+      const FVector3f tangent =
+          (edge1 * uvEdge2.Y - edge2 * uvEdge1.Y) / uvArea;
+      const FVector3f bitangent =
+          (edge2 * uvEdge1.X - edge1 * uvEdge2.X) / uvArea;
+
+      // Orient the face normal like the vertex normals, which may disagree
+      // with the winding order because of the inverted Y axis.
+      const FVector3f normalSum =
+          normals[pCorners[0]] + normals[pCorners[1]] + normals[pCorners[2]];
+      if ((faceNormal | normalSum) < 0.0f) {
+        faceNormal = -faceNormal;
+      }
+
+      const bool isMirrored = ((faceNormal ^ tangent) | bitangent) < 0.0f;
+      mirrored.get()[triangle] = isMirrored;
+
+      const FVector3f weightedTangent = tangent.GetSafeNormal() * area;
+      for (int32 corner = 0; corner < 3; ++corner) {
+        const uint32 vertex = pCorners[corner];
+        tangentSums.get()[2 * vertex + isMirrored] += weightedTangent;
+        orientations.get()[vertex] |= isMirrored ? 2 : 1;
+      }
+    }
+  }
+
+  // Split the vertices used by both positive and mirrored triangles. The
+  // mirrored triangles use the copy.
+  CesiumScratchBuffers::TScratchArray<uint32> copies;
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    if (orientations.get()[vertex] == 3) {
+      if (copies.get().Num() == 0) {
+        copies.get().SetNumUninitialized(vertexCount);
+      }
+      copies.get()[vertex] = uint32(vertexCount + copiedVertices.Num());
+      copiedVertices.Add(uint32(vertex));
+    }
+  }
+
+  for (int32 triangle = 0; triangle < triangleCount; ++triangle) {
+    if (!mirrored.get()[triangle]) {
+      continue;
+    }
+    for (int32 corner = 3 * triangle; corner < 3 * triangle + 3; ++corner) {
+      const uint32 vertex = indices[corner];
+      if (orientations.get()[vertex] == 3) {
+        indices[corner] = copies.get()[vertex];
+      }
+    }
+  }
+
+  appendAttributeCopies(vertices, copiedVertices);
+  const int32 totalCount = vertices.vertexCount;
+
+  vertices.tangents.SetNumUninitialized(totalCount);
+  forEachVertexRange(totalCount, 1, [&](int32 begin, int32 end) {
+    for (int32 i = begin; i < end; ++i) {
+      // Copies are used by the mirrored triangles, and vertices only used by
+      // mirrored triangles keep their index.
+      const bool isCopy = i >= vertexCount;
+      const int32 vertex = isCopy ? copiedVertices[i - vertexCount] : i;
+      const bool isMirrored = isCopy || orientations.get()[vertex] == 2;
+
+      const FVector3f& normal = vertices.normals[i];
+      const FVector3f& sum = tangentSums.get()[2 * vertex + isMirrored];
+      FVector3f tangent = sum - normal * (normal | sum);
+      if (!tangent.Normalize()) {
+        FVector3f unused;
+        normal.FindBestAxisVectors(tangent, unused);
+      }
+      vertices.tangents[i] = FVector4f(tangent, isMirrored ? -1.0f : 1.0f);
+    }
+  });
+}
+
+void computeIndexedFlatNormals(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    float creaseAngle,
+    VertexAttributes& vertices,
+    TArray<uint32>& copiedVertices) {
+  const int32 vertexCount = vertices.vertexCount;
+  const int32 triangleCount = indices.Num() / 3;
+
+  // The normal of each triangle, scaled by its area, and the unit normal.
+  // Positions have their Y axis inverted, which reverses the winding order,
+  // so the edges are crossed in the opposite order than in glTF.
+  CesiumScratchBuffers::TScratchArray<FVector3f> areaNormalBuffer;
+  CesiumScratchBuffers::TScratchArray<FVector3f> unitNormalBuffer;
+  TArray<FVector3f>& areaNormals = areaNormalBuffer.get();
+  TArray<FVector3f>& unitNormals = unitNormalBuffer.get();
+  areaNormals.SetNumUninitialized(triangleCount);
+  unitNormals.SetNumUninitialized(triangleCount);
+  forEachVertexRange(triangleCount, 1, [&](int32 begin, int32 end) {
+    for (int32 triangle = begin; triangle < end; ++triangle) {
+      const FVector3f p0 = positions.VertexPosition(indices[3 * triangle]);
+      const FVector3f edge1 =
+          positions.VertexPosition(indices[3 * triangle + 1]) - p0;
+      const FVector3f edge2 =
+          positions.VertexPosition(indices[3 * triangle + 2]) - p0;
+      areaNormals[triangle] = FVector3f::CrossProduct(edge2, edge1);
+      unitNormals[triangle] = areaNormals[triangle].GetSafeNormal();
+    }
+  });
+
+  // The corners of the triangles around each vertex, sorted by vertex. The
+  // corners of vertex i start at firstCorners[i].
+  CesiumScratchBuffers::TScratchArray<int32> firstCornerBuffer;
+  CesiumScratchBuffers::TScratchArray<int32> cornerBuffer;
+  TArray<int32>& firstCorners = firstCornerBuffer.get();
+  TArray<int32>& corners = cornerBuffer.get();
+  firstCorners.SetNumZeroed(vertexCount + 1);
+  corners.SetNumUninitialized(3 * triangleCount);
+  for (int32 corner = 0; corner < corners.Num(); ++corner) {
+    ++firstCorners[indices[corner] + 1];
+  }
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    firstCorners[vertex + 1] += firstCorners[vertex];
+  }
+  {
+    CesiumScratchBuffers::TScratchArray<int32> nextCornerBuffer;
+    TArray<int32>& nextCorners = nextCornerBuffer.get();
+    nextCorners.Append(firstCorners.GetData(), vertexCount);
+    for (int32 corner = 0; corner < corners.Num(); ++corner) {
+      corners[nextCorners[indices[corner]]++] = corner;
+    }
+  }
+
+  // A small tolerance keeps triangles that are coplanar, up to rounding,
+  // together when the crease angle is zero.
+  const float minimumCosine = FMath::Cos(creaseAngle) - 1e-5f;
+
+  CesiumScratchBuffers::TScratchArray<bool> groupedBuffer;
+  TArray<bool>& grouped = groupedBuffer.get();
+  grouped.SetNumZeroed(corners.Num());
+
+  vertices.normals.SetNumUninitialized(vertexCount);
+  for (int32 vertex = 0; vertex < vertexCount; ++vertex) {
+    const int32 begin = firstCorners[vertex];
+    const int32 end = firstCorners[vertex + 1];
+    if (begin == end) {
+      // Not used by any triangle.
+      vertices.normals[vertex] = FVector3f(0.0f, 0.0f, 1.0f);
+      continue;
+    }
+
+    // Group the triangles around the vertex with the first triangle not in a
+    // group yet. The first group keeps the vertex, and each further group
+    // gets a copy.
+    for (int32 i = begin; i < end; ++i) {
+      if (grouped[i]) {
+        continue;
+      }
+
+      uint32 groupVertex = uint32(vertex);
+      if (i != begin) {
+        groupVertex = uint32(vertexCount + copiedVertices.Num());
+        copiedVertices.Add(uint32(vertex));
+        vertices.normals.AddUninitialized();
+      }
+
+      FVector3f seed = FVector3f::ZeroVector;
+      FVector3f normalSum = FVector3f::ZeroVector;
+      for (int32 j = i; j < end; ++j) {
+        const int32 triangle = corners[j] / 3;
+        const FVector3f& unitNormal = unitNormals[triangle];
+        // Degenerate triangles have no normal, so they join any group.
+        if (grouped[j] || (!seed.IsZero() && !unitNormal.IsZero() &&
+                           (seed | unitNormal) < minimumCosine)) {
+          continue;
+        }
+
+        if (seed.IsZero()) {
+          seed = unitNormal;
+        }
+        grouped[j] = true;
+        normalSum += areaNormals[triangle];
+        indices[corners[j]] = groupVertex;
+      }
+
+      FVector3f normal = normalSum.GetSafeNormal();
+      vertices.normals[groupVertex] =
+          normal.IsZero() ? FVector3f(0.0f, 0.0f, 1.0f) : normal;
+    }
+  }
+
+  // The normals already include the copies, so only the other attributes are
+  // copied.
+  appendAttributeCopies(vertices, copiedVertices);
+}
+
+void appendVertexCopies(
+    const TArray<uint32>& copiedVertices,
+    FPositionVertexBuffer& positionBuffer,
+    FColorVertexBuffer* pColorBuffer) {
+  if (copiedVertices.Num() == 0) {
+    return;
+  }
+
+  const uint32 vertexCount = positionBuffer.GetNumVertices();
+  const uint32 totalCount = vertexCount + uint32(copiedVertices.Num());
+
+  CesiumScratchBuffers::TScratchArray<FVector3f> positions;
+  positions.get().SetNumUninitialized(totalCount);
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    positions.get()[i] = positionBuffer.VertexPosition(i);
+  }
+  positionBuffer.Init(totalCount, false);
+  for (uint32 i = 0; i < totalCount; ++i) {
+    positionBuffer.VertexPosition(i) =
+        positions.get()[i < vertexCount ? i : copiedVertices[i - vertexCount]];
+  }
+
+  if (!pColorBuffer || pColorBuffer->GetNumVertices() != vertexCount) {
+    return;
+  }
+
+  CesiumScratchBuffers::TScratchArray<FColor> colors;
+  colors.get().SetNumUninitialized(totalCount);
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    colors.get()[i] = pColorBuffer->VertexColor(i);
+  }
+  pColorBuffer->Init(totalCount, false);
+  for (uint32 i = 0; i < totalCount; ++i) {
+    pColorBuffer->VertexColor(i) =
+        colors.get()[i < vertexCount ? i : copiedVertices[i - vertexCount]];
+  }
+}
+
+bool canUseHalfPrecisionUVs(const VertexAttributes& vertices) {
+  for (const TArray<FVector2f>& uvSet : vertices.uvs) {
+    for (const FVector2f& uv : uvSet) {
+      if (FMath::Abs(uv.X) > MaximumHalfPrecisionUV ||
+          FMath::Abs(uv.Y) > MaximumHalfPrecisionUV) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool isOpaqueWhite(const FColorVertexBuffer& colorBuffer) {
+  const uint32 vertexCount = colorBuffer.GetNumVertices();
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    if (colorBuffer.VertexColor(i) != FColor::White) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void initStaticMeshVertexBuffer(
+    const VertexAttributes& vertices,
+    uint32 textureCoordinateCount,
+    FStaticMeshVertexBuffer& vertexBuffer) {
+  vertexBuffer.Init(vertices.vertexCount, textureCoordinateCount, false);
+  if (vertices.vertexCount == 0) {
+    return;
+  }
+
+  const bool hasNormals = vertices.normals.Num() == vertices.vertexCount;
+  const bool hasTangents =
+      hasNormals && vertices.tangents.Num() == vertices.vertexCount;
+  if (hasTangents) {
+    setTangentFrames<true, true>(vertices, vertexBuffer);
+  } else if (hasNormals) {
+    setTangentFrames<true, false>(vertices, vertexBuffer);
+  } else {
+    setTangentFrames<false, false>(vertices, vertexBuffer);
+  }
+
+  if (vertexBuffer.GetUseFullPrecisionUVs()) {
+    setUVs<FVector2f>(vertices, textureCoordinateCount, vertexBuffer);
+  } else {
+    setUVs<FVector2DHalf>(vertices, textureCoordinateCount, vertexBuffer);
+  }
+}
+
+} // namespace CesiumVertexBufferUtility
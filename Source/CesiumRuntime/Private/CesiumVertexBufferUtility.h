@@ -0,0 +1,353 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StaticMeshResources.h"
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/MeshPrimitive.h>
+
+/**
+ * Functions that copy glTF vertex attributes into Unreal vertex buffers.
+ *
+ * Vertex attributes are handled one array at a time instead of through an
+ * array of FStaticMeshBuildVertex, so that each loop touches only the memory
+ * of one attribute and positions can be written straight into the position
+ * vertex buffer. Unreal's Y axis points the opposite way of glTF's, so
+ * positions, normals, and tangents have their Y coordinate negated.
+ *
+ * Primitives with many vertices are split into ranges of vertices that are
+ * processed in parallel.
+ */
+namespace CesiumVertexBufferUtility {
+
+/**
+ * The vertex attributes of a primitive whose render data is being built,
+ * apart from its positions and colors, which are written directly into their
+ * vertex buffers. Attributes are indexed by Unreal vertex, which is the index
+ * into the index buffer when vertices are duplicated.
+ */
+struct VertexAttributes {
+  /**
+   * Borrows the attribute arrays from the calling thread's
+   * {@link CesiumScratchBuffers} pool.
+   */
+  VertexAttributes();
+
+  /**
+   * Returns the attribute arrays to the calling thread's pool.
+   */
+  ~VertexAttributes();
+
+  VertexAttributes(const VertexAttributes&) = delete;
+  VertexAttributes& operator=(const VertexAttributes&) = delete;
+
+  /**
+   * The number of vertices.
+   */
+  int32 vertexCount = 0;
+
+  /**
+   * The normal (TangentZ) of each vertex. Empty if there are no normals.
+   */
+  TArray<FVector3f> normals;
+
+  /**
+   * The tangent (TangentX) of each vertex, with the factor that turns the
+   * cross product of the normal and tangent into the bitangent in W. Empty if
+   * there are no tangents.
+   */
+  TArray<FVector4f> tangents;
+
+  /**
+   * The texture coordinate sets of the vertices, by Unreal texture coordinate
+   * index. Sets that were never written are empty.
+   */
+  TArray<TArray<FVector2f>, TInlineAllocator<MAX_STATIC_TEXCOORDS>> uvs;
+
+  /**
+   * Gets the texture coordinate set with the given index, adding it filled
+   * with zeros if it doesn't exist yet.
+   */
+  TArray<FVector2f>& getUVs(uint32 textureCoordinateIndex);
+};
+
+/**
+ * Calls the given function for consecutive ranges of vertices that together
+ * cover all vertices. If there are enough vertices, the ranges are processed
+ * in parallel, so the function must only write to the given range.
+ *
+ * @param vertexCount The number of vertices.
+ * @param granularity The number that the start of every range is a multiple
+ * of, for example 3 to keep the vertices of a triangle together.
+ * @param function The function to call with the start and end of each range.
+ */
+void forEachVertexRange(
+    int32 vertexCount,
+    int32 granularity,
+    TFunctionRef<void(int32 begin, int32 end)> function);
+
+/**
+ * Computes the axis-aligned bounding box of glTF positions, in glTF
+ * coordinates.
+ */
+FBox computeBoundingBox(const CesiumGltf::AccessorView<FVector3f>& positions);
+
+/**
+ * Gets the number of indices that a primitive is drawn with, after its
+ * triangle strip or fan is expanded to a triangle list. Triangle lists and
+ * points keep their indices.
+ *
+ * @param mode The glTF primitive mode.
+ * @param indexCount The number of glTF indices.
+ */
+int64 getTriangleListIndexCount(int32 mode, int64 indexCount);
+
+/**
+ * Writes a range of the indices that a primitive is drawn with, expanding a
+ * triangle strip or fan to a triangle list.
+ *
+ * @param indices The glTF indices, such as an index accessor view.
+ * @param mode The glTF primitive mode.
+ * @param first The first index to write. For triangle strips and fans, this
+ * must be a multiple of three.
+ * @param count The number of indices to write. For triangle strips and fans,
+ * this must be a multiple of three.
+ * @param pResult Receives the indices.
+ */
+template <typename TIndices, typename TResult>
+void copyTriangleListIndices(
+    const TIndices& indices,
+    int32 mode,
+    int64 first,
+    int64 count,
+    TResult* pResult) {
+  if (mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_STRIP) {
+    for (int64 i = first / 3; i < (first + count) / 3; ++i) {
+      // Every other triangle of a strip has the opposite winding order.
+      const int64 odd = i % 2;
+      *pResult++ = TResult(indices[i]);
+      *pResult++ = TResult(indices[i + 1 + odd]);
+      *pResult++ = TResult(indices[i + 2 - odd]);
+    }
+  } else if (mode == CesiumGltf::MeshPrimitive::Mode::TRIANGLE_FAN) {
+    for (int64 i = first / 3; i < (first + count) / 3; ++i) {
+      *pResult++ = TResult(indices[0]);
+      *pResult++ = TResult(indices[i + 1]);
+      *pResult++ = TResult(indices[i + 2]);
+    }
+  } else {
+    for (int64 i = first; i < first + count; ++i) {
+      *pResult++ = TResult(indices[i]);
+    }
+  }
+}
+
+/**
+ * Sets the indices of an index buffer to the indices that a primitive is
+ * drawn with, without first copying all of them into an array.
+ *
+ * The index buffer uses 16-bit indices unless the primitive has too many
+ * vertices. FRawStaticIndexBuffer only accepts 32-bit indices, so they are
+ * converted in small batches on the stack, which the index buffer narrows as
+ * it appends them.
+ *
+ * @param indices The glTF indices, such as an index accessor view.
+ * @param mode The glTF primitive mode.
+ * @param vertexCount The number of vertices of the primitive.
+ * @param indexBuffer The index buffer to set.
+ */
+template <typename TIndices>
+void setTriangleListIndices(
+    const TIndices& indices,
+    int32 mode,
+    int32 vertexCount,
+    FRawStaticIndexBuffer& indexBuffer) {
+  indexBuffer.SetIndices(
+      TArray<uint32>(),
+      vertexCount >= std::numeric_limits<uint16>::max()
+          ? EIndexBufferStride::Type::Force32Bit
+          : EIndexBufferStride::Type::Force16Bit);
+
+  constexpr int64 batchSize = 3 * 512;
+  uint32 batch[batchSize];
+  const int64 count = getTriangleListIndexCount(mode, int64(indices.size()));
+  for (int64 first = 0; first < count; first += batchSize) {
+    const int64 batchCount = FMath::Min(batchSize, count - first);
+    copyTriangleListIndices(indices, mode, first, batchCount, batch);
+    indexBuffer.AppendIndices(batch, uint32(batchCount));
+  }
+}
+
+/**
+ * Initializes the position vertex buffer from glTF positions, multiplying them
+ * by the given scale and negating their Y coordinate.
+ *
+ * @param positions The glTF positions.
+ * @param pIndices The index of the glTF vertex of each Unreal vertex, if
+ * vertices are duplicated, or nullptr to copy the positions as they are.
+ * @param scale The factor that positions are multiplied by.
+ * @param center The center of the bounding sphere, in Unreal coordinates.
+ * @param positionBuffer The buffer to initialize.
+ * @return The radius of the bounding sphere around the center that contains
+ * all positions.
+ */
+float copyPositions(
+    const CesiumGltf::AccessorView<FVector3f>& positions,
+    const TArray<uint32>* pIndices,
+    float scale,
+    const FVector3f& center,
+    FPositionVertexBuffer& positionBuffer);
+
+/**
+ * Copies glTF normals into the given array, negating their Y coordinate. The
+ * array is resized to the number of vertices.
+ *
+ * @param normals The glTF normals.
+ * @param pIndices The index of the glTF vertex of each Unreal vertex, if
+ * vertices are duplicated, or nullptr to copy the normals as they are.
+ * @param vertexCount The number of vertices.
+ * @param result The array that receives the normals.
+ */
+void copyNormals(
+    const CesiumGltf::AccessorView<FVector3f>& normals,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector3f>& result);
+
+/**
+ * Copies glTF tangents into the given array, negating their Y coordinate. The
+ * array is resized to the number of vertices.
+ *
+ * @param tangents The glTF tangents.
+ * @param pIndices The index of the glTF vertex of each Unreal vertex, if
+ * vertices are duplicated, or nullptr to copy the tangents as they are.
+ * @param vertexCount The number of vertices.
+ * @param result The array that receives the tangents.
+ */
+void copyTangents(
+    const CesiumGltf::AccessorView<FVector4f>& tangents,
+    const TArray<uint32>* pIndices,
+    int32 vertexCount,
+    TArray<FVector4f>& result);
+
+/**
+ * Copies glTF texture coordinates into the given array. Vertices without a
+ * texture coordinate get zeros. The array must already have one element per
+ * vertex.
+ *
+ * @param uvs The glTF texture coordinates.
+ * @param pIndices The index of the glTF vertex of each Unreal vertex, if
+ * vertices are duplicated, or nullptr to copy the coordinates as they are.
+ * @param result The array that receives the texture coordinates.
+ */
+void copyUVs(
+    const CesiumGltf::AccessorView<FVector2f>& uvs,
+    const TArray<uint32>* pIndices,
+    TArray<FVector2f>& result);
+
+/**
+ * Computes a tangent for each vertex of indexed triangles, without
+ * duplicating the vertices of every triangle the way MikkTSpace needs to. The
+ * tangent of a vertex is the area-weighted average of the tangents of the
+ * triangles around it, made perpendicular to its normal.
+ *
+ * A vertex shared by triangles whose texture coordinates are mirrored
+ * relative to each other can't have a single tangent frame, so it is split:
+ * its normal and texture coordinates are copied to a new vertex at the end,
+ * and the mirrored triangles are changed to use the copy. The caller must
+ * then copy the positions and colors of the same vertices with
+ * {@link appendVertexCopies}.
+ *
+ * @param positions The positions of the vertices.
+ * @param indices The triangle list, which is changed to use split vertices.
+ * @param vertices The vertex attributes. The normals must already be set,
+ * and the first texture coordinate set is the one the tangents follow.
+ * @param copiedVertices Receives the vertex copied to each added vertex.
+ */
+void computeIndexedTangents(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    VertexAttributes& vertices,
+    TArray<uint32>& copiedVertices);
+
+/**
+ * Computes flat normals for indexed triangles without giving every triangle
+ * its own vertices. The triangles around a vertex are grouped so that the
+ * normals of the triangles in a group differ by at most the crease angle, and
+ * each group gets a vertex of its own whose normal is the area-weighted
+ * average of the normals of its triangles. With a crease angle of zero, only
+ * coplanar triangles share a vertex, so the normals are exactly flat.
+ *
+ * The vertices added for further groups are appended at the end, with copies
+ * of the texture coordinates and tangents of the split vertex. The caller
+ * must then copy the positions and colors of the same vertices with
+ * {@link appendVertexCopies}.
+ *
+ * @param positions The positions of the vertices.
+ * @param indices The triangle list, which is changed to use split vertices.
+ * @param creaseAngle The largest angle, in radians, between the normals of
+ * triangles that share a vertex.
+ * @param vertices The vertex attributes, whose normals are replaced.
+ * @param copiedVertices Receives the vertex copied to each added vertex.
+ */
+void computeIndexedFlatNormals(
+    const FPositionVertexBuffer& positions,
+    TArray<uint32>& indices,
+    float creaseAngle,
+    VertexAttributes& vertices,
+    TArray<uint32>& copiedVertices);
+
+/**
+ * Appends copies of the given vertices to a position vertex buffer and,
+ * optionally, a color vertex buffer.
+ *
+ * @param copiedVertices The vertex to copy for each added vertex.
+ * @param positionBuffer The position vertex buffer.
+ * @param pColorBuffer The color vertex buffer, or nullptr if the vertices
+ * have no colors.
+ */
+void appendVertexCopies(
+    const TArray<uint32>& copiedVertices,
+    FPositionVertexBuffer& positionBuffer,
+    FColorVertexBuffer* pColorBuffer);
+
+/**
+ * The largest magnitude of a texture coordinate that may be stored with half
+ * precision. Half-precision floats have 10 bits of mantissa, so coordinates
+ * in [0.5, 1] are rounded to about a two-thousandth, and larger ones to
+ * correspondingly less.
+ */
+constexpr float MaximumHalfPrecisionUV = 1.0f;
+
+/**
+ * Determines whether the texture coordinates of the given vertices may be
+ * stored with half precision, because they are all within
+ * {@link MaximumHalfPrecisionUV} of zero.
+ */
+bool canUseHalfPrecisionUVs(const VertexAttributes& vertices);
+
+/**
+ * Determines whether every color in a color vertex buffer is opaque white,
+ * which renders the same as having no vertex colors.
+ */
+bool isOpaqueWhite(const FColorVertexBuffer& colorBuffer);
+
+/**
+ * Initializes the static mesh vertex buffer with the tangent frames and
+ * texture coordinates of the given vertices. Vertices without tangents get
+ * only a normal, and texture coordinate sets that were never written are
+ * filled with zeros.
+ *
+ * @param vertices The vertex attributes.
+ * @param textureCoordinateCount The number of texture coordinate sets of the
+ * buffer.
+ * @param vertexBuffer The buffer to initialize. It must already be set to the
+ * desired UV precision.
+ */
+void initStaticMeshVertexBuffer(
+    const VertexAttributes& vertices,
+    uint32 textureCoordinateCount,
+    FStaticMeshVertexBuffer& vertexBuffer);
+
+} // namespace CesiumVertexBufferUtility
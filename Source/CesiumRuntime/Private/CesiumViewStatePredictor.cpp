@@ -0,0 +1,83 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumViewStatePredictor.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include <glm/geometric.hpp>
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+// How much of a new velocity measurement is blended into the estimate, to
+// smooth out the jitter of uneven frame times.
+constexpr double velocitySmoothing = 0.5;
+
+// Cameras that would move less than this many meters over the lookahead time
+// are considered stationary and get no predictions.
+constexpr double minimumPredictedDistance = 1.0;
+} // namespace
+
+void CesiumViewStatePredictor::update(
+    const std::vector<ViewState>& viewStates,
+    double deltaTime) {
+  if (this->_positions.size() != viewStates.size()) {
+    this->reset();
+    for (const ViewState& viewState : viewStates) {
+      this->_positions.push_back(viewState.getPosition());
+    }
+    return;
+  }
+
+  if (deltaTime <= 0.0) {
+    return;
+  }
+
+  const bool hasVelocities = !this->_velocities.empty();
+  this->_velocities.resize(viewStates.size(), glm::dvec3(0.0));
+
+  for (size_t i = 0; i < viewStates.size(); ++i) {
+    const glm::dvec3& position = viewStates[i].getPosition();
+    glm::dvec3 measured = (position - this->_positions[i]) / deltaTime;
+    this->_velocities[i] =
+        hasVelocities
+            ? glm::mix(this->_velocities[i], measured, velocitySmoothing)
+            : measured;
+    this->_positions[i] = position;
+  }
+}
+
+void CesiumViewStatePredictor::predict(
+    const std::vector<ViewState>& viewStates,
+    double lookaheadTime,
+    int32 steps,
+    const CesiumGeospatial::Ellipsoid& ellipsoid,
+    std::vector<ViewState>& result) const {
+  if (steps <= 0 || lookaheadTime <= 0.0 ||
+      this->_velocities.size() != viewStates.size()) {
+    return;
+  }
+
+  for (size_t i = 0; i < viewStates.size(); ++i) {
+    const glm::dvec3& velocity = this->_velocities[i];
+    if (glm::length(velocity) * lookaheadTime < minimumPredictedDistance) {
+      continue;
+    }
+
+    const ViewState& current = viewStates[i];
+    for (int32 step = 1; step <= steps; ++step) {
+      double time = lookaheadTime * double(step) / double(steps);
+      result.push_back(ViewState::create(
+          current.getPosition() + velocity * time,
+          current.getDirection(),
+          current.getUp(),
+          current.getViewportSize(),
+          current.getHorizontalFieldOfView(),
+          current.getVerticalFieldOfView(),
+          ellipsoid));
+    }
+  }
+}
+
+void CesiumViewStatePredictor::reset() {
+  this->_positions.clear();
+  this->_velocities.clear();
+}
@@ -0,0 +1,68 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "HAL/Platform.h"
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace CesiumGeospatial {
+class Ellipsoid;
+}
+
+/**
+ * Estimates the velocity of each camera used for tile selection from its
+ * position in consecutive frames, and extrapolates the view states the cameras
+ * will likely have in the near future.
+ *
+ * Cameras are identified by their index in the list of view states, so the
+ * estimates start over whenever the number of cameras changes.
+ */
+class CesiumViewStatePredictor {
+public:
+  /**
+   * Updates the velocity estimates from the current view states.
+   *
+   * @param viewStates The current view states.
+   * @param deltaTime The time in seconds since the previous update.
+   */
+  void update(
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      double deltaTime);
+
+  /**
+   * Appends the predicted view states of each moving camera to the given
+   * list. The predictions are spaced evenly over the lookahead time, and keep
+   * the orientation and field of view of the current view.
+   *
+   * @param viewStates The current view states, as passed to the last update.
+   * @param lookaheadTime How far ahead to predict, in seconds.
+   * @param steps The number of predictions per camera.
+   * @param ellipsoid The ellipsoid of the tileset.
+   * @param result The list to append the predicted view states to.
+   */
+  void predict(
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      double lookaheadTime,
+      int32 steps,
+      const CesiumGeospatial::Ellipsoid& ellipsoid,
+      std::vector<Cesium3DTilesSelection::ViewState>& result) const;
+
+  /**
+   * Forgets all camera positions and velocities.
+   */
+  void reset();
+
+  /**
+   * Gets the estimated velocity of each camera, in meters per second. This is
+   * empty until two updates with the same number of cameras have happened.
+   */
+  const std::vector<glm::dvec3>& getVelocities() const {
+    return this->_velocities;
+  }
+
+private:
+  std::vector<glm::dvec3> _positions;
+  std::vector<glm::dvec3> _velocities;
+};
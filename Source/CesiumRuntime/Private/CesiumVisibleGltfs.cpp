@@ -0,0 +1,19 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVisibleGltfs.h"
+#include "CesiumGltfComponent.h"
+
+void CesiumVisibleGltfs::updateTransforms(
+    const glm::dmat4& cesiumToUnrealTransform,
+    uint64 transformEpoch) {
+  for (auto it = this->_gltfs.CreateIterator(); it; ++it) {
+    UCesiumGltfComponent* pGltf = it->Get();
+    if (!IsValid(pGltf) || !pGltf->IsVisible()) {
+      it.RemoveCurrent();
+      continue;
+    }
+
+    pGltf->UpdateTransformFromCesium(cesiumToUnrealTransform);
+    pGltf->TransformEpoch = transformEpoch;
+  }
+}
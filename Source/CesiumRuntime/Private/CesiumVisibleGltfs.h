@@ -0,0 +1,52 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Containers/Set.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <glm/mat4x4.hpp>
+
+class UCesiumGltfComponent;
+
+/**
+ * The glTF components of a tileset that are currently visible.
+ *
+ * When the transform of a tileset changes, only its visible components are
+ * updated right away, and these are usually a small fraction of all its
+ * components. Hidden components are updated if and when they are shown again.
+ */
+class CesiumVisibleGltfs {
+public:
+  /**
+   * Adds a component that was shown. Adding a component more than once has no
+   * effect.
+   */
+  void add(UCesiumGltfComponent* pGltf) { this->_gltfs.Add(pGltf); }
+
+  /**
+   * Removes a component that was hidden or is about to be destroyed.
+   */
+  void remove(UCesiumGltfComponent* pGltf) { this->_gltfs.Remove(pGltf); }
+
+  /**
+   * Forgets all components.
+   */
+  void clear() { this->_gltfs.Empty(); }
+
+  /**
+   * Gets the number of visible components.
+   */
+  int32 num() const { return this->_gltfs.Num(); }
+
+  /**
+   * Updates the transforms of the visible components and records the given
+   * transform epoch on them. Components that were destroyed or hidden in the
+   * meantime are skipped and forgotten.
+   */
+  void updateTransforms(
+      const glm::dmat4& cesiumToUnrealTransform,
+      uint64 transformEpoch);
+
+private:
+  TSet<TWeakObjectPtr<UCesiumGltfComponent>> _gltfs;
+};
@@ -20,8 +20,17 @@ struct CreateModelOptions {
   const FMetadataDescription* pEncodedMetadataDescription_DEPRECATED = nullptr;
   PRAGMA_ENABLE_DEPRECATION_WARNINGS
   bool alwaysIncludeTangents = false;
+  bool generateIndexedTangents = false;
+  bool generateIndexedFlatNormals = false;
+  float flatNormalCreaseAngle = 0.0f;
+  bool compactVertexFormat = false;
+  bool quantizePositions = false;
   bool createPhysicsMeshes = true;
+  bool cookPhysicsMeshesOnDemand = false;
+  bool simplifyPhysicsMeshes = false;
+  float physicsMeshMaximumError = 0.0f;
   bool ignoreKhrMaterialsUnlit = false;
+  bool mergePrimitives = false;
 
   Cesium3DTilesSelection::TileLoadResult tileLoadResult;
 
@@ -36,8 +45,17 @@ public:
         pEncodedMetadataDescription_DEPRECATED(
             other.pEncodedMetadataDescription_DEPRECATED),
         alwaysIncludeTangents(other.alwaysIncludeTangents),
+        generateIndexedTangents(other.generateIndexedTangents),
+        generateIndexedFlatNormals(other.generateIndexedFlatNormals),
+        flatNormalCreaseAngle(other.flatNormalCreaseAngle),
+        compactVertexFormat(other.compactVertexFormat),
+        quantizePositions(other.quantizePositions),
         createPhysicsMeshes(other.createPhysicsMeshes),
+        cookPhysicsMeshesOnDemand(other.cookPhysicsMeshesOnDemand),
+        simplifyPhysicsMeshes(other.simplifyPhysicsMeshes),
+        physicsMeshMaximumError(other.physicsMeshMaximumError),
         ignoreKhrMaterialsUnlit(other.ignoreKhrMaterialsUnlit),
+        mergePrimitives(other.mergePrimitives),
         tileLoadResult(std::move(other.tileLoadResult)) {
     pModel = std::get_if<CesiumGltf::Model>(&this->tileLoadResult.contentKind);
   }
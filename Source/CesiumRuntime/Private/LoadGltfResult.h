@@ -6,11 +6,12 @@
 #include "CesiumEncodedFeaturesMetadata.h"
 #include "CesiumMetadataPrimitive.h"
 #include "CesiumModelMetadata.h"
+#include "CesiumPhysicsMeshUtility.h"
 #include "CesiumPrimitiveFeatures.h"
 #include "CesiumPrimitiveMetadata.h"
+#include "CesiumQuantizedPositions.h"
 #include "CesiumRasterOverlays.h"
 #include "CesiumTextureUtility.h"
-#include "Chaos/TriangleMeshImplicitObject.h"
 #include "Containers/Map.h"
 #include "Containers/UnrealString.h"
 #include "Math/TransformNonVectorized.h"
@@ -51,14 +52,24 @@ struct LoadPrimitiveResult {
   int32_t materialIndex = -1;
 
   glm::dmat4x4 transform{1.0};
-#if ENGINE_VERSION_5_4_OR_HIGHER
-  Chaos::FTriangleMeshImplicitObjectPtr pCollisionMesh = nullptr;
-#else
-  TSharedPtr<Chaos::FTriangleMeshImplicitObject, ESPMode::ThreadSafe>
-      pCollisionMesh = nullptr;
-#endif
+  CesiumPhysicsMeshUtility::CollisionMeshPtr pCollisionMesh = nullptr;
+
+  /**
+   * The triangles to cook the collision mesh from once it is needed, if
+   * physics meshes are cooked on demand. Otherwise, this is nullptr and the
+   * collision mesh is cooked right away.
+   */
+  TSharedPtr<const CesiumPhysicsMeshUtility::CollisionMeshSource>
+      pCollisionMeshSource = nullptr;
   std::string name{};
 
+  /**
+   * The quantized positions to draw this primitive with, if positions are
+   * quantized. The render data still holds the full-precision positions until
+   * its resources are initialized.
+   */
+  TUniquePtr<FCesiumQuantizedPositions> pQuantizedPositions = nullptr;
+
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult> baseColorTexture;
   TUniquePtr<CesiumTextureUtility::LoadedTextureResult>
       metallicRoughnessTexture;
@@ -75,6 +86,12 @@ struct LoadPrimitiveResult {
 
   bool isUnlit = false;
 
+  /**
+   * The number of bytes of vertex memory saved by storing this primitive in
+   * the compact vertex format.
+   */
+  uint64 compactVertexBytesSaved = 0;
+
   bool onlyLand = true;
   bool onlyWater = false;
 
@@ -88,6 +105,13 @@ struct LoadPrimitiveResult {
    */
   glm::vec3 dimensions;
 
+  /**
+   * The primitives whose render data was merged into this one's, in the order
+   * of the mesh sections after the first. Their own render data and collision
+   * meshes have been moved into this primitive's.
+   */
+  std::vector<LoadPrimitiveResult> mergedPrimitives;
+
 #pragma endregion
 
 #pragma region CesiumGltfPrimitiveComponent data
@@ -183,5 +207,15 @@ struct LoadModelResult {
   // For backwards compatibility with CesiumEncodedMetadataComponent.
   std::optional<CesiumEncodedMetadataUtility::EncodedMetadata>
       EncodedMetadata_DEPRECATED{};
+
+  // The number of vertices of the loaded glTF primitives.
+  uint64 gltfVertexCount = 0;
+
+  // The number of vertices of the meshes created for them, which is larger
+  // when vertices were duplicated to generate normals or tangents.
+  uint64 vertexCount = 0;
+
+  // The vertex memory saved by the compact vertex format, in bytes.
+  uint64 compactVertexBytesSaved = 0;
 };
 } // namespace LoadGltfResult
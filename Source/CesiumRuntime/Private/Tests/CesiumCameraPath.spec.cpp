@@ -0,0 +1,83 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPath.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCameraPathSpec,
+    "Cesium.Unit.CameraPath",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+FString Filename;
+
+END_DEFINE_SPEC(FCesiumCameraPathSpec)
+
+void FCesiumCameraPathSpec::Define() {
+  BeforeEach([this]() {
+    Filename = FPaths::CreateTempFilename(
+        *FPaths::ProjectSavedDir(),
+        TEXT("CesiumCameraPath"),
+        TEXT(".csv"));
+  });
+
+  AfterEach([this]() { IFileManager::Get().Delete(*Filename); });
+
+  It("round-trips through CSV", [this]() {
+    CesiumCameraPath path;
+    CesiumCameraPath::Frame& first = path.frames.emplace_back();
+    first.time = 0.0;
+    CesiumCameraPath::Camera& camera = first.cameras.emplace_back();
+    camera.position = glm::dvec3(6378137.0, 1.5, -2.25);
+    camera.direction = glm::dvec3(-1.0, 0.0, 0.0);
+    camera.up = glm::dvec3(0.0, 0.0, 1.0);
+    camera.fieldOfViewDegrees = 60.0;
+    camera.viewportSize = glm::dvec2(1920.0, 1080.0);
+
+    CesiumCameraPath::Frame& second = path.frames.emplace_back();
+    second.time = 0.5;
+    second.cameras.push_back(camera);
+    second.cameras.push_back(camera);
+    second.cameras[1].fieldOfViewDegrees = 30.0;
+
+    TestTrue("Saved", path.saveToCsv(Filename));
+
+    std::optional<CesiumCameraPath> maybeLoaded =
+        CesiumCameraPath::loadFromCsv(Filename);
+    if (!TestTrue("Loaded", maybeLoaded.has_value())) {
+      return;
+    }
+
+    const CesiumCameraPath& loaded = *maybeLoaded;
+    if (!TestEqual("Frames", loaded.frames.size(), size_t(2))) {
+      return;
+    }
+    TestEqual("First cameras", loaded.frames[0].cameras.size(), size_t(1));
+    TestEqual("Second cameras", loaded.frames[1].cameras.size(), size_t(2));
+    TestEqual("Second time", loaded.frames[1].time, 0.5);
+
+    const CesiumCameraPath::Camera& loadedCamera = loaded.frames[0].cameras[0];
+    TestEqual("Position X", loadedCamera.position.x, camera.position.x);
+    TestEqual("Position Y", loadedCamera.position.y, camera.position.y);
+    TestEqual("Position Z", loadedCamera.position.z, camera.position.z);
+    TestEqual("Direction X", loadedCamera.direction.x, camera.direction.x);
+    TestEqual("Up Z", loadedCamera.up.z, camera.up.z);
+    TestEqual("Viewport width", loadedCamera.viewportSize.x, 1920.0);
+    TestEqual(
+        "Field of view",
+        loaded.frames[1].cameras[1].fieldOfViewDegrees,
+        30.0);
+  });
+
+  It("rejects malformed lines", [this]() {
+    FFileHelper::SaveStringToFile(
+        FString(TEXT("header\n0,0.0,1.0,2.0\n")),
+        *Filename);
+
+    AddExpectedError(TEXT("has 4 values"));
+    TestFalse("Loaded", CesiumCameraPath::loadFromCsv(Filename).has_value());
+  });
+}
@@ -0,0 +1,184 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraPathRecorderComponent.h"
+#include "CesiumCameraManager.h"
+#include "CesiumCameraPath.h"
+#include "CesiumCameraSubsystem.h"
+#include "CesiumGeoreference.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTestHelpers.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCameraPathRecorderComponentSpec,
+    "Cesium.Unit.CameraPathRecorderComponent",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+FString Filename;
+TObjectPtr<AActor> pActor;
+TObjectPtr<ACesiumGeoreference> pGeoreference;
+TObjectPtr<ACesiumCameraManager> pCameraManager;
+TObjectPtr<ASceneCapture2D> pSceneCapture;
+TObjectPtr<UCesiumCameraPathRecorderComponent> pRecorder;
+
+const FCesiumCamera camera = FCesiumCamera(
+    FVector2D(640.0, 480.0),
+    FVector(100.0, 200.0, 300.0),
+    FRotator(10.0, 20.0, 0.0),
+    60.0);
+
+CesiumCameraPath recordFrame() {
+  pRecorder->StartRecording();
+  pRecorder->TickComponent(0.0f, ELevelTick::LEVELTICK_All, nullptr);
+  pRecorder->StopRecording();
+
+  std::optional<CesiumCameraPath> maybePath =
+      CesiumCameraPath::loadFromCsv(Filename);
+  TestTrue("Recorded path is valid", maybePath.has_value());
+  return maybePath ? MoveTemp(*maybePath) : CesiumCameraPath();
+}
+
+size_t countCameras(const CesiumCameraPath& path) {
+  size_t count = 0;
+  for (const CesiumCameraPath::Frame& frame : path.frames) {
+    count += frame.cameras.size();
+  }
+  return count;
+}
+
+bool scaleUsingDPI() {
+  return GetDefault<UCesiumRuntimeSettings>()->ScaleLevelOfDetailByDPI;
+}
+
+END_DEFINE_SPEC(FCesiumCameraPathRecorderComponentSpec)
+
+void FCesiumCameraPathRecorderComponentSpec::Define() {
+  BeforeEach([this]() {
+    Filename = FPaths::CreateTempFilename(
+        *FPaths::ProjectSavedDir(),
+        TEXT("CesiumCameraPathRecorder"),
+        TEXT(".csv"));
+
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    pGeoreference = pWorld->SpawnActor<ACesiumGeoreference>();
+    pCameraManager = pWorld->SpawnActor<ACesiumCameraManager>();
+    pCameraManager->AddCamera(camera);
+
+    // A scene capture is used for tile selection, but isn't a player view.
+    pSceneCapture = pWorld->SpawnActor<ASceneCapture2D>();
+    UTextureRenderTarget2D* pRenderTarget =
+        NewObject<UTextureRenderTarget2D>(pSceneCapture);
+    pRenderTarget->SizeX = 256;
+    pRenderTarget->SizeY = 128;
+    pSceneCapture->GetCaptureComponent2D()->TextureTarget = pRenderTarget;
+
+    pActor = pWorld->SpawnActor<AActor>();
+    pRecorder = NewObject<UCesiumCameraPathRecorderComponent>(pActor);
+    pRecorder->Filename = Filename;
+    pRecorder->Georeference = pGeoreference;
+    pRecorder->CameraManager = pCameraManager;
+  });
+
+  AfterEach([this]() {
+    pRecorder->StopRecording();
+    pRecorder = nullptr;
+    pActor->Destroy();
+    pActor = nullptr;
+    pSceneCapture->Destroy();
+    pSceneCapture = nullptr;
+    pCameraManager->Destroy();
+    pCameraManager = nullptr;
+    pGeoreference->Destroy();
+    pGeoreference = nullptr;
+    IFileManager::Get().Delete(*Filename);
+  });
+
+  It("records the player and camera manager cameras by default", [this]() {
+    UCesiumCameraSubsystem* pSubsystem =
+        pActor->GetWorld()->GetSubsystem<UCesiumCameraSubsystem>();
+    size_t playerCameras = pSubsystem->GetPlayerCameras(scaleUsingDPI()).size();
+
+    CesiumCameraPath path = recordFrame();
+    TestEqual("Recorded cameras", countCameras(path), playerCameras + 1);
+    TestTrue("Recording is stopped", !pRecorder->IsRecording());
+    if (path.frames.empty() || path.frames[0].cameras.empty()) {
+      return;
+    }
+
+    const std::vector<CesiumCameraPath::Camera>& cameras =
+        path.frames[0].cameras;
+    bool foundSceneCapture = false;
+    for (const CesiumCameraPath::Camera& recorded : cameras) {
+      foundSceneCapture |= recorded.viewportSize == glm::dvec2(256, 128);
+    }
+    TestFalse("Scene capture is recorded", foundSceneCapture);
+
+    // The cameras of the camera manager are recorded last.
+    const CesiumCameraPath::Camera& recorded = cameras.back();
+    TestEqual("Field of view", recorded.fieldOfViewDegrees, 60.0);
+    TestEqual(
+        "Viewport size",
+        FVector2D(recorded.viewportSize.x, recorded.viewportSize.y),
+        FVector2D(640.0, 480.0));
+  });
+
+  It("records all cameras in Earth-Centered, Earth-Fixed coordinates",
+     [this]() {
+       pRecorder->RecordOnlyPlayerCameras = false;
+
+       UCesiumCameraSubsystem* pSubsystem =
+           pActor->GetWorld()->GetSubsystem<UCesiumCameraSubsystem>();
+       size_t otherCameras = pSubsystem->GetCameras(scaleUsingDPI()).size();
+
+       CesiumCameraPath path = recordFrame();
+       TestEqual("Frames", path.frames.size(), size_t(1));
+       if (path.frames.empty()) {
+         return;
+       }
+
+       const std::vector<CesiumCameraPath::Camera>& cameras =
+           path.frames[0].cameras;
+       TestEqual("Recorded cameras", cameras.size(), otherCameras + 1);
+
+       bool foundSceneCapture = false;
+       for (const CesiumCameraPath::Camera& recorded : cameras) {
+         foundSceneCapture |= recorded.viewportSize == glm::dvec2(256, 128);
+       }
+       TestTrue("Scene capture is recorded", foundSceneCapture);
+
+       // The cameras of the camera manager are recorded last.
+       const CesiumCameraPath::Camera& recorded = cameras.back();
+       FVector position =
+           pGeoreference->TransformUnrealPositionToEarthCenteredEarthFixed(
+               camera.Location);
+       FVector direction =
+           pGeoreference->TransformUnrealDirectionToEarthCenteredEarthFixed(
+               camera.Rotation.RotateVector(FVector::ForwardVector));
+       TestTrue(
+           "Position",
+           FVector(
+               recorded.position.x,
+               recorded.position.y,
+               recorded.position.z)
+               .Equals(position, 1e-3));
+       TestTrue(
+           "Direction",
+           FVector(
+               recorded.direction.x,
+               recorded.direction.y,
+               recorded.direction.z)
+               .Equals(direction, 1e-6));
+       TestEqual("Field of view", recorded.fieldOfViewDegrees, 60.0);
+       TestEqual(
+           "Viewport size",
+           FVector2D(recorded.viewportSize.x, recorded.viewportSize.y),
+           FVector2D(640.0, 480.0));
+     });
+}
@@ -0,0 +1,159 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumCameraSubsystem.h"
+#include "CesiumCameraManager.h"
+#include "CesiumEllipsoid.h"
+#include "CesiumTestHelpers.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/SceneCapture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumCameraSubsystemSpec,
+    "Cesium.Unit.CameraSubsystem",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<ASceneCapture2D> pSceneCapture;
+TObjectPtr<ACesiumCameraManager> pCameraManager;
+int32 cameraId = -1;
+
+END_DEFINE_SPEC(FCesiumCameraSubsystemSpec)
+
+void FCesiumCameraSubsystemSpec::Define() {
+  AfterEach([this]() {
+    if (IsValid(pSceneCapture)) {
+      pSceneCapture->Destroy();
+    }
+    pSceneCapture = nullptr;
+
+    if (IsValid(pCameraManager) && cameraId >= 0) {
+      pCameraManager->RemoveCamera(cameraId);
+    }
+    pCameraManager = nullptr;
+    cameraId = -1;
+  });
+
+  It("exists for the global world", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    TestNotNull(
+        "Subsystem is valid",
+        pWorld->GetSubsystem<UCesiumCameraSubsystem>());
+  });
+
+  It("tracks scene captures as they are spawned and destroyed", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    UCesiumCameraSubsystem* pSubsystem =
+        pWorld->GetSubsystem<UCesiumCameraSubsystem>();
+
+    int32 before = int32(pSubsystem->GetCameras(false).size());
+
+    pSceneCapture = pWorld->SpawnActor<ASceneCapture2D>();
+    UTextureRenderTarget2D* pRenderTarget =
+        NewObject<UTextureRenderTarget2D>(pSceneCapture);
+    pRenderTarget->SizeX = 256;
+    pRenderTarget->SizeY = 128;
+    pSceneCapture->GetCaptureComponent2D()->TextureTarget = pRenderTarget;
+
+    const std::vector<FCesiumCamera>& cameras = pSubsystem->GetCameras(false);
+    TestEqual(
+        "Camera count after spawning",
+        int32(cameras.size()),
+        before + 1);
+
+    bool found = false;
+    for (const FCesiumCamera& camera : cameras) {
+      found |= camera.ViewportSize == FVector2D(256.0, 128.0);
+    }
+    TestTrue("Scene capture camera is included", found);
+
+    pSceneCapture->Destroy();
+    pSceneCapture = nullptr;
+
+    TestEqual(
+        "Camera count after destroying",
+        int32(pSubsystem->GetCameras(false).size()),
+        before);
+  });
+
+  It("shares view states between identical requests", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    UCesiumCameraSubsystem* pSubsystem =
+        pWorld->GetSubsystem<UCesiumCameraSubsystem>();
+    UCesiumEllipsoid* pEllipsoid =
+        UCesiumEllipsoid::Create(FVector(6378137.0, 6378137.0, 6356752.3));
+
+    const std::vector<Cesium3DTilesSelection::ViewState>& first =
+        pSubsystem->GetViewStates(glm::dmat4(1.0), pEllipsoid, false, nullptr);
+    const std::vector<Cesium3DTilesSelection::ViewState>& second =
+        pSubsystem->GetViewStates(glm::dmat4(1.0), pEllipsoid, false, nullptr);
+    TestTrue("Identical requests share view states", &first == &second);
+
+    const std::vector<Cesium3DTilesSelection::ViewState>& translated =
+        pSubsystem->GetViewStates(
+            glm::translate(glm::dmat4(1.0), glm::dvec3(1.0, 0.0, 0.0)),
+            pEllipsoid,
+            false,
+            nullptr);
+    TestTrue(
+        "Different transforms get new view states",
+        &first != &translated);
+  });
+  It("includes cameras that are added later in the same frame", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    UCesiumCameraSubsystem* pSubsystem =
+        pWorld->GetSubsystem<UCesiumCameraSubsystem>();
+    UCesiumEllipsoid* pEllipsoid =
+        UCesiumEllipsoid::Create(FVector(6378137.0, 6378137.0, 6356752.3));
+    pCameraManager = ACesiumCameraManager::GetDefaultCameraManager(pWorld);
+
+    const std::vector<Cesium3DTilesSelection::ViewState>& before =
+        pSubsystem->GetViewStates(
+            glm::dmat4(1.0),
+            pEllipsoid,
+            false,
+            pCameraManager);
+    size_t countBefore = before.size();
+
+    cameraId = pCameraManager->AddCamera(FCesiumCamera(
+        FVector2D(256.0, 128.0),
+        FVector::ZeroVector,
+        FRotator::ZeroRotator,
+        60.0));
+
+    const std::vector<Cesium3DTilesSelection::ViewState>& after =
+        pSubsystem->GetViewStates(
+            glm::dmat4(1.0),
+            pEllipsoid,
+            false,
+            pCameraManager);
+    TestEqual("View states after adding", after.size(), countBefore + 1);
+    TestEqual(
+        "Earlier view states are still valid",
+        before.size(),
+        countBefore);
+  });
+
+  It("keeps earlier results valid when a scene capture is added", [this]() {
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    UCesiumCameraSubsystem* pSubsystem =
+        pWorld->GetSubsystem<UCesiumCameraSubsystem>();
+
+    const std::vector<FCesiumCamera>& before = pSubsystem->GetCameras(false);
+    size_t countBefore = before.size();
+
+    pSceneCapture = pWorld->SpawnActor<ASceneCapture2D>();
+    UTextureRenderTarget2D* pRenderTarget =
+        NewObject<UTextureRenderTarget2D>(pSceneCapture);
+    pRenderTarget->SizeX = 256;
+    pRenderTarget->SizeY = 128;
+    pSceneCapture->GetCaptureComponent2D()->TextureTarget = pRenderTarget;
+
+    const std::vector<FCesiumCamera>& after = pSubsystem->GetCameras(false);
+    TestTrue("A new result is computed", &before != &after);
+    TestEqual("The earlier result is unchanged", before.size(), countBefore);
+  });
+}
@@ -0,0 +1,92 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#if WITH_EDITOR
+
+#include "CesiumFlyToComponent.h"
+#include "CesiumCameraManager.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumFlyToComponentSpec,
+    "Cesium.Unit.FlyToComponent",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<UWorld> pWorld;
+TObjectPtr<AStaticMeshActor> pActor;
+TObjectPtr<UCesiumFlyToComponent> pFlyTo;
+TObjectPtr<ACesiumCameraManager> pCameraManager;
+
+END_DEFINE_SPEC(FCesiumFlyToComponentSpec)
+
+void FCesiumFlyToComponentSpec::Define() {
+  BeforeEach([this]() {
+    if (!IsValid(pWorld)) {
+      pWorld = FAutomationEditorCommonUtils::CreateNewMap();
+    }
+
+    pActor = pWorld->SpawnActor<AStaticMeshActor>();
+    pActor->SetMobility(EComponentMobility::Movable);
+    pFlyTo = Cast<UCesiumFlyToComponent>(pActor->AddComponentByClass(
+        UCesiumFlyToComponent::StaticClass(),
+        false,
+        FTransform::Identity,
+        false));
+    pCameraManager = ACesiumCameraManager::GetDefaultCameraManager(pWorld);
+  });
+
+  AfterEach([this]() {
+    pFlyTo->InterruptFlight();
+    pActor->Destroy();
+  });
+
+  It("doesn't preload by default", [this]() {
+    TestFalse(
+        "PreloadDestination",
+        GetDefault<UCesiumFlyToComponent>()->PreloadDestination);
+  });
+
+  It("adds preload cameras when a flight starts", [this]() {
+    pFlyTo->PreloadDestination = true;
+    pFlyTo->PreloadPointsAlongFlight = 2;
+    const int32 camerasBefore = pCameraManager->GetCameras().Num();
+
+    pFlyTo->FlyToLocationLongitudeLatitudeHeight(
+        FVector(-105.0, 40.0, 1000.0),
+        0.0,
+        -30.0,
+        false);
+
+    TestEqual(
+        "Cameras during flight",
+        pCameraManager->GetCameras().Num(),
+        camerasBefore + 3);
+
+    pFlyTo->InterruptFlight();
+    TestEqual(
+        "Cameras after flight",
+        pCameraManager->GetCameras().Num(),
+        camerasBefore);
+  });
+
+  It("doesn't add cameras when preloading is disabled", [this]() {
+    pFlyTo->PreloadDestination = false;
+    const int32 camerasBefore = pCameraManager->GetCameras().Num();
+
+    pFlyTo->FlyToLocationLongitudeLatitudeHeight(
+        FVector(-105.0, 40.0, 1000.0),
+        0.0,
+        -30.0,
+        false);
+
+    TestEqual(
+        "Cameras during flight",
+        pCameraManager->GetCameras().Num(),
+        camerasBefore);
+  });
+}
+
+#endif
@@ -0,0 +1,256 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltfPrimitiveComponent.h"
+#include "CesiumFeatureIdSet.h"
+#include "CesiumGltf/ExtensionExtMeshFeatures.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumPrimitiveFeatures.h"
+#include "CesiumTilesetPrimitiveComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+#include "StaticMeshResources.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumGltfPrimitiveComponentSpec,
+    "Cesium.Unit.GltfPrimitiveComponent",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+CesiumGltf::Model model;
+CesiumGltf::MeshPrimitive* pPrimitive;
+TObjectPtr<UCesiumGltfPrimitiveComponent> pPrimitiveComponent;
+END_DEFINE_SPEC(FCesiumGltfPrimitiveComponentSpec)
+
+void FCesiumGltfPrimitiveComponentSpec::Define() {
+  Describe("getPrimitiveDataForFace", [this]() {
+    BeforeEach([this]() {
+      pPrimitiveComponent = NewObject<UCesiumGltfPrimitiveComponent>();
+    });
+
+    It("returns the component's data without merged primitives", [this]() {
+      int64 primitiveFaceIndex = -1;
+      const CesiumPrimitiveData& primData =
+          pPrimitiveComponent->getPrimitiveDataForFace(5, primitiveFaceIndex);
+      TestTrue(
+          "PrimitiveData",
+          &primData == &pPrimitiveComponent->getPrimitiveData());
+      TestEqual("PrimitiveFaceIndex", primitiveFaceIndex, int64(5));
+      TestEqual("PrimitiveCount", pPrimitiveComponent->getPrimitiveCount(), 1);
+    });
+
+    It("maps faces to the merged primitive that contains them", [this]() {
+      CesiumPrimitiveData* pSecond =
+          &pPrimitiveComponent->addMergedPrimitive(10);
+      CesiumPrimitiveData* pThird =
+          &pPrimitiveComponent->addMergedPrimitive(25);
+      TestEqual("PrimitiveCount", pPrimitiveComponent->getPrimitiveCount(), 3);
+
+      std::array<int64, 5> faceIndices{0, 9, 10, 24, 30};
+      std::array<const CesiumPrimitiveData*, 5> expectedData{
+          &pPrimitiveComponent->getPrimitiveData(),
+          &pPrimitiveComponent->getPrimitiveData(),
+          pSecond,
+          pSecond,
+          pThird};
+      std::array<int64, 5> expectedFaceIndices{0, 9, 0, 14, 5};
+
+      for (size_t i = 0; i < faceIndices.size(); ++i) {
+        int64 primitiveFaceIndex = -1;
+        const CesiumPrimitiveData& primData =
+            pPrimitiveComponent->getPrimitiveDataForFace(
+                faceIndices[i],
+                primitiveFaceIndex);
+        TestTrue("PrimitiveData", &primData == expectedData[i]);
+        TestEqual(
+            "PrimitiveFaceIndex",
+            primitiveFaceIndex,
+            expectedFaceIndices[i]);
+      }
+    });
+
+    It("forgets merged primitives when they are destroyed", [this]() {
+      pPrimitiveComponent->addMergedPrimitive(10);
+      pPrimitiveComponent->destroyMergedPrimitives();
+
+      int64 primitiveFaceIndex = -1;
+      const CesiumPrimitiveData& primData =
+          pPrimitiveComponent->getPrimitiveDataForFace(12, primitiveFaceIndex);
+      TestTrue(
+          "PrimitiveData",
+          &primData == &pPrimitiveComponent->getPrimitiveData());
+      TestEqual("PrimitiveFaceIndex", primitiveFaceIndex, int64(12));
+    });
+  });
+
+  Describe("setTilesetPrimitiveComponent", [this]() {
+    BeforeEach([this]() {
+      pPrimitiveComponent = NewObject<UCesiumGltfPrimitiveComponent>();
+    });
+
+    It("skips the component's own render state", [this]() {
+      UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent =
+          NewObject<UCesiumTilesetPrimitiveComponent>();
+      pPrimitiveComponent->setTilesetPrimitiveComponent(
+          pTilesetPrimitiveComponent);
+      TestFalse(
+          "ShouldCreateRenderState",
+          pPrimitiveComponent->ShouldCreateRenderState());
+    });
+
+    It("doesn't show primitives without render data", [this]() {
+      UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent =
+          NewObject<UCesiumTilesetPrimitiveComponent>();
+      pTilesetPrimitiveComponent->ShowPrimitive(pPrimitiveComponent);
+      TestEqual(
+          "ShownPrimitiveCount",
+          pTilesetPrimitiveComponent->GetShownPrimitiveCount(),
+          0);
+    });
+
+    It("encloses the shown primitives in its bounds", [this]() {
+      TUniquePtr<FStaticMeshRenderData> pRenderData =
+          MakeUnique<FStaticMeshRenderData>();
+      pRenderData->AllocateLODResources(1);
+      pRenderData->Bounds =
+          FBoxSphereBounds(FBox(FVector(-100.0), FVector(100.0)));
+      UStaticMesh* pStaticMesh = NewObject<UStaticMesh>();
+      pStaticMesh->SetRenderData(MoveTemp(pRenderData));
+      pStaticMesh->CalculateExtendedBounds();
+
+      pPrimitiveComponent->SetStaticMesh(pStaticMesh);
+      pPrimitiveComponent->SetWorldLocation(FVector(1000.0, 0.0, 0.0));
+      pPrimitiveComponent->UpdateBounds();
+
+      UCesiumTilesetPrimitiveComponent* pTilesetPrimitiveComponent =
+          NewObject<UCesiumTilesetPrimitiveComponent>();
+      pTilesetPrimitiveComponent->ShowPrimitive(pPrimitiveComponent);
+      TestEqual(
+          "ShownPrimitiveCount",
+          pTilesetPrimitiveComponent->GetShownPrimitiveCount(),
+          1);
+
+      FBoxSphereBounds bounds =
+          pTilesetPrimitiveComponent->CalcBounds(FTransform::Identity);
+      TestEqual("Origin", bounds.Origin, FVector(1000.0, 0.0, 0.0));
+      TestEqual("BoxExtent", bounds.BoxExtent, FVector(100.0));
+
+      pTilesetPrimitiveComponent->HidePrimitive(pPrimitiveComponent);
+      TestEqual(
+          "ShownPrimitiveCount",
+          pTilesetPrimitiveComponent->GetShownPrimitiveCount(),
+          0);
+      bounds = pTilesetPrimitiveComponent->CalcBounds(FTransform::Identity);
+      TestEqual("BoxExtent", bounds.BoxExtent, FVector::ZeroVector);
+    });
+  });
+
+  Describe("Picking merged primitives", [this]() {
+    BeforeEach([this]() {
+      model = CesiumGltf::Model();
+      CesiumGltf::Mesh& mesh = model.meshes.emplace_back();
+      pPrimitive = &mesh.primitives.emplace_back();
+      pPrimitive->mode = CesiumGltf::MeshPrimitive::Mode::TRIANGLES;
+
+      std::vector<glm::vec3> positions{
+          glm::vec3(-1, 0, 0),
+          glm::vec3(0, 1, 0),
+          glm::vec3(1, 0, 0),
+          glm::vec3(-1, 3, 0),
+          glm::vec3(0, 4, 0),
+          glm::vec3(1, 3, 0),
+      };
+
+      CreateAttributeForPrimitive(
+          model,
+          *pPrimitive,
+          "POSITION",
+          CesiumGltf::AccessorSpec::Type::VEC3,
+          CesiumGltf::AccessorSpec::ComponentType::FLOAT,
+          positions);
+
+      pPrimitiveComponent = NewObject<UCesiumGltfPrimitiveComponent>();
+    });
+
+    It("resolves feature IDs relative to the merged primitive", [this]() {
+      // The first primitive has no position data, so a feature ID can only be
+      // found if the hit is resolved to the merged primitive.
+      CesiumPrimitiveData& merged = pPrimitiveComponent->addMergedPrimitive(2);
+      merged.pMeshPrimitive = pPrimitive;
+      merged.PositionAccessor = CesiumGltf::AccessorView<FVector3f>(
+          model,
+          static_cast<int32_t>(model.accessors.size() - 1));
+
+      CesiumGltf::FeatureId featureId;
+      featureId.featureCount = 6;
+      FCesiumFeatureIdSet featureIDSet(model, *pPrimitive, featureId);
+
+      FHitResult Hit;
+      Hit.Component = pPrimitiveComponent;
+
+      std::array<int32, 3> faceIndices{0, 2, 3};
+      std::array<int64, 3> expected{-1, 0, 3};
+      for (size_t i = 0; i < faceIndices.size(); i++) {
+        Hit.FaceIndex = faceIndices[i];
+        TestEqual(
+            "FeatureIDFromHit",
+            UCesiumFeatureIdSetBlueprintLibrary::GetFeatureIDFromHit(
+                featureIDSet,
+                Hit),
+            expected[i]);
+      }
+    });
+
+    It("picks the features of the merged primitive that was hit", [this]() {
+      const int32_t positionAccessorIndex =
+          static_cast<int32_t>(model.accessors.size() - 1);
+      model.meshes[0].primitives.push_back(*pPrimitive);
+      CesiumGltf::MeshPrimitive& first = model.meshes[0].primitives[0];
+      CesiumGltf::MeshPrimitive& second = model.meshes[0].primitives[1];
+
+      std::vector<uint8_t> firstFeatureIDs{0, 0, 0, 1, 1, 1};
+      AddFeatureIDsAsAttributeToModel(model, first, firstFeatureIDs, 4, 0);
+      std::vector<uint8_t> secondFeatureIDs{2, 2, 2, 3, 3, 3};
+      AddFeatureIDsAsAttributeToModel(model, second, secondFeatureIDs, 4, 0);
+
+      // Both primitives have two faces, so the second one starts at face 2.
+      std::array<CesiumPrimitiveData*, 2> primData{
+          &pPrimitiveComponent->getPrimitiveData(),
+          &pPrimitiveComponent->addMergedPrimitive(2)};
+      std::array<CesiumGltf::MeshPrimitive*, 2> primitives{&first, &second};
+      for (size_t i = 0; i < primData.size(); ++i) {
+        CesiumGltf::MeshPrimitive& primitive = *primitives[i];
+        primData[i]->pMeshPrimitive = &primitive;
+        primData[i]->PositionAccessor =
+            CesiumGltf::AccessorView<FVector3f>(model, positionAccessorIndex);
+        primData[i]->Features = FCesiumPrimitiveFeatures(
+            model,
+            primitive,
+            *primitive.getExtension<CesiumGltf::ExtensionExtMeshFeatures>());
+      }
+
+      FHitResult Hit;
+      Hit.Component = pPrimitiveComponent;
+
+      std::array<int32, 4> faceIndices{0, 1, 2, 3};
+      std::array<int64, 4> expected{0, 1, 2, 3};
+      for (size_t i = 0; i < faceIndices.size(); i++) {
+        Hit.FaceIndex = faceIndices[i];
+        const FCesiumPrimitiveFeatures& features =
+            UCesiumPrimitiveFeaturesBlueprintLibrary::GetPrimitiveFeatures(
+                pPrimitiveComponent,
+                Hit.FaceIndex);
+        TestEqual(
+            "FeatureIDFromHit",
+            UCesiumPrimitiveFeaturesBlueprintLibrary::GetFeatureIDFromHit(
+                features,
+                Hit,
+                0),
+            expected[i]);
+      }
+
+      TestTrue(
+          "Features without a face",
+          &UCesiumPrimitiveFeaturesBlueprintLibrary::GetPrimitiveFeatures(
+              pPrimitiveComponent) == &primData[0]->Features);
+    });
+  });
+}
@@ -0,0 +1,197 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumLifetime.h"
+#include "CesiumRuntimeSettings.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/AutomationTest.h"
+#include "StaticMeshResources.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumLifetimeSpec,
+    "Cesium.Unit.AmortizedDestructor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+bool originalUseBudget;
+float originalTimeBudget;
+int32 originalObjectBudget;
+
+UStaticMesh* createMesh(uint32 vertexCount) {
+  TUniquePtr<FStaticMeshRenderData> pRenderData =
+      MakeUnique<FStaticMeshRenderData>();
+  pRenderData->AllocateLODResources(1);
+  pRenderData->LODResources[0].VertexBuffers.PositionVertexBuffer.Init(
+      vertexCount,
+      true);
+  UStaticMesh* pMesh = NewObject<UStaticMesh>();
+  pMesh->SetRenderData(MoveTemp(pRenderData));
+  return pMesh;
+}
+
+END_DEFINE_SPEC(FCesiumLifetimeSpec)
+
+void FCesiumLifetimeSpec::Define() {
+  BeforeEach([this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    originalUseBudget = pSettings->UseDestructionBudget;
+    originalTimeBudget = pSettings->DestructionTimeBudget;
+    originalObjectBudget = pSettings->DestructionObjectBudget;
+  });
+
+  AfterEach([this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = originalUseBudget;
+    pSettings->DestructionTimeBudget = originalTimeBudget;
+    pSettings->DestructionObjectBudget = originalObjectBudget;
+  });
+
+  It("destroys objects right away without a budget", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = false;
+    pSettings->DestructionObjectBudget = 1;
+
+    AmortizedDestructor destructor;
+    UStaticMesh* pFirst = NewObject<UStaticMesh>();
+    UStaticMesh* pSecond = NewObject<UStaticMesh>();
+    destructor.destroy(pFirst);
+    destructor.destroy(pSecond);
+    TestFalse("First mesh is destroyed", IsValid(pFirst));
+    TestFalse("Second mesh is destroyed", IsValid(pSecond));
+  });
+
+  It("destroys no more objects per frame than the object budget", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = true;
+    pSettings->DestructionTimeBudget = 0.0f;
+    pSettings->DestructionObjectBudget = 2;
+
+    AmortizedDestructor destructor;
+    TArray<UStaticMesh*> meshes;
+    for (int32 i = 0; i < 5; ++i) {
+      UStaticMesh* pMesh = NewObject<UStaticMesh>();
+      meshes.Add(pMesh);
+      destructor.destroy(pMesh);
+    }
+
+    auto countDestroyed = [&meshes]() {
+      int32 count = 0;
+      for (UStaticMesh* pMesh : meshes) {
+        count += IsValid(pMesh) ? 0 : 1;
+      }
+      return count;
+    };
+
+    TestEqual("Destroyed before ticking", countDestroyed(), 0);
+    destructor.Tick(0.0f);
+    TestEqual("Destroyed after one frame", countDestroyed(), 2);
+    destructor.Tick(0.0f);
+    TestEqual("Destroyed after two frames", countDestroyed(), 4);
+    destructor.Tick(0.0f);
+    TestEqual("Destroyed after three frames", countDestroyed(), 5);
+  });
+
+  It("destroys at least one object per frame", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = true;
+    pSettings->DestructionTimeBudget = 0.000001f;
+    pSettings->DestructionObjectBudget = 0;
+
+    AmortizedDestructor destructor;
+    UStaticMesh* pMesh = NewObject<UStaticMesh>();
+    destructor.destroy(pMesh);
+    destructor.Tick(0.0f);
+    TestFalse("Mesh is destroyed", IsValid(pMesh));
+  });
+
+  It("destroys the objects holding the most memory first", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = true;
+    pSettings->DestructionTimeBudget = 0.0f;
+    pSettings->DestructionObjectBudget = 1;
+
+    AmortizedDestructor destructor;
+    UStaticMesh* pSmall = createMesh(10);
+    UStaticMesh* pLarge = createMesh(1000);
+    UStaticMesh* pMedium = createMesh(100);
+    destructor.destroy(pSmall);
+    destructor.destroy(pLarge);
+    destructor.destroy(pMedium);
+
+    destructor.Tick(0.0f);
+    TestFalse("Large mesh is destroyed first", IsValid(pLarge));
+    TestTrue("Medium mesh is not destroyed yet", IsValid(pMedium));
+    TestTrue("Small mesh is not destroyed yet", IsValid(pSmall));
+
+    destructor.Tick(0.0f);
+    TestFalse("Medium mesh is destroyed second", IsValid(pMedium));
+    TestTrue("Small mesh is not destroyed yet", IsValid(pSmall));
+
+    destructor.Tick(0.0f);
+    TestFalse("Small mesh is destroyed last", IsValid(pSmall));
+  });
+
+  It("destroys objects that waited before larger, newer ones", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseDestructionBudget = true;
+    pSettings->DestructionTimeBudget = 0.0f;
+    pSettings->DestructionObjectBudget = 1;
+
+    AmortizedDestructor destructor;
+    UStaticMesh* pSmall = createMesh(10);
+    UStaticMesh* pFirstLarge = createMesh(200000);
+    destructor.destroy(pSmall);
+    destructor.destroy(pFirstLarge);
+
+    destructor.Tick(0.0f);
+    TestFalse("First large mesh is destroyed", IsValid(pFirstLarge));
+    TestTrue("Small mesh is not destroyed yet", IsValid(pSmall));
+
+    // Larger than the small mesh, but by less than it gained by waiting.
+    UStaticMesh* pSecondLarge = createMesh(10000);
+    destructor.destroy(pSecondLarge);
+
+    destructor.Tick(0.0f);
+    TestFalse("Small mesh is destroyed", IsValid(pSmall));
+    TestTrue("Second large mesh is not destroyed yet", IsValid(pSecondLarge));
+
+    destructor.Tick(0.0f);
+    TestFalse("Second large mesh is destroyed", IsValid(pSecondLarge));
+  });
+
+  It("destroys objects of equal size in the order they were handed over",
+     [this]() {
+       UCesiumRuntimeSettings* pSettings =
+           GetMutableDefault<UCesiumRuntimeSettings>();
+       pSettings->UseDestructionBudget = true;
+       pSettings->DestructionTimeBudget = 0.0f;
+       pSettings->DestructionObjectBudget = 1;
+
+       AmortizedDestructor destructor;
+       TArray<UStaticMesh*> meshes;
+       for (int32 i = 0; i < 3; ++i) {
+         UStaticMesh* pMesh = NewObject<UStaticMesh>();
+         meshes.Add(pMesh);
+         destructor.destroy(pMesh);
+       }
+
+       for (int32 frame = 0; frame < meshes.Num(); ++frame) {
+         destructor.Tick(0.0f);
+         for (int32 i = 0; i < meshes.Num(); ++i) {
+           TestEqual(
+               FString::Printf(
+                   TEXT("Mesh %d destroyed after frame %d"),
+                   i,
+                   frame),
+               IsValid(meshes[i]),
+               i > frame);
+         }
+       }
+     });
+}
@@ -8,10 +8,12 @@
 #include "CesiumRuntime.h"
 
 #include "Editor.h"
+#include "Misc/App.h"
 #include "Settings/LevelEditorPlaySettings.h"
 #include "Tests/AutomationCommon.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "UnrealClient.h"
+#include <algorithm>
 
 namespace Cesium {
 
@@ -36,6 +38,58 @@ struct LoadTestContext {
 
 LoadTestContext gLoadTestContext;
 
+struct FixedTimeStep {
+  bool previousUseFixedTimeStep = false;
+  double previousFixedDeltaTime = 0.0;
+  bool active = false;
+
+  void set(double deltaTime) {
+    if (!active) {
+      previousUseFixedTimeStep = FApp::UseFixedTimeStep();
+      previousFixedDeltaTime = FApp::GetFixedDeltaTime();
+      active = true;
+    }
+    FApp::SetUseFixedTimeStep(true);
+    FApp::SetFixedDeltaTime(deltaTime);
+  }
+
+  void restore() {
+    if (active) {
+      FApp::SetUseFixedTimeStep(previousUseFixedTimeStep);
+      FApp::SetFixedDeltaTime(previousFixedDeltaTime);
+      active = false;
+    }
+  }
+};
+
+FixedTimeStep gFixedTimeStep;
+
+// Applies the next frame of the pass's camera path. Returns false once the
+// path is complete.
+bool replayNextCameraPathFrame(
+    SceneGenerationContext& playContext,
+    TestPass& pass) {
+  const std::vector<CesiumCameraPath::Frame>& frames = pass.pCameraPath->frames;
+  if (pass.nextCameraPathFrame >= frames.size()) {
+    playContext.clearCameraPathCameras();
+    gFixedTimeStep.restore();
+    return false;
+  }
+
+  // Advancing one frame per tick, with the recorded time between frames,
+  // makes the replay independent of how long each frame actually takes.
+  size_t index = pass.nextCameraPathFrame++;
+  double deltaTime = 1.0 / 30.0;
+  if (index + 1 < frames.size() &&
+      frames[index + 1].time > frames[index].time) {
+    deltaTime = frames[index + 1].time - frames[index].time;
+  }
+  gFixedTimeStep.set(deltaTime);
+
+  playContext.applyCameraPathFrame(frames[index]);
+  return true;
+}
+
 DEFINE_LATENT_AUTOMATION_COMMAND_FOUR_PARAMETER(
     TimeLoadingCommand,
     FString,
@@ -54,6 +108,11 @@ bool TimeLoadingCommand::Update() {
     playContext.syncWorldCamera();
     if (pass.setupStep)
       pass.setupStep(playContext, pass.optionalParameter);
+    if (pass.pCameraPath) {
+      pass.nextCameraPathFrame = 0;
+      pass.cameraPathEndMark = 0;
+      replayNextCameraPathFrame(playContext, pass);
+    }
 
     // Start test mark, turn updates back on
     pass.startMark = FPlatformTime::Seconds();
@@ -71,11 +130,18 @@ bool TimeLoadingCommand::Update() {
 
   pass.elapsedTime = timeMark - pass.startMark;
 
+  // Don't stop before the whole camera path is replayed
+  if (pass.pCameraPath && replayNextCameraPathFrame(playContext, pass)) {
+    pass.cameraPathEndMark = timeMark;
+    return false;
+  }
+
   // The command is over if tilesets are loaded, or timed out
-  // Wait for a maximum of 30 seconds
+  // Wait for a maximum of 30 seconds, after any camera path is replayed
   const size_t testTimeout = 30;
   bool tilesetsloaded = playContext.areTilesetsDoneLoading();
-  bool timedOut = pass.elapsedTime >= testTimeout;
+  double waitStartMark = std::max(pass.startMark, pass.cameraPathEndMark);
+  bool timedOut = timeMark - waitStartMark >= testTimeout;
 
   if (timedOut) {
     UE_LOG(
@@ -5,6 +5,7 @@
 #if WITH_EDITOR
 
 #include <functional>
+#include <memory>
 #include <swl/variant.hpp>
 
 #include "CesiumSceneGeneration.h"
@@ -24,6 +25,13 @@ struct TestPass {
   VerifyCallback verifyStep;
   TestingParameter optionalParameter;
 
+  // When set, the pass replays this camera path, one frame per world tick and
+  // with a fixed time step taken from the path, and then waits for the
+  // tilesets to finish loading. The elapsed time includes the replay.
+  std::shared_ptr<const CesiumCameraPath> pCameraPath;
+  size_t nextCameraPathFrame = 0;
+  double cameraPathEndMark = 0;
+
   bool testInProgress = false;
   double startMark = 0;
   double endMark = 0;
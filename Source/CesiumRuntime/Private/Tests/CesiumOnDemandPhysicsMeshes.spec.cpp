@@ -0,0 +1,42 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumOnDemandPhysicsMeshes.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumOnDemandPhysicsMeshesSpec,
+    "Cesium.Unit.OnDemandPhysicsMeshes",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumOnDemandPhysicsMeshesSpec)
+
+void FCesiumOnDemandPhysicsMeshesSpec::Define() {
+  const FBox bounds(FVector(0.0, 0.0, 0.0), FVector(100.0, 100.0, 10.0));
+
+  It("finds locations within the radius of a box", [this, bounds]() {
+    TestTrue(
+        "Inside",
+        CesiumOnDemandPhysicsMeshes::isNearAny(
+            bounds,
+            {FVector(50.0, 50.0, 5.0)},
+            0.0));
+    TestTrue(
+        "Near a face",
+        CesiumOnDemandPhysicsMeshes::isNearAny(
+            bounds,
+            {FVector(10000.0, 0.0, 0.0), FVector(50.0, 50.0, 60.0)},
+            50.0));
+    TestFalse(
+        "Near a corner, but outside the radius",
+        CesiumOnDemandPhysicsMeshes::isNearAny(
+            bounds,
+            {FVector(130.0, 140.0, 5.0)},
+            49.0));
+  });
+
+  It("finds nothing without locations", [this, bounds]() {
+    TestFalse(
+        "No locations",
+        CesiumOnDemandPhysicsMeshes::isNearAny(bounds, {}, 1.0e9));
+  });
+}
@@ -0,0 +1,123 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPhysicsMeshUtility.h"
+#include "Misc/AutomationTest.h"
+
+using namespace CesiumPhysicsMeshUtility;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPhysicsMeshUtilitySpec,
+    "Cesium.Unit.PhysicsMeshUtility",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumPhysicsMeshUtilitySpec)
+
+void FCesiumPhysicsMeshUtilitySpec::Define() {
+  It("copies the triangles of render data", [this]() {
+    FStaticMeshLODResources lod;
+    lod.VertexBuffers.PositionVertexBuffer.Init(3, false);
+    lod.VertexBuffers.PositionVertexBuffer.VertexPosition(1) =
+        FVector3f(1.0f, 0.0f, 0.0f);
+    lod.VertexBuffers.PositionVertexBuffer.VertexPosition(2) =
+        FVector3f(0.0f, 1.0f, 0.0f);
+    lod.IndexBuffer.SetIndices(
+        TArray<uint32>{0, 1, 2},
+        EIndexBufferStride::Type::Force16Bit);
+
+    const CollisionMeshSource source = copyCollisionMeshSource(lod);
+    TestEqual("Vertex count", source.positions.Num(), 3);
+    TestEqual("Position", source.positions[2], FVector3f(0.0f, 1.0f, 0.0f));
+    TestEqual("Indices", source.indices, TArray<uint32>{0, 1, 2});
+    TestTrue("Size", source.getSizeBytes() > 0);
+  });
+
+  It("cooks a collision mesh from copied triangles", [this]() {
+    CollisionMeshSource source;
+    source.positions = {
+        FVector3f(0.0f, 0.0f, 0.0f),
+        FVector3f(1.0f, 0.0f, 0.0f),
+        FVector3f(0.0f, 1.0f, 0.0f),
+        FVector3f(1.0f, 1.0f, 0.0f)};
+    source.indices = {0, 1, 2, 2, 1, 3};
+
+    CollisionMeshPtr pCollisionMesh = buildCollisionMesh(source);
+    if (!TestTrue("Cooked", pCollisionMesh != nullptr)) {
+      return;
+    }
+    TestEqual(
+        "Triangle count",
+        pCollisionMesh->Elements().GetNumTriangles(),
+        2);
+  });
+
+  Describe("simplifyCollisionMesh", [this]() {
+    // A flat grid of 4 x 4 quads, where every triangle has its own vertices,
+    // as if flat normals had been generated for it.
+    auto createGrid = []() {
+      CollisionMeshSource source;
+      auto addVertex = [&source](int32 x, int32 y) {
+        source.indices.Add(uint32(source.positions.Num()));
+        source.positions.Add(FVector3f(float(x), float(y), 0.0f));
+      };
+      for (int32 y = 0; y < 4; ++y) {
+        for (int32 x = 0; x < 4; ++x) {
+          addVertex(x, y);
+          addVertex(x + 1, y);
+          addVertex(x, y + 1);
+          addVertex(x, y + 1);
+          addVertex(x + 1, y);
+          addVertex(x + 1, y + 1);
+        }
+      }
+      return source;
+    };
+
+    It("welds duplicated vertices", [this, createGrid]() {
+      const CollisionMeshSource simplified =
+          simplifyCollisionMesh(createGrid(), 0.0f);
+      TestTrue("Vertex count", simplified.positions.Num() <= 25);
+      TestTrue("Triangles remain", simplified.indices.Num() > 0);
+    });
+
+    It("decimates flat regions and keeps the border", [this, createGrid]() {
+      const CollisionMeshSource simplified =
+          simplifyCollisionMesh(createGrid(), 0.01f);
+      TestTrue("Triangle count", simplified.indices.Num() < 3 * 32);
+      TestEqual("Complete triangles", simplified.indices.Num() % 3, 0);
+
+      int32 borderCount = 0;
+      for (const FVector3f& position : simplified.positions) {
+        TestEqual("Height", position.Z, 0.0f);
+        if (position.X == 0.0f || position.X == 4.0f || position.Y == 0.0f ||
+            position.Y == 4.0f) {
+          ++borderCount;
+        }
+      }
+      TestEqual("Border vertices", borderCount, 16);
+    });
+  });
+
+  It("converts Unreal distances to mesh coordinates", [this]() {
+    // Positions are stored scaled up by 1024, and the node scales by 2.
+    const glm::dmat4 meshToGltf = glm::dmat4(
+        glm::dvec4(2.0 / 1024.0, 0.0, 0.0, 0.0),
+        glm::dvec4(0.0, 1.0 / 1024.0, 0.0, 0.0),
+        glm::dvec4(0.0, 0.0, 1.0 / 1024.0, 0.0),
+        glm::dvec4(0.0, 0.0, 0.0, 1.0));
+    TestEqual(
+        "10 cm",
+        unrealToMeshDistance(10.0, meshToGltf),
+        0.1f * 1024.0f / 2.0f,
+        1.0e-4f);
+    TestEqual(
+        "Degenerate transform",
+        unrealToMeshDistance(10.0, glm::dmat4(0.0)),
+        0.0f);
+  });
+
+  It("doesn't cook a collision mesh without triangles", [this]() {
+    CollisionMeshSource source;
+    source.positions = {FVector3f(0.0f, 0.0f, 0.0f)};
+    TestTrue("Not cooked", buildCollisionMesh(source) == nullptr);
+  });
+}
@@ -0,0 +1,202 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumPrimitivePool.h"
+#include "CesiumGltfComponent.h"
+#include "CesiumGltfPrimitiveComponent.h"
+#include "Engine/CollisionProfile.h"
+#include "Engine/StaticMesh.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/AutomationTest.h"
+#include "PhysicsEngine/BodySetup.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumPrimitivePoolSpec,
+    "Cesium.Unit.PrimitivePool",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<UCesiumPrimitivePool> pPool;
+TObjectPtr<UCesiumGltfComponent> pGltf;
+
+UCesiumGltfPrimitiveComponent* createPrimitive() {
+  UCesiumGltfPrimitiveComponent* pPrimitive =
+      pPool->AcquirePrimitiveComponent(pGltf, NAME_None);
+  pPrimitive->AttachToComponent(
+      pGltf,
+      FAttachmentTransformRules::KeepRelativeTransform);
+
+  UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+  if (!pStaticMesh) {
+    pStaticMesh = NewObject<UStaticMesh>(pPrimitive);
+    pPrimitive->SetStaticMesh(pStaticMesh);
+  }
+
+  UMaterialInstanceDynamic* pMaterial =
+      pPool->AcquireMaterial(pGltf->BaseMaterial, NAME_None);
+  pMaterial->SetScalarParameterValue("TestParameter", 1.0f);
+  pStaticMesh->AddMaterial(pMaterial);
+
+  return pPrimitive;
+}
+
+END_DEFINE_SPEC(FCesiumPrimitivePoolSpec)
+
+void FCesiumPrimitivePoolSpec::Define() {
+  BeforeEach([this]() {
+    pPool = NewObject<UCesiumPrimitivePool>();
+    pGltf = NewObject<UCesiumGltfComponent>();
+  });
+
+  It("reuses released components, static meshes, and materials", [this]() {
+    pPool->SetMaximumSize(10);
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = createPrimitive();
+    UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+    UMaterialInstanceDynamic* pMaterial =
+        Cast<UMaterialInstanceDynamic>(pStaticMesh->GetMaterial(0));
+
+    pPool->ReleasePrimitiveComponents(pGltf);
+    TestEqual(
+        "Children after release",
+        pGltf->GetAttachChildren().Num(),
+        0);
+    TestEqual(
+        "Materials of the pooled mesh",
+        pStaticMesh->GetStaticMaterials().Num(),
+        0);
+
+    UCesiumGltfComponent* pOtherGltf = NewObject<UCesiumGltfComponent>();
+    UCesiumGltfPrimitiveComponent* pReused =
+        pPool->AcquirePrimitiveComponent(pOtherGltf, NAME_None);
+    TestTrue("Component is reused", pReused == pPrimitive);
+    TestTrue("Static mesh is kept", pReused->GetStaticMesh() == pStaticMesh);
+    TestTrue("Outer is the new glTF", pReused->GetOuter() == pOtherGltf);
+
+    UMaterialInstanceDynamic* pReusedMaterial =
+        pPool->AcquireMaterial(pGltf->BaseMaterial, NAME_None);
+    TestTrue("Material is reused", pReusedMaterial == pMaterial);
+    TestEqual(
+        "Parameters of the reused material",
+        pReusedMaterial->ScalarParameterValues.Num(),
+        0);
+  });
+
+  It("keeps the body setup of a pooled mesh, without its old data", [this]() {
+    pPool->SetMaximumSize(10);
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = createPrimitive();
+    UStaticMesh* pStaticMesh = pPrimitive->GetStaticMesh();
+    pStaticMesh->CreateBodySetup();
+    UBodySetup* pBodySetup = pStaticMesh->GetBodySetup();
+    pBodySetup->bCreatedPhysicsMeshes = true;
+    const FGuid guid = pBodySetup->BodySetupGuid;
+
+    pPool->ReleasePrimitiveComponents(pGltf);
+    TestTrue("Body setup is kept", pStaticMesh->GetBodySetup() == pBodySetup);
+    TestFalse(
+        "Physics meshes of the kept body setup",
+        pBodySetup->bCreatedPhysicsMeshes);
+    TestNotEqual(
+        "GUID of the kept body setup",
+        pBodySetup->BodySetupGuid,
+        guid);
+  });
+
+  It("only reuses materials with the same base material", [this]() {
+    pPool->SetMaximumSize(10);
+
+    createPrimitive();
+    pPool->ReleasePrimitiveComponents(pGltf);
+
+    UMaterialInstanceDynamic* pMaterial =
+        pPool->AcquireMaterial(pGltf->BaseMaterialWithWater, NAME_None);
+    TestTrue(
+        "New material has the requested parent",
+        pMaterial->Parent == pGltf->BaseMaterialWithWater);
+  });
+
+  It("does not keep more than the maximum size", [this]() {
+    pPool->SetMaximumSize(1);
+
+    createPrimitive();
+    createPrimitive();
+    pPool->ReleasePrimitiveComponents(pGltf);
+    TestEqual(
+        "Children left for destruction",
+        pGltf->GetAttachChildren().Num(),
+        1);
+  });
+
+  It("resets the state of reused components", [this]() {
+    pPool->SetMaximumSize(10);
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = createPrimitive();
+    pPrimitive->SetVisibility(false);
+    pPrimitive->SetCollisionProfileName(
+        UCollisionProfile::BlockAll_ProfileName);
+    pPrimitive->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    pPrimitive->SetMaterial(0, pGltf->BaseMaterial);
+    pPrimitive->SetCustomPrimitiveDataFloat(0, 1.0f);
+    pPrimitive->bCastDynamicShadow = false;
+    pPrimitive->ComponentTags.Add("Tile");
+
+    pPool->ReleasePrimitiveComponents(pGltf);
+    UCesiumGltfPrimitiveComponent* pReused =
+        pPool->AcquirePrimitiveComponent(pGltf, NAME_None);
+    TestTrue("Component is reused", pReused == pPrimitive);
+
+    const UCesiumGltfPrimitiveComponent* pDefaults =
+        GetDefault<UCesiumGltfPrimitiveComponent>();
+    TestTrue("Visible", pReused->GetVisibleFlag());
+    TestEqual(
+        "Collision profile",
+        pReused->GetCollisionProfileName(),
+        pDefaults->GetCollisionProfileName());
+    TestEqual(
+        "Collision enabled",
+        pReused->GetCollisionEnabled(),
+        pDefaults->GetCollisionEnabled());
+    TestEqual("Override materials", pReused->OverrideMaterials.Num(), 0);
+    TestEqual(
+        "Custom primitive data",
+        pReused->GetCustomPrimitiveData().Data[0],
+        0.0f);
+    TestTrue("Casts dynamic shadow", pReused->bCastDynamicShadow);
+    TestEqual("Tags", pReused->ComponentTags.Num(), 0);
+  });
+
+  It("counts hits and misses per pool", [this]() {
+    pPool->SetMaximumSize(10);
+    UCesiumPrimitivePool* pOtherPool = NewObject<UCesiumPrimitivePool>();
+    pOtherPool->SetMaximumSize(10);
+
+    createPrimitive();
+    pPool->ReleasePrimitiveComponents(pGltf);
+    pPool->AcquirePrimitiveComponent(pGltf, NAME_None);
+    TestEqual("Component hit rate", pPool->GetComponentHitRate(), 50.0f);
+
+    pOtherPool->AcquirePrimitiveComponent(pGltf, NAME_None);
+    TestEqual(
+        "Component hit rate of the other pool",
+        pOtherPool->GetComponentHitRate(),
+        0.0f);
+    TestEqual(
+        "Component hit rate after the other pool missed",
+        pPool->GetComponentHitRate(),
+        50.0f);
+  });
+
+  It("does nothing when disabled", [this]() {
+    pPool->SetMaximumSize(0);
+
+    UCesiumGltfPrimitiveComponent* pPrimitive = createPrimitive();
+    pPool->ReleasePrimitiveComponents(pGltf);
+    TestEqual(
+        "Children left for destruction",
+        pGltf->GetAttachChildren().Num(),
+        1);
+    TestTrue(
+        "New component is created",
+        pPool->AcquirePrimitiveComponent(pGltf, NAME_None) != pPrimitive);
+  });
+}
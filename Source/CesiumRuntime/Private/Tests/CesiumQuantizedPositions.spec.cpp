@@ -0,0 +1,74 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumQuantizedPositions.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumQuantizedPositionsSpec,
+    "Cesium.Unit.QuantizedPositions",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumQuantizedPositionsSpec)
+
+void FCesiumQuantizedPositionsSpec::Define() {
+  It("quantizes positions to the bounding box of a mesh", [this]() {
+    const FVector3f positions[] = {
+        FVector3f(-100.0f, 20.0f, 5.0f),
+        FVector3f(300.0f, -50.0f, 6.0f),
+        FVector3f(12.345f, 0.0f, 5.5f)};
+
+    FPositionVertexBuffer positionBuffer;
+    positionBuffer.Init(3, false);
+    for (uint32 i = 0; i < 3; ++i) {
+      positionBuffer.VertexPosition(i) = positions[i];
+    }
+
+    FCesiumQuantizedPositions quantized(positionBuffer);
+    const FCesiumPositionQuantization& quantization =
+        quantized.GetQuantization();
+    TestTrue(
+        "Offset",
+        quantization.Offset.Equals(FVector3f(-100.0f, -50.0f, 5.0f)));
+    TestEqual("Extent", quantization.Extent, 400.0f);
+
+    const TArray<FCesiumQuantizedPosition>& quantizedPositions =
+        quantized.GetPositions();
+    TestEqual("Vertex count", quantizedPositions.Num(), 3);
+    TestEqual("Minimum", quantizedPositions[0].X, uint16(0));
+    TestEqual("Maximum", quantizedPositions[1].X, uint16(MAX_uint16));
+    TestEqual("W", quantizedPositions[2].W, uint16(MAX_uint16));
+
+    // Rounding to the nearest step is off by at most half a step.
+    const float tolerance = 0.5f * 400.0f / float(MAX_uint16);
+    for (int32 i = 0; i < 3; ++i) {
+      TestTrue(
+          "Dequantized position",
+          quantization.Dequantize(quantizedPositions[i])
+              .Equals(positions[i], tolerance));
+    }
+  });
+
+  It("dequantizes normalized positions with its matrix", [this]() {
+    FCesiumPositionQuantization quantization;
+    quantization.Offset = FVector3f(1.0f, 2.0f, 3.0f);
+    quantization.Extent = 10.0f;
+
+    const FCesiumQuantizedPosition quantized =
+        quantization.Quantize(FVector3f(6.0f, 2.0f, 13.0f));
+    const FVector normalized(
+        quantized.X / double(MAX_uint16),
+        quantized.Y / double(MAX_uint16),
+        quantized.Z / double(MAX_uint16));
+    const FVector dequantized =
+        quantization.GetDequantizationMatrix().TransformPosition(normalized);
+    TestTrue("Position", dequantized.Equals(FVector(6.0, 2.0, 13.0), 1e-3));
+  });
+
+  It("uses an invertible quantization for a single position", [this]() {
+    const FCesiumPositionQuantization quantization =
+        FCesiumPositionQuantization::FromBounds(
+            FBox3f(FVector3f(4.0f), FVector3f(4.0f)));
+    TestTrue("Offset", quantization.Offset.Equals(FVector3f(4.0f)));
+    TestEqual("Extent", quantization.Extent, 1.0f);
+  });
+}
@@ -10,6 +10,7 @@
 #include "LevelEditorViewport.h"
 
 #include "Cesium3DTileset.h"
+#include "CesiumCameraManager.h"
 #include "CesiumGeoreference.h"
 #include "CesiumSunSky.h"
 #include "GlobeAwareDefaultPawn.h"
@@ -141,6 +142,56 @@ void SceneGenerationContext::syncWorldCamera() {
   }
 }
 
+void SceneGenerationContext::applyCameraPathFrame(
+    const CesiumCameraPath::Frame& frame) {
+  clearCameraPathCameras();
+
+  for (size_t i = 0; i < frame.cameras.size(); ++i) {
+    const CesiumCameraPath::Camera& camera = frame.cameras[i];
+
+    FVector location =
+        georeference->TransformEarthCenteredEarthFixedPositionToUnreal(
+            FVector(camera.position.x, camera.position.y, camera.position.z));
+    FVector direction =
+        georeference->TransformEarthCenteredEarthFixedDirectionToUnreal(FVector(
+            camera.direction.x,
+            camera.direction.y,
+            camera.direction.z));
+    FVector up =
+        georeference->TransformEarthCenteredEarthFixedDirectionToUnreal(
+            FVector(camera.up.x, camera.up.y, camera.up.z));
+    FRotator rotation = FRotationMatrix::MakeFromXZ(direction, up).Rotator();
+
+    if (i == 0) {
+      startPosition = location;
+      startRotation = rotation;
+      startFieldOfView = float(camera.fieldOfViewDegrees);
+      syncWorldCamera();
+      continue;
+    }
+
+    // The viewport of the player can't change during play, but the extra
+    // cameras keep their recorded viewport sizes.
+    ACesiumCameraManager* cameraManager =
+        ACesiumCameraManager::GetDefaultCameraManager(world);
+    cameraPathCameraIds.push_back(cameraManager->AddCamera(FCesiumCamera(
+        FVector2D(camera.viewportSize.x, camera.viewportSize.y),
+        location,
+        rotation,
+        camera.fieldOfViewDegrees)));
+  }
+}
+
+void SceneGenerationContext::clearCameraPathCameras() {
+  if (!cameraPathCameraIds.empty()) {
+    ACesiumCameraManager* cameraManager =
+        ACesiumCameraManager::GetDefaultCameraManager(world);
+    for (int32 cameraId : cameraPathCameraIds)
+      cameraManager->RemoveCamera(cameraId);
+    cameraPathCameraIds.clear();
+  }
+}
+
 void createCommonWorldObjects(SceneGenerationContext& context) {
 
   context.world = FAutomationEditorCommonUtils::CreateNewMap();
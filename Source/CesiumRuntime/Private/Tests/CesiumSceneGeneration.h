@@ -4,6 +4,7 @@
 
 #if WITH_EDITOR
 
+#include "CesiumCameraPath.h"
 #include <vector>
 
 class UWorld;
@@ -41,6 +42,16 @@ struct SceneGenerationContext {
   void initForPlay(SceneGenerationContext& creationContext);
   void syncWorldCamera();
 
+  /**
+   * Moves the player to the first camera of a camera path frame and adds the
+   * remaining cameras to the camera manager, replacing those of the previous
+   * frame.
+   */
+  void applyCameraPathFrame(const CesiumCameraPath::Frame& frame);
+  void clearCameraPathCameras();
+
+  std::vector<int32> cameraPathCameraIds;
+
   static FString testIonToken;
 };
 
@@ -0,0 +1,118 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumScratchBuffers.h"
+#include "Misc/AutomationTest.h"
+#include <future>
+#include <thread>
+
+BEGIN_DEFINE_SPEC(
+    FCesiumScratchBuffersSpec,
+    "Cesium.Unit.ScratchBuffers",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumScratchBuffersSpec)
+
+// A distinct element type, so that arrays borrowed by other code on the test
+// thread don't affect the results.
+struct ScratchTestElement {
+  uint8 bytes[16];
+};
+
+void FCesiumScratchBuffersSpec::Define() {
+  BeforeEach([]() {
+    // Start from an empty pool by ending two tiles in a row.
+    CesiumScratchBuffers::endTile();
+    CesiumScratchBuffers::endTile();
+  });
+
+  It("reuses the memory of released arrays", [this]() {
+    {
+      CesiumScratchBuffers::TScratchArray<ScratchTestElement> array;
+      array.get().SetNumUninitialized(1000);
+    }
+
+    const CesiumScratchBuffers::Counters before =
+        CesiumScratchBuffers::getCounters();
+    TArray<ScratchTestElement> array =
+        CesiumScratchBuffers::acquire<ScratchTestElement>();
+    const CesiumScratchBuffers::Counters after =
+        CesiumScratchBuffers::getCounters();
+
+    TestEqual("Num", array.Num(), 0);
+    TestTrue("Max", array.Max() >= 1000);
+    TestEqual("Borrowed", after.borrowed - before.borrowed, uint64(1));
+    TestEqual("Reused", after.reused - before.reused, uint64(1));
+
+    CesiumScratchBuffers::release(MoveTemp(array));
+  });
+
+  It("releases arrays that were not borrowed during a tile", [this]() {
+    const int64 retainedBefore =
+        CesiumScratchBuffers::getCounters().retainedBytes;
+    {
+      CesiumScratchBuffers::TScratchArray<ScratchTestElement> array;
+      array.get().SetNumUninitialized(1000);
+    }
+    TestTrue(
+        "Retained after release",
+        CesiumScratchBuffers::getCounters().retainedBytes >=
+            retainedBefore + 16000);
+
+    // The array was released during this tile, so it is kept for the next.
+    CesiumScratchBuffers::endTile();
+    TestTrue(
+        "Retained after the first tile",
+        CesiumScratchBuffers::getCounters().retainedBytes >=
+            retainedBefore + 16000);
+
+    CesiumScratchBuffers::endTile();
+    TestTrue(
+        "Released after an unused tile",
+        CesiumScratchBuffers::getCounters().retainedBytes <= retainedBefore);
+  });
+
+  It("releases unused arrays of threads that don't end tiles", [this]() {
+    std::promise<void> released;
+    std::promise<void> tilesEnded;
+    int32 maxAfterTiles = -1;
+
+    // Stands in for a worker that helps loading tiles, but never ends one.
+    std::thread worker([&]() {
+      {
+        CesiumScratchBuffers::TScratchArray<ScratchTestElement> array;
+        array.get().SetNumUninitialized(1000);
+      }
+      released.set_value();
+
+      tilesEnded.get_future().wait();
+      TArray<ScratchTestElement> array =
+          CesiumScratchBuffers::acquire<ScratchTestElement>();
+      maxAfterTiles = array.Max();
+      CesiumScratchBuffers::release(MoveTemp(array));
+    });
+
+    released.get_future().wait();
+    CesiumScratchBuffers::endTile();
+    CesiumScratchBuffers::endTile();
+    tilesEnded.set_value();
+    worker.join();
+
+    TestEqual("Max of the array borrowed after two tiles", maxAfterTiles, 0);
+  });
+
+  It("doesn't retain more than the limit of a thread", [this]() {
+    const int64 retainedBefore =
+        CesiumScratchBuffers::getCounters().retainedBytes;
+    {
+      CesiumScratchBuffers::TScratchArray<ScratchTestElement> array;
+      array.get().SetNumUninitialized(int32(
+          CesiumScratchBuffers::MaximumRetainedBytesPerThread /
+              int64(sizeof(ScratchTestElement)) +
+          1));
+    }
+    TestEqual(
+        "Retained",
+        CesiumScratchBuffers::getCounters().retainedBytes,
+        retainedBefore);
+  });
+}
@@ -0,0 +1,166 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileBudgetSubsystem.h"
+#include "Cesium3DTileset.h"
+#include "CesiumRuntimeSettings.h"
+#include "CesiumTestHelpers.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileBudgetSubsystemSpec,
+    "Cesium.Unit.TileBudgetSubsystem",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+using TilesetUsage = UCesiumTileBudgetSubsystem::TilesetUsage;
+using TilesetAllocation = UCesiumTileBudgetSubsystem::TilesetAllocation;
+
+int64 sumCachedBytes(const std::vector<TilesetAllocation>& allocations) {
+  int64 sum = 0;
+  for (const TilesetAllocation& allocation : allocations) {
+    sum += allocation.maximumCachedBytes;
+  }
+  return sum;
+}
+
+int32 sumLoads(const std::vector<TilesetAllocation>& allocations) {
+  int32 sum = 0;
+  for (const TilesetAllocation& allocation : allocations) {
+    sum += allocation.maximumSimultaneousTileLoads;
+  }
+  return sum;
+}
+
+END_DEFINE_SPEC(FCesiumTileBudgetSubsystemSpec)
+
+void FCesiumTileBudgetSubsystemSpec::Define() {
+  It("splits the world budget between the tilesets in the world", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    int64 previousCachedBytes = pSettings->WorldMaximumCachedBytes;
+    int64 previousMinimumBytes = pSettings->WorldMinimumCachedBytesPerTileset;
+    int32 previousLoads = pSettings->WorldMaximumSimultaneousTileLoads;
+    pSettings->WorldMaximumCachedBytes = 1000;
+    pSettings->WorldMinimumCachedBytesPerTileset = 100;
+    pSettings->WorldMaximumSimultaneousTileLoads = 10;
+
+    UWorld* pWorld = CesiumTestHelpers::getGlobalWorldContext();
+    UCesiumTileBudgetSubsystem* pSubsystem =
+        pWorld->GetSubsystem<UCesiumTileBudgetSubsystem>();
+    ACesium3DTileset* pFirst = pWorld->SpawnActor<ACesium3DTileset>();
+    pFirst->TileBudgetPriority = 3.0f;
+    ACesium3DTileset* pSecond = pWorld->SpawnActor<ACesium3DTileset>();
+
+    TilesetAllocation alone = pSubsystem->GetAllocation(pFirst);
+    TestEqual("Cache alone", alone.maximumCachedBytes, int64(1000));
+    TestEqual("Loads alone", alone.maximumSimultaneousTileLoads, 10);
+
+    // Adding a tileset splits the budget again, and both tilesets get their
+    // minimum spare cache before the rest is split by priority.
+    TilesetAllocation second = pSubsystem->GetAllocation(pSecond);
+    TilesetAllocation first = pSubsystem->GetAllocation(pFirst);
+    TestEqual("First cache", first.maximumCachedBytes, int64(700));
+    TestEqual("Second cache", second.maximumCachedBytes, int64(300));
+    TestEqual("First loads", first.maximumSimultaneousTileLoads, 7);
+    TestEqual("Second loads", second.maximumSimultaneousTileLoads, 3);
+
+    pSubsystem->RemoveTileset(pFirst);
+    pSubsystem->RemoveTileset(pSecond);
+    pFirst->Destroy();
+    pSecond->Destroy();
+    pSettings->WorldMaximumCachedBytes = previousCachedBytes;
+    pSettings->WorldMinimumCachedBytesPerTileset = previousMinimumBytes;
+    pSettings->WorldMaximumSimultaneousTileLoads = previousLoads;
+  });
+
+  It("splits the budget by priority when nothing is rendered", [this]() {
+    std::vector<TilesetUsage> usages(2);
+    usages[0].priority = 3.0;
+    usages[1].priority = 1.0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 0, 10);
+    TestEqual("First cache", allocations[0].maximumCachedBytes, int64(750));
+    TestEqual("Second cache", allocations[1].maximumCachedBytes, int64(250));
+    TestEqual("First loads", allocations[0].maximumSimultaneousTileLoads, 7);
+    TestEqual("Second loads", allocations[1].maximumSimultaneousTileLoads, 3);
+  });
+
+  It("always grants the rendered bytes and stays within the limit", [this]() {
+    std::vector<TilesetUsage> usages(3);
+    usages[0].renderedBytes = 300;
+    usages[1].renderedBytes = 100;
+    usages[2].renderedBytes = 0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 0, 10);
+    TestEqual("Total cache", sumCachedBytes(allocations), int64(1000));
+    TestEqual("First cache", allocations[0].maximumCachedBytes, int64(750));
+    TestEqual("Second cache", allocations[1].maximumCachedBytes, int64(250));
+    TestEqual("Idle cache", allocations[2].maximumCachedBytes, int64(0));
+  });
+
+  It("gives every tileset its minimum spare cache", [this]() {
+    std::vector<TilesetUsage> usages(3);
+    usages[0].renderedBytes = 300;
+    usages[1].renderedBytes = 100;
+    usages[2].renderedBytes = 0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 40, 10);
+    TestEqual("Total cache", sumCachedBytes(allocations), int64(1000));
+    TestEqual("First cache", allocations[0].maximumCachedBytes, int64(700));
+    TestEqual("Second cache", allocations[1].maximumCachedBytes, int64(260));
+    TestEqual("Idle cache", allocations[2].maximumCachedBytes, int64(40));
+  });
+
+  It("shrinks the minimum spare cache to fit the limit", [this]() {
+    std::vector<TilesetUsage> usages(2);
+    usages[0].renderedBytes = 900;
+    usages[1].renderedBytes = 0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 200, 10);
+    TestEqual("Total cache", sumCachedBytes(allocations), int64(1000));
+    TestEqual("First cache", allocations[0].maximumCachedBytes, int64(950));
+    TestEqual("Idle cache", allocations[1].maximumCachedBytes, int64(50));
+  });
+
+  It("keeps only the rendered bytes when over the limit", [this]() {
+    std::vector<TilesetUsage> usages(2);
+    usages[0].renderedBytes = 800;
+    usages[1].renderedBytes = 400;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 0, 10);
+    TestEqual("First cache", allocations[0].maximumCachedBytes, int64(800));
+    TestEqual("Second cache", allocations[1].maximumCachedBytes, int64(400));
+  });
+
+  It("gives loads to tilesets waiting for tiles", [this]() {
+    std::vector<TilesetUsage> usages(3);
+    usages[0].tilesWaitingToLoad = 30;
+    usages[1].tilesWaitingToLoad = 10;
+    usages[1].priority = 3.0;
+    usages[2].tilesWaitingToLoad = 0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 1000, 0, 21);
+    TestEqual("Total loads", sumLoads(allocations), 21);
+    TestEqual("First loads", allocations[0].maximumSimultaneousTileLoads, 10);
+    TestEqual("Second loads", allocations[1].maximumSimultaneousTileLoads, 10);
+    TestEqual("Idle loads", allocations[2].maximumSimultaneousTileLoads, 1);
+  });
+
+  It("lets every tileset load at least one tile", [this]() {
+    std::vector<TilesetUsage> usages(4);
+    usages[0].priority = 0.0;
+
+    std::vector<TilesetAllocation> allocations =
+        UCesiumTileBudgetSubsystem::ComputeAllocations(usages, 0, 0, 2);
+    for (const TilesetAllocation& allocation : allocations) {
+      TestEqual("Loads", allocation.maximumSimultaneousTileLoads, 1);
+    }
+  });
+}
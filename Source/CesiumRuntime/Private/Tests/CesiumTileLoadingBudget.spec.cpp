@@ -0,0 +1,163 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTileLoadingBudget.h"
+#include "CesiumRuntimeSettings.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTileLoadingBudgetSpec,
+    "Cesium.Unit.TileLoadingBudget",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+using Direction = CesiumTileLoadingBudget::Direction;
+
+bool previousEnabled;
+float previousTarget;
+float previousMinimum;
+float previousMaximum;
+float previousUnloadingShare;
+
+END_DEFINE_SPEC(FCesiumTileLoadingBudgetSpec)
+
+void FCesiumTileLoadingBudgetSpec::Define() {
+  BeforeEach([this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    previousEnabled = pSettings->UseAdaptiveTileLoadingBudget;
+    previousTarget = pSettings->TargetGameThreadFrameTime;
+    previousMinimum = pSettings->MinimumTileLoadingBudget;
+    previousMaximum = pSettings->MaximumTileLoadingBudget;
+    previousUnloadingShare = pSettings->TileUnloadingBudgetShare;
+
+    pSettings->UseAdaptiveTileLoadingBudget = true;
+    pSettings->TargetGameThreadFrameTime = 10.0f;
+    pSettings->MinimumTileLoadingBudget = 4.0f;
+    pSettings->MaximumTileLoadingBudget = 4.0f;
+    pSettings->TileUnloadingBudgetShare = 0.25f;
+  });
+
+  AfterEach([this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->UseAdaptiveTileLoadingBudget = previousEnabled;
+    pSettings->TargetGameThreadFrameTime = previousTarget;
+    pSettings->MinimumTileLoadingBudget = previousMinimum;
+    pSettings->MaximumTileLoadingBudget = previousMaximum;
+    pSettings->TileUnloadingBudgetShare = previousUnloadingShare;
+  });
+
+  It("keeps separate budgets for loading and unloading", [this]() {
+    CesiumTileLoadingBudget::FrameBudget frameBudget;
+    CesiumTileLoadingBudget budget(frameBudget);
+    budget.beginFrame(1, 10.0);
+
+    TestEqual(
+        "Loading budget",
+        budget.getRemainingMilliseconds(Direction::Load),
+        3.0);
+    TestEqual(
+        "Unloading budget",
+        budget.getRemainingMilliseconds(Direction::Unload),
+        1.0);
+
+    budget.consume(Direction::Unload, 5.0);
+    TestTrue(
+        "Unloading budget is used up",
+        budget.getRemainingMilliseconds(Direction::Unload) < 0.01);
+    TestEqual(
+        "Loading budget is unaffected",
+        budget.getRemainingMilliseconds(Direction::Load),
+        3.0);
+
+    budget.consume(Direction::Load, 1.0);
+    TestEqual(
+        "Loading budget after loading",
+        budget.getRemainingMilliseconds(Direction::Load),
+        2.0);
+  });
+
+  It("never reports an unlimited budget", [this]() {
+    CesiumTileLoadingBudget::FrameBudget frameBudget;
+    CesiumTileLoadingBudget budget(frameBudget);
+    budget.beginFrame(1, 10.0);
+    budget.consume(Direction::Load, 100.0);
+    TestTrue(
+        "Remaining time is positive",
+        budget.getRemainingMilliseconds(Direction::Load) > 0.0);
+  });
+
+  It("resets the time used in each frame", [this]() {
+    CesiumTileLoadingBudget::FrameBudget frameBudget;
+    CesiumTileLoadingBudget budget(frameBudget);
+    budget.beginFrame(1, 10.0);
+    budget.consume(Direction::Load, 2.0);
+    budget.consume(Direction::Unload, 0.5);
+
+    budget.beginFrame(2, 10.0);
+    TestEqual(
+        "Loading budget",
+        budget.getRemainingMilliseconds(Direction::Load),
+        3.0);
+    TestEqual(
+        "Unloading budget",
+        budget.getRemainingMilliseconds(Direction::Unload),
+        1.0);
+  });
+
+  It("splits the frame budget evenly among tilesets", [this]() {
+    CesiumTileLoadingBudget::FrameBudget frameBudget;
+    CesiumTileLoadingBudget first(frameBudget);
+    CesiumTileLoadingBudget second(frameBudget);
+
+    // The tilesets are counted in one frame, and split the next.
+    first.beginFrame(1, 10.0);
+    second.beginFrame(1, 10.0);
+    first.beginFrame(2, 10.0);
+    second.beginFrame(2, 10.0);
+
+    TestEqual(
+        "First loading budget",
+        first.getRemainingMilliseconds(Direction::Load),
+        1.5);
+    TestEqual(
+        "Second unloading budget",
+        second.getRemainingMilliseconds(Direction::Unload),
+        0.5);
+
+    first.consume(Direction::Load, 10.0);
+    TestTrue(
+        "First loading budget is used up",
+        first.getRemainingMilliseconds(Direction::Load) < 0.01);
+    TestEqual(
+        "Second loading budget is unaffected",
+        second.getRemainingMilliseconds(Direction::Load),
+        1.5);
+  });
+
+  It("adapts the frame budget to the frame time", [this]() {
+    UCesiumRuntimeSettings* pSettings =
+        GetMutableDefault<UCesiumRuntimeSettings>();
+    pSettings->MinimumTileLoadingBudget = 1.0f;
+    pSettings->MaximumTileLoadingBudget = 10.0f;
+
+    CesiumTileLoadingBudget::FrameBudget frameBudget;
+    uint64 frame = 1;
+    frameBudget.beginFrame(frame++, 10.0);
+    double initial = frameBudget.getMilliseconds();
+
+    for (int i = 0; i < 10; ++i) {
+      frameBudget.beginFrame(frame++, 5.0);
+    }
+    double afterFastFrames = frameBudget.getMilliseconds();
+    TestTrue("Budget grows while frames are fast", afterFastFrames > initial);
+
+    for (int i = 0; i < 100; ++i) {
+      frameBudget.beginFrame(frame++, 40.0);
+    }
+    TestEqual(
+        "Budget shrinks to the minimum while frames are slow",
+        frameBudget.getMilliseconds(),
+        1.0);
+  });
+}
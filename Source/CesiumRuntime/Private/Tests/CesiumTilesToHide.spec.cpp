@@ -0,0 +1,103 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesToHide.h"
+#include "Misc/AutomationTest.h"
+#include <Cesium3DTilesSelection/Tile.h>
+#include <memory>
+
+using namespace Cesium3DTilesSelection;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTilesToHideSpec,
+    "Cesium.Unit.TilesToHide",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+// A root with the children A and B, where A has the child A0.
+std::unique_ptr<Tile> pRoot;
+Tile* pA;
+Tile* pB;
+Tile* pA0;
+
+std::unordered_set<const Tile*> tilesBeingCreated;
+
+std::function<bool(const Tile&)> isBeingCreated() {
+  return [this](const Tile& tile) {
+    return this->tilesBeingCreated.count(&tile) > 0;
+  };
+}
+
+END_DEFINE_SPEC(FCesiumTilesToHideSpec)
+
+void FCesiumTilesToHideSpec::Define() {
+  BeforeEach([this]() {
+    pRoot = std::make_unique<Tile>(nullptr);
+    std::vector<Tile> children;
+    children.emplace_back(nullptr);
+    children.emplace_back(nullptr);
+    pRoot->createChildTiles(std::move(children));
+    pA = &pRoot->getChildren()[0];
+    pB = &pRoot->getChildren()[1];
+
+    std::vector<Tile> grandchildren;
+    grandchildren.emplace_back(nullptr);
+    pA->createChildTiles(std::move(grandchildren));
+    pA0 = &pA->getChildren()[0];
+
+    tilesBeingCreated.clear();
+  });
+
+  AfterEach([this]() { pRoot.reset(); });
+
+  It("hides a replaced tile once its replacement completes", [this]() {
+    CesiumTilesToHide tilesToHide;
+    tilesToHide.add(pA);
+    tilesBeingCreated.insert(pA0);
+
+    tilesToHide.update({pA0}, isBeingCreated());
+    TestTrue("Replaced tile is kept visible", tilesToHide.isKeptVisible(*pA));
+    TestTrue("Nothing is hidden", tilesToHide.takeTilesToHide().empty());
+    TestFalse("Replaced tile is still to hide", tilesToHide.isEmpty());
+
+    tilesBeingCreated.clear();
+    tilesToHide.update({pA0}, isBeingCreated());
+    TestFalse("Replaced tile is released", tilesToHide.isKeptVisible(*pA));
+    std::vector<Tile*> hidden = tilesToHide.takeTilesToHide();
+    TestEqual("Hidden tiles", hidden.size(), size_t(1));
+    TestTrue("Replaced tile is hidden", !hidden.empty() && hidden[0] == pA);
+    TestTrue("Nothing is left to hide", tilesToHide.isEmpty());
+  });
+
+  It("keeps descendants of a tile that is still being created", [this]() {
+    CesiumTilesToHide tilesToHide;
+    tilesToHide.add(pA0);
+    tilesBeingCreated.insert(pA);
+
+    tilesToHide.update({pA}, isBeingCreated());
+    TestTrue("Descendant is kept visible", tilesToHide.isKeptVisible(*pA0));
+    TestTrue("Nothing is hidden", tilesToHide.takeTilesToHide().empty());
+  });
+
+  It("hides unrelated tiles while other tiles are being created", [this]() {
+    CesiumTilesToHide tilesToHide;
+    tilesToHide.add(pB);
+    tilesBeingCreated.insert(pA0);
+
+    tilesToHide.update({pA0}, isBeingCreated());
+    TestFalse("Sibling is not kept visible", tilesToHide.isKeptVisible(*pB));
+    std::vector<Tile*> hidden = tilesToHide.takeTilesToHide();
+    TestTrue("Sibling is hidden", hidden.size() == 1 && hidden[0] == pB);
+  });
+
+  It("adds each tile only once and forgets removed tiles", [this]() {
+    CesiumTilesToHide tilesToHide;
+    tilesToHide.add(pA);
+    tilesToHide.add(pA);
+    tilesToHide.add(pB);
+    TestEqual("Tiles to hide", tilesToHide.getTiles().size(), size_t(2));
+
+    tilesToHide.remove(pA);
+    tilesToHide.remove(pB);
+    TestTrue("Nothing is left to hide", tilesToHide.isEmpty());
+  });
+}
@@ -0,0 +1,60 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumTilesetSceneProxy.h"
+#include "ConvexVolume.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumTilesetSceneProxySpec,
+    "Cesium.Unit.TilesetSceneProxy",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+// The half space with x <= 1000.
+FConvexVolume frustum;
+
+FBoxSphereBounds boundsAt(double x) {
+  return FBoxSphereBounds(FBox(FVector(x - 10.0), FVector(x + 10.0)));
+}
+
+END_DEFINE_SPEC(FCesiumTilesetSceneProxySpec)
+
+void FCesiumTilesetSceneProxySpec::Define() {
+  BeforeEach([this]() {
+    frustum = FConvexVolume();
+    frustum.Planes.Add(FPlane(FVector(1.0, 0.0, 0.0), 1000.0));
+    frustum.Init();
+  });
+
+  Describe("IsMeshInFrustum", [this]() {
+    It("draws meshes inside of the frustum", [this]() {
+      TestTrue(
+          "Inside",
+          FCesiumTilesetSceneProxy::IsMeshInFrustum(boundsAt(0.0), frustum));
+      TestTrue(
+          "Intersecting",
+          FCesiumTilesetSceneProxy::IsMeshInFrustum(boundsAt(1005.0), frustum));
+    });
+
+    It("culls meshes outside of the frustum", [this]() {
+      TestFalse(
+          "Outside",
+          FCesiumTilesetSceneProxy::IsMeshInFrustum(boundsAt(2000.0), frustum));
+    });
+
+    It("applies the translation of the frustum", [this]() {
+      TestTrue(
+          "Translated inside",
+          FCesiumTilesetSceneProxy::IsMeshInFrustum(
+              boundsAt(2000.0),
+              frustum,
+              FVector(-1500.0, 0.0, 0.0)));
+      TestFalse(
+          "Translated outside",
+          FCesiumTilesetSceneProxy::IsMeshInFrustum(
+              boundsAt(0.0),
+              frustum,
+              FVector(1500.0, 0.0, 0.0)));
+    });
+  });
+}
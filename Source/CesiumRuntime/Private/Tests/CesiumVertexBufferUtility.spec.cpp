@@ -0,0 +1,358 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVertexBufferUtility.h"
+#include "CesiumGltfSpecUtility.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/ScopeLock.h"
+
+using namespace CesiumGltf;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVertexBufferUtilitySpec,
+    "Cesium.Unit.VertexBufferUtility",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FCesiumVertexBufferUtilitySpec)
+
+namespace {
+/**
+ * Creates four vertices around the origin, with normals along the Z axis and
+ * texture coordinates that follow the X and Y axes.
+ */
+void createQuad(
+    FPositionVertexBuffer& positions,
+    CesiumVertexBufferUtility::VertexAttributes& vertices) {
+  const FVector3f quadPositions[] = {
+      FVector3f(0.0f, 0.0f, 0.0f),
+      FVector3f(1.0f, 0.0f, 0.0f),
+      FVector3f(0.0f, 1.0f, 0.0f),
+      FVector3f(-1.0f, 0.0f, 0.0f)};
+
+  positions.Init(4, false);
+  vertices.vertexCount = 4;
+  vertices.normals.Init(FVector3f(0.0f, 0.0f, 1.0f), 4);
+  TArray<FVector2f>& uvs = vertices.getUVs(0);
+  for (int32 i = 0; i < 4; ++i) {
+    positions.VertexPosition(i) = quadPositions[i];
+    uvs[i] = FVector2f(quadPositions[i].X, quadPositions[i].Y);
+  }
+}
+} // namespace
+
+void FCesiumVertexBufferUtilitySpec::Define() {
+  Describe("forEachVertexRange", [this]() {
+    It("covers every vertex exactly once", [this]() {
+      const int32 vertexCount = 1000003;
+      TArray<int32> visits;
+      visits.SetNumZeroed(vertexCount);
+      CesiumVertexBufferUtility::forEachVertexRange(
+          vertexCount,
+          1,
+          [&visits](int32 begin, int32 end) {
+            for (int32 i = begin; i < end; ++i) {
+              ++visits[i];
+            }
+          });
+
+      int32 wrongCount = 0;
+      for (int32 visitCount : visits) {
+        wrongCount += visitCount != 1;
+      }
+      TestEqual("Vertices not visited exactly once", wrongCount, 0);
+    });
+
+    It("starts ranges at multiples of the granularity", [this]() {
+      FCriticalSection lock;
+      TArray<TPair<int32, int32>> ranges;
+      CesiumVertexBufferUtility::forEachVertexRange(
+          300000,
+          3,
+          [&lock, &ranges](int32 begin, int32 end) {
+            FScopeLock scopeLock(&lock);
+            ranges.Emplace(begin, end);
+          });
+
+      TestTrue("Split into several ranges", ranges.Num() > 1);
+      for (const TPair<int32, int32>& range : ranges) {
+        TestEqual("Range start", range.Key % 3, 0);
+      }
+    });
+  });
+
+  Describe("copyTriangleListIndices", [this]() {
+    It("expands a triangle strip with alternating winding order", [this]() {
+      const TArray<uint8> strip{0, 1, 2, 3, 4};
+      const int64 count = CesiumVertexBufferUtility::getTriangleListIndexCount(
+          MeshPrimitive::Mode::TRIANGLE_STRIP,
+          strip.Num());
+      TestEqual("Index count", count, int64(9));
+
+      TArray<uint16> triangles;
+      triangles.SetNumUninitialized(int32(count));
+      CesiumVertexBufferUtility::copyTriangleListIndices(
+          strip,
+          MeshPrimitive::Mode::TRIANGLE_STRIP,
+          0,
+          count,
+          triangles.GetData());
+      TestEqual(
+          "Indices",
+          triangles,
+          TArray<uint16>{0, 1, 2, 1, 3, 2, 2, 3, 4});
+    });
+
+    It("expands a triangle fan around its first vertex", [this]() {
+      const TArray<uint8> fan{0, 1, 2, 3};
+      TArray<uint16> triangles;
+      triangles.SetNumUninitialized(6);
+      CesiumVertexBufferUtility::copyTriangleListIndices(
+          fan,
+          MeshPrimitive::Mode::TRIANGLE_FAN,
+          0,
+          6,
+          triangles.GetData());
+      TestEqual("Indices", triangles, TArray<uint16>{0, 1, 2, 0, 2, 3});
+    });
+
+    It("ignores strips and fans without a whole triangle", [this]() {
+      TestEqual(
+          "Index count",
+          CesiumVertexBufferUtility::getTriangleListIndexCount(
+              MeshPrimitive::Mode::TRIANGLE_FAN,
+              2),
+          int64(0));
+    });
+  });
+
+  It("sets 16-bit indices straight from a glTF accessor", [this]() {
+    Model model;
+    MeshPrimitive& primitive =
+        model.meshes.emplace_back().primitives.emplace_back();
+    primitive.mode = MeshPrimitive::Mode::TRIANGLE_STRIP;
+    // More indices than a single batch, to cover appending several batches.
+    std::vector<uint16_t> strip(2000);
+    for (size_t i = 0; i < strip.size(); ++i) {
+      strip[i] = uint16_t(i);
+    }
+    CreateIndicesForPrimitive(
+        model,
+        primitive,
+        AccessorSpec::ComponentType::UNSIGNED_SHORT,
+        strip);
+
+    AccessorView<uint16_t> indexView(model, primitive.indices);
+    FRawStaticIndexBuffer indexBuffer;
+    CesiumVertexBufferUtility::setTriangleListIndices(
+        indexView,
+        primitive.mode,
+        2000,
+        indexBuffer);
+
+    TestFalse("32-bit", indexBuffer.Is32Bit());
+    TestEqual("Index count", indexBuffer.GetNumIndices(), 3 * 1998);
+    TestEqual("First triangle", indexBuffer.GetIndex(2), uint32(2));
+    TestEqual("Odd triangle", indexBuffer.GetIndex(4), uint32(3));
+    TestEqual("Last index", indexBuffer.GetIndex(3 * 1998 - 1), uint32(1998));
+  });
+
+  It("computes the bounding sphere radius while copying positions", [this]() {
+    Model model;
+    MeshPrimitive& primitive =
+        model.meshes.emplace_back().primitives.emplace_back();
+    std::vector<glm::vec3> positions(100000, glm::vec3(0.0f));
+    positions[76543] = glm::vec3(0.0f, 3.0f, 4.0f);
+    CreateAttributeForPrimitive(
+        model,
+        primitive,
+        "POSITION",
+        AccessorSpec::Type::VEC3,
+        AccessorSpec::ComponentType::FLOAT,
+        positions);
+
+    AccessorView<FVector3f> positionView(
+        model,
+        primitive.attributes.at("POSITION"));
+    FPositionVertexBuffer positionBuffer;
+    const float radius = CesiumVertexBufferUtility::copyPositions(
+        positionView,
+        nullptr,
+        2.0f,
+        FVector3f(0.0f),
+        positionBuffer);
+
+    TestEqual("Radius", radius, 10.0f, 1e-4f);
+    TestEqual(
+        "Flipped position",
+        positionBuffer.VertexPosition(76543),
+        FVector3f(0.0f, -6.0f, 8.0f));
+  });
+
+  Describe("computeIndexedTangents", [this]() {
+    It("keeps the vertices of consistently mapped triangles", [this]() {
+      FPositionVertexBuffer positions;
+      CesiumVertexBufferUtility::VertexAttributes vertices;
+      createQuad(positions, vertices);
+
+      TArray<uint32> indices{0, 1, 2, 0, 2, 3};
+      TArray<uint32> copiedVertices;
+      CesiumVertexBufferUtility::computeIndexedTangents(
+          positions,
+          indices,
+          vertices,
+          copiedVertices);
+
+      TestEqual("Copied vertices", copiedVertices.Num(), 0);
+      TestEqual("Vertex count", vertices.vertexCount, 4);
+      TestEqual("Indices", indices, TArray<uint32>{0, 1, 2, 0, 2, 3});
+      for (const FVector4f& tangent : vertices.tangents) {
+        TestTrue("Tangent", tangent.Equals(FVector4f(1.0f, 0.0f, 0.0f, 1.0f)));
+      }
+    });
+
+    It("splits the vertices shared with mirrored triangles", [this]() {
+      FPositionVertexBuffer positions;
+      CesiumVertexBufferUtility::VertexAttributes vertices;
+      createQuad(positions, vertices);
+      // Mirror the second triangle along the U axis.
+      vertices.getUVs(0)[3] = FVector2f(1.0f, 0.0f);
+
+      TArray<uint32> indices{0, 1, 2, 0, 2, 3};
+      TArray<uint32> copiedVertices;
+      CesiumVertexBufferUtility::computeIndexedTangents(
+          positions,
+          indices,
+          vertices,
+          copiedVertices);
+
+      TestEqual("Copied vertices", copiedVertices, TArray<uint32>{0, 2});
+      TestEqual("Vertex count", vertices.vertexCount, 6);
+      TestEqual("Indices", indices, TArray<uint32>{0, 1, 2, 4, 5, 3});
+      TestEqual("Normal count", vertices.normals.Num(), 6);
+      TestEqual("UV of copy", vertices.uvs[0][5], FVector2f(0.0f, 1.0f));
+
+      const FVector4f positive(1.0f, 0.0f, 0.0f, 1.0f);
+      const FVector4f mirrored(-1.0f, 0.0f, 0.0f, -1.0f);
+      TestTrue("Tangent 0", vertices.tangents[0].Equals(positive));
+      TestTrue("Tangent 1", vertices.tangents[1].Equals(positive));
+      TestTrue("Tangent 2", vertices.tangents[2].Equals(positive));
+      TestTrue("Tangent 3", vertices.tangents[3].Equals(mirrored));
+      TestTrue("Tangent 4", vertices.tangents[4].Equals(mirrored));
+      TestTrue("Tangent 5", vertices.tangents[5].Equals(mirrored));
+
+      CesiumVertexBufferUtility::appendVertexCopies(
+          copiedVertices,
+          positions,
+          nullptr);
+      TestEqual("Position count", positions.GetNumVertices(), uint32(6));
+      TestEqual(
+          "Position of copy",
+          positions.VertexPosition(5),
+          FVector3f(0.0f, 1.0f, 0.0f));
+    });
+  });
+
+  Describe("computeIndexedFlatNormals", [this]() {
+    It("keeps the vertices of coplanar triangles", [this]() {
+      FPositionVertexBuffer positions;
+      CesiumVertexBufferUtility::VertexAttributes vertices;
+      createQuad(positions, vertices);
+
+      TArray<uint32> indices{0, 1, 2, 0, 2, 3};
+      TArray<uint32> copiedVertices;
+      CesiumVertexBufferUtility::computeIndexedFlatNormals(
+          positions,
+          indices,
+          0.0f,
+          vertices,
+          copiedVertices);
+
+      // The inverted Y axis reverses the winding order, so counterclockwise
+      // triangles in the XY plane face down.
+      TestEqual("Copied vertices", copiedVertices.Num(), 0);
+      TestEqual("Indices", indices, TArray<uint32>{0, 1, 2, 0, 2, 3});
+      for (const FVector3f& normal : vertices.normals) {
+        TestTrue("Normal", normal.Equals(FVector3f(0.0f, 0.0f, -1.0f)));
+      }
+    });
+
+    It("splits the vertices on edges sharper than the crease angle", [this]() {
+      FPositionVertexBuffer positions;
+      CesiumVertexBufferUtility::VertexAttributes vertices;
+      createQuad(positions, vertices);
+      // Fold the second triangle up, so that it faces along the X axis.
+      positions.VertexPosition(3) = FVector3f(0.0f, 0.0f, 1.0f);
+
+      TArray<uint32> indices{0, 1, 2, 0, 2, 3};
+      TArray<uint32> copiedVertices;
+      CesiumVertexBufferUtility::computeIndexedFlatNormals(
+          positions,
+          indices,
+          FMath::DegreesToRadians(80.0f),
+          vertices,
+          copiedVertices);
+
+      TestEqual("Copied vertices", copiedVertices, TArray<uint32>{0, 2});
+      TestEqual("Vertex count", vertices.vertexCount, 6);
+      TestEqual("Indices", indices, TArray<uint32>{0, 1, 2, 4, 5, 3});
+      TestEqual("UV count", vertices.uvs[0].Num(), 6);
+      TestEqual("UV of copy", vertices.uvs[0][4], FVector2f(0.0f, 0.0f));
+
+      const FVector3f down(0.0f, 0.0f, -1.0f);
+      const FVector3f back(-1.0f, 0.0f, 0.0f);
+      TestTrue("Normal 0", vertices.normals[0].Equals(down));
+      TestTrue("Normal 1", vertices.normals[1].Equals(down));
+      TestTrue("Normal 2", vertices.normals[2].Equals(down));
+      TestTrue("Normal 3", vertices.normals[3].Equals(back));
+      TestTrue("Normal 4", vertices.normals[4].Equals(back));
+      TestTrue("Normal 5", vertices.normals[5].Equals(back));
+    });
+
+    It("shares the vertices on edges within the crease angle", [this]() {
+      FPositionVertexBuffer positions;
+      CesiumVertexBufferUtility::VertexAttributes vertices;
+      createQuad(positions, vertices);
+      positions.VertexPosition(3) = FVector3f(0.0f, 0.0f, 1.0f);
+
+      TArray<uint32> indices{0, 1, 2, 0, 2, 3};
+      TArray<uint32> copiedVertices;
+      CesiumVertexBufferUtility::computeIndexedFlatNormals(
+          positions,
+          indices,
+          FMath::DegreesToRadians(100.0f),
+          vertices,
+          copiedVertices);
+
+      TestEqual("Copied vertices", copiedVertices.Num(), 0);
+      TestTrue(
+          "Shared normal",
+          vertices.normals[0].Equals(
+              FVector3f(-1.0f, 0.0f, -1.0f).GetSafeNormal()));
+    });
+  });
+
+  It("allows half-precision UVs only for small texture coordinates", [this]() {
+    CesiumVertexBufferUtility::VertexAttributes vertices;
+    vertices.vertexCount = 2;
+    vertices.getUVs(0)[1] = FVector2f(1.0f, -1.0f);
+    TestTrue(
+        "Small coordinates",
+        CesiumVertexBufferUtility::canUseHalfPrecisionUVs(vertices));
+
+    vertices.getUVs(1)[0] = FVector2f(0.5f, 1.5f);
+    TestFalse(
+        "Large coordinates",
+        CesiumVertexBufferUtility::canUseHalfPrecisionUVs(vertices));
+  });
+
+  It("detects vertex colors that are all opaque white", [this]() {
+    FColorVertexBuffer colors;
+    colors.Init(3, false);
+    for (uint32 i = 0; i < 3; ++i) {
+      colors.VertexColor(i) = FColor::White;
+    }
+    TestTrue("White", CesiumVertexBufferUtility::isOpaqueWhite(colors));
+
+    colors.VertexColor(1) = FColor(255, 255, 255, 128);
+    TestFalse("Translucent", CesiumVertexBufferUtility::isOpaqueWhite(colors));
+  });
+}
@@ -0,0 +1,101 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumViewStatePredictor.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "Misc/AutomationTest.h"
+#include <glm/trigonometric.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+
+BEGIN_DEFINE_SPEC(
+    FCesiumViewStatePredictorSpec,
+    "Cesium.Unit.ViewStatePredictor",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+ViewState createViewState(const glm::dvec3& position) {
+  return ViewState::create(
+      position,
+      glm::dvec3(-1.0, 0.0, 0.0),
+      glm::dvec3(0.0, 0.0, 1.0),
+      glm::dvec2(1024.0, 768.0),
+      glm::radians(60.0),
+      glm::radians(45.0),
+      Ellipsoid::WGS84);
+}
+
+END_DEFINE_SPEC(FCesiumViewStatePredictorSpec)
+
+void FCesiumViewStatePredictorSpec::Define() {
+  const glm::dvec3 start(Ellipsoid::WGS84.getMaximumRadius() + 1000.0, 0, 0);
+
+  It("predicts nothing before the velocity is known", [this, start]() {
+    CesiumViewStatePredictor predictor;
+    std::vector<ViewState> viewStates{createViewState(start)};
+    predictor.update(viewStates, 0.1);
+
+    std::vector<ViewState> predicted;
+    predictor.predict(viewStates, 2.0, 2, Ellipsoid::WGS84, predicted);
+    TestTrue("No predictions", predicted.empty());
+  });
+
+  It("extrapolates moving cameras over the lookahead time", [this, start]() {
+    CesiumViewStatePredictor predictor;
+    predictor.update({createViewState(start)}, 0.1);
+
+    std::vector<ViewState> viewStates{
+        createViewState(start + glm::dvec3(0.0, 10.0, 0.0))};
+    predictor.update(viewStates, 0.1);
+
+    std::vector<ViewState> predicted;
+    predictor.predict(viewStates, 2.0, 2, Ellipsoid::WGS84, predicted);
+    if (!TestEqual("Predictions", predicted.size(), size_t(2))) {
+      return;
+    }
+
+    TestEqual("First prediction", predicted[0].getPosition().y, 110.0, 1e-6);
+    TestEqual("Second prediction", predicted[1].getPosition().y, 210.0, 1e-6);
+    TestEqual(
+        "Direction",
+        predicted[1].getDirection().x,
+        viewStates[0].getDirection().x);
+  });
+
+  It("skips stationary cameras", [this, start]() {
+    CesiumViewStatePredictor predictor;
+    std::vector<ViewState> viewStates{
+        createViewState(start),
+        createViewState(start + glm::dvec3(0.0, 0.0, 100.0))};
+    predictor.update(viewStates, 0.1);
+
+    viewStates[1] = createViewState(start + glm::dvec3(0.0, 0.0, 110.0));
+    predictor.update(viewStates, 0.1);
+
+    std::vector<ViewState> predicted;
+    predictor.predict(viewStates, 1.0, 1, Ellipsoid::WGS84, predicted);
+    if (!TestEqual("Predictions", predicted.size(), size_t(1))) {
+      return;
+    }
+    TestEqual("Prediction", predicted[0].getPosition().z, 210.0, 1e-6);
+  });
+
+  It("starts over when the number of cameras changes", [this, start]() {
+    CesiumViewStatePredictor predictor;
+    predictor.update({createViewState(start)}, 0.1);
+    predictor.update(
+        {createViewState(start + glm::dvec3(0.0, 10.0, 0.0))},
+        0.1);
+    TestEqual("Velocities", predictor.getVelocities().size(), size_t(1));
+
+    std::vector<ViewState> viewStates{
+        createViewState(start),
+        createViewState(start)};
+    predictor.update(viewStates, 0.1);
+    TestTrue("Velocities reset", predictor.getVelocities().empty());
+
+    std::vector<ViewState> predicted;
+    predictor.predict(viewStates, 2.0, 2, Ellipsoid::WGS84, predicted);
+    TestTrue("No predictions", predicted.empty());
+  });
+}
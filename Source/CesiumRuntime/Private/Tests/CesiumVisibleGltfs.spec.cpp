@@ -0,0 +1,73 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumVisibleGltfs.h"
+#include "CesiumGltfComponent.h"
+#include "Misc/AutomationTest.h"
+
+BEGIN_DEFINE_SPEC(
+    FCesiumVisibleGltfsSpec,
+    "Cesium.Unit.VisibleGltfs",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::ProductFilter)
+
+TObjectPtr<UCesiumGltfComponent> pVisible;
+TObjectPtr<UCesiumGltfComponent> pHidden;
+
+END_DEFINE_SPEC(FCesiumVisibleGltfsSpec)
+
+void FCesiumVisibleGltfsSpec::Define() {
+  BeforeEach([this]() {
+    pVisible = NewObject<UCesiumGltfComponent>();
+    pVisible->SetVisibility(true);
+    pVisible->TransformEpoch = 1;
+
+    pHidden = NewObject<UCesiumGltfComponent>();
+    pHidden->SetVisibility(false);
+    pHidden->TransformEpoch = 1;
+  });
+
+  AfterEach([this]() {
+    pVisible = nullptr;
+    pHidden = nullptr;
+  });
+
+  It("updates only the visible components", [this]() {
+    CesiumVisibleGltfs visibleGltfs;
+    visibleGltfs.add(pVisible);
+
+    visibleGltfs.updateTransforms(glm::dmat4(1.0), 2);
+    TestEqual("Visible epoch", pVisible->TransformEpoch, uint64(2));
+    TestEqual("Hidden epoch", pHidden->TransformEpoch, uint64(1));
+  });
+
+  It("forgets components that were hidden in the meantime", [this]() {
+    CesiumVisibleGltfs visibleGltfs;
+    visibleGltfs.add(pVisible);
+    visibleGltfs.add(pHidden);
+    TestEqual("Components before", visibleGltfs.num(), 2);
+
+    visibleGltfs.updateTransforms(glm::dmat4(1.0), 2);
+    TestEqual("Components after", visibleGltfs.num(), 1);
+    TestEqual("Visible epoch", pVisible->TransformEpoch, uint64(2));
+    TestEqual("Hidden epoch", pHidden->TransformEpoch, uint64(1));
+  });
+
+  It("forgets destroyed components", [this]() {
+    CesiumVisibleGltfs visibleGltfs;
+    visibleGltfs.add(pVisible);
+    pVisible->MarkAsGarbage();
+
+    visibleGltfs.updateTransforms(glm::dmat4(1.0), 2);
+    TestEqual("Components", visibleGltfs.num(), 0);
+  });
+
+  It("adds each component only once and removes it", [this]() {
+    CesiumVisibleGltfs visibleGltfs;
+    visibleGltfs.add(pVisible);
+    visibleGltfs.add(pVisible);
+    TestEqual("Components", visibleGltfs.num(), 1);
+
+    visibleGltfs.remove(pVisible);
+    TestEqual("Components after removing", visibleGltfs.num(), 0);
+  });
+}
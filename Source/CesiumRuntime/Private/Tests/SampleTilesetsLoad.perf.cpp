@@ -7,11 +7,13 @@
 #include "Misc/AutomationTest.h"
 
 #include "CesiumAsync/ICacheDatabase.h"
+#include "CesiumCameraPath.h"
 #include "CesiumGltfComponent.h"
 #include "CesiumIonRasterOverlay.h"
 #include "CesiumRuntime.h"
 #include "CesiumSunSky.h"
 #include "GlobeAwareDefaultPawn.h"
+#include "Misc/CommandLine.h"
 
 using namespace Cesium;
 
@@ -35,6 +37,11 @@ IMPLEMENT_SIMPLE_AUTOMATION_TEST(
     "Cesium.Performance.Tileset Loading.Melbourne photogrammetry (open data), vary max tile loads",
     EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
 
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FLoadTilesetDenverCameraPath,
+    "Cesium.Performance.Tileset Loading.Aerometrex Denver, recorded camera path",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
 void samplesClearCache(SceneGenerationContext&, TestPass::TestingParameter) {
   std::shared_ptr<CesiumAsync::ICacheDatabase> pCacheDatabase =
       getCacheDatabase();
@@ -277,4 +284,44 @@ bool FLoadTilesetMelbourneVaryMaxTileLoads::RunTest(const FString& Parameters) {
       768,
       reportStep);
 }
+
+bool FLoadTilesetDenverCameraPath::RunTest(const FString& Parameters) {
+  // The path is recorded with UCesiumCameraPathRecorderComponent, e.g.
+  // -CesiumCameraPath=C:/Project/Saved/CameraPaths/CameraPath.csv
+  FString cameraPathFilename;
+  if (!FParse::Value(
+          FCommandLine::Get(),
+          TEXT("CesiumCameraPath="),
+          cameraPathFilename)) {
+    UE_LOG(
+        LogCesium,
+        Display,
+        TEXT("Skipping test, no -CesiumCameraPath was given"));
+    return true;
+  }
+
+  std::optional<CesiumCameraPath> maybePath =
+      CesiumCameraPath::loadFromCsv(cameraPathFilename);
+  if (!TestTrue("Camera path loaded", maybePath.has_value())) {
+    return false;
+  }
+
+  std::shared_ptr<const CesiumCameraPath> pCameraPath =
+      std::make_shared<const CesiumCameraPath>(std::move(*maybePath));
+
+  std::vector<TestPass> testPasses;
+  TestPass coldCache{"Cold Cache", samplesClearCache, nullptr};
+  coldCache.pCameraPath = pCameraPath;
+  testPasses.push_back(coldCache);
+  TestPass warmCache{"Warm Cache", samplesRefreshTilesets, nullptr};
+  warmCache.pCameraPath = pCameraPath;
+  testPasses.push_back(warmCache);
+
+  return RunLoadTest(
+      GetBeautifiedTestName(),
+      setupForDenver,
+      testPasses,
+      1024,
+      768);
+}
 #endif
@@ -0,0 +1,443 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "Cesium3DTilesSelection/IPrepareRendererResources.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/TilesetExternals.h"
+#include "Cesium3DTilesSelection/TilesetLoadFailureDetails.h"
+#include "Cesium3DTilesSelection/TilesetOptions.h"
+#include "Cesium3DTilesSelection/ViewUpdateResult.h"
+#include "CesiumAsync/AsyncSystem.h"
+#include "CesiumCameraPath.h"
+#include "CesiumGeospatial/Ellipsoid.h"
+#include "CesiumRuntime.h"
+#include "CesiumUtility/CreditSystem.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+/**
+ * Replays a camera path through tile selection, without creating any Unreal
+ * objects for the tiles, and reports the per-frame cost of selection. Because
+ * it needs neither a viewport nor a network, it can run on a headless machine
+ * with -NullRHI. It's configured from the command line:
+ *
+ * -CesiumBenchmarkTileset=<path or file:/// URL of a tileset.json>
+ * -CesiumBenchmarkCameraPath=<camera path CSV, see CesiumCameraPath>
+ * -CesiumBenchmarkOutput=<JSON file to write the results to> (optional)
+ * -CesiumBenchmarkBaseline=<JSON results of an earlier run> (optional)
+ * -CesiumBenchmarkTolerance=<allowed relative slowdown, default 0.1>
+ *
+ * Before each frame is timed, the tiles it needs are loaded to completion,
+ * without timing. The selection that is timed then sees the same tiles in the
+ * same state on every run and every machine, regardless of how fast tiles
+ * load, so its cost and the tile counts are comparable between runs. The test
+ * fails if the selection time percentiles exceed those of the baseline by
+ * more than the tolerance, or if any tile count differs from the baseline,
+ * because then the selection itself changed and the times are incomparable.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FTileSelectionCameraPath,
+    "Cesium.Performance.Tile Selection.Camera path",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace Cesium3DTilesSelection;
+
+namespace {
+
+/**
+ * Loads tile content without preparing any renderer resources for it.
+ */
+class NullResourcePreparer : public IPrepareRendererResources {
+public:
+  virtual CesiumAsync::Future<TileLoadResultAndRenderResources>
+  prepareInLoadThread(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      TileLoadResult&& tileLoadResult,
+      const glm::dmat4& transform,
+      const std::any& rendererOptions) override {
+    return asyncSystem.createResolvedFuture(
+        TileLoadResultAndRenderResources{std::move(tileLoadResult), nullptr});
+  }
+
+  virtual void*
+  prepareInMainThread(Tile& tile, void* pLoadThreadResult) override {
+    return nullptr;
+  }
+
+  virtual void free(
+      Tile& tile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override {}
+
+  virtual void* prepareRasterInLoadThread(
+      CesiumGltf::ImageAsset& image,
+      const std::any& rendererOptions) override {
+    return nullptr;
+  }
+
+  virtual void* prepareRasterInMainThread(
+      CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult) override {
+    return nullptr;
+  }
+
+  virtual void freeRaster(
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pLoadThreadResult,
+      void* pMainThreadResult) noexcept override {}
+
+  virtual void attachRasterInMainThread(
+      const Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources,
+      const glm::dvec2& translation,
+      const glm::dvec2& scale) override {}
+
+  virtual void detachRasterInMainThread(
+      const Tile& tile,
+      int32_t overlayTextureCoordinateID,
+      const CesiumRasterOverlays::RasterOverlayTile& rasterTile,
+      void* pMainThreadRendererResources) noexcept override {}
+};
+
+struct FrameResult {
+  // The time spent in updateView once the frame's tiles are loaded.
+  double selectionMilliseconds;
+  double tilesVisited;
+  double tilesRendered;
+  double tilesCulled;
+};
+
+// Percentiles use the nearest-rank method on the sorted values.
+double percentile(const std::vector<double>& sorted, double fraction) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+
+  size_t rank = size_t(std::ceil(fraction * double(sorted.size())));
+  return sorted[std::clamp(rank, size_t(1), sorted.size()) - 1];
+}
+
+TSharedRef<FJsonObject> summarize(
+    const std::vector<FrameResult>& frames,
+    double FrameResult::*pMember) {
+  std::vector<double> values;
+  values.reserve(frames.size());
+  double sum = 0.0;
+  for (const FrameResult& frame : frames) {
+    values.push_back(frame.*pMember);
+    sum += frame.*pMember;
+  }
+  std::sort(values.begin(), values.end());
+
+  TSharedRef<FJsonObject> pSummary = MakeShared<FJsonObject>();
+  pSummary->SetNumberField(TEXT("p50"), percentile(values, 0.50));
+  pSummary->SetNumberField(TEXT("p95"), percentile(values, 0.95));
+  pSummary->SetNumberField(TEXT("p99"), percentile(values, 0.99));
+  pSummary->SetNumberField(TEXT("max"), values.empty() ? 0.0 : values.back());
+  pSummary->SetNumberField(
+      TEXT("mean"),
+      values.empty() ? 0.0 : sum / double(values.size()));
+  return pSummary;
+}
+
+FString toTilesetUrl(const FString& tileset) {
+  if (tileset.StartsWith(TEXT("file:///")) ||
+      tileset.StartsWith(TEXT("http://")) ||
+      tileset.StartsWith(TEXT("https://"))) {
+    return tileset;
+  }
+
+  FString url = TEXT("file:///") + FPaths::ConvertRelativePathToFull(tileset);
+  url.ReplaceCharInline('\\', '/');
+  url.ReplaceInline(TEXT(" "), TEXT("%20"));
+  return url;
+}
+
+// Gives the tileset's main thread continuations a chance to run until the
+// condition is true or the timeout expires.
+template <typename Condition>
+bool pumpUntil(Condition&& condition, double timeoutSeconds) {
+  double start = FPlatformTime::Seconds();
+  while (!condition()) {
+    if (FPlatformTime::Seconds() - start > timeoutSeconds) {
+      return false;
+    }
+    getAsyncSystem().dispatchMainThreadTasks();
+    FPlatformProcess::Sleep(0.001f);
+  }
+  return true;
+}
+
+// Selects tiles for the views and lets them load until nothing is left to
+// load, or the timeout expires.
+bool loadToCompletion(
+    Tileset& tileset,
+    const std::vector<ViewState>& viewStates,
+    double timeoutSeconds) {
+  return pumpUntil(
+      [&tileset, &viewStates]() {
+        const ViewUpdateResult& result = tileset.updateView(viewStates, 0.0f);
+        return result.workerThreadTileLoadQueueLength == 0 &&
+               result.mainThreadTileLoadQueueLength == 0 &&
+               tileset.computeLoadProgress() >= 100.0f;
+      },
+      timeoutSeconds);
+}
+
+// Checks that every statistic of a tile count is the same as in the baseline.
+bool compareCounts(
+    FAutomationTestBase& test,
+    const FJsonObject& baseline,
+    const FJsonObject& results,
+    const TCHAR* name) {
+  const TSharedPtr<FJsonObject>* ppBaseline = nullptr;
+  if (!baseline.TryGetObjectField(name, ppBaseline)) {
+    test.AddError(FString::Printf(TEXT("Baseline is missing %s."), name));
+    return false;
+  }
+
+  const TSharedPtr<FJsonObject>& pCurrent = results.GetObjectField(name);
+  bool same = true;
+  for (const TCHAR* statistic :
+       {TEXT("p50"), TEXT("p95"), TEXT("p99"), TEXT("max"), TEXT("mean")}) {
+    double expected = (*ppBaseline)->GetNumberField(statistic);
+    double actual = pCurrent->GetNumberField(statistic);
+    if (expected != actual) {
+      test.AddError(FString::Printf(
+          TEXT("%s %s changed from %.2f to %.2f."),
+          name,
+          statistic,
+          expected,
+          actual));
+      same = false;
+    }
+  }
+  return same;
+}
+
+} // namespace
+
+bool FTileSelectionCameraPath::RunTest(const FString& Parameters) {
+  FString tilesetArgument;
+  FString cameraPathFilename;
+  if (!FParse::Value(
+          FCommandLine::Get(),
+          TEXT("CesiumBenchmarkTileset="),
+          tilesetArgument) ||
+      !FParse::Value(
+          FCommandLine::Get(),
+          TEXT("CesiumBenchmarkCameraPath="),
+          cameraPathFilename)) {
+    AddInfo(TEXT("Skipped because -CesiumBenchmarkTileset and "
+                 "-CesiumBenchmarkCameraPath were not given."));
+    return true;
+  }
+
+  FString outputFilename;
+  FParse::Value(
+      FCommandLine::Get(),
+      TEXT("CesiumBenchmarkOutput="),
+      outputFilename);
+  FString baselineFilename;
+  FParse::Value(
+      FCommandLine::Get(),
+      TEXT("CesiumBenchmarkBaseline="),
+      baselineFilename);
+  double tolerance = 0.1;
+  FParse::Value(
+      FCommandLine::Get(),
+      TEXT("CesiumBenchmarkTolerance="),
+      tolerance);
+
+  std::optional<CesiumCameraPath> maybePath =
+      CesiumCameraPath::loadFromCsv(cameraPathFilename);
+  if (!maybePath || maybePath->frames.empty()) {
+    AddError(FString::Printf(
+        TEXT("Camera path %s could not be loaded or is empty."),
+        *cameraPathFilename));
+    return false;
+  }
+  const CesiumCameraPath& path = *maybePath;
+
+  const FString url = toTilesetUrl(tilesetArgument);
+  const CesiumGeospatial::Ellipsoid& ellipsoid =
+      CesiumGeospatial::Ellipsoid::WGS84;
+
+  TilesetExternals externals{
+      getAssetAccessor(),
+      std::make_shared<NullResourcePreparer>(),
+      getAsyncSystem(),
+      std::make_shared<CesiumUtility::CreditSystem>(),
+      spdlog::default_logger()};
+
+  bool loadFailed = false;
+  TilesetOptions options;
+  options.ellipsoid = ellipsoid;
+  options.loadErrorCallback =
+      [&loadFailed, this](const TilesetLoadFailureDetails& details) {
+        loadFailed = true;
+        AddError(UTF8_TO_TCHAR(details.message.c_str()));
+      };
+
+  TUniquePtr<Tileset> pTileset =
+      MakeUnique<Tileset>(externals, TCHAR_TO_UTF8(*url), options);
+
+  bool rootLoaded = pumpUntil(
+      [&pTileset, &loadFailed]() {
+        return loadFailed || pTileset->getRootTile() != nullptr;
+      },
+      60.0);
+  if (!rootLoaded || loadFailed) {
+    AddError(FString::Printf(TEXT("Tileset %s could not be loaded."), *url));
+    return false;
+  }
+
+  std::vector<FrameResult> frames;
+  frames.reserve(path.frames.size());
+
+  std::vector<ViewState> viewStates;
+  double previousTime = path.frames.front().time;
+
+  for (const CesiumCameraPath::Frame& frame : path.frames) {
+    viewStates.clear();
+    for (const CesiumCameraPath::Camera& camera : frame.cameras) {
+      viewStates.push_back(
+          CesiumCameraPath::createViewState(camera, ellipsoid));
+    }
+
+    if (!loadToCompletion(*pTileset, viewStates, 60.0)) {
+      AddError(FString::Printf(
+          TEXT("The tiles of frame %d did not finish loading."),
+          int32(frames.size())));
+      break;
+    }
+
+    float deltaTime = float(std::max(frame.time - previousTime, 0.0));
+    previousTime = frame.time;
+
+    double start = FPlatformTime::Seconds();
+    const ViewUpdateResult& result =
+        pTileset->updateView(viewStates, deltaTime);
+    double end = FPlatformTime::Seconds();
+
+    FrameResult& frameResult = frames.emplace_back();
+    frameResult.selectionMilliseconds = (end - start) * 1000.0;
+    frameResult.tilesVisited = double(result.tilesVisited);
+    frameResult.tilesRendered = double(result.tilesToRenderThisFrame.size());
+    frameResult.tilesCulled = double(result.tilesCulled);
+  }
+
+  bool destroyed = false;
+  pTileset->getAsyncDestructionCompleteEvent().thenImmediately(
+      [&destroyed]() { destroyed = true; });
+  pTileset.Reset();
+  pumpUntil([&destroyed]() { return destroyed; }, 60.0);
+
+  if (HasAnyErrors()) {
+    return false;
+  }
+
+  TSharedRef<FJsonObject> pResults = MakeShared<FJsonObject>();
+  pResults->SetStringField(TEXT("tileset"), url);
+  pResults->SetStringField(TEXT("cameraPath"), cameraPathFilename);
+  pResults->SetNumberField(TEXT("frames"), double(frames.size()));
+  pResults->SetObjectField(
+      TEXT("selectionMilliseconds"),
+      summarize(frames, &FrameResult::selectionMilliseconds));
+  pResults->SetObjectField(
+      TEXT("tilesVisited"),
+      summarize(frames, &FrameResult::tilesVisited));
+  pResults->SetObjectField(
+      TEXT("tilesRendered"),
+      summarize(frames, &FrameResult::tilesRendered));
+  pResults->SetObjectField(
+      TEXT("tilesCulled"),
+      summarize(frames, &FrameResult::tilesCulled));
+
+  FString json;
+  TSharedRef<TJsonWriter<>> pWriter = TJsonWriterFactory<>::Create(&json);
+  FJsonSerializer::Serialize(pResults, pWriter);
+  UE_LOG(LogCesium, Display, TEXT("Tile selection results: %s"), *json);
+
+  if (!outputFilename.IsEmpty() &&
+      !FFileHelper::SaveStringToFile(json, *outputFilename)) {
+    AddError(FString::Printf(TEXT("Could not write %s."), *outputFilename));
+  }
+
+  if (baselineFilename.IsEmpty()) {
+    return true;
+  }
+
+  FString baselineJson;
+  TSharedPtr<FJsonObject> pBaseline;
+  if (!FFileHelper::LoadFileToString(baselineJson, *baselineFilename) ||
+      !FJsonSerializer::Deserialize(
+          TJsonReaderFactory<>::Create(baselineJson),
+          pBaseline) ||
+      !pBaseline.IsValid()) {
+    AddError(FString::Printf(
+        TEXT("Could not read baseline %s."),
+        *baselineFilename));
+    return false;
+  }
+
+  // Different tile counts mean that the selection itself changed, which
+  // makes the times incomparable.
+  double baselineFrames = 0.0;
+  if (!pBaseline->TryGetNumberField(TEXT("frames"), baselineFrames) ||
+      baselineFrames != double(frames.size())) {
+    AddError(FString::Printf(
+        TEXT("Baseline %s is for a different camera path."),
+        *baselineFilename));
+    return false;
+  }
+
+  bool sameCounts = true;
+  for (const TCHAR* count :
+       {TEXT("tilesVisited"), TEXT("tilesRendered"), TEXT("tilesCulled")}) {
+    sameCounts &= compareCounts(*this, *pBaseline, *pResults, count);
+  }
+  if (!sameCounts) {
+    return false;
+  }
+
+  const TSharedPtr<FJsonObject>* ppBaselineSelection = nullptr;
+  if (!pBaseline->TryGetObjectField(
+          TEXT("selectionMilliseconds"),
+          ppBaselineSelection)) {
+    AddError(FString::Printf(
+        TEXT("Baseline %s is missing results."),
+        *baselineFilename));
+    return false;
+  }
+
+  const TSharedPtr<FJsonObject>& pSelection =
+      pResults->GetObjectField(TEXT("selectionMilliseconds"));
+  for (const TCHAR* statistic : {TEXT("p50"), TEXT("p95"), TEXT("p99")}) {
+    double baseline = (*ppBaselineSelection)->GetNumberField(statistic);
+    double current = pSelection->GetNumberField(statistic);
+    if (current > baseline * (1.0 + tolerance)) {
+      AddError(FString::Printf(
+          TEXT("Selection time %s regressed from %.4f ms to %.4f ms."),
+          statistic,
+          baseline,
+          current));
+    }
+  }
+
+  return !HasAnyErrors();
+}
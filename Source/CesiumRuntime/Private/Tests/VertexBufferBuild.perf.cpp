@@ -0,0 +1,298 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/Model.h"
+#include "CesiumGltfSpecUtility.h"
+#include "CesiumVertexBufferUtility.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "StaticMeshResources.h"
+#include <glm/glm.hpp>
+#include <vector>
+
+/**
+ * Compares the time it takes to build the vertex buffers of a glTF primitive
+ * the way the glTF loader used to, through an array of FStaticMeshBuildVertex,
+ * with the time it takes using CesiumVertexBufferUtility. Both indexed and
+ * duplicated vertices are measured, and the test fails if the two ways don't
+ * produce the same vertex buffers.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FVertexBufferBuild,
+    "Cesium.Performance.Vertex Buffers.Build",
+    EAutomationTestFlags::ApplicationContextMask |
+        EAutomationTestFlags::PerfFilter)
+
+using namespace CesiumGltf;
+
+namespace {
+
+constexpr int32 gridSize = 256;
+constexpr int32 iterationCount = 20;
+constexpr float positionScale = 100.0f;
+
+struct VertexBuffers {
+  FPositionVertexBuffer positions;
+  FStaticMeshVertexBuffer staticMesh;
+  float sphereRadius = 0.0f;
+};
+
+/**
+ * Creates a primitive with a grid of vertices that have normals, tangents, and
+ * texture coordinates.
+ */
+Model createGridModel() {
+  Model model;
+  Mesh& mesh = model.meshes.emplace_back();
+  MeshPrimitive& primitive = mesh.primitives.emplace_back();
+
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec3> normals;
+  std::vector<glm::vec4> tangents;
+  std::vector<glm::vec2> uvs;
+  for (int32 y = 0; y < gridSize; ++y) {
+    for (int32 x = 0; x < gridSize; ++x) {
+      const float u = float(x) / float(gridSize - 1);
+      const float v = float(y) / float(gridSize - 1);
+      positions.emplace_back(u, v, glm::sin(u * 10.0f) * glm::cos(v * 10.0f));
+      normals.emplace_back(glm::normalize(glm::vec3(u - 0.5f, v - 0.5f, 1.0f)));
+      tangents.emplace_back(1.0f, 0.0f, 0.0f, (x + y) % 2 ? 1.0f : -1.0f);
+      uvs.emplace_back(u, v);
+    }
+  }
+
+  std::vector<uint32_t> indices;
+  for (int32 y = 0; y + 1 < gridSize; ++y) {
+    for (int32 x = 0; x + 1 < gridSize; ++x) {
+      const uint32_t i = uint32_t(y * gridSize + x);
+      indices.insert(
+          indices.end(),
+          {i, i + 1, i + gridSize, i + 1, i + gridSize + 1, i + gridSize});
+    }
+  }
+
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "POSITION",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      positions);
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "NORMAL",
+      AccessorSpec::Type::VEC3,
+      AccessorSpec::ComponentType::FLOAT,
+      normals);
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TANGENT",
+      AccessorSpec::Type::VEC4,
+      AccessorSpec::ComponentType::FLOAT,
+      tangents);
+  CreateAttributeForPrimitive(
+      model,
+      primitive,
+      "TEXCOORD_0",
+      AccessorSpec::Type::VEC2,
+      AccessorSpec::ComponentType::FLOAT,
+      uvs);
+  CreateIndicesForPrimitive(
+      model,
+      primitive,
+      AccessorSpec::ComponentType::UNSIGNED_INT,
+      indices);
+
+  return model;
+}
+
+struct GridViews {
+  AccessorView<FVector3f> positions;
+  AccessorView<FVector3f> normals;
+  AccessorView<FVector4f> tangents;
+  AccessorView<FVector2f> uvs;
+  TArray<uint32> indices;
+};
+
+GridViews createViews(const Model& model) {
+  const MeshPrimitive& primitive = model.meshes[0].primitives[0];
+  GridViews result{
+      AccessorView<FVector3f>(model, primitive.attributes.at("POSITION")),
+      AccessorView<FVector3f>(model, primitive.attributes.at("NORMAL")),
+      AccessorView<FVector4f>(model, primitive.attributes.at("TANGENT")),
+      AccessorView<FVector2f>(model, primitive.attributes.at("TEXCOORD_0")),
+      {}};
+
+  AccessorView<uint32_t> indexView(model, primitive.indices);
+  result.indices.SetNum(int32(indexView.size()));
+  for (int32 i = 0; i < result.indices.Num(); ++i) {
+    result.indices[i] = indexView[i];
+  }
+  return result;
+}
+
+/**
+ * Builds the vertex buffers the way the glTF loader did before
+ * CesiumVertexBufferUtility existed.
+ */
+void buildThroughBuildVertices(
+    const GridViews& views,
+    bool duplicateVertices,
+    const FVector& center,
+    VertexBuffers& result) {
+  TArray<FStaticMeshBuildVertex> vertices;
+  vertices.SetNum(
+      duplicateVertices ? views.indices.Num()
+                        : static_cast<int32>(views.positions.size()));
+
+  result.sphereRadius = 0.0f;
+  for (int32 i = 0; i < vertices.Num(); ++i) {
+    FStaticMeshBuildVertex& vertex = vertices[i];
+    const uint32 vertexIndex = duplicateVertices ? views.indices[i] : i;
+    const FVector3f& pos = views.positions[vertexIndex];
+    vertex.Position.X = pos.X * positionScale;
+    vertex.Position.Y = -pos.Y * positionScale;
+    vertex.Position.Z = pos.Z * positionScale;
+    vertex.UVs[0] = FVector2f(0.0f, 0.0f);
+    result.sphereRadius = FMath::Max(
+        float((FVector(vertex.Position) - center).Size()),
+        result.sphereRadius);
+  }
+
+  for (int32 i = 0; i < vertices.Num(); ++i) {
+    FStaticMeshBuildVertex& vertex = vertices[i];
+    const uint32 vertexIndex = duplicateVertices ? views.indices[i] : i;
+    const FVector3f& normal = views.normals[vertexIndex];
+    vertex.TangentZ = FVector3f(normal.X, -normal.Y, normal.Z);
+
+    const FVector4f& tangent = views.tangents[vertexIndex];
+    vertex.TangentX = FVector3f(tangent.X, -tangent.Y, tangent.Z);
+    vertex.TangentY =
+        FVector3f::CrossProduct(vertex.TangentZ, vertex.TangentX) * tangent.W;
+
+    vertex.UVs[0] = views.uvs[vertexIndex];
+  }
+
+  result.positions.Init(vertices, false);
+  result.staticMesh.SetUseFullPrecisionUVs(true);
+  result.staticMesh.Init(vertices.Num(), 1, false);
+  for (int32 i = 0; i < vertices.Num(); ++i) {
+    const FStaticMeshBuildVertex& source = vertices[i];
+    result.staticMesh.SetVertexTangents(
+        i,
+        source.TangentX,
+        source.TangentY,
+        source.TangentZ);
+    result.staticMesh.SetVertexUV(i, 0, source.UVs[0], false);
+  }
+}
+
+void buildThroughUtility(
+    const GridViews& views,
+    bool duplicateVertices,
+    const FVector& center,
+    VertexBuffers& result) {
+  const TArray<uint32>* pIndices =
+      duplicateVertices ? &views.indices : nullptr;
+
+  CesiumVertexBufferUtility::VertexAttributes vertices;
+  vertices.vertexCount = duplicateVertices
+                             ? views.indices.Num()
+                             : static_cast<int32>(views.positions.size());
+
+  result.sphereRadius = CesiumVertexBufferUtility::copyPositions(
+      views.positions,
+      pIndices,
+      positionScale,
+      FVector3f(center),
+      result.positions);
+  CesiumVertexBufferUtility::copyNormals(
+      views.normals,
+      pIndices,
+      vertices.vertexCount,
+      vertices.normals);
+  CesiumVertexBufferUtility::copyTangents(
+      views.tangents,
+      pIndices,
+      vertices.vertexCount,
+      vertices.tangents);
+  CesiumVertexBufferUtility::copyUVs(views.uvs, pIndices, vertices.getUVs(0));
+
+  result.staticMesh.SetUseFullPrecisionUVs(true);
+  CesiumVertexBufferUtility::initStaticMeshVertexBuffer(
+      vertices,
+      1,
+      result.staticMesh);
+}
+
+template <typename TBuild>
+double measureBestSeconds(TBuild&& build) {
+  double best = TNumericLimits<double>::Max();
+  for (int32 i = 0; i < iterationCount; ++i) {
+    const double start = FPlatformTime::Seconds();
+    build();
+    best = FMath::Min(best, FPlatformTime::Seconds() - start);
+  }
+  return best;
+}
+
+bool buffersMatch(const VertexBuffers& a, const VertexBuffers& b) {
+  const uint32 vertexCount = a.positions.GetNumVertices();
+  if (vertexCount != b.positions.GetNumVertices() ||
+      vertexCount != b.staticMesh.GetNumVertices() ||
+      !FMath::IsNearlyEqual(a.sphereRadius, b.sphereRadius, 1e-3f)) {
+    return false;
+  }
+
+  const FStaticMeshVertexBuffer& sa = a.staticMesh;
+  const FStaticMeshVertexBuffer& sb = b.staticMesh;
+  for (uint32 i = 0; i < vertexCount; ++i) {
+    if (!a.positions.VertexPosition(i).Equals(b.positions.VertexPosition(i)) ||
+        !sa.VertexTangentX(i).Equals(sb.VertexTangentX(i)) ||
+        !sa.VertexTangentY(i).Equals(sb.VertexTangentY(i)) ||
+        !sa.VertexTangentZ(i).Equals(sb.VertexTangentZ(i)) ||
+        !sa.GetVertexUV(i, 0).Equals(sb.GetVertexUV(i, 0))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+bool FVertexBufferBuild::RunTest(const FString& Parameters) {
+  const Model model = createGridModel();
+  const GridViews views = createViews(model);
+  const FVector center(50.0, -50.0, 0.0);
+
+  for (bool duplicateVertices : {false, true}) {
+    VertexBuffers before;
+    VertexBuffers after;
+    const double beforeSeconds = measureBestSeconds([&]() {
+      buildThroughBuildVertices(views, duplicateVertices, center, before);
+    });
+    const double afterSeconds = measureBestSeconds([&]() {
+      buildThroughUtility(views, duplicateVertices, center, after);
+    });
+
+    const TCHAR* name =
+        duplicateVertices ? TEXT("Duplicated") : TEXT("Indexed");
+    AddInfo(FString::Printf(
+        TEXT("%s, %u vertices: FStaticMeshBuildVertex %.3f ms, "
+             "CesiumVertexBufferUtility %.3f ms (%.2fx)"),
+        name,
+        after.positions.GetNumVertices(),
+        beforeSeconds * 1000.0,
+        afterSeconds * 1000.0,
+        afterSeconds > 0.0 ? beforeSeconds / afterSeconds : 0.0));
+
+    TestTrue(
+        FString::Printf(TEXT("%s vertex buffers match"), name),
+        buffersMatch(before, after));
+  }
+
+  return true;
+}
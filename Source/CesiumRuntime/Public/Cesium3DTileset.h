@@ -31,7 +31,15 @@ class UMaterialInterface;
 class ACesiumCartographicSelection;
 class ACesiumCameraManager;
 class UCesiumBoundingVolumePoolComponent;
+class UCesiumGltfComponent;
+class UCesiumPrimitivePool;
+class UCesiumTilesetPrimitiveComponent;
+class CesiumOnDemandPhysicsMeshes;
+class CesiumTileLoadingBudget;
+class CesiumTilesToHide;
 class CesiumViewExtension;
+class CesiumViewStatePredictor;
+class CesiumVisibleGltfs;
 struct FCesiumCamera;
 
 namespace Cesium3DTilesSelection {
@@ -80,6 +88,49 @@ enum class ETilesetSource : uint8 {
 UENUM(BlueprintType)
 enum class EApplyDpiScaling : uint8 { Yes, No, UseProjectDefault };
 
+/**
+ * How tangents are generated for glTF primitives that need them but don't
+ * have them.
+ */
+UENUM(BlueprintType)
+enum class ETangentGeneration : uint8 {
+  /**
+   * Tangents are generated with the MikkTSpace algorithm, which requires
+   * giving every triangle its own three vertices.
+   */
+  MikkTSpace UMETA(DisplayName = "MikkTSpace"),
+
+  /**
+   * The tangents of the triangles that share a vertex are averaged, keeping
+   * the vertices shared. A vertex is only split when the texture coordinates
+   * of the triangles around it are mirrored relative to each other. This uses
+   * far less memory, but the tangents don't exactly match those that tools
+   * baking normal maps usually assume.
+   */
+  Indexed
+};
+
+/**
+ * The vertex format of the meshes created for glTF primitives.
+ */
+UENUM(BlueprintType)
+enum class ETileVertexFormat : uint8 {
+  /**
+   * Each primitive gets the smallest vertex format that doesn't noticeably
+   * lose precision. Texture coordinates are stored with half precision unless
+   * the primitive has feature IDs, metadata, or raster overlays, or
+   * coordinates outside [-1, 1]. Vertex colors that are all opaque white are
+   * left out.
+   */
+  Compact,
+
+  /**
+   * Texture coordinates are always stored with full precision, and vertex
+   * colors are always kept.
+   */
+  FullPrecision UMETA(DisplayName = "Full Precision")
+};
+
 UCLASS()
 class CESIUMRUNTIME_API ACesium3DTileset : public AActor {
   GENERATED_BODY()
@@ -266,6 +317,20 @@ private:
       Meta = (AllowPrivateAccess))
   UCesiumBoundingVolumePoolComponent* BoundingVolumePoolComponent = nullptr;
 
+  /**
+   * The pool of components, static meshes, and materials of unloaded tiles
+   * that are reused by newly-loaded tiles.
+   */
+  UPROPERTY(Transient)
+  UCesiumPrimitivePool* PrimitivePool = nullptr;
+
+  /**
+   * The component that renders the tiles of this tileset when
+   * UseTilesetSceneProxy is enabled.
+   */
+  UPROPERTY(Transient)
+  UCesiumTilesetPrimitiveComponent* TilesetPrimitiveComponent = nullptr;
+
   /**
    * The custom view extension this tileset uses to pull renderer view
    * information.
@@ -424,6 +489,23 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
   int64 MaximumCachedBytes = 256 * 1024 * 1024;
 
+  /**
+   * The relative importance of this tileset when the world tile budget is
+   * enabled in the Cesium runtime settings. In that case,
+   * MaximumSimultaneousTileLoads and MaximumCachedBytes are ignored, and the
+   * world's budget is split between all tilesets in proportion to this weight
+   * and to how much each tileset is rendering and waiting to load.
+   *
+   * A tileset with a priority of 0 still keeps the tiles it renders and loads
+   * one tile at a time, but gets no share of the remaining budget.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0.0))
+  float TileBudgetPriority = 1.0f;
+
   /**
    * The number of loading descendents a tile should allow before deciding to
    * render itself instead of waiting.
@@ -442,6 +524,80 @@ public:
       meta = (ClampMin = 0))
   int32 LoadingDescendantLimit = 20;
 
+  /**
+   * The maximum number of primitive components of unloaded tiles that are kept
+   * for reuse by newly-loaded tiles, along with their static meshes. The same
+   * number of material instances is kept as well.
+   *
+   * Reusing these objects reduces the number of objects that are created and
+   * garbage collected while new tiles are loaded quickly, such as during fast
+   * camera flights. A reused component is reset to its default visibility,
+   * collision, shadow, and material settings, but state that users attach to
+   * tile components beyond that may carry over to other tiles.
+   *
+   * This is 0 by default, which disables reuse.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0))
+  int32 PrimitivePoolSize = 0;
+
+  /**
+   * Whether to load the tiles that the cameras are about to see.
+   *
+   * When this is enabled, the velocity of each camera is estimated from frame
+   * to frame, and the tiles for additional views along its predicted path are
+   * loaded. These views are selected separately, after the current views, so
+   * they never change the tiles that are shown, and they only get the load
+   * slots that the current views leave. This helps the tileset keep up with
+   * fast-moving cameras, such as those of aircraft, at the cost of loading
+   * tiles that may never be needed.
+   *
+   * Predictive loading is not used while UseLodTransitions is enabled, because
+   * the separate selection would interfere with the fading of the tiles.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Tile Loading")
+  bool EnablePredictiveLoading = false;
+
+  /**
+   * How far ahead, in seconds, to predict the views of moving cameras.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0.0, EditCondition = "EnablePredictiveLoading"))
+  float PredictiveLoadingLookaheadTime = 2.0f;
+
+  /**
+   * The number of predicted views per moving camera. They are spaced evenly
+   * over the lookahead time.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta =
+          (ClampMin = 1,
+           ClampMax = 8,
+           EditCondition = "EnablePredictiveLoading"))
+  int32 PredictiveLoadingSteps = 2;
+
+  /**
+   * The number of tiles that the predicted views may wait for, not counting
+   * those needed by the current views, at which predictive loading stops. As
+   * more of them wait to load, the predictions furthest ahead are dropped
+   * first, one step at a time.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Tile Loading",
+      meta = (ClampMin = 0, EditCondition = "EnablePredictiveLoading"))
+  int32 MaximumPredictiveTileLoads = 20;
+
   /**
    * Whether to cull tiles that are outside the frustum.
    *
@@ -778,6 +934,109 @@ private:
       Category = "Cesium|Physics")
   bool CreatePhysicsMeshes = true;
 
+  /**
+   * Whether to cook the physics meshes of tiles only once they come near one
+   * of the collision interest actors, instead of while every tile is loaded.
+   *
+   * Cooking physics meshes is often the most expensive part of loading a
+   * tile, even though most tiles are too far away from anything to ever be
+   * collided with. When this is enabled, the triangles of each tile are kept
+   * on the CPU, and its physics mesh is cooked on a worker thread once the
+   * tile is rendered within PhysicsMeshCookingRadius of a collision interest
+   * actor. The physics mesh is released again when the tile is no longer
+   * rendered or is no longer near any of these actors. Until its physics mesh
+   * is cooked, a tile can't be collided with or hit by line traces.
+   *
+   * The physics meshes of glTF models with GPU instancing are always cooked
+   * while they are loaded.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCookPhysicsMeshesOnDemand,
+      BlueprintSetter = SetCookPhysicsMeshesOnDemand,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  bool CookPhysicsMeshesOnDemand = false;
+
+  /**
+   * How close, in Unreal units, the bounds of a tile must come to a collision
+   * interest actor for its physics mesh to be cooked, when physics meshes are
+   * cooked on demand. Physics meshes are released a bit further out, so that
+   * tiles near the edge of this radius aren't cooked over and over.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (ClampMin = 0.0,
+           EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand"))
+  double PhysicsMeshCookingRadius = 50000.0;
+
+  /**
+   * The actors near which tiles have their physics meshes cooked, when
+   * physics meshes are cooked on demand, such as vehicles or the sources of
+   * line traces.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand"))
+  TArray<TObjectPtr<AActor>> CollisionInterestActors;
+
+  /**
+   * Whether the pawns of all player controllers are collision interest actors
+   * too, in addition to CollisionInterestActors.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Physics",
+      meta =
+          (EditCondition = "CreatePhysicsMeshes && CookPhysicsMeshesOnDemand"))
+  bool PlayerPawnsAreCollisionInterestActors = true;
+
+  /**
+   * Whether to cook the physics meshes of tiles from simplified versions of
+   * their triangles.
+   *
+   * The vertices of each glTF primitive that share a position, such as the
+   * copies made for flat normals and tangents, are welded, and the resulting
+   * mesh is decimated for as long as its surface stays within
+   * PhysicsMeshMaximumError of the original one. The border of each tile is
+   * left unchanged, so the physics meshes of neighboring tiles still meet.
+   * This reduces the memory used by physics meshes and the time it takes to
+   * cook them, at the cost of simplifying them while tiles are loaded.
+   *
+   * The face indices of hits on simplified physics meshes don't match the
+   * triangles of the rendered tiles, so features and metadata can't be picked
+   * from such hits.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetSimplifyPhysicsMeshes,
+      BlueprintSetter = SetSimplifyPhysicsMeshes,
+      Category = "Cesium|Physics",
+      meta = (EditCondition = "CreatePhysicsMeshes"))
+  bool SimplifyPhysicsMeshes = false;
+
+  /**
+   * The largest distance, in Unreal units, by which the surface of a
+   * simplified physics mesh may deviate from the surface of the tile it is
+   * cooked for.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetPhysicsMeshMaximumError,
+      BlueprintSetter = SetPhysicsMeshMaximumError,
+      Category = "Cesium|Physics",
+      meta =
+          (ClampMin = 0.0,
+           EditCondition = "CreatePhysicsMeshes && SimplifyPhysicsMeshes"))
+  float PhysicsMeshMaximumError = 10.0f;
+
   /**
    * Whether to generate navigation collisions for this tileset.
    *
@@ -793,6 +1052,28 @@ private:
       Category = "Cesium|Navigation")
   bool CreateNavCollision = false;
 
+  /**
+   * Whether the tiles of this tileset can affect navigation.
+   *
+   * When disabled, the navigation system ignores the tiles entirely, so that
+   * loading and unloading tiles never marks the navigation mesh as dirty, and
+   * no navigation collisions are created even if "Create Nav Collision" is
+   * enabled. Disable this for tilesets that never take part in navigation
+   * mesh generation.
+   *
+   * This differs from disabling "Create Nav Collision", which only leaves out
+   * the navigation collision objects of the tiles. Tiles with physics meshes
+   * still affect navigation then, because the navigation system gathers
+   * their collision geometry directly, and still mark the navigation mesh as
+   * dirty when they load and unload.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetCanEverAffectNavigation,
+      BlueprintSetter = SetCanEverAffectNavigation,
+      Category = "Cesium|Navigation")
+  bool CanEverAffectNavigation = true;
+
   /**
    * Whether to always generate a correct tangent space basis for tiles that
    * don't have them.
@@ -815,6 +1096,19 @@ private:
       Category = "Cesium|Rendering")
   bool AlwaysIncludeTangents = false;
 
+  /**
+   * How to generate tangents for glTF primitives that need them but don't
+   * have them. This has no effect on primitives without normals, because
+   * their flat normals already require giving every triangle its own
+   * vertices.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetTangentGeneration,
+      BlueprintSetter = SetTangentGeneration,
+      Category = "Cesium|Rendering")
+  ETangentGeneration TangentGeneration = ETangentGeneration::MikkTSpace;
+
   /**
    * Whether to generate smooth normals when normals are missing in the glTF.
    *
@@ -831,6 +1125,57 @@ private:
       Category = "Cesium|Rendering")
   bool GenerateSmoothNormals = false;
 
+  /**
+   * Whether glTF primitives without normals keep their vertices shared when
+   * flat normals are generated for them. Normally, every triangle gets its own
+   * three vertices so that they can all have the triangle's normal. When this
+   * is enabled, a vertex is only split between triangles whose normals differ
+   * by more than FlatNormalCreaseAngle. This uses far less memory for meshes
+   * with large flat areas, such as many CAD and BIM models.
+   *
+   * This has no effect when "Generate Smooth Normals" is enabled, because
+   * those primitives then have normals.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetGenerateIndexedFlatNormals,
+      BlueprintSetter = SetGenerateIndexedFlatNormals,
+      Category = "Cesium|Rendering")
+  bool GenerateIndexedFlatNormals = false;
+
+  /**
+   * The largest angle, in degrees, between the normals of triangles that share
+   * a vertex when "Generate Indexed Flat Normals" is enabled. At zero, only
+   * triangles in the same plane share vertices, so shading is exactly flat.
+   * Larger angles share more vertices, but smooth the shading across the
+   * edges between triangles.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetFlatNormalCreaseAngle,
+      BlueprintSetter = SetFlatNormalCreaseAngle,
+      Category = "Cesium|Rendering",
+      meta =
+          (EditCondition = "GenerateIndexedFlatNormals",
+           ClampMin = 0.0,
+           ClampMax = 180.0))
+  float FlatNormalCreaseAngle = 0.0f;
+
+  /**
+   * The vertex format of the meshes created for this tileset's glTF
+   * primitives. The compact format chooses the smallest safe format for each
+   * primitive, which GetCompactVertexFormatSavings reports the savings of.
+   * Half-precision texture coordinates are only accurate to about a
+   * thousandth, so keep full precision if a material needs precise texture
+   * coordinates or vertex colors that the compact format would drop.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetVertexFormat,
+      BlueprintSetter = SetVertexFormat,
+      Category = "Cesium|Rendering")
+  ETileVertexFormat VertexFormat = ETileVertexFormat::FullPrecision;
+
   /**
    * Whether to request and render the water mask.
    *
@@ -863,6 +1208,71 @@ private:
       meta = (DisplayName = "Ignore KHR_materials_unlit"))
   bool IgnoreKhrMaterialsUnlit = false;
 
+  /**
+   * Whether to merge the compatible glTF primitives of each tile into a single
+   * mesh with one section per primitive, instead of creating a separate
+   * component, mesh, and material for every primitive. This reduces the number
+   * of components and draw calls for tilesets whose tiles have many small
+   * primitives.
+   *
+   * Primitives that are merged share a material when they use the same glTF
+   * material and material parameters. Points and instanced primitives are
+   * never merged. Picking functions that take a hit result or face index
+   * still resolve to the original primitive. Functions that take a component,
+   * such as GetPrimitiveFeatures, take an optional face index for the same
+   * purpose, and return the data of the first primitive in the mesh without
+   * it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetMergePrimitives,
+      BlueprintSetter = SetMergePrimitives,
+      Category = "Cesium|Rendering")
+  bool MergePrimitives = false;
+
+  /**
+   * Whether to render all tiles of this tileset with a single primitive
+   * component, instead of giving every glTF primitive a scene proxy of its
+   * own. Showing and hiding tiles then only updates the list of meshes drawn
+   * by that component, which avoids creating and updating the render state
+   * of many components.
+   *
+   * The primitive components of the tiles are still created, registered, and
+   * shown or hidden, because they provide collision and picking. The meshes
+   * are culled per tile, but they're gathered every frame rather than using
+   * cached draw commands. Points and instanced primitives are rendered as
+   * usual.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetUseTilesetSceneProxy,
+      BlueprintSetter = SetUseTilesetSceneProxy,
+      Category = "Cesium|Rendering|Experimental")
+  bool UseTilesetSceneProxy = false;
+
+  /**
+   * Whether to store the vertex positions of tile meshes with 16 bits per
+   * component, relative to the bounding box of each mesh, instead of as full
+   * floats. A quantized position takes 8 bytes instead of 12, because it is
+   * padded to four components, so this reduces the GPU memory of the
+   * positions by a third. Normals, tangents, and texture coordinates are
+   * unchanged. The precision of a position is 1/65535 of the largest side of
+   * its mesh's bounding box.
+   *
+   * This only applies to meshes that are rendered by the tileset's scene
+   * proxy, so it has no effect unless UseTilesetSceneProxy is enabled. Tiles
+   * rendered by their own scene proxies, as well as points and instanced
+   * primitives, always use full-precision positions. Collision and picking
+   * also still use full-precision positions.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintGetter = GetQuantizePositions,
+      BlueprintSetter = SetQuantizePositions,
+      Category = "Cesium|Rendering|Experimental",
+      meta = (EditCondition = "UseTilesetSceneProxy"))
+  bool QuantizePositions = false;
+
   /**
    * A custom Material to use to render opaque elements in this tileset, in
    * order to implement custom visual effects.
@@ -945,6 +1355,26 @@ public:
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   float GetLoadProgress() const { return LoadProgress; }
 
+  /**
+   * Gets the number of vertices of the meshes of this tileset's loaded tiles,
+   * divided by the number of vertices of their glTF primitives. This is 1 when
+   * no vertices were duplicated, and approaches 6 for indexed meshes whose
+   * vertices were all duplicated to generate flat normals or MikkTSpace
+   * tangents. It is also 1 while no tiles are loaded.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  float GetVertexInflationFactor() const;
+
+  /**
+   * Gets the number of bytes of vertex memory that the meshes of this
+   * tileset's loaded tiles use less because of the compact vertex format, in
+   * comparison with the full-precision format.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  int64 GetCompactVertexFormatSavings() const {
+    return int64(this->_compactVertexBytesSaved);
+  }
+
   UFUNCTION(BlueprintGetter, Category = "Cesium")
   bool GetUseLodTransitions() const { return UseLodTransitions; }
 
@@ -1013,24 +1443,76 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
   void SetCreatePhysicsMeshes(bool bCreatePhysicsMeshes);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetCookPhysicsMeshesOnDemand() const {
+    return CookPhysicsMeshesOnDemand;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetCookPhysicsMeshesOnDemand(bool bCookPhysicsMeshesOnDemand);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  bool GetSimplifyPhysicsMeshes() const { return SimplifyPhysicsMeshes; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetSimplifyPhysicsMeshes(bool bSimplifyPhysicsMeshes);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Physics")
+  float GetPhysicsMeshMaximumError() const { return PhysicsMeshMaximumError; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Physics")
+  void SetPhysicsMeshMaximumError(float NewPhysicsMeshMaximumError);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
   bool GetCreateNavCollision() const { return CreateNavCollision; }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
   void SetCreateNavCollision(bool bCreateNavCollision);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Navigation")
+  bool GetCanEverAffectNavigation() const { return CanEverAffectNavigation; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Navigation")
+  void SetCanEverAffectNavigation(bool bCanEverAffectNavigation);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetAlwaysIncludeTangents() const { return AlwaysIncludeTangents; }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetAlwaysIncludeTangents(bool bAlwaysIncludeTangents);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  ETangentGeneration GetTangentGeneration() const { return TangentGeneration; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetTangentGeneration(ETangentGeneration NewTangentGeneration);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetGenerateSmoothNormals() const { return GenerateSmoothNormals; }
 
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetGenerateSmoothNormals(bool bGenerateSmoothNormals);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetGenerateIndexedFlatNormals() const {
+    return GenerateIndexedFlatNormals;
+  }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetGenerateIndexedFlatNormals(bool bGenerateIndexedFlatNormals);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  float GetFlatNormalCreaseAngle() const { return FlatNormalCreaseAngle; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetFlatNormalCreaseAngle(float NewFlatNormalCreaseAngle);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  ETileVertexFormat GetVertexFormat() const { return VertexFormat; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetVertexFormat(ETileVertexFormat NewVertexFormat);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   bool GetEnableWaterMask() const { return EnableWaterMask; }
 
@@ -1042,6 +1524,24 @@ public:
   UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
   void SetIgnoreKhrMaterialsUnlit(bool bIgnoreKhrMaterialsUnlit);
 
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
+  bool GetMergePrimitives() const { return MergePrimitives; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering")
+  void SetMergePrimitives(bool bMergePrimitives);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering|Experimental")
+  bool GetUseTilesetSceneProxy() const { return UseTilesetSceneProxy; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering|Experimental")
+  void SetUseTilesetSceneProxy(bool bUseTilesetSceneProxy);
+
+  UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering|Experimental")
+  bool GetQuantizePositions() const { return QuantizePositions; }
+
+  UFUNCTION(BlueprintSetter, Category = "Cesium|Rendering|Experimental")
+  void SetQuantizePositions(bool bQuantizePositions);
+
   UFUNCTION(BlueprintGetter, Category = "Cesium|Rendering")
   UMaterialInterface* GetMaterial() const { return Material; }
 
@@ -1096,6 +1596,21 @@ public:
    */
   const glm::dmat4& GetCesiumTilesetToUnrealRelativeWorldTransform() const;
 
+  /**
+   * This method is not supposed to be called by clients. It gets the pool of
+   * reusable tile primitive objects, or nullptr if there is none.
+   */
+  UCesiumPrimitivePool* GetPrimitivePool() const { return this->PrimitivePool; }
+
+  /**
+   * This method is not supposed to be called by clients. It gets the component
+   * that renders the tiles of this tileset, or nullptr if every tile primitive
+   * renders itself.
+   */
+  UCesiumTilesetPrimitiveComponent* GetTilesetPrimitiveComponent() const {
+    return this->TilesetPrimitiveComponent;
+  }
+
   Cesium3DTilesSelection::Tileset* GetTileset() {
     return this->_pTileset.Get();
   }
@@ -1148,16 +1663,7 @@ protected:
 
 private:
   void LoadTileset();
-  void DestroyTileset();
-
-  static Cesium3DTilesSelection::ViewState CreateViewStateFromViewParameters(
-      const FCesiumCamera& camera,
-      const glm::dmat4& unrealWorldToTileset,
-      UCesiumEllipsoid* ellipsoid);
-
-  std::vector<FCesiumCamera> GetCameras() const;
-  std::vector<FCesiumCamera> GetPlayerCameras() const;
-  std::vector<FCesiumCamera> GetSceneCaptures() const;
+  void DestroyTileset(bool allowAmortizedTileDestruction = true);
 
 public:
   /**
@@ -1185,6 +1691,31 @@ private:
    */
   void updateTilesetOptionsFromProperties();
 
+  /**
+   * Reports the tile cache and loading usage of the last view update to the
+   * world's tile budget, if it's enabled.
+   */
+  void reportTileBudgetUsage(
+      const Cesium3DTilesSelection::ViewUpdateResult& result);
+
+  /**
+   * Updates the camera velocity estimates and loads the tiles for the
+   * predicted views of moving cameras, in a view update of their own that
+   * follows the update for the current views. The fewer tiles the predicted
+   * views were waiting for in the last frame, compared to
+   * MaximumPredictiveTileLoads, the further ahead the predictions reach.
+   *
+   * @param viewStates The current view states.
+   * @param pEllipsoid The ellipsoid of the tileset.
+   * @param DeltaTime The time since the previous frame, in seconds.
+   * @param tilesToRender The tiles rendered for the current views.
+   */
+  void loadPredictedViews(
+      const std::vector<Cesium3DTilesSelection::ViewState>& viewStates,
+      UCesiumEllipsoid* pEllipsoid,
+      float DeltaTime,
+      const std::vector<Cesium3DTilesSelection::Tile*>& tilesToRender);
+
   /**
    * Update all the "_last..." fields of this instance based
    * on the given ViewUpdateResult, printing a log message
@@ -1195,13 +1726,24 @@ private:
   void updateLastViewUpdateResultState(
       const Cesium3DTilesSelection::ViewUpdateResult& result);
 
+  /**
+   * Requests the physics meshes of the given tiles that are near a collision
+   * interest actor, and releases the physics meshes that are no longer
+   * needed, when physics meshes are cooked on demand.
+   */
+  void updateOnDemandPhysicsMeshes(
+      const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
+
   /**
    * Creates the visual representations of the given tiles to
    * be rendered in the current frame.
    *
+   * Tiles that were already shown in the previous frame are skipped.
+   *
    * @param tiles The tiles
+   * @return The number of tiles whose state was actually modified.
    */
-  void
+  uint32
   showTilesToRender(const std::vector<Cesium3DTilesSelection::Tile*>& tiles);
 
   /**
@@ -1212,8 +1754,6 @@ private:
   void AddFocusViewportDelegate();
 
 #if WITH_EDITOR
-  std::vector<FCesiumCamera> GetEditorCameras() const;
-
   /**
    * Will focus all viewports on this tileset.
    *
@@ -1252,6 +1792,11 @@ private:
   uint32_t _lastTilesWaitingForOcclusionResults;
   uint32_t _lastMaxDepthVisited;
 
+  // The vertex counts of the loaded tiles, for GetVertexInflationFactor.
+  uint64 _gltfVertexCount = 0;
+  uint64 _vertexCount = 0;
+  uint64 _compactVertexBytesSaved = 0;
+
   std::chrono::high_resolution_clock::time_point _startTime;
 
   bool _captureMovieMode;
@@ -1274,10 +1819,53 @@ private:
   // If we find a way to clear the wrong occlusion information in the
   // Unreal Engine, then this field may be removed, and the
   // tilesToHideThisFrame may be hidden immediately.
-  std::vector<Cesium3DTilesSelection::Tile*> _tilesToHideNextFrame;
+  //
+  // Tiles that are replaced by tiles still being created are kept in this
+  // list until their replacements can be shown.
+  TSharedPtr<CesiumTilesToHide> _pTilesToHideNextFrame;
+
+  // Incremented once per updated frame. Each UCesiumGltfComponent records the
+  // generation in which it was last shown, so tiles that were already shown
+  // in the previous frame can be skipped instead of having their visibility
+  // and collision settings re-applied. Incrementing this by more than one
+  // forces every rendered tile to be refreshed on the next frame.
+  uint64 _renderGeneration;
+
+  // Incremented whenever the transformation from the Cesium tileset to the
+  // Unreal world changes. Only visible tiles are updated right away; each
+  // UCesiumGltfComponent records the epoch of its transform, so hidden tiles
+  // can be updated when they are shown again.
+  uint64 _transformEpoch;
+
+  // The glTF components of this tileset that are currently visible, which are
+  // the only ones updated right away when the transform changes.
+  TSharedPtr<CesiumVisibleGltfs> _pVisibleGltfs;
+
+  // Tiles whose primitive components could not all be created within the
+  // tile creation time slice, in the order they were loaded. Their creation
+  // continues in later frames, and they are not shown until it is complete.
+  std::vector<TWeakObjectPtr<UCesiumGltfComponent>> _gltfsBeingCreated;
+
+  // True while the native tileset is being destroyed and the actor itself
+  // stays alive. The tiles freed meanwhile are destroyed over several frames.
+  bool _amortizeTileDestruction;
 
   int32 _tilesetsBeingDestroyed;
 
+  // Estimates camera velocities for predictive loading.
+  TSharedPtr<CesiumViewStatePredictor> _pViewStatePredictor;
+
+  // The number of tiles that the predicted views were waiting for in the last
+  // frame.
+  uint32 _predictedTileLoadQueueLength;
+
+  // Cooks and releases physics meshes when they are cooked on demand.
+  TSharedPtr<CesiumOnDemandPhysicsMeshes> _pOnDemandPhysicsMeshes;
+
+  // The game thread time this tileset may spend loading and unloading tiles
+  // in each frame, if the adaptive tile loading budget is enabled.
+  TSharedPtr<CesiumTileLoadingBudget> _pTileLoadingBudget;
+
   friend class UnrealResourcePreparer;
   friend class UCesiumGltfPointsComponent;
 };
@@ -68,6 +68,12 @@ public:
   UFUNCTION(BlueprintCallable, Category = "Cesium")
   const TMap<int32, FCesiumCamera>& GetCameras() const;
 
+  /**
+   * @brief Gets a number that changes whenever a camera is added, removed, or
+   * updated, so that users of the cameras can tell when they changed.
+   */
+  uint64 GetRevision() const { return this->_revision; }
+
   virtual bool ShouldTickIfViewportsOnly() const override;
 
   virtual void Tick(float DeltaTime) override;
@@ -75,6 +81,7 @@ public:
 private:
   int32 _currentCameraId = 0;
   TMap<int32, FCesiumCamera> _cameras;
+  uint64 _revision = 0;
 
   static FName DEFAULT_CAMERAMANAGER_TAG;
 };
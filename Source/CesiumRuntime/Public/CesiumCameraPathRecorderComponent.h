@@ -0,0 +1,111 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "CoreMinimal.h"
+#include "Serialization/Archive.h"
+#include "Templates/UniquePtr.h"
+#include "CesiumCameraPathRecorderComponent.generated.h"
+
+class ACesiumCameraManager;
+class ACesiumGeoreference;
+
+/**
+ * Records the cameras that tilesets use for tile selection every frame, so
+ * that a real session can be replayed later by the Cesium load and
+ * performance tests.
+ *
+ * Each frame, the views of the players' camera managers and the cameras of
+ * the Cesium camera manager are recorded. If RecordOnlyPlayerCameras is
+ * disabled, the scene capture and editor cameras are recorded as well, i.e.
+ * all cameras that tilesets use. Cameras are written in Earth-Centered,
+ * Earth-Fixed coordinates to a CSV file, so that the recording doesn't depend
+ * on the origin of the georeference. The file is written as the recording
+ * progresses and closed when recording stops or the component ends play.
+ */
+UCLASS(ClassGroup = "Cesium", Meta = (BlueprintSpawnableComponent))
+class CESIUMRUNTIME_API UCesiumCameraPathRecorderComponent
+    : public UActorComponent {
+  GENERATED_BODY()
+
+public:
+  UCesiumCameraPathRecorderComponent();
+
+  /**
+   * The file to record to. A relative path is relative to the project's
+   * Saved/CameraPaths directory. An existing file is overwritten.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  FString Filename = TEXT("CameraPath.csv");
+
+  /**
+   * Whether to start recording as soon as play begins.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool RecordOnBeginPlay = false;
+
+  /**
+   * Whether to leave out scene capture and editor cameras. The views of the
+   * players' camera managers and the cameras of the Cesium camera manager are
+   * always recorded.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  bool RecordOnlyPlayerCameras = true;
+
+  /**
+   * The georeference used to convert the cameras to Earth-Centered,
+   * Earth-Fixed coordinates. If this is null, the default georeference of the
+   * owning actor is used.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ACesiumGeoreference* Georeference = nullptr;
+
+  /**
+   * The camera manager whose cameras are recorded along with the player
+   * cameras. If this is null, the default camera manager is used.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
+  ACesiumCameraManager* CameraManager = nullptr;
+
+  /**
+   * Starts recording to the file given by the Filename property, stopping any
+   * previous recording. Returns false if the file can't be opened.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  bool StartRecording();
+
+  /**
+   * Stops recording and closes the file.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void StopRecording();
+
+  /**
+   * Whether the component is currently recording.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  bool IsRecording() const;
+
+  /**
+   * Gets the absolute path of the file that is, or would be, recorded to.
+   */
+  UFUNCTION(BlueprintPure, Category = "Cesium")
+  FString GetAbsoluteFilename() const;
+
+  virtual void TickComponent(
+      float DeltaTime,
+      ELevelTick TickType,
+      FActorComponentTickFunction* ThisTickFunction) override;
+
+protected:
+  virtual void BeginPlay() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+  void recordFrame();
+
+  TUniquePtr<FArchive> _pWriter;
+  uint64 _frameNumber = 0;
+  double _startTime = 0.0;
+};
@@ -0,0 +1,169 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Cesium3DTilesSelection/ViewState.h"
+#include "CesiumCamera.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <deque>
+#include <glm/mat4x4.hpp>
+#include <vector>
+
+#include "CesiumCameraSubsystem.generated.h"
+
+class ACesiumCameraManager;
+class AActor;
+class ULevel;
+class UCesiumEllipsoid;
+class USceneCaptureComponent2D;
+
+/**
+ * @brief Collects the cameras that {@link Cesium3DTileset}s use for tile
+ * selection once per frame and shares them between all tilesets in the world.
+ *
+ * This includes the player cameras, the editor viewport cameras (when not in
+ * a game world), and all registered scene captures. `ASceneCapture2D` actors
+ * are registered automatically as they are spawned or streamed in. Scene
+ * capture components attached to other actors can be registered explicitly
+ * with {@link RegisterSceneCapture}.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumCameraSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+  virtual void Deinitialize() override;
+
+  /**
+   * @brief Registers a scene capture component to be used for tile selection
+   * by all tilesets in this world.
+   *
+   * Only perspective scene captures with a valid texture target are used.
+   * Registering the same component more than once has no effect.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void RegisterSceneCapture(USceneCaptureComponent2D* SceneCapture);
+
+  /**
+   * @brief Unregisters a scene capture component previously registered with
+   * {@link RegisterSceneCapture}.
+   */
+  UFUNCTION(BlueprintCallable, Category = "Cesium")
+  void UnregisterSceneCapture(USceneCaptureComponent2D* SceneCapture);
+
+  /**
+   * @brief Gets the player, editor, and scene capture cameras for the current
+   * frame. The result is computed once per frame, unless a scene capture is
+   * registered or unregistered during the frame. The returned reference
+   * remains valid until the end of the frame.
+   *
+   * @param scaleUsingDPI Whether viewport sizes should be divided by the DPI
+   * scale of the viewport.
+   */
+  const std::vector<FCesiumCamera>& GetCameras(bool scaleUsingDPI);
+
+  /**
+   * @brief Gets only the cameras of the players' camera managers for the
+   * current frame, without the scene capture and editor cameras. Unlike
+   * {@link GetCameras}, the result is computed on every call.
+   *
+   * @param scaleUsingDPI Whether viewport sizes should be divided by the DPI
+   * scale of the viewport.
+   */
+  std::vector<FCesiumCamera> GetPlayerCameras(bool scaleUsingDPI) const;
+
+  /**
+   * @brief Gets the view states for the current frame's cameras, plus the
+   * cameras of the given camera manager, as seen by a tileset.
+   *
+   * Tilesets with identical parameters share the same result, so the view
+   * states are only computed once per frame for each distinct combination.
+   * They are computed again if the cameras change during the frame, e.g.
+   * because a scene capture or a camera of the camera manager is added. The
+   * returned reference remains valid until the end of the frame.
+   *
+   * @param unrealWorldToTileset The transformation from Unreal world
+   * coordinates to the tileset's coordinate system.
+   * @param pEllipsoid The ellipsoid of the tileset.
+   * @param scaleUsingDPI Whether viewport sizes should be scaled by DPI.
+   * @param pCameraManager The tileset's camera manager, or nullptr.
+   */
+  const std::vector<Cesium3DTilesSelection::ViewState>& GetViewStates(
+      const glm::dmat4& unrealWorldToTileset,
+      UCesiumEllipsoid* pEllipsoid,
+      bool scaleUsingDPI,
+      const ACesiumCameraManager* pCameraManager);
+
+  /**
+   * @brief Creates a view state for tile selection from a camera.
+   *
+   * @param camera The camera.
+   * @param unrealWorldToTileset The transformation from Unreal world
+   * coordinates to the tileset's coordinate system.
+   * @param ellipsoid The ellipsoid of the tileset.
+   */
+  static Cesium3DTilesSelection::ViewState CreateViewStateFromViewParameters(
+      const FCesiumCamera& camera,
+      const glm::dmat4& unrealWorldToTileset,
+      UCesiumEllipsoid* ellipsoid);
+
+protected:
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+
+private:
+  struct CachedCameras {
+    uint64 version;
+    bool scaleUsingDPI;
+    std::vector<FCesiumCamera> cameras;
+  };
+
+  struct CachedViewStates {
+    uint64 version;
+    glm::dmat4 unrealWorldToTileset;
+    const UCesiumEllipsoid* pEllipsoid;
+    bool scaleUsingDPI;
+    const ACesiumCameraManager* pCameraManager;
+    uint64 cameraManagerRevision;
+    std::vector<Cesium3DTilesSelection::ViewState> viewStates;
+  };
+
+  void invalidateIfNewFrame();
+  void invalidate();
+
+  void collectPlayerCameras(
+      bool scaleUsingDPI,
+      std::vector<FCesiumCamera>& cameras) const;
+  void collectSceneCaptures(std::vector<FCesiumCamera>& cameras);
+#if WITH_EDITOR
+  void collectEditorCameras(
+      bool scaleUsingDPI,
+      std::vector<FCesiumCamera>& cameras) const;
+#endif
+
+  void registerSceneCapturesInLevel(ULevel* pLevel);
+  void onActorSpawned(AActor* pActor);
+  void onLevelAdded(ULevel* pLevel, UWorld* pWorld);
+  void onLevelRemoved(ULevel* pLevel, UWorld* pWorld);
+
+  UFUNCTION()
+  void OnSceneCaptureActorDestroyed(AActor* DestroyedActor);
+
+  TArray<TWeakObjectPtr<USceneCaptureComponent2D>> _sceneCaptures;
+  bool _sceneCapturesNeedInitialScan = true;
+
+  // Results are only released at the start of the next frame, because
+  // references to them may be held until the end of the frame. Invalidating
+  // them during a frame only changes the version that results must have to
+  // be reused.
+  uint64 _frame = 0;
+  uint64 _version = 0;
+  std::deque<CachedCameras> _cameras;
+  std::deque<CachedViewStates> _viewStates;
+
+  FDelegateHandle _actorSpawnedHandle;
+  FDelegateHandle _levelAddedHandle;
+  FDelegateHandle _levelRemovedHandle;
+};
@@ -152,6 +152,11 @@ public:
    * included in the Unreal mesh data. To avoid using
    * CesiumFeaturesMetadataComponent, use GetFeatureIDFromHit instead.
    *
+   * If glTF primitives were merged into the component's mesh, the UV channel
+   * is looked up for the primitive that contains the given face, such as the
+   * FaceIndex of the hit. If no face is given, it is looked up for the
+   * component's first primitive.
+   *
    * This returns -1 if the feature ID texture is invalid, or if the specified
    * texture coordinate set is not present in the component's mesh data.
    */
@@ -161,7 +166,8 @@ public:
       Category = "Cesium|Features|FeatureIDTexture")
   static int64 GetUnrealUVChannel(
       const UPrimitiveComponent* Component,
-      UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture);
+      UPARAM(ref) const FCesiumFeatureIdTexture& FeatureIDTexture,
+      int64 FaceIndex = -1);
 
   PRAGMA_DISABLE_DEPRECATION_WARNINGS
   /**
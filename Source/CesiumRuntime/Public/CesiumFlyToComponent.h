@@ -4,10 +4,14 @@
 
 #include "CesiumGeospatial/SimplePlanarEllipsoidCurve.h"
 #include "CesiumGlobeAnchoredActorComponent.h"
+#include <vector>
 #include "CesiumFlyToComponent.generated.h"
 
 class UCurveFloat;
 class UCesiumGlobeAnchorComponent;
+class ACesiumCameraManager;
+class ACesiumGeoreference;
+struct FCesiumCamera;
 
 /**
  * The delegate for when the Actor finishes flying.
@@ -122,6 +126,79 @@ public:
   UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium")
   ECesiumFlyToRotation RotationToUse = ECesiumFlyToRotation::Actor;
 
+  /**
+   * Whether to load the tiles at the destination while the flight is in
+   * progress, instead of only once the Actor gets close to it.
+   *
+   * When a flight starts, a camera looking in the final direction is added at
+   * the destination to the default CesiumCameraManager, so that tilesets using
+   * it load the tiles the Actor will see on arrival. The camera is removed
+   * when the flight completes or is interrupted.
+   *
+   * This is disabled by default, because the extra cameras also affect what
+   * the tilesets load and show while the flight is in progress.
+   */
+  UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Cesium|Preloading")
+  bool PreloadDestination = false;
+
+  /**
+   * The number of additional cameras to add at evenly-spaced points along the
+   * flight, so that the tiles the Actor passes by are loaded ahead of time as
+   * well. Each of these cameras is removed once the Actor has passed it.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Preloading",
+      meta =
+          (ClampMin = 0, ClampMax = 16, EditCondition = "PreloadDestination"))
+  int32 PreloadPointsAlongFlight = 0;
+
+  /**
+   * If greater than zero, the flight pauses before its final descent until
+   * the LoadProgress of every visible tileset in the world has reached this
+   * percentage, so that the Actor doesn't arrive at a blurry view. If zero,
+   * the flight never waits.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Preloading",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 100.0,
+           EditCondition = "PreloadDestination"))
+  float DestinationLoadProgressThreshold = 0.0f;
+
+  /**
+   * The fraction (0.0 to 1.0) of the flight duration after which the final
+   * descent begins. If DestinationLoadProgressThreshold is greater than zero,
+   * this is where the flight waits for the destination tiles to load.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Preloading",
+      meta =
+          (ClampMin = 0.0,
+           ClampMax = 1.0,
+           EditCondition = "DestinationLoadProgressThreshold > 0.0"))
+  float FinalDescentStart = 0.8f;
+
+  /**
+   * The maximum time in seconds that the flight waits before its final
+   * descent. After this time, the flight continues even if the destination
+   * tiles are not loaded yet.
+   */
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "Cesium|Preloading",
+      meta =
+          (ClampMin = 0.0,
+           EditCondition = "DestinationLoadProgressThreshold > 0.0"))
+  float MaximumDestinationLoadWaitTime = 10.0f;
+
   /**
    * A delegate that will be called when the Actor finishes flying.
    *
@@ -203,10 +280,32 @@ protected:
       float DeltaTime,
       ELevelTick TickType,
       FActorComponentTickFunction* ThisTickFunction) override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+  /**
+   * A camera that is added to the camera manager during a flight in order to
+   * load tiles ahead of the Actor.
+   */
+  struct PreloadCamera {
+    FVector positionEcef;
+    FQuat rotationEastSouthUp;
+    // The flight progress at which the Actor reaches this camera.
+    float flyPercentage;
+    int32 id;
+  };
+
   FQuat GetCurrentRotationEastSouthUp();
   void SetCurrentRotationEastSouthUp(const FQuat& EastSouthUpRotation);
+  double GetAltitudeOffset(float FlyPercentage) const;
+
+  void AddPreloadCameras();
+  void UpdatePreloadCameras(float FlyPercentage);
+  void RemovePreloadCameras();
+  FCesiumCamera CreatePreloadCamera(
+      const PreloadCamera& Camera,
+      ACesiumGeoreference& Georeference) const;
+  bool IsDestinationLoaded() const;
 
   bool _flightInProgress = false;
   bool _canInterruptByMoving;
@@ -218,4 +317,11 @@ private:
   FVector _previousPositionEcef;
   TUniquePtr<CesiumGeospatial::SimplePlanarEllipsoidCurve> _currentCurve;
   double _length;
+
+  std::vector<PreloadCamera> _preloadCameras;
+  TWeakObjectPtr<ACesiumCameraManager> _pPreloadCameraManager;
+  FVector2D _preloadViewportSize = FVector2D(1920.0, 1080.0);
+  double _preloadFieldOfView = 90.0;
+  float _destinationWaitTime = 0.0f;
+  bool _finalDescentAllowed = true;
 };
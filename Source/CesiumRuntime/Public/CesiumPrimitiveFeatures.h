@@ -59,13 +59,19 @@ public:
   /**
    * Gets the primitive features of a glTF primitive component. If component is
    * not a Cesium glTF primitive component, the returned features are empty.
+   *
+   * A component may render several glTF primitives that were merged into its
+   * mesh. In that case, the features are those of the primitive that contains
+   * the given face, such as the FaceIndex of a hit result. If no face is
+   * given, the features of the component's first primitive are returned.
    */
   UFUNCTION(
       BlueprintCallable,
       BlueprintPure,
       Category = "Cesium|Primitive|Features")
-  static const FCesiumPrimitiveFeatures&
-  GetPrimitiveFeatures(const UPrimitiveComponent* component);
+  static const FCesiumPrimitiveFeatures& GetPrimitiveFeatures(
+      const UPrimitiveComponent* component,
+      int64 FaceIndex = -1);
 
   /**
    * Gets all the feature ID sets that are associated with the
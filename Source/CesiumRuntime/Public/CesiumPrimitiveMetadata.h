@@ -57,13 +57,19 @@ public:
   /**
    * Gets the primitive metadata of a glTF primitive component. If component is
    * not a Cesium glTF primitive component, the returned metadata is empty.
+   *
+   * A component may render several glTF primitives that were merged into its
+   * mesh. In that case, the metadata is that of the primitive that contains
+   * the given face, such as the FaceIndex of a hit result. If no face is
+   * given, the metadata of the component's first primitive is returned.
    */
   UFUNCTION(
       BlueprintCallable,
       BlueprintPure,
       Category = "Cesium|Primitive|Metadata")
-  static const FCesiumPrimitiveMetadata&
-  GetPrimitiveMetadata(const UPrimitiveComponent* component);
+  static const FCesiumPrimitiveMetadata& GetPrimitiveMetadata(
+      const UPrimitiveComponent* component,
+      int64 FaceIndex = -1);
 
   /**
    * Get the indices of the property textures that are associated with the
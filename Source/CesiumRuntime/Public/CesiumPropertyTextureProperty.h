@@ -204,6 +204,11 @@ public:
    * included in the Unreal mesh data. To avoid using
    * CesiumFeaturesMetadataComponent, use GetFeatureIDFromHit instead.
    *
+   * If glTF primitives were merged into the component's mesh, the UV channel
+   * is looked up for the primitive that contains the given face, such as the
+   * FaceIndex of the hit. If no face is given, it is looked up for the
+   * component's first primitive.
+   *
    * This returns -1 if the property texture property is invalid, or if the
    * specified texture coordinate set is not present in the component's mesh
    * data.
@@ -214,7 +219,8 @@ public:
       Category = "Cesium|Metadata|PropertyTextureProperty")
   static int64 GetUnrealUVChannel(
       const UPrimitiveComponent* Component,
-      UPARAM(ref) const FCesiumPropertyTextureProperty& Property);
+      UPARAM(ref) const FCesiumPropertyTextureProperty& Property,
+      int64 FaceIndex = -1);
 
   /**
    * @brief Get the channels array of this property. This contains the indices
@@ -45,6 +45,170 @@ public:
   UPROPERTY(Config, EditAnywhere, Category = "Experimental Feature Flags")
   bool EnableExperimentalOcclusionCullingFeature = false;
 
+  /**
+   * Whether the time that tilesets may spend on the game thread each frame
+   * finalizing newly-loaded tiles and unloading cached tiles is adjusted
+   * automatically to keep the game thread frame time near the target below.
+   *
+   * The budget is split evenly among all tilesets, and each tileset's share
+   * is split again between loading and unloading. When this is disabled, each
+   * tileset may spend up to 5 milliseconds on each of these tasks every
+   * frame.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseAdaptiveTileLoadingBudget = false;
+
+  /**
+   * The game thread frame time, in milliseconds, that the adaptive tile
+   * loading budget aims for. The budget grows while recent frames are faster
+   * than this and shrinks while they are slower.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseAdaptiveTileLoadingBudget", ClampMin = 1.0))
+  float TargetGameThreadFrameTime = 11.1f;
+
+  /**
+   * The smallest time, in milliseconds, that all tilesets together may spend
+   * finalizing and unloading tiles in a frame, no matter how slow recent
+   * frames were. Each tileset always finalizes at least one tile per frame.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseAdaptiveTileLoadingBudget", ClampMin = 0.0))
+  float MinimumTileLoadingBudget = 0.5f;
+
+  /**
+   * The largest time, in milliseconds, that all tilesets together may spend
+   * finalizing and unloading tiles in a frame, no matter how fast recent
+   * frames were.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseAdaptiveTileLoadingBudget", ClampMin = 0.0))
+  float MaximumTileLoadingBudget = 10.0f;
+
+  /**
+   * The fraction of the adaptive tile loading budget that is reserved for
+   * unloading cached tiles. The rest is used to finalize newly-loaded tiles.
+   * Because each has its own budget, unloading can't starve loading, nor the
+   * other way around.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta =
+          (EditCondition = "UseAdaptiveTileLoadingBudget",
+           ClampMin = 0.0,
+           ClampMax = 1.0))
+  float TileUnloadingBudgetShare = 0.25f;
+
+  /**
+   * The maximum time in milliseconds to spend creating the Unreal components
+   * of a single newly-loaded tile in one frame. Tiles with many primitives are
+   * then created over several frames, and are shown only once they are
+   * complete. When the adaptive tile loading budget is enabled, the remaining
+   * budget also limits this time. A value of 0 creates each tile all at once.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0))
+  float TileCreationTimeSlice = 0.0f;
+
+  /**
+   * Whether the Unreal objects of unloaded tiles are destroyed over several
+   * frames, within DestructionTimeBudget and DestructionObjectBudget, instead
+   * of as soon as the tiles are unloaded. This avoids hitches when many tiles
+   * are unloaded at once, at the cost of releasing their memory later. The
+   * components of a tileset that is recreated, for example after one of its
+   * properties changes, are always destroyed within these budgets.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseDestructionBudget = false;
+
+  /**
+   * The maximum time in milliseconds to spend destroying the Unreal objects of
+   * unloaded tiles each frame. Objects that don't fit are destroyed in later
+   * frames, those holding the most memory first, though objects gain priority
+   * the longer they wait. At least one object is destroyed per frame. A value
+   * of 0 means no time limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0.0))
+  float DestructionTimeBudget = 2.0f;
+
+  /**
+   * The maximum number of Unreal objects of unloaded tiles to destroy each
+   * frame. A value of 0 means no limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (ClampMin = 0))
+  int32 DestructionObjectBudget = 0;
+
+  /**
+   * Whether the tilesets in a world share a single tile cache size and number
+   * of simultaneous tile loads, instead of each using its own
+   * MaximumCachedBytes and MaximumSimultaneousTileLoads.
+   *
+   * The shared budget is split between the tilesets every frame according to
+   * their TileBudgetPriority and to what each of them is currently rendering
+   * and waiting to load.
+   */
+  UPROPERTY(Config, EditAnywhere, Category = "Tile Loading")
+  bool UseWorldTileBudget = false;
+
+  /**
+   * The maximum number of bytes that all tilesets in a world together may
+   * cache. As with a tileset's own MaximumCachedBytes, tiles that are needed
+   * for rendering are never unloaded, even if they exceed this limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseWorldTileBudget", ClampMin = 0))
+  int64 WorldMaximumCachedBytes = 1024 * 1024 * 1024;
+
+  /**
+   * The number of bytes that each tileset may cache in addition to the tiles
+   * it renders, no matter how little it rendered recently, as long as the
+   * WorldMaximumCachedBytes allow it. This keeps the tiles of a tileset that
+   * is briefly idle, e.g. out of view, from being unloaded right away.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseWorldTileBudget", ClampMin = 0))
+  int64 WorldMinimumCachedBytesPerTileset = 64 * 1024 * 1024;
+
+  /**
+   * The maximum number of tiles that all tilesets in a world together may load
+   * at once. Every tileset may load at least one tile at a time, regardless of
+   * this limit.
+   */
+  UPROPERTY(
+      Config,
+      EditAnywhere,
+      Category = "Tile Loading",
+      meta = (EditCondition = "UseWorldTileBudget", ClampMin = 1))
+  int32 WorldMaximumSimultaneousTileLoads = 40;
+
   /**
    * The number of requests to handle before each prune of old cached results
    * from the database.
@@ -0,0 +1,130 @@
+// Copyright 2020-2024 CesiumGS, Inc. and Contributors
+
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+#include <vector>
+
+#include "CesiumTileBudgetSubsystem.generated.h"
+
+class ACesium3DTileset;
+
+/**
+ * @brief Splits a single tile cache size and number of simultaneous tile
+ * loads between all {@link Cesium3DTileset}s in a world.
+ *
+ * This is only used when `UseWorldTileBudget` is enabled in the Cesium runtime
+ * settings. Each tileset reports what it rendered and how many tiles it is
+ * waiting to load after it updates its view, and receives its share of the
+ * world's budget before the next update.
+ *
+ * The bytes of the tiles that each tileset renders are always granted, because
+ * cesium-native never unloads them anyway. Each tileset also gets a minimum
+ * of spare cache, and the rest of the cache is split in proportion to each
+ * tileset's priority and rendered bytes, so that the total stays within the
+ * world's limit. Tile loads are split in proportion to each
+ * tileset's priority and number of tiles waiting to load, with every tileset
+ * getting at least one.
+ */
+UCLASS()
+class CESIUMRUNTIME_API UCesiumTileBudgetSubsystem : public UWorldSubsystem {
+  GENERATED_BODY()
+
+public:
+  /**
+   * @brief What a tileset used in its most recent view update.
+   */
+  struct TilesetUsage {
+    /**
+     * @brief The tileset's priority weight.
+     */
+    double priority = 1.0;
+
+    /**
+     * @brief The total number of bytes of the tileset's loaded tiles.
+     */
+    int64 totalBytes = 0;
+
+    /**
+     * @brief The number of bytes of the tiles the tileset rendered.
+     */
+    int64 renderedBytes = 0;
+
+    /**
+     * @brief The number of tiles that the tileset is waiting to load.
+     */
+    uint32 tilesWaitingToLoad = 0;
+  };
+
+  /**
+   * @brief A tileset's share of the world's budget.
+   */
+  struct TilesetAllocation {
+    int64 maximumCachedBytes = 0;
+    int32 maximumSimultaneousTileLoads = 1;
+  };
+
+  virtual void Deinitialize() override;
+
+  /**
+   * @brief Whether the world tile budget is enabled in the runtime settings.
+   */
+  bool IsEnabled() const;
+
+  /**
+   * @brief Gets the share of the budget of the given tileset for the current
+   * frame. The shares are recomputed at most once per frame, based on the
+   * most recently reported usage of each tileset.
+   */
+  TilesetAllocation GetAllocation(const ACesium3DTileset* pTileset);
+
+  /**
+   * @brief Reports what the given tileset used in its most recent view
+   * update. Tilesets that stop reporting no longer receive a share.
+   */
+  void ReportUsage(const ACesium3DTileset* pTileset, const TilesetUsage& usage);
+
+  /**
+   * @brief Removes the given tileset from the budget, for example because its
+   * tiles were destroyed.
+   */
+  void RemoveTileset(const ACesium3DTileset* pTileset);
+
+  /**
+   * @brief Splits a budget between tilesets according to their usage.
+   *
+   * @param usages The usage of each tileset.
+   * @param maximumCachedBytes The number of bytes that all tilesets together
+   * may cache.
+   * @param minimumSpareBytesPerTileset The number of bytes beyond its rendered
+   * bytes that each tileset may cache, if the maximum allows it.
+   * @param maximumSimultaneousTileLoads The number of tiles that all tilesets
+   * together may load at once.
+   * @return The share of each tileset, in the same order as the usages.
+   */
+  static std::vector<TilesetAllocation> ComputeAllocations(
+      const std::vector<TilesetUsage>& usages,
+      int64 maximumCachedBytes,
+      int64 minimumSpareBytesPerTileset,
+      int32 maximumSimultaneousTileLoads);
+
+protected:
+  virtual bool DoesSupportWorldType(
+      const EWorldType::Type WorldType) const override;
+
+private:
+  struct TilesetEntry {
+    TWeakObjectPtr<const ACesium3DTileset> pTileset;
+    TilesetUsage usage;
+    TilesetAllocation allocation;
+    uint64 lastReportedFrame;
+  };
+
+  TilesetEntry* findEntry(const ACesium3DTileset* pTileset);
+  void updateIfNewFrame();
+  void updateAllocations();
+
+  TArray<TilesetEntry> _tilesets;
+  uint64 _frame = 0;
+};